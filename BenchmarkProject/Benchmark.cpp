@@ -0,0 +1,209 @@
+/**
+* @file       Benchmark.cpp
+* @brief      CBenchmarkState and CBenchmarkRunner class implementations
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*/
+
+#include "stdafx.h"
+#include "Benchmark.h"
+
+#ifndef _FSTREAM_
+    #include <fstream>
+#endif
+
+/// width of the benchmark name column
+constexpr int    BENCHMARK_NAME_WIDTH = 52;
+/// factor an iteration count may grow by between runs
+constexpr double MAX_ITERATION_GROWTH = 10.0;
+
+/**
+    @brief Outputs a duration in the most legible unit
+*/
+static void OutputTime ( std::basic_ostream<TCHAR>& os, double dSeconds ) noexcept
+{
+    if ( dSeconds < 1e-6 )
+        os << std::setw(10) << dSeconds * 1e9 << _T(" ns");
+    else if ( dSeconds < 1e-3 )
+        os << std::setw(10) << dSeconds * 1e6 << _T(" us");
+    else if ( dSeconds < 1.0 )
+        os << std::setw(10) << dSeconds * 1e3 << _T(" ms");
+    else
+        os << std::setw(10) << dSeconds << _T(" s ");
+}
+
+/**
+    @brief Outputs a rate with a decimal magnitude suffix
+*/
+static void OutputRate ( std::basic_ostream<TCHAR>& os, double dRate, const TCHAR* szUnit ) noexcept
+{
+    if ( dRate >= 1e9 )
+        os << std::setw(10) << dRate / 1e9 << _T(" G") << szUnit;
+    else if ( dRate >= 1e6 )
+        os << std::setw(10) << dRate / 1e6 << _T(" M") << szUnit;
+    else if ( dRate >= 1e3 )
+        os << std::setw(10) << dRate / 1e3 << _T(" k") << szUnit;
+    else
+        os << std::setw(10) << dRate << _T("  ") << szUnit;
+}
+
+
+CBenchmarkState::CBenchmarkState ( QWORD qwMaxIterations ) noexcept
+    : m_qwMaxIterations ( qwMaxIterations ),
+      m_qwIterations    ( 0 ),
+      m_qwItems         ( 0 ),
+      m_qwBytes         ( 0 ),
+      m_dElapsed        ( 0.0 ),
+      m_bTiming         ( false ),
+      m_tpStart         ( )
+{
+}
+
+void CBenchmarkState::PauseTiming ( void ) noexcept
+{
+    if ( m_bTiming )
+    {
+        m_dElapsed += std::chrono::duration<double> ( std::chrono::steady_clock::now ( ) - m_tpStart ).count ( );
+        m_bTiming   = false;
+    }
+}
+
+void CBenchmarkState::ResumeTiming ( void ) noexcept
+{
+    if ( m_bTiming == false )
+    {
+        m_bTiming = true;
+        m_tpStart = std::chrono::steady_clock::now ( );
+    }
+}
+
+
+CBenchmarkRunner::CBenchmarkRunner ( double dMinTime ) noexcept
+    : m_dMinTime  ( dMinTime ),
+      m_strFilter ( ),
+      m_vResults  ( ),
+      m_pStream   ( nullptr )
+{
+}
+
+bool CBenchmarkRunner::IsSelected ( const TCHAR* szName ) const noexcept
+{
+    return m_strFilter.empty ( ) || (std::basic_string<TCHAR> ( szName ).find ( m_strFilter ) != std::basic_string<TCHAR>::npos);
+}
+
+bool CBenchmarkRunner::Run ( const TCHAR* szName, const BENCHMARK_FN& fnBenchmark ) noexcept
+{
+    if ( IsSelected ( szName ) == false )
+        return false;
+
+    BENCHMARK_RESULT result = { };
+
+    result.strName = szName;
+
+    QWORD qwIterations = 1;
+
+    for ( ; ; )
+    {
+        CBenchmarkState state ( qwIterations );
+
+        fnBenchmark ( state );
+
+        const double dElapsed = state.GetElapsed ( );
+
+        if ( dElapsed >= m_dMinTime || qwIterations >= MAX_BENCHMARK_ITERATIONS )
+        {
+            result.qwIterations    = state.GetIterations ( );
+            result.dTime           = (result.qwIterations > 0) ? dElapsed / result.qwIterations : 0.0;
+            result.dItemsPerSecond = (dElapsed > 0.0) ? state.GetItemsProcessed ( ) / dElapsed : 0.0;
+            result.dBytesPerSecond = (dElapsed > 0.0) ? state.GetBytesProcessed ( ) / dElapsed : 0.0;
+            break;
+        }
+
+        // aim a little beyond the minimum time, so that the next run is
+        // likely to be the last one
+        double dGrowth = (dElapsed > 0.0) ? (m_dMinTime * 1.4) / dElapsed : MAX_ITERATION_GROWTH;
+
+        if ( dGrowth > MAX_ITERATION_GROWTH )
+            dGrowth = MAX_ITERATION_GROWTH;
+
+        const QWORD qwNext = static_cast<QWORD>(qwIterations * dGrowth);
+
+        qwIterations = (qwNext > qwIterations) ? qwNext : qwIterations + 1;
+
+        if ( qwIterations > MAX_BENCHMARK_ITERATIONS )
+            qwIterations = MAX_BENCHMARK_ITERATIONS;
+    }
+
+    m_vResults.push_back ( result );
+
+    if ( m_pStream != nullptr )
+        OutputResult ( *m_pStream, result ) << std::flush;
+
+    return true;
+}
+
+std::basic_ostream<TCHAR>& CBenchmarkRunner::OutputHeader ( std::basic_ostream<TCHAR>& os ) noexcept
+{
+    os << std::left << std::setw(BENCHMARK_NAME_WIDTH) << _T("Benchmark") << std::right
+       << std::setw(13) << _T("Time")
+       << std::setw(12) << _T("Iterations")
+       << std::setw(17) << _T("Items/s")
+       << std::setw(17) << _T("Bytes/s") << std::endl;
+
+    os << std::basic_string<TCHAR> ( BENCHMARK_NAME_WIDTH + 13 + 12 + 17 + 17, _T('-') ) << std::endl;
+
+    return os;
+}
+
+std::basic_ostream<TCHAR>& CBenchmarkRunner::OutputResult ( std::basic_ostream<TCHAR>& os, const BENCHMARK_RESULT& result ) noexcept
+{
+    const std::streamsize      nPrecision = os.precision ( );
+    const std::ios_base::fmtflags ffFlags = os.flags ( );
+
+    os << std::left << std::setw(BENCHMARK_NAME_WIDTH) << result.strName << std::right;
+
+    os << std::fixed << std::setprecision(2);
+
+    OutputTime ( os, result.dTime );
+
+    os << std::setw(12) << result.qwIterations << _T(" ");
+
+    if ( result.dItemsPerSecond > 0.0 )
+        OutputRate ( os, result.dItemsPerSecond, _T("/s ") );
+    else
+        os << std::setw(16) << _T(" ");
+
+    if ( result.dBytesPerSecond > 0.0 )
+        OutputRate ( os, result.dBytesPerSecond, _T("B/s") );
+
+    os << _T("\n");
+
+    os.flags ( ffFlags );
+    os.precision ( nPrecision );
+
+    return os;
+}
+
+bool CBenchmarkRunner::SaveCsv ( const TCHAR* szFileName ) const noexcept
+{
+    std::basic_ofstream<TCHAR> ofs ( szFileName, std::ios::out | std::ios::trunc );
+
+    if ( ofs.is_open ( ) == false )
+        return false;
+
+    ofs << _T("name,iterations,seconds_per_iteration,items_per_second,bytes_per_second\n");
+
+    ofs << std::setprecision(9);
+
+    for ( std::vector<BENCHMARK_RESULT>::const_iterator it = m_vResults.begin ( ); it != m_vResults.end ( ); ++it )
+    {
+        ofs << it->strName << _T(",") << it->qwIterations << _T(",") << it->dTime << _T(",")
+            << it->dItemsPerSecond << _T(",") << it->dBytesPerSecond << _T("\n");
+    }
+
+    ofs.close ( );
+
+    return ofs.fail ( ) == false;
+}
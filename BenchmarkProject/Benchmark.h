@@ -0,0 +1,298 @@
+/**
+* @file       Benchmark.h
+* @brief      CBenchmarkState and CBenchmarkRunner class interfaces
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  A minimal microbenchmark harness, in the manner of Google Benchmark.
+*  A benchmark is a function given a CBenchmarkState, which times the body
+*  of its loop:
+*
+*        while ( state.KeepRunning ( ) )
+*        {
+*            ... code being measured ...
+*        }
+*
+*  The runner repeats a benchmark with an increasing number of iterations
+*  until a run lasts at least the minimum time, and reports the time per
+*  iteration of that final run.  Setup and tear down within the loop may be
+*  excluded by way of PauseTiming and ResumeTiming.
+*/
+#pragma once
+
+#if !defined(_BENCHMARK_H__)
+#define _BENCHMARK_H__
+
+#ifndef _COMMON_DEF_H__
+    #include "CommonDef.h"
+#endif
+
+#ifndef _CHRONO_
+    #include <chrono>
+#endif
+
+#ifndef _FUNCTIONAL_
+    #include <functional>
+#endif
+
+#ifndef _OSTREAM_
+    #include <ostream>
+#endif
+
+#ifndef _STRING_
+    #include <string>
+#endif
+
+#ifndef _VECTOR_
+    #include <vector>
+#endif
+
+/// default minimum duration of a benchmark run, in seconds
+constexpr double DEFAULT_MIN_TIME         = 0.5;
+/// upper limit on the number of iterations of a benchmark run
+constexpr QWORD  MAX_BENCHMARK_ITERATIONS = 1000000000;
+
+/**
+    @brief Timing state of a single benchmark run
+*/
+class CBenchmarkState
+{
+    typedef std::chrono::steady_clock::time_point TIME_POINT_T;
+
+    QWORD           m_qwMaxIterations;  ///< iterations to be run
+    QWORD           m_qwIterations;     ///< iterations started
+    QWORD           m_qwItems;          ///< items processed, in total
+    QWORD           m_qwBytes;          ///< bytes processed, in total
+    double          m_dElapsed;         ///< timed seconds
+    bool            m_bTiming;          ///< the timer is running
+    TIME_POINT_T    m_tpStart;          ///< start of the current timed interval
+
+public:
+    /**
+        @brief Initialization Constructor
+
+        @param [in] qwMaxIterations     iterations to be run
+    */
+    explicit CBenchmarkState(QWORD qwMaxIterations) noexcept;
+
+    /// Default Destructor
+    ~CBenchmarkState() = default;
+
+/**
+    @brief Starts the next iteration
+
+    @retval true        if another iteration is to be run
+    @retval false       once every iteration has been run
+*/
+    bool KeepRunning(void) noexcept
+    {
+        if ( m_qwIterations == 0 )
+            ResumeTiming ( );
+
+        if ( m_qwIterations < m_qwMaxIterations )
+        {
+            m_qwIterations++;
+            return true;
+        }
+
+        PauseTiming ( );
+
+        return false;
+    };
+
+/**
+    @brief Stops the timer, excluding what follows from the measurement
+*/
+    void PauseTiming(void) noexcept;
+
+/**
+    @brief Restarts the timer
+*/
+    void ResumeTiming(void) noexcept;
+
+/**
+    @brief Sets the number of items processed by the whole run
+
+    @param [in] qwItems     count of items, e.g. edges or cycles
+*/
+    void SetItemsProcessed(QWORD qwItems) noexcept
+    { m_qwItems = qwItems; };
+
+/**
+    @brief Sets the number of bytes processed by the whole run
+
+    @param [in] qwBytes     count of bytes
+*/
+    void SetBytesProcessed(QWORD qwBytes) noexcept
+    { m_qwBytes = qwBytes; };
+
+/**
+    @brief Retrieves the number of iterations to be run
+
+    @retval QWORD       count of iterations
+*/
+    constexpr QWORD GetMaxIterations(void) const noexcept
+    { return m_qwMaxIterations; };
+
+/**
+    @brief Retrieves the number of iterations started
+
+    @retval QWORD       count of iterations
+*/
+    constexpr QWORD GetIterations(void) const noexcept
+    { return m_qwIterations; };
+
+/**
+    @brief Retrieves the number of items processed
+
+    @retval QWORD       count of items
+*/
+    constexpr QWORD GetItemsProcessed(void) const noexcept
+    { return m_qwItems; };
+
+/**
+    @brief Retrieves the number of bytes processed
+
+    @retval QWORD       count of bytes
+*/
+    constexpr QWORD GetBytesProcessed(void) const noexcept
+    { return m_qwBytes; };
+
+/**
+    @brief Retrieves the timed duration of the run
+
+    @retval double      elapsed seconds
+*/
+    constexpr double GetElapsed(void) const noexcept
+    { return m_dElapsed; };
+
+private:
+    /// copy constructor
+    CBenchmarkState(const CBenchmarkState& o) = delete;
+
+    /// assignment operator
+    CBenchmarkState& operator=(const CBenchmarkState& rhs) = delete;
+};
+
+/**
+    @brief Measurements of a single benchmark
+*/
+struct BENCHMARK_RESULT
+{
+    std::basic_string<TCHAR> strName;          ///< benchmark name
+    QWORD                    qwIterations;     ///< iterations of the final run
+    double                   dTime;            ///< seconds per iteration
+    double                   dItemsPerSecond;  ///< items processed per second, 0 if not set
+    double                   dBytesPerSecond;  ///< bytes processed per second, 0 if not set
+};
+
+/**
+    @brief Runs benchmarks and collects their results
+*/
+class CBenchmarkRunner
+{
+    double                            m_dMinTime;  ///< minimum duration of a run, in seconds
+    std::basic_string<TCHAR>          m_strFilter; ///< only names containing it are run
+    std::vector<BENCHMARK_RESULT>     m_vResults;  ///< results, in the order run
+    std::basic_ostream<TCHAR>*        m_pStream;   ///< receives each result as it completes
+
+public:
+
+    /// benchmark function
+    typedef std::function<void(CBenchmarkState& state)> BENCHMARK_FN;
+
+    /**
+        @brief Initialization Constructor
+
+        @param [in] dMinTime    minimum duration of a run, in seconds
+    */
+    explicit CBenchmarkRunner(double dMinTime = DEFAULT_MIN_TIME) noexcept;
+
+    /// Default Destructor
+    ~CBenchmarkRunner() = default;
+
+/**
+    @brief Restricts the benchmarks run to those whose name contains a string
+
+    @param [in] szFilter    the string, empty to run every benchmark
+*/
+    void SetFilter(const TCHAR* szFilter) noexcept
+    { m_strFilter = szFilter; };
+
+/**
+    @brief Sets the stream each result is output to as it completes
+
+    @param [in] pStream     destination output stream, nullptr for none
+*/
+    void SetOutputStream(std::basic_ostream<TCHAR>* pStream) noexcept
+    { m_pStream = pStream; };
+
+/**
+    @brief Determines whether a benchmark passes the filter
+
+    @param [in] szName      benchmark name
+
+    @retval true            if the benchmark is to be run
+    @retval false           otherwise
+*/
+    bool IsSelected(const TCHAR* szName) const noexcept;
+
+/**
+    @brief Runs a benchmark, if selected, and records its result
+
+    @param [in] szName      benchmark name
+    @param [in] fnBenchmark benchmark function
+
+    @retval true            if the benchmark was run
+    @retval false           if filtered out
+*/
+    bool Run(const TCHAR* szName, const BENCHMARK_FN& fnBenchmark) noexcept;
+
+/**
+    @brief Retrieves the results of every benchmark run
+
+    @retval std::vector<BENCHMARK_RESULT>&  the results, in the order run
+*/
+    const std::vector<BENCHMARK_RESULT>& GetResults(void) const noexcept
+    { return m_vResults; };
+
+/**
+    @brief Formats and outputs the column headings
+
+    @param [in,out] os      destination output stream
+
+    @retval std::basic_ostream<TCHAR>&  reference to updated stream
+*/
+    static std::basic_ostream<TCHAR>& OutputHeader(std::basic_ostream<TCHAR>& os) noexcept;
+
+/**
+    @brief Formats and outputs a result as a table row
+
+    @param [in,out] os      destination output stream
+    @param [in] result      the result
+
+    @retval std::basic_ostream<TCHAR>&  reference to updated stream
+*/
+    static std::basic_ostream<TCHAR>& OutputResult(std::basic_ostream<TCHAR>& os, const BENCHMARK_RESULT& result) noexcept;
+
+/**
+    @brief Writes every result to a CSV file, for before/after comparisons
+
+    @param [in] szFileName  name of the CSV file
+
+    @retval true            on success
+    @retval false           on error
+*/
+    bool SaveCsv(const TCHAR* szFileName) const noexcept;
+
+private:
+    /// copy constructor
+    CBenchmarkRunner(const CBenchmarkRunner& o) = delete;
+
+    /// assignment operator
+    CBenchmarkRunner& operator=(const CBenchmarkRunner& rhs) = delete;
+};
+
+#endif
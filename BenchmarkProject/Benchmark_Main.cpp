@@ -0,0 +1,458 @@
+/**
+ * @file       Benchmark_Main.cpp
+ * @brief      Main source file for the pipeline project microbenchmarks
+ *
+ * @author     Mark L. Short
+ * @date       October 14, 2026
+ *
+ *    Measures the throughput of the paths every run of the pipeline project
+ *    depends upon, over synthetic traces of each shape from 10^3 up to
+ *    10^7 instructions:
+ *    - BM_LoadData                          parsing a text trace file, and
+ *                                           freezing it as LoadGraph does
+ *    - BM_AddNode, BM_AddEdge               building a CDependencyGraph
+ *    - BM_ClearGraph                        releasing it
+ *    - BM_Freeze                            freezing it into CSR form
+ *    - BM_BulkBuild                         building the CSR form by way of
+ *                                           a CEdgeListBuilder instead
+ *    - BM_GetNumEdges                       counting its edges
+ *    - BM_CalculateNumberOfStallsRequired   the data hazard analysis
+ *    - BM_ProcessNextCycle                  stepping the pipeline simulator
+ *    - BM_LaneSim8, BM_LaneSim32            stepping 8 or 32 simulations of
+ *                                           the trace in the lanes of a
+ *                                           CLaneSim, per lane cycle
+ *
+ *    BM_AddEdge and BM_ClearGraph have an Arena variant, measuring a graph
+ *    constructed with GA_ARENA.
+ *
+ *    Each benchmark is named BM_xxx/shape/instructions, such that a filter
+ *    may select any subset.  Saving the results of a run before and after a
+ *    change, by way of -csv, affords a direct comparison.
+ */
+
+#include "stdafx.h"
+#include "Benchmark.h"
+#include "SyntheticTrace.h"
+#include "TraceLoader.h"
+#include "HazardAnalysis.h"
+#include "PipelineSim.h"
+#include "LaneSim.h"
+
+#ifndef _FILESYSTEM_
+    #include <filesystem>
+#endif
+
+#ifndef _SSTREAM_
+    #include <sstream>
+#endif
+
+
+/// File the text trace benchmarks are loaded from, unless named otherwise
+constexpr TCHAR  g_szTempFileName[] = _T("BenchmarkTrace.txt");
+/// Smallest trace benchmarked, unless specified otherwise
+constexpr size_t DEFAULT_MIN_NODES  = 1000;
+/// Largest trace benchmarked, unless specified otherwise
+constexpr size_t DEFAULT_MAX_NODES  = 10000000;
+
+/// Receives results which would otherwise be optimized away
+static volatile size_t g_nSink = 0;
+
+
+/**
+ * @brief FormatName composes the name of a benchmark over a trace.
+ *
+ * @param [in] szBenchmark  name of the benchmark
+ * @param [in] trace        synthetic trace benchmarked
+ *
+ * @retval tstring          the name, i.e. BM_xxx/shape/instructions
+ */
+tstring FormatName ( const TCHAR* szBenchmark, const CSyntheticTrace& trace );
+
+/**
+ * @brief IsAnySelected determines whether any benchmark over a trace passes
+ * the filter, such that unused traces need not be generated.
+ *
+ * @param [in] runner       benchmark runner
+ * @param [in] trace        synthetic trace, of the shape and size to be run
+ *
+ * @retval true             if at least one benchmark is to be run
+ * @retval false            otherwise
+ */
+bool IsAnySelected ( const CBenchmarkRunner& runner, const CSyntheticTrace& trace );
+
+/**
+ * @brief RunTraceBenchmarks runs every selected benchmark over a trace.
+ *
+ * The mutable graph, its frozen form and the hazard analysis are built
+ * once, and shared by the benchmarks which only read them.
+ *
+ * @param [in,out] runner       benchmark runner
+ * @param [in] trace            synthetic trace
+ * @param [in] szTempFileName   file the trace is written to for BM_LoadData
+ */
+void RunTraceBenchmarks ( CBenchmarkRunner& runner, const CSyntheticTrace& trace, const TCHAR* szTempFileName );
+
+
+/// Names of the benchmarks run over each trace
+static const TCHAR* const g_rgszBenchmarks[] =
+{
+    _T("BM_LoadData"),
+    _T("BM_AddNode"),
+    _T("BM_AddEdge"),
+    _T("BM_AddEdgeArena"),
+    _T("BM_ClearGraph"),
+    _T("BM_ClearGraphArena"),
+    _T("BM_Freeze"),
+    _T("BM_BulkBuild"),
+    _T("BM_GetNumEdges"),
+    _T("BM_CalculateNumberOfStallsRequired"),
+    _T("BM_ProcessNextCycle"),
+    _T("BM_LaneSim8"),
+    _T("BM_LaneSim32"),
+};
+
+
+int _tmain ( int argc, _TCHAR* argv[] )
+{
+    const TCHAR* szTempFile = g_szTempFileName;
+    const TCHAR* szCsvFile  = nullptr;
+    const TCHAR* szFilter   = _T("");
+    size_t       nMinNodes  = DEFAULT_MIN_NODES;
+    size_t       nMaxNodes  = DEFAULT_MAX_NODES;
+    double       dMinTime   = DEFAULT_MIN_TIME;
+
+    // usage: BenchmarkProject [-filter <substring>] [-min <instructions>] [-max <instructions>]
+    //                         [-min-time <seconds>] [-csv <file>] [-temp <trace file>]
+    for (int i = 1; i < argc; i++)
+    {
+        if ( (_tcscmp(argv[i], _T("-filter")) == 0) && (i + 1 < argc) )
+            szFilter   = argv[++i];
+        else if ( (_tcscmp(argv[i], _T("-min")) == 0) && (i + 1 < argc) )
+            nMinNodes  = static_cast<size_t>(_tcstoul(argv[++i], nullptr, 10));
+        else if ( (_tcscmp(argv[i], _T("-max")) == 0) && (i + 1 < argc) )
+            nMaxNodes  = static_cast<size_t>(_tcstoul(argv[++i], nullptr, 10));
+        else if ( (_tcscmp(argv[i], _T("-min-time")) == 0) && (i + 1 < argc) )
+            dMinTime   = _tcstod(argv[++i], nullptr);
+        else if ( (_tcscmp(argv[i], _T("-csv")) == 0) && (i + 1 < argc) )
+            szCsvFile  = argv[++i];
+        else if ( (_tcscmp(argv[i], _T("-temp")) == 0) && (i + 1 < argc) )
+            szTempFile = argv[++i];
+        else
+            tcout << _T("Unrecognized option: ") << argv[i] << std::endl;
+    }
+
+    if ( nMinNodes == 0 )
+        nMinNodes = 1;
+
+    CBenchmarkRunner runner ( dMinTime );
+
+    runner.SetFilter ( szFilter );
+    runner.SetOutputStream ( &tcout );
+
+    CBenchmarkRunner::OutputHeader ( tcout );
+
+    CSyntheticTrace trace;
+
+    for ( int iShape = SG_CHAIN; iShape < SG_NUM_SHAPES; iShape++ )
+    {
+        // decades of instructions, i.e. 10^3, 10^4, ... by default
+        for ( size_t nNumNodes = nMinNodes; nNumNodes <= nMaxNodes; nNumNodes *= 10 )
+        {
+            trace.Generate ( static_cast<SG_TRACE_SHAPE>(iShape), nNumNodes );
+
+            if ( IsAnySelected ( runner, trace ) )
+                RunTraceBenchmarks ( runner, trace, szTempFile );
+
+            trace.Clear ( );
+
+            if ( nNumNodes > nMaxNodes / 10 )
+                break;
+        }
+    }
+
+    if ( szCsvFile != nullptr && runner.SaveCsv ( szCsvFile ) == false )
+    {
+        tcout << _T("Error writing CSV file:") << szCsvFile << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+tstring FormatName ( const TCHAR* szBenchmark, const CSyntheticTrace& trace )
+{
+    std::basic_ostringstream<TCHAR> oss;
+
+    oss << szBenchmark << _T("/") << CSyntheticTrace::GetShapeName ( trace.GetShape ( ) )
+        << _T("/") << trace.GetNumNodes ( );
+
+    return oss.str ( );
+}
+
+bool IsAnySelected ( const CBenchmarkRunner& runner, const CSyntheticTrace& trace )
+{
+    bool bReturn = false;
+
+    for ( size_t i = 0; i < _countof(g_rgszBenchmarks) && bReturn == false; i++ )
+        bReturn = runner.IsSelected ( FormatName ( g_rgszBenchmarks[i], trace ).c_str ( ) );
+
+    return bReturn;
+}
+
+void RunTraceBenchmarks ( CBenchmarkRunner& runner, const CSyntheticTrace& trace, const TCHAR* szTempFileName )
+{
+    const QWORD qwNumNodes = trace.GetNumNodes ( );
+    const QWORD qwNumEdges = trace.GetNumEdges ( );
+
+    // the text trace is parsed and frozen as LoadGraph would, less its
+    // console output
+    const tstring strLoadData = FormatName ( _T("BM_LoadData"), trace );
+
+    if ( runner.IsSelected ( strLoadData.c_str ( ) ) )
+    {
+        std::error_code ec;
+
+        if ( trace.SaveText ( szTempFileName ) == false )
+        {
+            tcout << _T("Error writing trace file:") << szTempFileName << std::endl;
+        }
+        else
+        {
+            const QWORD qwFileSize = std::filesystem::file_size ( szTempFileName, ec );
+
+            runner.Run ( strLoadData.c_str ( ), [&] ( CBenchmarkState& state )
+            {
+                while ( state.KeepRunning ( ) )
+                {
+                    CEdgeListBuilder    builder;
+                    CCsrDependencyGraph csr;
+                    CTraceLoader        loader ( builder );
+
+                    loader.LoadFile ( szTempFileName );
+
+                    g_nSink = csr.Freeze ( builder );
+
+                    // the graphs are released outside of the measurement
+                    state.PauseTiming ( );
+                    builder.Clear ( );
+                    csr.Clear ( );
+                    state.ResumeTiming ( );
+                }
+
+                state.SetItemsProcessed ( state.GetIterations ( ) * (qwNumNodes + qwNumEdges) );
+                state.SetBytesProcessed ( state.GetIterations ( ) * qwFileSize );
+            } );
+        }
+
+        std::filesystem::remove ( szTempFileName, ec );
+    }
+
+    runner.Run ( FormatName ( _T("BM_AddNode"), trace ).c_str ( ), [&] ( CBenchmarkState& state )
+    {
+        CDependencyGraph dag;
+
+        while ( state.KeepRunning ( ) )
+        {
+            for ( size_t i = 0; i < trace.GetNumNodes ( ); i++ )
+                dag.AddNode ( static_cast<NODE_ID_T>(i) );
+
+            g_nSink = dag.GetNumNodes ( );
+
+            state.PauseTiming ( );
+            dag.Clear ( );
+            state.ResumeTiming ( );
+        }
+
+        state.SetItemsProcessed ( state.GetIterations ( ) * qwNumNodes );
+    } );
+
+    for ( int iAllocation = GA_HEAP; iAllocation <= GA_ARENA; iAllocation++ )
+    {
+        const GA_GRAPH_ALLOCATION gaAllocation = static_cast<GA_GRAPH_ALLOCATION>(iAllocation);
+
+        const TCHAR* szAddEdge = (gaAllocation == GA_ARENA) ? _T("BM_AddEdgeArena")    : _T("BM_AddEdge");
+        const TCHAR* szClear   = (gaAllocation == GA_ARENA) ? _T("BM_ClearGraphArena") : _T("BM_ClearGraph");
+
+        runner.Run ( FormatName ( szAddEdge, trace ).c_str ( ), [&] ( CBenchmarkState& state )
+        {
+            CDependencyGraph dag ( gaAllocation );
+
+            while ( state.KeepRunning ( ) )
+            {
+                // only the edges are measured, the nodes having been added in advance
+                state.PauseTiming ( );
+                dag.Clear ( );
+
+                for ( size_t i = 0; i < trace.GetNumNodes ( ); i++ )
+                    dag.AddNode ( static_cast<NODE_ID_T>(i) );
+
+                state.ResumeTiming ( );
+
+                g_nSink = trace.BuildGraph ( dag );
+            }
+
+            state.SetItemsProcessed ( state.GetIterations ( ) * qwNumEdges );
+        } );
+
+        runner.Run ( FormatName ( szClear, trace ).c_str ( ), [&] ( CBenchmarkState& state )
+        {
+            CDependencyGraph dag ( gaAllocation );
+
+            while ( state.KeepRunning ( ) )
+            {
+                state.PauseTiming ( );
+                trace.BuildGraph ( dag );
+                state.ResumeTiming ( );
+
+                dag.Clear ( );
+            }
+
+            state.SetItemsProcessed ( state.GetIterations ( ) * (qwNumNodes + qwNumEdges) );
+        } );
+    }
+
+    if ( runner.IsSelected ( FormatName ( _T("BM_Freeze"), trace ).c_str ( ) ) )
+    {
+        CDependencyGraph dagFreeze;
+
+        trace.BuildGraph ( dagFreeze );
+
+        runner.Run ( FormatName ( _T("BM_Freeze"), trace ).c_str ( ), [&] ( CBenchmarkState& state )
+        {
+            CCsrDependencyGraph csr;
+
+            while ( state.KeepRunning ( ) )
+                g_nSink = csr.Freeze ( dagFreeze );
+
+            state.SetItemsProcessed ( state.GetIterations ( ) * (qwNumNodes + qwNumEdges) );
+        } );
+    }
+
+    runner.Run ( FormatName ( _T("BM_BulkBuild"), trace ).c_str ( ), [&] ( CBenchmarkState& state )
+    {
+        CEdgeListBuilder    builder;
+        CCsrDependencyGraph csr;
+
+        while ( state.KeepRunning ( ) )
+        {
+            trace.BuildEdgeList ( builder );
+
+            g_nSink = csr.Freeze ( builder );
+
+            state.PauseTiming ( );
+            builder.Clear ( );
+            state.ResumeTiming ( );
+        }
+
+        state.SetItemsProcessed ( state.GetIterations ( ) * (qwNumNodes + qwNumEdges) );
+    } );
+
+    const bool bGetNumEdges = runner.IsSelected ( FormatName ( _T("BM_GetNumEdges"), trace ).c_str ( ) );
+    const bool bStalls      = runner.IsSelected ( FormatName ( _T("BM_CalculateNumberOfStallsRequired"), trace ).c_str ( ) );
+    const bool bSimulate    = runner.IsSelected ( FormatName ( _T("BM_ProcessNextCycle"), trace ).c_str ( ) ) ||
+                              runner.IsSelected ( FormatName ( _T("BM_LaneSim8"), trace ).c_str ( ) ) ||
+                              runner.IsSelected ( FormatName ( _T("BM_LaneSim32"), trace ).c_str ( ) );
+
+    if ( (bGetNumEdges || bStalls || bSimulate) == false )
+        return;
+
+    CDependencyGraph dag;
+
+    trace.BuildGraph ( dag );
+
+    runner.Run ( FormatName ( _T("BM_GetNumEdges"), trace ).c_str ( ), [&] ( CBenchmarkState& state )
+    {
+        while ( state.KeepRunning ( ) )
+            g_nSink = dag.GetNumEdges ( );
+
+        state.SetItemsProcessed ( state.GetIterations ( ) * qwNumNodes );
+    } );
+
+    if ( (bStalls || bSimulate) == false )
+        return;
+
+    CCsrDependencyGraph csr ( dag );
+
+    dag.Clear ( );
+
+    const CPipelineConfig config;
+
+    runner.Run ( FormatName ( _T("BM_CalculateNumberOfStallsRequired"), trace ).c_str ( ), [&] ( CBenchmarkState& state )
+    {
+        // as CalculateNumberOfStallsRequired, less the analysis object construction
+        CHazardAnalysis hazards;
+
+        while ( state.KeepRunning ( ) )
+            g_nSink = static_cast<size_t>(hazards.Analyze ( csr, config ));
+
+        state.SetItemsProcessed ( state.GetIterations ( ) * (qwNumNodes + qwNumEdges) );
+    } );
+
+    if ( bSimulate == false )
+        return;
+
+    CHazardAnalysis hazards;
+
+    runner.Run ( FormatName ( _T("BM_ProcessNextCycle"), trace ).c_str ( ), [&] ( CBenchmarkState& state )
+    {
+        CPipelineSim sim ( config );
+        QWORD        qwCycles = 0;
+
+        while ( state.KeepRunning ( ) )
+        {
+            state.PauseTiming ( );
+            sim.Reset ( );
+            sim.LoadInstructions ( csr, hazards );
+            state.ResumeTiming ( );
+
+            while ( sim.ProcessNextCycle ( ) )
+                qwCycles++;
+        }
+
+        g_nSink = static_cast<size_t>(qwCycles);
+
+        state.SetItemsProcessed ( qwCycles );
+    } );
+
+    // every lane simulates the whole trace, as a sweep's lanes would
+    std::vector<BYTE> vStallCycles;
+
+    hazards.Analyze ( csr, config );
+
+    for ( CCsrDependencyGraph::const_iterator it = csr.begin ( ); it != csr.end ( ); ++it )
+    {
+        if ( it->IsValid ( ) )
+            vStallCycles.push_back ( static_cast<BYTE>(hazards.GetStallCycles ( it->GetNodeID ( ) )) );
+    }
+
+    for ( DWORD dwNumLanes = 8; dwNumLanes <= MAX_SIM_LANES; dwNumLanes *= 4 )
+    {
+        const TCHAR* szLaneSim = (dwNumLanes == 8) ? _T("BM_LaneSim8") : _T("BM_LaneSim32");
+
+        runner.Run ( FormatName ( szLaneSim, trace ).c_str ( ), [&] ( CBenchmarkState& state )
+        {
+            CLaneSim lanes ( config );
+            QWORD    qwLaneCycles = 0;
+
+            while ( state.KeepRunning ( ) )
+            {
+                state.PauseTiming ( );
+                lanes.Reset ( );
+
+                for ( DWORD dwLane = 0; dwLane < dwNumLanes; dwLane++ )
+                    lanes.AddLane ( vStallCycles.data ( ), vStallCycles.size ( ) );
+
+                state.ResumeTiming ( );
+
+                lanes.Run ( );
+
+                for ( DWORD dwLane = 0; dwLane < dwNumLanes; dwLane++ )
+                    qwLaneCycles += lanes.GetCycleCount ( dwLane );
+            }
+
+            g_nSink = static_cast<size_t>(qwLaneCycles);
+
+            state.SetItemsProcessed ( qwLaneCycles );
+        } );
+    }
+}
@@ -0,0 +1,175 @@
+/**
+* @file       SyntheticTrace.cpp
+* @brief      CSyntheticTrace class implementation
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*/
+
+#include "stdafx.h"
+#include "SyntheticTrace.h"
+
+#ifndef _RANDOM_
+    #include <random>
+#endif
+
+/// size of the trace file output buffer
+constexpr size_t TRACE_WRITE_BUFFER_SIZE = 1024 * 1024;
+
+
+CSyntheticTrace::CSyntheticTrace ( ) noexcept
+    : m_sgShape   ( SG_CHAIN ),
+      m_nNumNodes ( 0 ),
+      m_vEdges    ( )
+{
+}
+
+size_t CSyntheticTrace::Generate ( SG_TRACE_SHAPE sgShape, size_t nNumNodes, DWORD dwSeed ) noexcept
+{
+    Clear ( );
+
+    m_sgShape   = sgShape;
+    m_nNumNodes = nNumNodes;
+
+    std::mt19937 rng ( dwSeed );
+
+    switch ( sgShape )
+    {
+    case SG_CHAIN:
+        m_vEdges.reserve ( nNumNodes );
+
+        for ( size_t i = 1; i < nNumNodes; i++ )
+            m_vEdges.push_back ( GRAPH_EDGE { static_cast<NODE_ID_T>(i), static_cast<NODE_ID_T>(i - 1) } );
+        break;
+
+    case SG_FAN_OUT:
+        m_vEdges.reserve ( nNumNodes );
+
+        for ( size_t i = 1; i < nNumNodes; i++ )
+        {
+            const size_t nRoot = i - (i % FAN_OUT_WIDTH);
+
+            if ( nRoot != i )
+                m_vEdges.push_back ( GRAPH_EDGE { static_cast<NODE_ID_T>(i), static_cast<NODE_ID_T>(nRoot) } );
+        }
+        break;
+
+    case SG_RANDOM_DAG:
+        m_vEdges.reserve ( nNumNodes * RANDOM_MAX_DEGREE / 2 );
+
+        for ( size_t i = 1; i < nNumNodes; i++ )
+        {
+            const size_t nWindow = (i < RANDOM_WINDOW) ? i : RANDOM_WINDOW;
+            const size_t nDegree = rng ( ) % (RANDOM_MAX_DEGREE + 1);
+            const size_t nFirst  = m_vEdges.size ( );
+
+            for ( size_t j = 0; j < nDegree && j < nWindow; j++ )
+            {
+                const NODE_ID_T idTo = static_cast<NODE_ID_T>(i - 1 - rng ( ) % nWindow);
+
+                // only distinct dependencies, as the graph would discard the others
+                bool bDuplicate = false;
+
+                for ( size_t k = nFirst; k < m_vEdges.size ( ); k++ )
+                    bDuplicate = bDuplicate || (m_vEdges[k].idTo == idTo);
+
+                if ( bDuplicate == false )
+                    m_vEdges.push_back ( GRAPH_EDGE { static_cast<NODE_ID_T>(i), idTo } );
+            }
+        }
+        break;
+
+    default:
+        m_nNumNodes = 0;
+        break;
+    }
+
+    return m_vEdges.size ( );
+}
+
+size_t CSyntheticTrace::BuildGraph ( CDependencyGraph& dag ) const noexcept
+{
+    size_t nReturn = 0;
+
+    for ( size_t i = 0; i < m_nNumNodes; i++ )
+        dag.AddNode ( static_cast<NODE_ID_T>(i) );
+
+    for ( std::vector<GRAPH_EDGE>::const_iterator it = m_vEdges.begin ( ); it != m_vEdges.end ( ); ++it )
+    {
+        // the same dependency distance weight as CTraceLoader assigns
+        const int iWeight = static_cast<int>(it->idFrom) - static_cast<int>(it->idTo);
+
+        if ( dag.AddEdge ( it->idFrom, it->idTo, iWeight ) )
+            nReturn++;
+    }
+
+    return nReturn;
+}
+
+size_t CSyntheticTrace::BuildEdgeList ( CEdgeListBuilder& builder ) const noexcept
+{
+    size_t nReturn = 0;
+
+    builder.Reserve ( m_nNumNodes, m_vEdges.size ( ) );
+
+    for ( size_t i = 0; i < m_nNumNodes; i++ )
+        builder.AddNode ( static_cast<NODE_ID_T>(i) );
+
+    for ( std::vector<GRAPH_EDGE>::const_iterator it = m_vEdges.begin ( ); it != m_vEdges.end ( ); ++it )
+    {
+        const int iWeight = static_cast<int>(it->idFrom) - static_cast<int>(it->idTo);
+
+        if ( builder.AddEdge ( it->idFrom, it->idTo, iWeight ) )
+            nReturn++;
+    }
+
+    return nReturn;
+}
+
+bool CSyntheticTrace::SaveText ( const TCHAR* szFileName ) const noexcept
+{
+    FILE* pFile = _tfopen ( szFileName, _T("w") );
+
+    if ( pFile == nullptr )
+        return false;
+
+    setvbuf ( pFile, nullptr, _IOFBF, TRACE_WRITE_BUFFER_SIZE );
+
+    bool bReturn = true;
+
+    for ( size_t i = 0; i < m_nNumNodes && bReturn; i++ )
+        bReturn = fprintf ( pFile, (i > 0) ? ", %u" : "%u", static_cast<unsigned>(i) ) > 0;
+
+    bReturn = bReturn && (fputc ( '\n', pFile ) != EOF);
+
+    // "B A" means that B depends upon the result of A
+    for ( std::vector<GRAPH_EDGE>::const_iterator it = m_vEdges.begin ( ); it != m_vEdges.end ( ) && bReturn; ++it )
+        bReturn = fprintf ( pFile, "%u %u\n", it->idFrom, it->idTo ) > 0;
+
+    if ( fclose ( pFile ) != 0 )
+        bReturn = false;
+
+    return bReturn;
+}
+
+void CSyntheticTrace::Clear ( void ) noexcept
+{
+    std::vector<GRAPH_EDGE>().swap ( m_vEdges );
+    m_nNumNodes = 0;
+}
+
+const TCHAR* CSyntheticTrace::GetShapeName ( SG_TRACE_SHAPE sgShape ) noexcept
+{
+    switch ( sgShape )
+    {
+    case SG_CHAIN:
+        return _T("chain");
+    case SG_FAN_OUT:
+        return _T("fanout");
+    case SG_RANDOM_DAG:
+        return _T("random");
+    default:
+        return _T("unknown");
+    }
+}
@@ -0,0 +1,160 @@
+/**
+* @file       SyntheticTrace.h
+* @brief      CSyntheticTrace class interface
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  Generates instruction traces of a chosen shape and size, such that the
+*  graph build, load and simulation paths may be measured at scales well
+*  beyond those of the sample data:
+*  - a chain, each instruction depending upon its predecessor, the worst
+*    case for data hazards
+*  - a wide fan-out, blocks of instructions each depending upon the
+*    first instruction of their block, i.e. a few nodes of huge out-degree
+*  - a random DAG, each instruction depending upon a few randomly chosen
+*    recent predecessors, approximating the locality of a real trace
+*
+*  Every dependency is upon an earlier instruction, so each trace is
+*  acyclic, and listed in the trace file format read by CTraceLoader.
+*/
+#pragma once
+
+#if !defined(_SYNTHETIC_TRACE_H__)
+#define _SYNTHETIC_TRACE_H__
+
+#ifndef _CSR_DEPENDENCY_GRAPH_H__
+    #include "CsrDependencyGraph.h"
+#endif
+
+#ifndef _EDGE_LIST_BUILDER_H__
+    #include "EdgeListBuilder.h"
+#endif
+
+#ifndef _VECTOR_
+    #include <vector>
+#endif
+
+/**
+    @brief Synthetic trace shapes
+*/
+typedef enum SG_TRACE_SHAPE
+{
+    SG_CHAIN      = 0,   ///< each instruction depends upon its predecessor
+    SG_FAN_OUT    = 1,   ///< each block of instructions depends upon its 1st
+    SG_RANDOM_DAG = 2,   ///< random dependencies upon recent predecessors
+    SG_NUM_SHAPES        ///< number of trace shapes
+} SG_TRACE_SHAPE_T;
+
+/// number of instructions depending upon each fan-out root
+constexpr size_t FAN_OUT_WIDTH      = 1024;
+/// maximum number of dependencies of each random DAG instruction
+constexpr size_t RANDOM_MAX_DEGREE  = 3;
+/// distance of the furthest predecessor a random DAG instruction depends upon
+constexpr size_t RANDOM_WINDOW      = 16;
+/// default random number generator seed, for reproducible traces
+constexpr DWORD  DEFAULT_TRACE_SEED = 5133;
+
+/**
+    @brief Synthetic instruction trace generator
+*/
+class CSyntheticTrace
+{
+    SG_TRACE_SHAPE          m_sgShape;    ///< shape of the trace
+    size_t                  m_nNumNodes;  ///< number of instructions
+    std::vector<GRAPH_EDGE> m_vEdges;     ///< dependencies, in instruction order
+
+public:
+    /// Default Constructor
+    CSyntheticTrace() noexcept;
+
+    /// Default Destructor
+    ~CSyntheticTrace() = default;
+
+/**
+    @brief Generates a trace, replacing any previous one
+
+    @param [in] sgShape     shape of the trace
+    @param [in] nNumNodes   number of instructions, numbered from 0
+    @param [in] dwSeed      random number generator seed
+
+    @retval size_t          number of dependencies generated
+*/
+    size_t Generate(SG_TRACE_SHAPE sgShape, size_t nNumNodes, DWORD dwSeed = DEFAULT_TRACE_SEED) noexcept;
+
+/**
+    @brief Adds the trace's instructions and dependencies to a graph
+
+    @param [in,out] dag     destination graph, expected to be empty
+
+    @retval size_t          number of edges added
+*/
+    size_t BuildGraph(CDependencyGraph& dag) const noexcept;
+
+/**
+    @brief Adds the trace's instructions and dependencies to an edge list
+
+    @param [in,out] builder destination edge list, expected to be empty
+
+    @retval size_t          number of edges added
+*/
+    size_t BuildEdgeList(CEdgeListBuilder& builder) const noexcept;
+
+/**
+    @brief Writes the trace in the text trace file format
+
+    @param [in] szFileName  name of the trace file
+
+    @retval true            on success
+    @retval false           on error
+*/
+    bool SaveText(const TCHAR* szFileName) const noexcept;
+
+/**
+    @brief Releases the generated trace
+*/
+    void Clear(void) noexcept;
+
+/**
+    @brief Retrieves the shape of the trace
+
+    @retval SG_TRACE_SHAPE  the shape
+*/
+    constexpr SG_TRACE_SHAPE GetShape(void) const noexcept
+    { return m_sgShape; };
+
+/**
+    @brief Retrieves the number of instructions
+
+    @retval size_t          count of instructions
+*/
+    constexpr size_t GetNumNodes(void) const noexcept
+    { return m_nNumNodes; };
+
+/**
+    @brief Retrieves the number of dependencies
+
+    @retval size_t          count of dependencies
+*/
+    size_t GetNumEdges(void) const noexcept
+    { return m_vEdges.size ( ); };
+
+/**
+    @brief Retrieves the name of a trace shape
+
+    @param [in] sgShape     shape of the trace
+
+    @retval const TCHAR*    the name, as used in benchmark names
+*/
+    static const TCHAR* GetShapeName(SG_TRACE_SHAPE sgShape) noexcept;
+
+private:
+    /// copy constructor
+    CSyntheticTrace(const CSyntheticTrace& o) = delete;
+
+    /// assignment operator
+    CSyntheticTrace& operator=(const CSyntheticTrace& rhs) = delete;
+};
+
+#endif
@@ -0,0 +1,448 @@
+/**
+* @file       PipelineApi.cpp
+* @brief      Pipeline simulation library C interface implementation
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*/
+
+#include "stdafx.h"
+#include "PipelineApi.h"
+#include "CsrDependencyGraph.h"
+#include "EdgeListBuilder.h"
+#include "TraceLoader.h"
+#include "HazardAnalysis.h"
+#include "ListScheduler.h"
+#include "PipelineSim.h"
+
+#ifndef _ALGORITHM_
+    #include <algorithm>
+#endif
+
+#ifndef _CSTRING_
+    #include <cstring>
+#endif
+
+#ifndef _NEW_
+    #include <new>
+#endif
+
+// the values of the interface are those of the simulation, so are passed
+// straight through
+static_assert(PIPELINE_MAX_STAGES        == MAX_PIPELINE_STAGES,  "PIPELINE_MAX_STAGES mismatch");
+static_assert(PIPELINE_MIN_STAGES        == MIN_PIPELINE_STAGES,  "PIPELINE_MIN_STAGES mismatch");
+static_assert(PIPELINE_STALL_RUN_BUCKETS == STALL_RUN_BUCKETS,    "PIPELINE_STALL_RUN_BUCKETS mismatch");
+static_assert(PIPELINE_CLASS_ALU          == IC_ALU,              "PIPELINE_CLASS_xxx mismatch");
+static_assert(PIPELINE_CLASS_LOAD         == IC_LOAD,             "PIPELINE_CLASS_xxx mismatch");
+static_assert(PIPELINE_CLASS_BRANCH       == IC_BRANCH,           "PIPELINE_CLASS_xxx mismatch");
+static_assert(PIPELINE_CLASS_BRANCH_TAKEN == IC_BRANCH_TAKEN,     "PIPELINE_CLASS_xxx mismatch");
+static_assert(PIPELINE_CLASS_MUL          == IC_MUL,              "PIPELINE_CLASS_xxx mismatch");
+static_assert(PIPELINE_CLASS_DIV          == IC_DIV,              "PIPELINE_CLASS_xxx mismatch");
+static_assert(PIPELINE_FORWARD_NONE       == FP_NONE,             "PIPELINE_FORWARD_xxx mismatch");
+static_assert(PIPELINE_FORWARD_EX_EX      == FP_EX_EX,            "PIPELINE_FORWARD_xxx mismatch");
+static_assert(PIPELINE_FORWARD_MEM_EX     == FP_MEM_EX,           "PIPELINE_FORWARD_xxx mismatch");
+static_assert(PIPELINE_FORWARD_FULL       == FP_FULL,             "PIPELINE_FORWARD_xxx mismatch");
+static_assert(PIPELINE_PREDICTOR_NOT_TAKEN == BP_NOT_TAKEN,       "PIPELINE_PREDICTOR_xxx mismatch");
+static_assert(PIPELINE_PREDICTOR_TAKEN     == BP_TAKEN,           "PIPELINE_PREDICTOR_xxx mismatch");
+static_assert(PIPELINE_PREDICTOR_BIMODAL   == BP_BIMODAL,         "PIPELINE_PREDICTOR_xxx mismatch");
+static_assert(PIPELINE_PREDICTOR_GSHARE    == BP_GSHARE,          "PIPELINE_PREDICTOR_xxx mismatch");
+
+/**
+    @brief Frozen dependency graph behind an HPIPELINE_GRAPH
+*/
+struct PIPELINE_GRAPH
+{
+    CCsrDependencyGraph dag;    ///< the graph, never modified once frozen
+};
+
+/**
+    @brief Copies the portion of a caller's structure known to both it
+           and the library over the defaults
+
+    @param [out] dst        destination structure, holding the defaults
+    @param [in]  src        caller's structure, whose cbSize is the first member
+
+    @retval true            on success
+    @retval false           if src is too small to hold its cbSize
+*/
+template <class T>
+static bool ReadSized ( T& dst, const T& src ) noexcept
+{
+    if ( src.cbSize < sizeof(src.cbSize) )
+        return false;
+
+    memcpy ( &dst, &src, std::min ( static_cast<size_t>(src.cbSize), sizeof(T) ) );
+    dst.cbSize = sizeof(T);
+
+    return true;
+}
+
+/**
+    @brief Copies the portion of the library's structure known to the
+           caller into the caller's structure
+
+    @param [out] dst        caller's structure, whose cbSize is set
+    @param [in]  src        library's structure
+
+    @retval true            on success
+    @retval false           if dst is too small to hold its cbSize
+*/
+template <class T>
+static bool WriteSized ( T& dst, const T& src ) noexcept
+{
+    const uint32_t cbSize = dst.cbSize;
+
+    if ( cbSize < sizeof(dst.cbSize) )
+        return false;
+
+    memcpy ( &dst, &src, std::min ( static_cast<size_t>(cbSize), sizeof(T) ) );
+    dst.cbSize = cbSize;
+
+    return true;
+}
+
+/**
+    @brief Builds a pipeline descriptor from a configuration
+
+    Unlike the console application, which warns of an invalid value and
+    carries on with the default, an invalid value is rejected.
+
+    @param [in]  cfg        configuration
+    @param [out] config     receives the descriptor
+
+    @retval true            on success
+    @retval false           if any value is out of range
+*/
+static bool BuildConfig ( const PIPELINE_CONFIG& cfg, CPipelineConfig& config )
+{
+    if ( cfg.dwNumStages < MIN_PIPELINE_STAGES || cfg.dwNumStages > MAX_PIPELINE_STAGES ||
+         (cfg.dwForwarding & ~FP_FULL) != 0 || cfg.dwPredictor >= BP_NUM_TYPES )
+        return false;
+
+    config = CPipelineConfig ( cfg.dwNumStages );
+    config.SetForwarding ( cfg.dwForwarding );
+
+    bool bReturn = config.SetIssueWidth ( cfg.dwIssueWidth );
+
+    for ( DWORD i = 0; bReturn && i < cfg.dwNumStages; i++ )
+    {
+        if ( cfg.dwStageWidth[i] != 0 )
+            bReturn = config.SetStageWidth ( i, cfg.dwStageWidth[i] );
+    }
+
+    bReturn = bReturn && config.SetBranchPredictor ( static_cast<BP_PREDICTOR_TYPE>(cfg.dwPredictor) ) &&
+                         config.SetPredictorBits ( cfg.dwPredictorBits );
+
+    if ( bReturn && cfg.iBranchPenalty >= 0 )
+        config.SetBranchPenalty ( static_cast<DWORD>(cfg.iBranchPenalty) );
+
+    if ( bReturn && cfg.iMulLatency >= 0 )
+        bReturn = config.SetExecuteLatency ( IC_MUL, static_cast<DWORD>(cfg.iMulLatency) );
+
+    // as with the console application, the divider remains unable to
+    // accept another divide until the last has completed
+    if ( bReturn && cfg.iDivLatency >= 0 )
+        bReturn = config.SetExecuteLatency ( IC_DIV, static_cast<DWORD>(cfg.iDivLatency) ) &&
+                  config.SetIssueInterval ( IC_DIV, static_cast<DWORD>(cfg.iDivLatency) );
+
+    return bReturn;
+}
+
+
+uint32_t PIPELINE_CALL PipelineGetVersion ( void )
+{
+    return PIPELINE_API_VERSION;
+}
+
+const char* PIPELINE_CALL PipelineGetStatusText ( PIPELINE_STATUS psStatus )
+{
+    switch ( psStatus )
+    {
+        case PIPELINE_OK:
+            return "success";
+        case PIPELINE_E_INVALID_ARG:
+            return "invalid argument";
+        case PIPELINE_E_OUT_OF_MEMORY:
+            return "out of memory";
+        case PIPELINE_E_INVALID_GRAPH:
+            return "instruction class or node ID out of range";
+        case PIPELINE_E_CYCLIC_GRAPH:
+            return "dependency cycle found";
+        case PIPELINE_E_INVALID_CONFIG:
+            return "configuration value out of range";
+        default:
+            return "unknown status";
+    }
+}
+
+PIPELINE_STATUS PIPELINE_CALL PipelineCreateGraphFromTrace ( const char* pText, size_t cbText,
+                                                             HPIPELINE_GRAPH* phGraph )
+{
+    if ( phGraph == nullptr || (pText == nullptr && cbText > 0) )
+        return PIPELINE_E_INVALID_ARG;
+
+    *phGraph = nullptr;
+
+    PIPELINE_GRAPH* pGraph = nullptr;
+
+    // every allocation is made within, a failure of any being reported
+    // rather than unwinding into the caller
+    try
+    {
+        CEdgeListBuilder builder;
+        CTraceLoader     loader ( builder );
+
+        // the whole of the text is a single block
+        if ( cbText > 0 )
+            loader.ParseBlock ( pText, pText + cbText );
+
+        loader.Finish ( );
+
+        if ( loader.IsMalformed ( ) )
+            return PIPELINE_E_INVALID_GRAPH;
+
+        pGraph = new PIPELINE_GRAPH;
+
+        pGraph->dag.Freeze ( builder );
+    }
+    catch ( const std::bad_alloc& )
+    {
+        delete pGraph;
+        return PIPELINE_E_OUT_OF_MEMORY;
+    }
+
+    *phGraph = pGraph;
+
+    return PIPELINE_OK;
+}
+
+PIPELINE_STATUS PIPELINE_CALL PipelineCreateGraph ( const uint8_t* pClasses, size_t nNumNodes,
+                                                    const PIPELINE_EDGE* pEdges, size_t nNumEdges,
+                                                    HPIPELINE_GRAPH* phGraph )
+{
+    if ( phGraph == nullptr || (pEdges == nullptr && nNumEdges > 0) )
+        return PIPELINE_E_INVALID_ARG;
+
+    *phGraph = nullptr;
+
+    if ( nNumNodes >= INVALID_NODE_ID )
+        return PIPELINE_E_INVALID_GRAPH;
+
+    PIPELINE_GRAPH* pGraph = nullptr;
+
+    try
+    {
+        CEdgeListBuilder builder;
+
+        builder.Reserve ( nNumNodes, nNumEdges );
+
+        for ( size_t i = 0; i < nNumNodes; i++ )
+        {
+            const NODE_ID_T idNode = static_cast<NODE_ID_T>(i);
+
+            builder.AddNode ( idNode );
+
+            if ( pClasses != nullptr )
+            {
+                if ( pClasses[i] >= IC_NUM_CLASSES )
+                    return PIPELINE_E_INVALID_GRAPH;
+
+                builder.SetNodeClass ( idNode, static_cast<IC_INSTRUCTION_CLASS>(pClasses[i]) );
+            }
+        }
+
+        for ( size_t i = 0; i < nNumEdges; i++ )
+        {
+            const PIPELINE_EDGE& edge = pEdges[i];
+
+            if ( edge.idFrom >= nNumNodes || edge.idTo >= nNumNodes )
+                return PIPELINE_E_INVALID_GRAPH;
+
+            // weighted by dependency distance, as CTraceLoader does
+            builder.AddEdge ( edge.idFrom, edge.idTo, static_cast<int>(edge.idFrom) - static_cast<int>(edge.idTo) );
+        }
+
+        pGraph = new PIPELINE_GRAPH;
+
+        pGraph->dag.Freeze ( builder );
+    }
+    catch ( const std::bad_alloc& )
+    {
+        delete pGraph;
+        return PIPELINE_E_OUT_OF_MEMORY;
+    }
+
+    *phGraph = pGraph;
+
+    return PIPELINE_OK;
+}
+
+void PIPELINE_CALL PipelineDestroyGraph ( HPIPELINE_GRAPH hGraph )
+{
+    delete hGraph;
+}
+
+PIPELINE_STATUS PIPELINE_CALL PipelineGetGraphInfo ( HPIPELINE_GRAPH hGraph, PIPELINE_GRAPH_INFO* pInfo )
+{
+    if ( hGraph == nullptr || pInfo == nullptr )
+        return PIPELINE_E_INVALID_ARG;
+
+    const CCsrDependencyGraph& dag = hGraph->dag;
+
+    PIPELINE_GRAPH_INFO info = { };
+
+    info.cbSize          = sizeof(info);
+    info.qwNumNodes      = dag.GetNumNodes ( );
+    info.qwNumEdges      = dag.GetNumEdges ( );
+    info.qwNumCycleEdges = dag.GetCycleEdges ( ).size ( );
+    info.qwMemoryUsage   = dag.GetMemoryUsage ( );
+
+    return WriteSized ( *pInfo, info ) ? PIPELINE_OK : PIPELINE_E_INVALID_ARG;
+}
+
+void PIPELINE_CALL PipelineInitConfig ( PIPELINE_CONFIG* pConfig )
+{
+    if ( pConfig == nullptr )
+        return;
+
+    // the defaults of a CPipelineConfig, without the allocation of its
+    // stage names in constructing one
+    PIPELINE_CONFIG cfg = { };
+
+    cfg.cbSize          = sizeof(cfg);
+    cfg.dwNumStages     = DEFAULT_PIPELINE_STAGES;
+    cfg.dwForwarding    = FP_NONE;
+    cfg.dwIssueWidth    = 1;
+    cfg.dwPredictor     = BP_NOT_TAKEN;
+    cfg.dwPredictorBits = DEFAULT_PREDICTOR_BITS;
+    cfg.iBranchPenalty  = -1;
+    cfg.iMulLatency     = -1;
+    cfg.iDivLatency     = -1;
+    cfg.dwFlags         = 0;
+
+    *pConfig = cfg;
+}
+
+/**
+    @brief Simulates the execution of a graph
+
+    Every allocation of the simulation is made within, std::bad_alloc
+    being thrown should any fail.
+
+    @param [in]  dag        frozen graph to be simulated
+    @param [in]  cfg        configuration, its defaults completed
+    @param [out] stats      receives the results of the library's version
+
+    @retval PIPELINE_OK                 on success
+    @retval PIPELINE_E_CYCLIC_GRAPH     if the graph cannot be simulated
+    @retval PIPELINE_E_INVALID_CONFIG   if a configuration value is out of range
+*/
+static PIPELINE_STATUS SimulateGraph ( const CCsrDependencyGraph& dag, const PIPELINE_CONFIG& cfg,
+                                       PIPELINE_STATS& stats )
+{
+    CPipelineConfig config;
+
+    if ( BuildConfig ( cfg, config ) == false )
+        return PIPELINE_E_INVALID_CONFIG;
+
+    // a dependency cycle leaves no order in which to issue the graph
+    if ( dag.IsAcyclic ( ) == false )
+        return PIPELINE_E_CYCLIC_GRAPH;
+
+    CPipelineSim    sim ( config );
+    CHazardAnalysis hazards;
+    CListScheduler  scheduler;
+
+    bool bSchedule = (cfg.dwFlags & PIPELINE_FLAG_SCHEDULE) != 0;
+
+    // as with the console application, a graph which cannot be scheduled
+    // is issued in its initial order
+    if ( bSchedule && (scheduler.Schedule ( dag, config ) != dag.GetNumNodes ( )) )
+        bSchedule = false;
+
+    sim.LoadInstructions ( dag, hazards, bSchedule ? &scheduler.GetIssueOrder ( ) : nullptr );
+
+    const bool bFastForward = (cfg.dwFlags & PIPELINE_FLAG_FAST_FORWARD) != 0;
+
+    if ( bFastForward )
+    {
+        sim.FastForward ( );
+    }
+    else
+    {
+        while ( sim.ProcessNextCycle ( ) )
+            ;
+    }
+
+    const CPipelineStats& simStats = sim.GetStats ( );
+
+    stats.cbSize             = sizeof(stats);
+    stats.dwNumStages        = config.GetNumStages ( );
+    stats.dwFlags            = (bSchedule ? PIPELINE_FLAG_SCHEDULE : 0) | (bFastForward ? PIPELINE_FLAG_FAST_FORWARD : 0);
+    stats.qwInstructions     = dag.GetNumNodes ( );
+    stats.qwSequentialCycles = static_cast<uint64_t>(dag.GetNumNodes ( )) * config.GetNumStages ( );
+    stats.qwCycles           = simStats.GetCycles ( );
+    stats.qwCompleted        = simStats.GetCompleted ( );
+    stats.qwStalls           = sim.GetStallCount ( );
+    stats.qwStructuralStalls = hazards.GetStructuralStalls ( );
+    stats.qwHazardBubbles    = simStats.GetHazardBubbles ( );
+    stats.qwDrainBubbles     = simStats.GetDrainBubbles ( );
+    stats.qwFlushBubbles     = simStats.GetFlushBubbles ( );
+    stats.qwBranches         = simStats.GetBranches ( );
+    stats.qwMispredicted     = simStats.GetMispredicted ( );
+
+    // each instruction of a multi-cycle class holds up the next as it executes
+    for ( CCsrDependencyGraph::const_iterator it = dag.begin ( ); it != dag.end ( ); ++it )
+    {
+        if ( it->IsValid ( ) )
+            stats.qwSequentialCycles += config.GetExecuteLatency ( it->GetClass ( ) ) - 1;
+    }
+
+    for ( DWORD i = 0; i < config.GetNumStages ( ); i++ )
+    {
+        stats.qwStageBusy[i]    = simStats.GetStageBusy ( i );
+        stats.qwStageBubbles[i] = simStats.GetStageBubbles ( i );
+    }
+
+    for ( DWORD i = 0; i < STALL_RUN_BUCKETS; i++ )
+        stats.qwStallRuns[i] = simStats.GetStallRuns ( i + 1 );
+
+    stats.dCPI                = simStats.GetCPI ( );
+    stats.dIPC                = simStats.GetIPC ( );
+    stats.dPredictionAccuracy = simStats.GetPredictionAccuracy ( );
+    stats.dElapsed            = simStats.GetElapsed ( );
+
+    return PIPELINE_OK;
+}
+
+PIPELINE_STATUS PIPELINE_CALL PipelineSimulate ( HPIPELINE_GRAPH hGraph, const PIPELINE_CONFIG* pConfig,
+                                                 PIPELINE_STATS* pStats )
+{
+    PIPELINE_CONFIG cfg = { };
+
+    PipelineInitConfig ( &cfg );
+
+    if ( hGraph == nullptr || pStats == nullptr || pStats->cbSize < sizeof(pStats->cbSize) ||
+         (pConfig != nullptr && ReadSized ( cfg, *pConfig ) == false) )
+        return PIPELINE_E_INVALID_ARG;
+
+    PIPELINE_STATS  stats    = { };
+    PIPELINE_STATUS psReturn = PIPELINE_OK;
+
+    // the descriptor, the simulation and their working storage are all
+    // sized by the configuration or the graph
+    try
+    {
+        psReturn = SimulateGraph ( hGraph->dag, cfg, stats );
+    }
+    catch ( const std::bad_alloc& )
+    {
+        psReturn = PIPELINE_E_OUT_OF_MEMORY;
+    }
+
+    if ( psReturn == PIPELINE_OK )
+        WriteSized ( *pStats, stats );
+
+    return psReturn;
+}
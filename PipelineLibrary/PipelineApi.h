@@ -0,0 +1,298 @@
+/**
+* @file       PipelineApi.h
+* @brief      Pipeline simulation library C interface
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  A stable C interface to the pipeline simulation, for embedding it in
+*  another process rather than running the console application once per
+*  trace.  A graph is created from memory, either as the text of an
+*  instruction trace, in the format read by the console application, or
+*  as arrays of instruction classes and dependencies.  Any number of
+*  simulations may then be run over it, each configured by a
+*  PIPELINE_CONFIG, and each returning its results as a PIPELINE_STATS.
+*
+*  Nothing is written to the console, and the library holds no global
+*  state: a graph is never modified once created, so it may be simulated
+*  by any number of threads at once, and destroyed once they are done.
+*
+*  The interface is plain C, and each structure passed across it leads
+*  with its size in bytes, which the caller sets to sizeof the structure
+*  as it was compiled.  Members are only ever appended to a structure, so
+*  a caller built against an earlier version of this header, passing a
+*  smaller structure, continues to work: any member it lacks takes its
+*  default value, and is not written.
+*/
+#pragma once
+
+#if !defined(_PIPELINE_API_H__)
+#define _PIPELINE_API_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(PIPELINE_STATIC)
+    #define PIPELINE_API
+#elif defined(_WIN32)
+    #if defined(PIPELINE_EXPORTS)
+        #define PIPELINE_API __declspec(dllexport)
+    #else
+        #define PIPELINE_API __declspec(dllimport)
+    #endif
+#elif defined(__GNUC__)
+    #define PIPELINE_API __attribute__((visibility("default")))
+#else
+    #define PIPELINE_API
+#endif
+
+#if defined(_WIN32)
+    #define PIPELINE_CALL __cdecl
+#else
+    #define PIPELINE_CALL
+#endif
+
+/// version of the interface described by this header
+#define PIPELINE_API_VERSION            1
+
+/// maximum number of pipeline stages
+#define PIPELINE_MAX_STAGES             32
+/// minimum number of pipeline stages
+#define PIPELINE_MIN_STAGES             3
+/// number of stall run histogram buckets, the last counting every longer run
+#define PIPELINE_STALL_RUN_BUCKETS      32
+
+/**
+    @name Instruction classes, as listed in a trace
+    @{
+*/
+#define PIPELINE_CLASS_ALU              0   ///< arithmetic / logic, result produced in EX
+#define PIPELINE_CLASS_LOAD             1   ///< memory load, result produced in MEM
+#define PIPELINE_CLASS_BRANCH           2   ///< conditional branch, not taken
+#define PIPELINE_CLASS_BRANCH_TAKEN     3   ///< conditional branch, taken
+#define PIPELINE_CLASS_MUL              4   ///< integer multiply, multi-cycle EX
+#define PIPELINE_CLASS_DIV              5   ///< integer divide, multi-cycle EX
+/** @} */
+
+/**
+    @name Forwarding paths, combined as a mask
+    @{
+*/
+#define PIPELINE_FORWARD_NONE           0x00    ///< results are only available after WB
+#define PIPELINE_FORWARD_EX_EX          0x01    ///< EX result forwarded to the next EX
+#define PIPELINE_FORWARD_MEM_EX         0x02    ///< MEM result forwarded to EX
+#define PIPELINE_FORWARD_FULL           0x03    ///< both forwarding paths
+/** @} */
+
+/**
+    @name Branch prediction schemes
+    @{
+*/
+#define PIPELINE_PREDICTOR_NOT_TAKEN    0   ///< static, every branch predicted not taken
+#define PIPELINE_PREDICTOR_TAKEN        1   ///< static, every branch predicted taken
+#define PIPELINE_PREDICTOR_BIMODAL      2   ///< 2-bit counters indexed by the branch address
+#define PIPELINE_PREDICTOR_GSHARE       3   ///< 2-bit counters indexed by the address and history
+/** @} */
+
+/**
+    @name Simulation flags
+    @{
+*/
+#define PIPELINE_FLAG_SCHEDULE          0x01    ///< issue in critical path list scheduled order
+#define PIPELINE_FLAG_FAST_FORWARD      0x02    ///< compute the run in closed form, where possible
+/** @} */
+
+/**
+    @brief Status returned by each function
+*/
+typedef enum PIPELINE_STATUS
+{
+    PIPELINE_OK                 =  0,   ///< success
+    PIPELINE_E_INVALID_ARG      = -1,   ///< a pointer or structure size is invalid
+    PIPELINE_E_OUT_OF_MEMORY    = -2,   ///< an allocation failed
+    PIPELINE_E_INVALID_GRAPH    = -3,   ///< an instruction class or node ID is out of range
+    PIPELINE_E_CYCLIC_GRAPH     = -4,   ///< the graph contains a dependency cycle
+    PIPELINE_E_INVALID_CONFIG   = -5    ///< a configuration value is out of range
+} PIPELINE_STATUS;
+
+/// opaque handle of a frozen dependency graph
+typedef struct PIPELINE_GRAPH* HPIPELINE_GRAPH;
+
+/**
+    @brief A dependency of one instruction upon the result of another
+*/
+typedef struct PIPELINE_EDGE
+{
+    uint32_t    idFrom;     ///< node ID of the dependent instruction
+    uint32_t    idTo;       ///< node ID of the instruction depended upon
+} PIPELINE_EDGE;
+
+/**
+    @brief Description of a graph
+*/
+typedef struct PIPELINE_GRAPH_INFO
+{
+    uint32_t    cbSize;             ///< size of the structure, in bytes
+    uint32_t    dwReserved;         ///< alignment padding, always 0
+    uint64_t    qwNumNodes;         ///< number of instructions
+    uint64_t    qwNumEdges;         ///< number of unique dependencies
+    uint64_t    qwNumCycleEdges;    ///< dependencies closing a cycle, 0 if acyclic
+    uint64_t    qwMemoryUsage;      ///< bytes held by the frozen graph
+} PIPELINE_GRAPH_INFO;
+
+/**
+    @brief Configuration of a simulation, initialized by PipelineInitConfig
+*/
+typedef struct PIPELINE_CONFIG
+{
+    uint32_t    cbSize;             ///< size of the structure, in bytes
+    uint32_t    dwNumStages;        ///< number of pipeline stages
+    uint32_t    dwForwarding;       ///< mask of PIPELINE_FORWARD_xxx paths
+    uint32_t    dwIssueWidth;       ///< instructions issued per cycle, 1 for a scalar pipeline
+    uint32_t    dwStageWidth[PIPELINE_MAX_STAGES]; ///< instructions each stage holds, 0 for the issue width
+    uint32_t    dwPredictor;        ///< PIPELINE_PREDICTOR_xxx scheme
+    uint32_t    dwPredictorBits;    ///< log2 of the predictor table size
+    int32_t     iBranchPenalty;     ///< misprediction penalty cycles, -1 for that of the resolution stage
+    int32_t     iMulLatency;        ///< multiply execute cycles, -1 for the default
+    int32_t     iDivLatency;        ///< divide execute cycles, and its issue interval, -1 for the default
+    uint32_t    dwFlags;            ///< mask of PIPELINE_FLAG_xxx values
+} PIPELINE_CONFIG;
+
+/**
+    @brief Results of a simulation
+*/
+typedef struct PIPELINE_STATS
+{
+    uint32_t    cbSize;             ///< size of the structure, in bytes
+    uint32_t    dwNumStages;        ///< number of pipeline stages simulated
+    uint32_t    dwFlags;            ///< PIPELINE_FLAG_xxx values applied, the schedule
+                                    ///< being dropped if it could not be built
+    uint32_t    dwReserved;         ///< alignment padding, always 0
+    uint64_t    qwInstructions;     ///< instructions issued
+    uint64_t    qwSequentialCycles; ///< cycles of a sequential, non overlapped execution
+    uint64_t    qwCycles;           ///< cycles of the overlapped execution
+    uint64_t    qwCompleted;        ///< instructions completed
+    uint64_t    qwStalls;           ///< stall cycles introduced
+    uint64_t    qwStructuralStalls; ///< stall cycles awaiting a busy functional unit
+    uint64_t    qwHazardBubbles;    ///< bubbles inserted by data hazard stalls
+    uint64_t    qwDrainBubbles;     ///< NOOPs fetched to drain the pipeline
+    uint64_t    qwFlushBubbles;     ///< NOOPs fetched refilling after a misprediction
+    uint64_t    qwBranches;         ///< branches fetched
+    uint64_t    qwMispredicted;     ///< branches mispredicted
+    uint64_t    qwStageBusy[PIPELINE_MAX_STAGES];    ///< cycles each stage held an instruction
+    uint64_t    qwStageBubbles[PIPELINE_MAX_STAGES]; ///< cycles each stage held a bubble
+    uint64_t    qwStallRuns[PIPELINE_STALL_RUN_BUCKETS]; ///< count of stall runs by length - 1
+    double      dCPI;               ///< cycles per completed instruction
+    double      dIPC;               ///< instructions completed per cycle
+    double      dPredictionAccuracy;///< fraction of branches correctly predicted
+    double      dElapsed;           ///< wall time simulated, in seconds
+} PIPELINE_STATS;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+    @brief Retrieves the version of the interface implemented
+
+    @retval uint32_t        PIPELINE_API_VERSION, as the library was built
+*/
+PIPELINE_API uint32_t PIPELINE_CALL PipelineGetVersion(void);
+
+/**
+    @brief Retrieves a description of a status
+
+    @param [in] psStatus    status returned by any function
+
+    @retval const char*     static, NUL terminated description
+*/
+PIPELINE_API const char* PIPELINE_CALL PipelineGetStatusText(PIPELINE_STATUS psStatus);
+
+/**
+    @brief Creates a graph from the text of an instruction trace
+
+    The text is parsed exactly as a trace file is by the console
+    application, and need not be NUL terminated.
+
+    @param [in]  pText      text of the trace
+    @param [in]  cbText     length of the text, in bytes
+    @param [out] phGraph    receives the new graph
+
+    @retval PIPELINE_OK                 on success
+    @retval PIPELINE_E_INVALID_GRAPH    if the trace is malformed
+    @retval PIPELINE_E_OUT_OF_MEMORY    if the graph cannot be accommodated
+*/
+PIPELINE_API PIPELINE_STATUS PIPELINE_CALL PipelineCreateGraphFromTrace(const char* pText, size_t cbText,
+                                                                        HPIPELINE_GRAPH* phGraph);
+
+/**
+    @brief Creates a graph from arrays of instructions and dependencies
+
+    The instructions are issued in node ID order, node i being the i-th
+    element of pClasses.  The weight of each dependency is the distance
+    between its node IDs, as when read from a trace, and duplicates are
+    dropped.
+
+    @param [in]  pClasses   PIPELINE_CLASS_xxx class of each instruction,
+                            or NULL for every instruction to be an ALU one
+    @param [in]  nNumNodes  number of instructions
+    @param [in]  pEdges     dependencies, either end-point of each being
+                            less than nNumNodes, or NULL if nNumEdges is 0
+    @param [in]  nNumEdges  number of dependencies
+    @param [out] phGraph    receives the new graph
+
+    @retval PIPELINE_OK                 on success
+    @retval PIPELINE_E_INVALID_GRAPH    if a class or node ID is out of range
+    @retval PIPELINE_E_OUT_OF_MEMORY    if the graph cannot be accommodated
+*/
+PIPELINE_API PIPELINE_STATUS PIPELINE_CALL PipelineCreateGraph(const uint8_t* pClasses, size_t nNumNodes,
+                                                               const PIPELINE_EDGE* pEdges, size_t nNumEdges,
+                                                               HPIPELINE_GRAPH* phGraph);
+
+/**
+    @brief Destroys a graph
+
+    @param [in] hGraph      graph to be destroyed, may be NULL
+*/
+PIPELINE_API void PIPELINE_CALL PipelineDestroyGraph(HPIPELINE_GRAPH hGraph);
+
+/**
+    @brief Describes a graph
+
+    @param [in]     hGraph  graph to be described
+    @param [in,out] pInfo   receives the description, its cbSize set
+
+    @retval PIPELINE_OK     on success
+*/
+PIPELINE_API PIPELINE_STATUS PIPELINE_CALL PipelineGetGraphInfo(HPIPELINE_GRAPH hGraph, PIPELINE_GRAPH_INFO* pInfo);
+
+/**
+    @brief Initializes a configuration with the defaults of the console
+           application, a scalar 4 stage pipeline without forwarding
+
+    @param [out] pConfig    configuration to be initialized, including cbSize
+*/
+PIPELINE_API void PIPELINE_CALL PipelineInitConfig(PIPELINE_CONFIG* pConfig);
+
+/**
+    @brief Simulates the execution of a graph
+
+    @param [in]     hGraph  graph to be simulated
+    @param [in]     pConfig configuration, its cbSize set, or NULL for
+                            the defaults
+    @param [in,out] pStats  receives the results, its cbSize set
+
+    @retval PIPELINE_OK                 on success
+    @retval PIPELINE_E_CYCLIC_GRAPH     if the graph cannot be simulated
+    @retval PIPELINE_E_INVALID_CONFIG   if a configuration value is out of range
+    @retval PIPELINE_E_OUT_OF_MEMORY    if the simulation cannot be accommodated
+*/
+PIPELINE_API PIPELINE_STATUS PIPELINE_CALL PipelineSimulate(HPIPELINE_GRAPH hGraph, const PIPELINE_CONFIG* pConfig,
+                                                            PIPELINE_STATS* pStats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,318 @@
+/**
+* @file       BatchDriver.cpp
+* @brief      CBatchDriver class implementation
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*/
+
+#include "stdafx.h"
+#include "BatchDriver.h"
+#include "CsrDependencyGraph.h"
+#include "EdgeListBuilder.h"
+#include "TraceLoader.h"
+#include "HazardAnalysis.h"
+#include "ListScheduler.h"
+#include "ResultCache.h"
+#include "WorkStealingPool.h"
+
+#ifndef _ALGORITHM_
+    #include <algorithm>
+#endif
+
+#ifndef _CHRONO_
+    #include <chrono>
+#endif
+
+#ifndef _DEQUE_
+    #include <deque>
+#endif
+
+#ifndef _FILESYSTEM_
+    #include <filesystem>
+#endif
+
+#ifndef _FSTREAM_
+    #include <fstream>
+#endif
+
+namespace fs = std::filesystem;
+
+/**
+    @brief A worker's private graph, analysis and simulator instances
+*/
+class CWorkerContext
+{
+public:
+    CEdgeListBuilder    m_Builder;    ///< edge list a text trace is loaded into
+    CCsrDependencyGraph m_dag;        ///< frozen graph being simulated
+    CHazardAnalysis     m_Hazards;    ///< hazard analysis of m_dag
+    CListScheduler      m_Scheduler;  ///< scheduler of m_dag
+    CPipelineSim        m_Sim;        ///< pipeline simulator
+
+    /// Initialization Constructor
+    explicit CWorkerContext(const CPipelineConfig& config) noexcept
+        : m_Builder   ( ),
+          m_dag       ( ),
+          m_Hazards   ( ),
+          m_Scheduler ( ),
+          m_Sim       ( config )
+    { };
+};
+
+/**
+    @brief Retrieves a path in the TCHAR representation
+*/
+static std::basic_string<TCHAR> GetPathString ( const fs::path& path )
+{
+#if defined(UNICODE) || defined(_UNICODE)
+    return path.wstring ( );
+#else
+    return path.string ( );
+#endif
+}
+
+
+CBatchDriver::CBatchDriver ( const CPipelineConfig& config, bool bSchedule ) noexcept
+    : m_Config       ( config ),
+      m_bSchedule    ( bSchedule ),
+      m_vFiles       ( ),
+      m_vResults     ( ),
+      m_dwNumWorkers ( 0 ),
+      m_dElapsed     ( 0.0 ),
+      m_pCache       ( nullptr )
+{
+}
+
+size_t CBatchDriver::AddSource ( const TCHAR* szSource ) noexcept
+{
+    std::error_code ec;
+
+    return fs::is_directory ( fs::path ( szSource ), ec ) ? AddDirectory ( szSource )
+                                                          : AddManifest ( szSource );
+}
+
+size_t CBatchDriver::AddDirectory ( const TCHAR* szDirectory ) noexcept
+{
+    std::vector<std::basic_string<TCHAR>> vFiles;
+
+    std::error_code ec;
+
+    for ( fs::directory_iterator it ( fs::path ( szDirectory ), ec );
+          ec.value ( ) == 0 && it != fs::directory_iterator ( ); it.increment ( ec ) )
+    {
+        std::error_code ecType;
+
+        if ( it->is_regular_file ( ecType ) )
+            vFiles.push_back ( GetPathString ( it->path ( ) ) );
+    }
+
+    // directory iteration order is unspecified
+    std::sort ( vFiles.begin ( ), vFiles.end ( ) );
+
+    m_vFiles.insert ( m_vFiles.end ( ), vFiles.begin ( ), vFiles.end ( ) );
+
+    return vFiles.size ( );
+}
+
+size_t CBatchDriver::AddManifest ( const TCHAR* szManifest ) noexcept
+{
+    size_t nReturn = 0;
+
+    const fs::path pathManifest ( szManifest );
+
+    std::ifstream ifs ( pathManifest );
+    std::string   strLine;
+
+    while ( std::getline ( ifs, strLine ) )
+    {
+        // tolerate CR-LF line endings, and skip blank and comment lines
+        if ( strLine.empty ( ) == false && strLine.back ( ) == '\r' )
+            strLine.pop_back ( );
+
+        if ( strLine.empty ( ) || strLine[0] == '#' )
+            continue;
+
+        fs::path pathTrace = fs::u8path ( strLine );
+
+        if ( pathTrace.is_relative ( ) )
+            pathTrace = pathManifest.parent_path ( ) / pathTrace;
+
+        m_vFiles.push_back ( GetPathString ( pathTrace ) );
+        nReturn++;
+    }
+
+    return nReturn;
+}
+
+size_t CBatchDriver::Run ( DWORD dwNumThreads ) noexcept
+{
+    const std::chrono::steady_clock::time_point tpStart = std::chrono::steady_clock::now ( );
+
+    m_vResults.assign ( m_vFiles.size ( ), BATCH_RESULT { } );
+
+    CWorkStealingPool pool ( dwNumThreads );
+
+    // each worker has a context of its own, a deque affording in-place construction
+    std::deque<CWorkerContext> deqContexts;
+
+    for ( DWORD i = 0; i < pool.GetNumWorkers ( ); i++ )
+        deqContexts.emplace_back ( m_Config );
+
+    pool.Run ( m_vFiles.size ( ), [this, &deqContexts] ( size_t nTask, DWORD dwWorker )
+    {
+        m_vResults[nTask].strFileName = m_vFiles[nTask];
+
+        SimulateTrace ( deqContexts[dwWorker], m_vResults[nTask] );
+    } );
+
+    m_dwNumWorkers = pool.GetNumWorkers ( );
+    m_dElapsed     = std::chrono::duration<double> ( std::chrono::steady_clock::now ( ) - tpStart ).count ( );
+
+    size_t nReturn = 0;
+
+    for ( std::vector<BATCH_RESULT>::const_iterator it = m_vResults.begin ( ); it != m_vResults.end ( ); ++it )
+    {
+        if ( it->bLoaded && it->bAcyclic )
+            nReturn++;
+    }
+
+    return nReturn;
+}
+
+void CBatchDriver::SimulateTrace ( CWorkerContext& context, BATCH_RESULT& result ) const noexcept
+{
+    const TCHAR* szFileName = result.strFileName.c_str ( );
+
+    if ( CCsrDependencyGraph::IsBinaryGraphFile ( szFileName ) )
+    {
+        result.bLoaded = context.m_dag.Load ( szFileName );
+    }
+    else
+    {
+        CTraceLoader loader ( context.m_Builder );
+
+        result.bLoaded = loader.LoadFile ( szFileName );
+
+        if ( result.bLoaded )
+            context.m_dag.Freeze ( context.m_Builder );
+
+        context.m_Builder.Clear ( );
+    }
+
+    if ( result.bLoaded == false )
+        return;
+
+    result.bAcyclic  = context.m_dag.IsAcyclic ( );
+    result.nNumNodes = context.m_dag.GetNumNodes ( );
+    result.nNumEdges = context.m_dag.GetNumEdges ( );
+
+    if ( result.bAcyclic == false )
+        return;
+
+    const QWORD qwGraphHash = (m_pCache != nullptr) ? context.m_dag.GetContentHash ( ) : 0;
+    const QWORD qwConfigKey = (m_pCache != nullptr) ? CResultCache::GetConfigKey ( m_Config, m_bSchedule ) : 0;
+
+    CACHED_RESULT cached = { };
+
+    if ( m_pCache != nullptr && m_pCache->Lookup ( qwGraphHash, qwConfigKey, cached ) )
+    {
+        result.qwCycles    = cached.qwCycles;
+        result.qwStalls    = cached.qwStalls;
+        result.qwCompleted = cached.qwCompleted;
+        result.bCached     = true;
+        return;
+    }
+
+    CPipelineSim& sim = context.m_Sim;
+
+    sim.Reset ( );
+
+    // a trace which cannot be scheduled issues in its initial order
+    const bool bScheduled = m_bSchedule &&
+                            (context.m_Scheduler.Schedule ( context.m_dag, m_Config ) == result.nNumNodes);
+
+    sim.LoadInstructions ( context.m_dag, context.m_Hazards,
+                           bScheduled ? &context.m_Scheduler.GetIssueOrder ( ) : nullptr );
+
+    // only the counts are of interest, so the cycles are not stepped
+    result.qwCycles    = sim.FastForward ( );
+
+    result.qwStalls    = sim.GetStallCount ( );
+    result.qwCompleted = sim.GetCompletionCount ( );
+
+    if ( m_pCache != nullptr )
+    {
+        cached.qwCycles    = result.qwCycles;
+        cached.qwStalls    = result.qwStalls;
+        cached.qwCompleted = result.qwCompleted;
+
+        m_pCache->Insert ( qwGraphHash, qwConfigKey, cached );
+    }
+}
+
+tostream& CBatchDriver::OutputResults ( tostream& os ) const noexcept
+{
+    size_t nNumFailed  = 0;
+    size_t nNumCached  = 0;
+    QWORD  qwNumNodes  = 0;
+    QWORD  qwCycles    = 0;
+    QWORD  qwStalls    = 0;
+
+    os << std::left  << std::setw(40) << _T("Trace")
+       << std::right << std::setw(14) << _T("Instructions")
+       << std::setw(12) << _T("Cycles")
+       << std::setw(10) << _T("Stalls")
+       << std::setw(10) << _T("CPI") << _T("\n");
+
+    for ( std::vector<BATCH_RESULT>::const_iterator it = m_vResults.begin ( ); it != m_vResults.end ( ); ++it )
+    {
+        os << std::left << std::setw(40) << it->strFileName << std::right;
+
+        if ( it->bLoaded == false )
+        {
+            os << _T("  error loading trace\n");
+            nNumFailed++;
+        }
+        else if ( it->bAcyclic == false )
+        {
+            os << _T("  dependency cycles found\n");
+            nNumFailed++;
+        }
+        else
+        {
+            os << std::setw(14) << it->nNumNodes
+               << std::setw(12) << it->qwCycles
+               << std::setw(10) << it->qwStalls
+               << std::setw(10) << std::fixed << std::setprecision(3)
+               << ((it->nNumNodes > 0) ? static_cast<double>(it->qwCycles) / it->nNumNodes : 0.0)
+               << _T("\n");
+
+            qwNumNodes += it->nNumNodes;
+            qwCycles   += it->qwCycles;
+            qwStalls   += it->qwStalls;
+
+            if ( it->bCached )
+                nNumCached++;
+        }
+    }
+
+    os << _T("------------------------------------------------------------------") << _T("\n");
+    os << _T("Traces simulated: ") << (m_vResults.size ( ) - nNumFailed)
+       << _T(", failed: ") << nNumFailed;
+
+    if ( m_pCache != nullptr )
+        os << _T(", found in result cache: ") << nNumCached;
+
+    os << _T("\n");
+    os << _T("Total instructions: ") << qwNumNodes
+       << _T(", cycles: ") << qwCycles
+       << _T(", stalls: ") << qwStalls << _T("\n");
+    os << _T("Aggregate CPI: ") << std::fixed << std::setprecision(3)
+       << ((qwNumNodes > 0) ? static_cast<double>(qwCycles) / qwNumNodes : 0.0) << _T("\n");
+    os << _T("Elapsed time: ") << m_dElapsed << _T(" seconds, using ")
+       << m_dwNumWorkers << _T(" worker thread(s)") << std::endl;
+
+    return os;
+}
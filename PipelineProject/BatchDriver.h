@@ -0,0 +1,166 @@
+/**
+* @file       BatchDriver.h
+* @brief      CBatchDriver class interface
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  Simulates a batch of independent instruction traces in parallel.  The
+*  traces are named either by a directory, every regular file of which is
+*  taken to be a trace, or by a manifest file listing one trace per line
+*  (blank lines and lines starting with '#' are ignored, and relative paths
+*  are relative to the manifest's directory).
+*
+*  Each worker thread of a CWorkStealingPool owns its own graph, analysis
+*  and simulator instances, which are reused from one trace to the next,
+*  so that no state is shared between workers.  The per-trace results are
+*  aggregated once every trace has been simulated.
+*
+*  Given a CResultCache, a trace found in the cache with the same pipeline
+*  configuration, by content rather than by name, is loaded and hashed but
+*  not simulated, and the result of each trace simulated is inserted.
+*/
+#pragma once
+
+#if !defined(_BATCH_DRIVER_H__)
+#define _BATCH_DRIVER_H__
+
+#ifndef _PIPELINE_SIM_H__
+    #include "PipelineSim.h"
+#endif
+
+#ifndef _STRING_
+    #include <string>
+#endif
+
+#ifndef _VECTOR_
+    #include <vector>
+#endif
+
+/**
+    @brief Results of simulating a single trace
+*/
+struct BATCH_RESULT
+{
+    std::basic_string<TCHAR> strFileName;  ///< trace file name
+    bool                     bLoaded;      ///< trace has been loaded successfully
+    bool                     bAcyclic;     ///< trace contains no dependency cycles
+    size_t                   nNumNodes;    ///< number of instructions
+    size_t                   nNumEdges;    ///< number of dependencies
+    QWORD                    qwCycles;     ///< cycles simulated
+    QWORD                    qwStalls;     ///< stalls introduced
+    QWORD                    qwCompleted;  ///< instructions completed
+    bool                     bCached;      ///< results were found in the result cache
+};
+
+class CWorkerContext;
+class CResultCache;
+
+/**
+    @brief Parallel batch simulation driver
+*/
+class CBatchDriver
+{
+    CPipelineConfig                       m_Config;       ///< pipeline descriptor
+    bool                                  m_bSchedule;    ///< issue instructions in scheduled order
+    std::vector<std::basic_string<TCHAR>> m_vFiles;       ///< trace file names
+    std::vector<BATCH_RESULT>             m_vResults;     ///< per-trace results, in m_vFiles order
+    DWORD                                 m_dwNumWorkers; ///< worker threads used by the last run
+    double                                m_dElapsed;     ///< wall time of the last run, in seconds
+    CResultCache*                         m_pCache;       ///< cache of results, if any
+
+public:
+    /**
+        @brief Initialization Constructor
+
+        @param [in] config      descriptor of the pipeline to be simulated
+        @param [in] bSchedule   true to issue instructions in scheduled order
+    */
+    explicit CBatchDriver(const CPipelineConfig& config, bool bSchedule = false) noexcept;
+
+    /// Default Destructor
+    ~CBatchDriver() = default;
+
+/**
+    @brief Adds the traces named by a directory or manifest file
+
+    @param [in] szSource    directory or manifest file name
+
+    @retval size_t          number of traces added
+*/
+    size_t AddSource(const TCHAR* szSource) noexcept;
+
+/**
+    @brief Adds every regular file of a directory, in file name order
+
+    @param [in] szDirectory directory name
+
+    @retval size_t          number of traces added
+*/
+    size_t AddDirectory(const TCHAR* szDirectory) noexcept;
+
+/**
+    @brief Adds every trace listed by a manifest file
+
+    @param [in] szManifest  manifest file name
+
+    @retval size_t          number of traces added
+*/
+    size_t AddManifest(const TCHAR* szManifest) noexcept;
+
+/**
+    @brief Retrieves the number of traces in the batch
+
+    @retval size_t          count of traces
+*/
+    size_t GetNumTraces(void) const noexcept
+    { return m_vFiles.size(); };
+
+/**
+    @brief Sets the cache of results looked up ahead of each simulation
+
+    @param [in] pCache      result cache, which must outlive any run, or
+                            nullptr to simulate every trace
+*/
+    void SetResultCache(CResultCache* pCache) noexcept
+    { m_pCache = pCache; };
+
+/**
+    @brief Simulates every trace of the batch
+
+    @param [in] dwNumThreads    number of worker threads, 0 to use the
+                                number of hardware threads available
+
+    @retval size_t              number of traces simulated successfully
+*/
+    size_t Run(DWORD dwNumThreads = 0) noexcept;
+
+/**
+    @brief Retrieves the per-trace results of the last run
+
+    @retval std::vector<BATCH_RESULT>&  results, in the order the traces were added
+*/
+    const std::vector<BATCH_RESULT>& GetResults(void) const noexcept
+    { return m_vResults; };
+
+/**
+    @brief Formats and outputs the per-trace and aggregate results
+
+    @param [in,out] os      destination output stream
+
+    @retval tostream&       reference to updated stream
+*/
+    tostream& OutputResults(tostream& os) const noexcept;
+
+private:
+/**
+    @brief Loads and simulates a single trace
+
+    @param [in,out] context     the executing worker's graph and simulator
+    @param [in,out] result      receives the trace results
+*/
+    void SimulateTrace(CWorkerContext& context, BATCH_RESULT& result) const noexcept;
+};
+
+#endif
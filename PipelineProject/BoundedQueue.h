@@ -0,0 +1,174 @@
+/**
+* @file       BoundedQueue.h
+* @brief      CBoundedQueue class template interface and implementation
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  A fixed-capacity FIFO handing items from a producer thread to a consumer
+*  thread, the producer being blocked while the queue is full, and the
+*  consumer while it is empty.  Items are exchanged with the slots by way
+*  of swap rather than copied, so a producer pushing an item receives in
+*  return the item last popped from that slot.  When the items own storage,
+*  e.g. a block of vectors, the storage of the items consumed is thereby
+*  recycled by the producer, and no more than capacity + 2 items' worth is
+*  ever allocated, however many items pass through the queue.
+*/
+#pragma once
+
+#if !defined(_BOUNDED_QUEUE_H__)
+#define _BOUNDED_QUEUE_H__
+
+#ifndef _CONDITION_VARIABLE_
+    #include <condition_variable>
+#endif
+
+#ifndef _MUTEX_
+    #include <mutex>
+#endif
+
+#ifndef _UTILITY_
+    #include <utility>
+#endif
+
+#ifndef _VECTOR_
+    #include <vector>
+#endif
+
+/**
+    @brief A blocking fixed-capacity single producer, single consumer queue
+
+    @tparam T   item type, must be default constructible and swappable
+*/
+template <class T>
+class CBoundedQueue
+{
+    std::mutex              m_mtxLock;     ///< guards every member below
+    std::condition_variable m_cvNotEmpty;  ///< signalled as an item is pushed, or the queue closed
+    std::condition_variable m_cvNotFull;   ///< signalled as an item is popped, or the queue closed
+    std::vector<T>          m_vSlots;      ///< underlying storage
+    size_t                  m_nHead;       ///< index of the oldest item
+    size_t                  m_nSize;       ///< current number of items
+    bool                    m_bClosed;     ///< no further items are to be pushed
+
+public:
+    /**
+        @brief Initialization Constructor
+
+        @param [in] nCapacity   maximum number of items held, at least 1
+    */
+    explicit CBoundedQueue(size_t nCapacity) noexcept
+        : m_mtxLock   (),
+          m_cvNotEmpty(),
+          m_cvNotFull (),
+          m_vSlots    ((nCapacity > 0) ? nCapacity : 1),
+          m_nHead     (0),
+          m_nSize     (0),
+          m_bClosed   (false)
+    { };
+
+    /// Default Destructor
+    ~CBoundedQueue() = default;
+
+/**
+    @retval size_t      the maximum number of items
+*/
+    size_t capacity(void) const noexcept
+    { return m_vSlots.size(); };
+
+/**
+    @brief Appends an item, waiting for room if the queue is full
+
+    @param [in,out] item    item to be appended, receives the previous
+                            content of the slot it is swapped into
+
+    @retval true            on success
+    @retval false           if the queue has been closed
+*/
+    bool Push(T& item) noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mtxLock);
+
+        m_cvNotFull.wait(lock, [this] { return m_bClosed || m_nSize < m_vSlots.size(); });
+
+        if ( m_bClosed )
+            return false;
+
+        std::swap(m_vSlots[(m_nHead + m_nSize) % m_vSlots.size()], item);
+        m_nSize++;
+
+        lock.unlock();
+        m_cvNotEmpty.notify_one();
+
+        return true;
+    };
+
+/**
+    @brief Removes the oldest item, waiting for one if the queue is empty
+
+    The items pushed before the queue was closed are still popped.
+
+    @param [in,out] item    receives the oldest item, its previous content
+                            being swapped into the vacated slot
+
+    @retval true            on success
+    @retval false           if the queue is empty, and has been closed
+*/
+    bool Pop(T& item) noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mtxLock);
+
+        m_cvNotEmpty.wait(lock, [this] { return m_bClosed || m_nSize > 0; });
+
+        if ( m_nSize == 0 )
+            return false;
+
+        std::swap(m_vSlots[m_nHead], item);
+        m_nHead = (m_nHead + 1) % m_vSlots.size();
+        m_nSize--;
+
+        lock.unlock();
+        m_cvNotFull.notify_one();
+
+        return true;
+    };
+
+/**
+    @brief Closes the queue, such that pushing fails and popping fails
+           once the queue is empty, waking any thread waiting on either
+*/
+    void Close(void) noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mtxLock);
+            m_bClosed = true;
+        }
+
+        m_cvNotEmpty.notify_all();
+        m_cvNotFull.notify_all();
+    };
+
+/**
+    @brief Discards any items held, and reopens a closed queue
+
+    No thread may be waiting on the queue, nor be about to.
+*/
+    void Reset(void) noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_mtxLock);
+
+        m_nHead   = 0;
+        m_nSize   = 0;
+        m_bClosed = false;
+    };
+
+private:
+    /// copy constructor
+    CBoundedQueue(const CBoundedQueue& o) = delete;
+
+    /// assignment operator
+    CBoundedQueue& operator=(const CBoundedQueue& rhs) = delete;
+};
+
+#endif
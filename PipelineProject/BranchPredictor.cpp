@@ -0,0 +1,64 @@
+/**
+* @file       BranchPredictor.cpp
+* @brief      CBranchPredictor class implementation
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*/
+
+#include "stdafx.h"
+#include "BranchPredictor.h"
+#include <algorithm>
+
+/// initial counter value, weakly not taken
+constexpr BYTE PREDICT_COUNTER_INITIAL = PREDICT_TAKEN_THRESHOLD - 1;
+
+
+CBranchPredictor::CBranchPredictor ( ) noexcept
+    : m_bpType      ( BP_NOT_TAKEN ),
+      m_dwIndexMask ( 0 ),
+      m_dwHistory   ( 0 ),
+      m_vCounters   ( )
+{
+}
+
+CBranchPredictor::CBranchPredictor ( const CPipelineConfig& config )
+    : m_bpType      ( BP_NOT_TAKEN ),
+      m_dwIndexMask ( 0 ),
+      m_dwHistory   ( 0 ),
+      m_vCounters   ( )
+{
+    Configure ( config.GetBranchPredictor ( ), config.GetPredictorBits ( ) );
+}
+
+void CBranchPredictor::Configure ( BP_PREDICTOR_TYPE bpType, DWORD dwBits )
+{
+    m_bpType = (bpType < BP_NUM_TYPES) ? bpType : BP_NOT_TAKEN;
+
+    if ( dwBits < 1 )
+        dwBits = 1;
+    else if ( dwBits > MAX_PREDICTOR_BITS )
+        dwBits = MAX_PREDICTOR_BITS;
+
+    // only the dynamic schemes have a table
+    if ( m_bpType == BP_BIMODAL || m_bpType == BP_GSHARE )
+    {
+        m_dwIndexMask = (static_cast<DWORD>(1) << dwBits) - 1;
+        m_vCounters.resize ( static_cast<size_t>(m_dwIndexMask) + 1 );
+    }
+    else
+    {
+        m_dwIndexMask = 0;
+        std::vector<BYTE>().swap ( m_vCounters );
+    }
+
+    Reset ( );
+}
+
+void CBranchPredictor::Reset ( void ) noexcept
+{
+    m_dwHistory = 0;
+
+    std::fill ( m_vCounters.begin ( ), m_vCounters.end ( ), PREDICT_COUNTER_INITIAL );
+}
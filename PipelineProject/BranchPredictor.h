@@ -0,0 +1,164 @@
+/**
+* @file       BranchPredictor.h
+* @brief      CBranchPredictor class interface
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  The branch predictor consulted by CPipelineSim as each branch is fetched,
+*  implementing whichever BP_PREDICTOR_TYPE scheme the pipeline descriptor
+*  selects:
+*  - static not taken, or static taken, requiring no state at all
+*  - bimodal, a table of 2-bit saturating counters indexed by the low bits
+*    of the branch address
+*  - gshare, a table of 2-bit saturating counters indexed by the low bits
+*    of the branch address XOR the global history of branch outcomes
+*  @sa S. McFarling, "Combining Branch Predictors", WRL TN-36, 1993
+*
+*  Rather than an interface having a virtual implementation per scheme, the
+*  scheme is a tag selecting the index computation, so a prediction costs a
+*  single predictable switch and, for the dynamic schemes, a single table
+*  load.  The counters are held one per byte in a single contiguous table, by
+*  default 4 KB, such that the whole of it remains resident in the L1 cache
+*  throughout the simulation.  A new scheme is added as a BP_PREDICTOR_TYPE,
+*  and a case of Predict and, if need be, GetIndex.
+*
+*  As a trace records no instruction addresses, the ID of a branch's node
+*  stands in for its address, as it does for the instruction itself.
+*/
+#pragma once
+
+#if !defined(_BRANCH_PREDICTOR_H__)
+#define _BRANCH_PREDICTOR_H__
+
+#ifndef _PIPELINE_CONFIG_H__
+    #include "PipelineConfig.h"
+#endif
+
+#ifndef _VECTOR_
+    #include <vector>
+#endif
+
+/// counter values of at least this are predicted taken
+constexpr BYTE PREDICT_TAKEN_THRESHOLD = 2;
+/// saturated value of a 2-bit counter
+constexpr BYTE PREDICT_COUNTER_MAX     = 3;
+
+/**
+    @brief Branch predictor
+*/
+class CBranchPredictor
+{
+    BP_PREDICTOR_TYPE   m_bpType;       ///< prediction scheme
+    DWORD               m_dwIndexMask;  ///< number of table entries - 1
+    DWORD               m_dwHistory;    ///< global branch history, the latest outcome in bit 0
+    std::vector<BYTE>   m_vCounters;    ///< 2-bit saturating counters, empty for a static scheme
+
+public:
+    /// Default Constructor, predicts every branch not taken
+    CBranchPredictor() noexcept;
+
+    /**
+        @brief Initialization Constructor
+
+        @param [in] config      descriptor of the pipeline, specifying the
+                                prediction scheme and its table size
+    */
+    explicit CBranchPredictor(const CPipelineConfig& config);
+
+    /// Default Destructor
+    ~CBranchPredictor() = default;
+
+/**
+    @brief Selects the prediction scheme, and resets its state
+
+    A dynamic scheme has a table of 2^dwBits counters, whose allocation
+    throws std::bad_alloc on failure.
+
+    @param [in] bpType      prediction scheme
+    @param [in] dwBits      log2 of the number of table entries
+*/
+    void Configure(BP_PREDICTOR_TYPE bpType, DWORD dwBits);
+
+/**
+    @brief Returns every counter to weakly not taken, and clears the history
+*/
+    void Reset(void) noexcept;
+
+/**
+    @brief Retrieves the prediction scheme
+
+    @retval BP_PREDICTOR_TYPE   prediction scheme
+*/
+    constexpr BP_PREDICTOR_TYPE GetType(void) const noexcept
+    { return m_bpType; };
+
+/**
+    @brief Retrieves the size of the predictor table
+
+    @retval size_t          table size in bytes, 0 for a static scheme
+*/
+    size_t GetTableSize(void) const noexcept
+    { return m_vCounters.size(); };
+
+/**
+    @brief Predicts the outcome of a branch
+
+    @param [in] dwAddress   address of the branch
+
+    @retval true            if the branch is predicted taken
+*/
+    bool Predict(DWORD dwAddress) const noexcept
+    {
+        switch (m_bpType)
+        {
+            case BP_TAKEN:
+                return true;
+            case BP_BIMODAL:
+            case BP_GSHARE:
+                return m_vCounters[GetIndex(dwAddress)] >= PREDICT_TAKEN_THRESHOLD;
+            default:
+                return false;
+        }
+    };
+
+/**
+    @brief Trains the predictor with the resolved outcome of a branch
+
+    @param [in] dwAddress   address of the branch
+    @param [in] bTaken      true if the branch was taken
+*/
+    void Update(DWORD dwAddress, bool bTaken) noexcept
+    {
+        if ( m_vCounters.empty() )
+            return;
+
+        BYTE& byCounter = m_vCounters[GetIndex(dwAddress)];
+
+        if ( bTaken )
+        {
+            if ( byCounter < PREDICT_COUNTER_MAX )
+                byCounter++;
+        }
+        else if ( byCounter > 0 )
+        {
+            byCounter--;
+        }
+
+        m_dwHistory = ((m_dwHistory << 1) | (bTaken ? 1 : 0)) & m_dwIndexMask;
+    };
+
+private:
+/**
+    @brief Computes the table index of a branch
+
+    @param [in] dwAddress   address of the branch
+
+    @retval DWORD           index into m_vCounters
+*/
+    DWORD GetIndex(DWORD dwAddress) const noexcept
+    { return ((m_bpType == BP_GSHARE) ? (dwAddress ^ m_dwHistory) : dwAddress) & m_dwIndexMask; };
+};
+
+#endif
@@ -12,7 +12,47 @@
 #if !defined(_COMMON_DEF_H__)
 #define _COMMON_DEF_H__
 
+#if defined(_MSC_VER)
 typedef unsigned __int8  BYTE;   ///< 8-bit unsigned type
 typedef unsigned __int32 DWORD;  ///< 32-bit unsigned type
+typedef unsigned __int64 QWORD;  ///< 64-bit unsigned type
+#else
+typedef unsigned char      BYTE;   ///< 8-bit unsigned type
+typedef unsigned int       DWORD;  ///< 32-bit unsigned type
+typedef unsigned long long QWORD;  ///< 64-bit unsigned type
+#endif
+
+/**
+    @brief Instruction class
+
+    Determines the pipeline stage in which an instruction's result
+    is produced, and thus how it may be forwarded to a dependent
+    instruction.  A branch is classed by the outcome it had when the
+    trace was recorded, any result of its own being produced in EX.
+    A multiply or divide also produces its result in EX, but occupies
+    its functional unit for more than a single cycle in doing so.
+*/
+typedef enum IC_INSTRUCTION_CLASS : BYTE
+{
+    IC_ALU          = 0, ///< arithmetic / logic, result produced in EX
+    IC_LOAD         = 1, ///< memory load, result produced in MEM
+    IC_BRANCH       = 2, ///< conditional branch, not taken
+    IC_BRANCH_TAKEN = 3, ///< conditional branch, taken
+    IC_MUL          = 4, ///< integer multiply, result produced in a multi-cycle EX
+    IC_DIV          = 5, ///< integer divide, result produced in a multi-cycle EX
+    IC_NUM_CLASSES       ///< number of instruction classes
+} IC_INSTRUCTION_CLASS_T;
+
+/**
+    @brief Determines whether an instruction class is that of a branch
+
+    @param [in] icClass     instruction class
+
+    @retval true            for IC_BRANCH and IC_BRANCH_TAKEN
+*/
+constexpr bool IsBranchClass(IC_INSTRUCTION_CLASS icClass) noexcept
+{
+    return (icClass == IC_BRANCH) || (icClass == IC_BRANCH_TAKEN);
+}
 
 #endif
\ No newline at end of file
@@ -0,0 +1,119 @@
+/**
+* @file       ContentHash.h
+* @brief      CContentHash class interface and implementation
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  A 64-bit hash accumulated over a sequence of 64-bit values, by way of the
+*  MurmurHash3 block mixing and finalization steps.  It identifies content,
+*  such as that of a frozen graph, in place of comparing the content itself,
+*  and is neither intended for, nor suited to, any cryptographic purpose.
+*  @sa https://github.com/aappleby/smhasher/wiki/MurmurHash3
+*/
+#pragma once
+
+#if !defined(_CONTENT_HASH_H__)
+#define _CONTENT_HASH_H__
+
+#ifndef _COMMON_DEF_H__
+    #include "CommonDef.h"
+#endif
+
+#ifndef _CSTRING_
+    #include <cstring>
+#endif
+
+/**
+    @brief Incrementally accumulated 64-bit content hash
+*/
+class CContentHash
+{
+    QWORD   m_qwState;   ///< hash of the values added so far
+    QWORD   m_qwLength;  ///< number of values added
+
+    /// rotates a value left by a number of bits
+    static constexpr QWORD RotateLeft(QWORD qwValue, DWORD dwBits) noexcept
+    { return (qwValue << dwBits) | (qwValue >> (64 - dwBits)); };
+
+public:
+    /**
+        @brief Initialization Constructor
+
+        @param [in] qwSeed      initial state, distinguishing the hashes
+                                of different kinds of content
+    */
+    explicit constexpr CContentHash(QWORD qwSeed = 0) noexcept
+        : m_qwState (qwSeed),
+          m_qwLength(0)
+    { };
+
+    /// Default Destructor
+    ~CContentHash() = default;
+
+/**
+    @brief Adds a value to the hash
+
+    @param [in] qwValue     value to be added
+*/
+    void Add(QWORD qwValue) noexcept
+    {
+        qwValue  *= 0x87C37B91114253D5ull;
+        qwValue   = RotateLeft(qwValue, 31);
+        qwValue  *= 0x4CF5AD432745937Full;
+
+        m_qwState ^= qwValue;
+        m_qwState  = RotateLeft(m_qwState, 27) * 5 + 0x52DCE729;
+        m_qwLength++;
+    };
+
+/**
+    @brief Adds a block of bytes to the hash, 8 at a time
+
+    The final partial value is padded with zeroes, the number of bytes
+    being added as well.
+
+    @param [in] pData       start of the block
+    @param [in] nNumBytes   length of the block in bytes
+*/
+    void AddBytes(const void* pData, size_t nNumBytes) noexcept
+    {
+        const BYTE* pBytes = static_cast<const BYTE*>(pData);
+        QWORD       qwValue;
+
+        for ( ; nNumBytes >= sizeof(qwValue); nNumBytes -= sizeof(qwValue), pBytes += sizeof(qwValue) )
+        {
+            memcpy(&qwValue, pBytes, sizeof(qwValue));
+            Add(qwValue);
+        }
+
+        qwValue = 0;
+
+        if ( nNumBytes > 0 )
+            memcpy(&qwValue, pBytes, nNumBytes);
+
+        Add(qwValue);
+        Add(nNumBytes);
+    };
+
+/**
+    @brief Retrieves the hash of the values added so far
+
+    @retval QWORD           hash value
+*/
+    QWORD GetHash(void) const noexcept
+    {
+        QWORD qwHash = m_qwState ^ m_qwLength;
+
+        qwHash ^= qwHash >> 33;
+        qwHash *= 0xFF51AFD7ED558CCDull;
+        qwHash ^= qwHash >> 33;
+        qwHash *= 0xC4CEB9FE1A85EC53ull;
+        qwHash ^= qwHash >> 33;
+
+        return qwHash;
+    };
+};
+
+#endif
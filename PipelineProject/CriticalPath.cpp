@@ -0,0 +1,146 @@
+/**
+* @file       CriticalPath.cpp
+* @brief      CCriticalPath class implementation
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*/
+
+#include "stdafx.h"
+#include "CriticalPath.h"
+
+#ifndef _ALGORITHM_
+    #include <algorithm>
+#endif
+
+
+CCriticalPath::CCriticalPath ( ) noexcept
+    : m_vEarliest      ( ),
+      m_vLatest        ( ),
+      m_vCriticalChain ( ),
+      m_qwLength       ( 0 ),
+      m_qwLowerBound   ( 0 )
+{
+}
+
+bool CCriticalPath::Analyze ( const CCsrDependencyGraph& dag, const CPipelineConfig& config ) noexcept
+{
+    Clear ( );
+
+    std::vector<NODE_ID_T> vTopological;
+
+    if ( dag.TopologicalSort ( vTopological ) == false )
+        return false;
+
+    // the latency of a dependency upon each producer class
+    QWORD qwClassLatency[(NF_CLASS_MASK >> NF_CLASS_SHIFT) + 1];
+
+    for ( DWORD i = 0; i < _countof(qwClassLatency); i++ )
+        qwClassLatency[i] = config.GetHazardPenalty ( static_cast<IC_INSTRUCTION_CLASS>(i) ) + 1;
+
+    const size_t nCapacity = dag.GetNodeCapacity ( );
+
+    m_vEarliest.assign ( nCapacity, 0 );
+
+    NODE_ID_T idLast = INVALID_NODE_ID;
+
+    // forward pass, every producer precedes its consumers
+    for ( std::vector<NODE_ID_T>::const_iterator it = vTopological.begin ( ); it != vTopological.end ( ); ++it )
+    {
+        const CCsrGraphNode node = dag.GetNode ( *it );
+
+        QWORD qwEarliest = 1;
+
+        for ( CCsrGraphNode::const_iterator pEdge = node.beginEdge ( ); pEdge != node.endEdge ( ); ++pEdge )
+        {
+            const NODE_ID_T idProducer = pEdge->GetDestNodeID ( );
+
+            if ( idProducer != *it && dag.HasNode ( idProducer ) )
+            {
+                const QWORD qwReady = m_vEarliest[idProducer] + qwClassLatency[dag.GetNode ( idProducer ).GetClass ( )];
+
+                if ( qwReady > qwEarliest )
+                    qwEarliest = qwReady;
+            }
+        }
+
+        m_vEarliest[*it] = qwEarliest;
+
+        if ( qwEarliest > m_qwLength || (qwEarliest == m_qwLength && *it < idLast) )
+        {
+            m_qwLength = qwEarliest;
+            idLast     = *it;
+        }
+    }
+
+    // backward pass, every consumer being visited before its producers
+    m_vLatest.assign ( nCapacity, 0 );
+
+    for ( std::vector<NODE_ID_T>::const_iterator it = vTopological.begin ( ); it != vTopological.end ( ); ++it )
+        m_vLatest[*it] = m_qwLength;
+
+    for ( std::vector<NODE_ID_T>::const_reverse_iterator it = vTopological.rbegin ( ); it != vTopological.rend ( ); ++it )
+    {
+        const CCsrGraphNode node = dag.GetNode ( *it );
+
+        for ( CCsrGraphNode::const_iterator pEdge = node.beginEdge ( ); pEdge != node.endEdge ( ); ++pEdge )
+        {
+            const NODE_ID_T idProducer = pEdge->GetDestNodeID ( );
+
+            if ( idProducer != *it && dag.HasNode ( idProducer ) )
+            {
+                const QWORD qwLatest = m_vLatest[*it] - qwClassLatency[dag.GetNode ( idProducer ).GetClass ( )];
+
+                if ( qwLatest < m_vLatest[idProducer] )
+                    m_vLatest[idProducer] = qwLatest;
+            }
+        }
+    }
+
+    // trace the critical chain back from its final instruction, by way of
+    // the producer which determined each instruction's earliest start
+    for ( NODE_ID_T idNode = idLast; idNode != INVALID_NODE_ID; )
+    {
+        m_vCriticalChain.push_back ( idNode );
+
+        const CCsrGraphNode node = dag.GetNode ( idNode );
+
+        NODE_ID_T idCritical = INVALID_NODE_ID;
+
+        for ( CCsrGraphNode::const_iterator pEdge = node.beginEdge ( ); pEdge != node.endEdge ( ); ++pEdge )
+        {
+            const NODE_ID_T idProducer = pEdge->GetDestNodeID ( );
+
+            if ( idProducer != idNode && dag.HasNode ( idProducer ) &&
+                 m_vEarliest[idProducer] + qwClassLatency[dag.GetNode ( idProducer ).GetClass ( )] == m_vEarliest[idNode] )
+            {
+                idCritical = idProducer;
+                break;
+            }
+        }
+
+        idNode = idCritical;
+    }
+
+    std::reverse ( m_vCriticalChain.begin ( ), m_vCriticalChain.end ( ) );
+
+    // every instruction occupies an issue slot of its own, and the last
+    // one issued takes a further (stages - 1) cycles to complete
+    const QWORD qwNumNodes = dag.GetNumNodes ( );
+
+    if ( qwNumNodes > 0 )
+        m_qwLowerBound = ((m_qwLength > qwNumNodes) ? m_qwLength : qwNumNodes) + config.GetNumStages ( ) - 1;
+
+    return true;
+}
+
+void CCriticalPath::Clear ( void ) noexcept
+{
+    std::vector<QWORD>().swap ( m_vEarliest );
+    std::vector<QWORD>().swap ( m_vLatest );
+    std::vector<NODE_ID_T>().swap ( m_vCriticalChain );
+
+    m_qwLength     = 0;
+    m_qwLowerBound = 0;
+}
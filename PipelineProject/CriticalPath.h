@@ -0,0 +1,139 @@
+/**
+* @file       CriticalPath.h
+* @brief      CCriticalPath class interface
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  Critical path (or weighted longest path) analysis of a frozen dependency
+*  graph, which affords a lower bound on the cycles required to execute its
+*  instructions without running the pipeline simulation.
+*
+*  Instructions are issued at most one per cycle, and a consumer may issue
+*  no earlier than the latency of its producer after it, that latency being
+*  one cycle plus the stall penalty of the forwarding path used.  Visiting
+*  the nodes in topological order, then in reverse, yields for each node:
+*  - its earliest start, the earliest issue slot its dependencies allow
+*  - its latest start, the latest issue slot not lengthening the critical path
+*  - its slack, the difference between the two
+*
+*  The critical chain is the dependency chain of zero slack terminating at
+*  the instruction of latest earliest start.  All passes are O(V + E).
+*/
+#pragma once
+
+#if !defined(_CRITICAL_PATH_H__)
+#define _CRITICAL_PATH_H__
+
+#ifndef _CSR_DEPENDENCY_GRAPH_H__
+    #include "CsrDependencyGraph.h"
+#endif
+
+#ifndef _PIPELINE_CONFIG_H__
+    #include "PipelineConfig.h"
+#endif
+
+#ifndef _VECTOR_
+    #include <vector>
+#endif
+
+/**
+    @brief Critical path analysis
+
+    Issue slots are 1-based, an instruction without any dependencies
+    having an earliest start of 1.
+*/
+class CCriticalPath
+{
+    std::vector<QWORD>     m_vEarliest;      ///< earliest start, indexed by node ID
+    std::vector<QWORD>     m_vLatest;        ///< latest start, indexed by node ID
+    std::vector<NODE_ID_T> m_vCriticalChain; ///< critical chain, producers first
+    QWORD                  m_qwLength;       ///< critical path length, in issue slots
+    QWORD                  m_qwLowerBound;   ///< lower bound on the cycles required
+
+public:
+    /// Default Constructor
+    CCriticalPath() noexcept;
+
+    /// Default Destructor
+    ~CCriticalPath() = default;
+
+/**
+    @brief Performs the critical path analysis
+
+    The graph must have been frozen with its reverse index.
+
+    @param [in] dag         frozen graph of instruction dependencies
+    @param [in] config      descriptor of the pipeline, whose depth and
+                            forwarding paths determine the latencies
+
+    @retval true            on success
+    @retval false           if the graph contains a dependency cycle,
+                            or lacks its reverse index
+*/
+    bool Analyze(const CCsrDependencyGraph& dag, const CPipelineConfig& config) noexcept;
+
+/**
+    @brief Retrieves the earliest start of an instruction
+
+    @param [in] idNode      target node ID
+
+    @retval QWORD           1-based issue slot, 0 if not in the graph
+*/
+    QWORD GetEarliestStart(const NODE_ID_T& idNode) const noexcept
+    { return (idNode < m_vEarliest.size()) ? m_vEarliest[idNode] : 0; };
+
+/**
+    @brief Retrieves the latest start of an instruction
+
+    @param [in] idNode      target node ID
+
+    @retval QWORD           1-based issue slot, 0 if not in the graph
+*/
+    QWORD GetLatestStart(const NODE_ID_T& idNode) const noexcept
+    { return (idNode < m_vLatest.size()) ? m_vLatest[idNode] : 0; };
+
+/**
+    @brief Retrieves the slack of an instruction
+
+    @param [in] idNode      target node ID
+
+    @retval QWORD           issue slots the instruction may be delayed
+                            by without lengthening the critical path
+*/
+    QWORD GetSlack(const NODE_ID_T& idNode) const noexcept
+    { return GetLatestStart(idNode) - GetEarliestStart(idNode); };
+
+/**
+    @brief Retrieves the critical chain
+
+    @retval std::vector<NODE_ID_T>&     node IDs of the chain, producers first
+*/
+    const std::vector<NODE_ID_T>& GetCriticalChain(void) const noexcept
+    { return m_vCriticalChain; };
+
+/**
+    @brief Retrieves the critical path length
+
+    @retval QWORD           latest earliest start of any instruction
+*/
+    constexpr QWORD GetCriticalPathLength(void) const noexcept
+    { return m_qwLength; };
+
+/**
+    @brief Retrieves the lower bound on the cycles required to execute
+           every instruction, regardless of their issue order
+
+    @retval QWORD           count of cycles
+*/
+    constexpr QWORD GetCycleLowerBound(void) const noexcept
+    { return m_qwLowerBound; };
+
+/**
+    @brief Releases the results of the last analysis
+*/
+    void Clear(void) noexcept;
+};
+
+#endif
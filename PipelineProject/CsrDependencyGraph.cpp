@@ -0,0 +1,670 @@
+/**
+* @file       CsrDependencyGraph.cpp
+* @brief      CCsrDependencyGraph class implementation
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*/
+
+#include "stdafx.h"
+#include "CsrDependencyGraph.h"
+#include "EdgeListBuilder.h"
+#include "ContentHash.h"
+#include <algorithm>
+
+// the binary graph file is written as raw memory images of these types
+static_assert(sizeof(GRAPH_FILE_HEADER) == 40, "unexpected GRAPH_FILE_HEADER layout");
+static_assert(sizeof(CDirectedEdgeData) == 8,  "unexpected CDirectedEdgeData layout");
+static_assert(sizeof(EDGE_OFFSET_T)     == 8,  "unexpected EDGE_OFFSET_T layout");
+static_assert(sizeof(PACKED_EDGE_T)     == 4,  "unexpected PACKED_EDGE_T layout");
+static_assert(sizeof(ESCAPED_EDGE)      == 16, "unexpected ESCAPED_EDGE layout");
+
+/// number of unpacked edges read from a version 1 graph file at a time
+constexpr size_t READ_CHUNK_EDGES = 4096;
+
+
+bool CCsrGraphNode::HasEdge ( const NODE_ID_T& idToNode ) const noexcept
+{
+    const NODE_ID_T idNode = static_cast<NODE_ID_T>(m_nIndex);
+    const size_t    nEnd   = static_cast<size_t>(m_pGraph->m_vOffsets[m_nIndex + 1]);
+
+    size_t nFirst = static_cast<size_t>(m_pGraph->m_vOffsets[m_nIndex]);
+    size_t nLast  = nEnd;
+
+    // edges are ordered by destination node ID, so a binary search suffices
+    while ( nFirst < nLast )
+    {
+        const size_t nMiddle = nFirst + (nLast - nFirst) / 2;
+
+        if ( m_pGraph->GetDestNodeID ( nMiddle, idNode ) < idToNode )
+            nFirst = nMiddle + 1;
+        else
+            nLast  = nMiddle;
+    }
+
+    return (nFirst != nEnd) && (m_pGraph->GetDestNodeID ( nFirst, idNode ) == idToNode);
+}
+
+CCsrDependencyGraph::CCsrDependencyGraph ( ) noexcept
+    : m_nNumNodes(0),
+      m_vNodeFlags(),
+      m_vOffsets(1, 0),
+      m_vEdges(),
+      m_vEscapedEdges(),
+      m_vInOffsets(),
+      m_vInEdges(),
+      m_vInEscapedEdges(),
+      m_vCycleEdges()
+{
+}
+
+CCsrDependencyGraph::CCsrDependencyGraph ( const CDependencyGraph& dag, bool bReverseIndex ) noexcept
+    : m_nNumNodes(0),
+      m_vNodeFlags(),
+      m_vOffsets(1, 0),
+      m_vEdges(),
+      m_vEscapedEdges(),
+      m_vInOffsets(),
+      m_vInEdges(),
+      m_vInEscapedEdges(),
+      m_vCycleEdges()
+{
+    Freeze(dag, bReverseIndex);
+}
+
+size_t CCsrDependencyGraph::Freeze ( const CDependencyGraph& dag, bool bReverseIndex ) noexcept
+{
+    Clear ( );
+
+    const size_t nCapacity = static_cast<size_t>(dag.end ( ) - dag.begin ( ));
+
+    m_vNodeFlags.assign ( nCapacity, 0 );
+    m_vOffsets.assign ( nCapacity + 1, 0 );
+    m_vEdges.reserve ( dag.GetNumEdges ( ) );
+
+    size_t nIndex = 0;
+
+    for ( CDependencyGraph::const_iterator it = dag.begin ( ); it != dag.end ( ); ++it, ++nIndex )
+    {
+        if ( it->IsValid ( ) )
+        {
+            m_vNodeFlags[nIndex] = static_cast<BYTE>(NF_VALID | (it->GetClass ( ) << NF_CLASS_SHIFT));
+            m_nNumNodes++;
+
+            // the edge set is already ordered by destination node ID
+            for ( CGraphNode::const_iterator itEdge = it->beginEdge ( ); itEdge != it->endEdge ( ); ++itEdge )
+                AppendEdge ( static_cast<NODE_ID_T>(nIndex), *itEdge, false, m_vEdges, m_vEscapedEdges );
+        }
+
+        m_vOffsets[nIndex + 1] = m_vEdges.size ( );
+    }
+
+    if ( bReverseIndex )
+        BuildReverseIndex ( );
+
+    FindCycleEdges ( );
+
+    return m_vEdges.size ( );
+}
+
+size_t CCsrDependencyGraph::Freeze ( CEdgeListBuilder& builder, bool bReverseIndex )
+{
+    Clear ( );
+
+    builder.SortEdges ( );
+
+    const size_t nCapacity = builder.m_vNodeFlags.size ( );
+
+    m_nNumNodes  = builder.m_nNumNodes;
+    m_vNodeFlags = builder.m_vNodeFlags;
+    m_vOffsets.assign ( nCapacity + 1, 0 );
+    m_vEdges.reserve ( builder.m_vTriples.size ( ) );
+
+    const EDGE_TRIPLE* pPrev = nullptr;
+
+    for ( std::vector<EDGE_TRIPLE>::const_iterator it = builder.m_vTriples.begin ( ); it != builder.m_vTriples.end ( ); ++it )
+    {
+        // of duplicate edges, the first added has been sorted first
+        if ( pPrev != nullptr && pPrev->idFrom == it->idFrom && pPrev->idTo == it->idTo )
+            continue;
+
+        AppendEdge ( it->idFrom, CDirectedEdgeData ( it->idTo, it->iWeight ), false, m_vEdges, m_vEscapedEdges );
+        m_vOffsets[it->idFrom + 1]++;
+
+        pPrev = &*it;
+    }
+
+    // the per-node edge counts become the offsets of each node's first edge
+    for ( size_t i = 0; i < nCapacity; i++ )
+        m_vOffsets[i + 1] += m_vOffsets[i];
+
+    if ( bReverseIndex )
+        BuildReverseIndex ( );
+
+    FindCycleEdges ( );
+
+    return m_vEdges.size ( );
+}
+
+void CCsrDependencyGraph::BuildReverseIndex ( void )
+{
+    const size_t nCapacity = m_vNodeFlags.size ( );
+
+    std::vector<EDGE_OFFSET_T>(nCapacity + 1, 0).swap ( m_vInOffsets );
+    std::vector<PACKED_EDGE_T>().swap ( m_vInEdges );
+    std::vector<ESCAPED_EDGE>().swap ( m_vInEscapedEdges );
+
+    // 1st pass, count the 'in' degree of every node, edges to a destination
+    // beyond the node range are not indexed.
+    size_t nNumInEdges = 0;
+
+    for ( size_t nSrc = 0; nSrc < nCapacity; nSrc++ )
+    {
+        for ( size_t i = static_cast<size_t>(m_vOffsets[nSrc]); i < m_vOffsets[nSrc + 1]; i++ )
+        {
+            size_t nDest = GetDestNodeID ( i, static_cast<NODE_ID_T>(nSrc) );
+
+            if ( nDest < nCapacity )
+            {
+                m_vInOffsets[nDest + 1]++;
+                nNumInEdges++;
+            }
+        }
+    }
+
+    // convert the counts into starting offsets
+    for ( size_t i = 0; i < nCapacity; i++ )
+        m_vInOffsets[i + 1] += m_vInOffsets[i];
+
+    // 2nd pass, scatter the edges.  Visiting the source nodes in ascending
+    // order leaves each 'in' edge range ordered by source node ID.
+    m_vInEdges.resize ( nNumInEdges );
+
+    std::vector<EDGE_OFFSET_T> vInsertPos ( m_vInOffsets.begin ( ), m_vInOffsets.end ( ) - 1 );
+
+    for ( size_t nSrc = 0; nSrc < nCapacity; nSrc++ )
+    {
+        for ( size_t i = static_cast<size_t>(m_vOffsets[nSrc]); i < m_vOffsets[nSrc + 1]; i++ )
+        {
+            const CDirectedEdgeData edge  = GetEdge ( i, static_cast<NODE_ID_T>(nSrc), false );
+            const size_t            nDest = edge.GetDestNodeID ( );
+
+            if ( nDest < nCapacity )
+            {
+                const size_t            nPos = static_cast<size_t>(vInsertPos[nDest]++);
+                const CDirectedEdgeData edgeIn ( static_cast<NODE_ID_T>(nSrc), edge.GetWeight ( ) );
+
+                if ( PackEdge ( static_cast<NODE_ID_T>(nDest), edgeIn, true, m_vInEdges[nPos] ) == false )
+                    m_vInEscapedEdges.push_back ( ESCAPED_EDGE { nPos, edgeIn } );
+            }
+        }
+    }
+
+    // the escaped 'in' edges are found in scatter order
+    std::sort ( m_vInEscapedEdges.begin ( ), m_vInEscapedEdges.end ( ) );
+}
+
+bool CCsrDependencyGraph::PackEdge ( NODE_ID_T idNode, const CDirectedEdgeData& edge, bool bIn,
+                                     PACKED_EDGE_T& peEdge ) noexcept
+{
+    const long long nDistance = bIn ? static_cast<long long>(edge.GetDestNodeID ( )) - idNode
+                                    : static_cast<long long>(idNode) - edge.GetDestNodeID ( );
+    const long long nResidual = edge.GetWeight ( ) - nDistance;
+
+    const bool bReturn = (nDistance >= -PE_MAX_DISTANCE) && (nDistance <= PE_MAX_DISTANCE) &&
+                         (nResidual >= PE_MIN_RESIDUAL)  && (nResidual <= PE_MAX_RESIDUAL);
+
+    peEdge = bReturn ? (static_cast<DWORD>(nDistance) & PE_DISTANCE_MASK) | (static_cast<DWORD>(nResidual) << PE_DISTANCE_BITS)
+                     : PE_ESCAPE;
+
+    return bReturn;
+}
+
+void CCsrDependencyGraph::AppendEdge ( NODE_ID_T idNode, const CDirectedEdgeData& edge, bool bIn,
+                                       std::vector<PACKED_EDGE_T>& vEdges, std::vector<ESCAPED_EDGE>& vEscaped )
+{
+    PACKED_EDGE_T peEdge = PE_ESCAPE;
+
+    if ( PackEdge ( idNode, edge, bIn, peEdge ) == false )
+        vEscaped.push_back ( ESCAPED_EDGE { vEdges.size ( ), edge } );
+
+    vEdges.push_back ( peEdge );
+}
+
+size_t CCsrDependencyGraph::GetMemoryUsage ( void ) const noexcept
+{
+    return m_vNodeFlags.capacity ( )      * sizeof(BYTE)          +
+           m_vOffsets.capacity ( )        * sizeof(EDGE_OFFSET_T) +
+           m_vEdges.capacity ( )          * sizeof(PACKED_EDGE_T) +
+           m_vEscapedEdges.capacity ( )   * sizeof(ESCAPED_EDGE)  +
+           m_vInOffsets.capacity ( )      * sizeof(EDGE_OFFSET_T) +
+           m_vInEdges.capacity ( )        * sizeof(PACKED_EDGE_T) +
+           m_vInEscapedEdges.capacity ( ) * sizeof(ESCAPED_EDGE);
+}
+
+QWORD CCsrDependencyGraph::GetContentHash ( void ) const noexcept
+{
+    // seeded with the file signature, so as not to be mistaken for
+    // the hash of other content
+    CContentHash hash ( GRAPH_FILE_MAGIC );
+
+    hash.Add ( m_nNumNodes );
+    hash.AddBytes ( m_vNodeFlags.data ( ), m_vNodeFlags.size ( ) );
+
+    // the offsets delimit each node's edges, which would otherwise be
+    // indistinguishable from those of its neighbours
+    for ( std::vector<EDGE_OFFSET_T>::const_iterator it = m_vOffsets.begin ( ); it != m_vOffsets.end ( ); ++it )
+        hash.Add ( *it );
+
+    // each edge is hashed as decoded, however it is packed
+    for ( size_t nSrc = 0; nSrc < m_vNodeFlags.size ( ); nSrc++ )
+    {
+        for ( size_t i = static_cast<size_t>(m_vOffsets[nSrc]); i < m_vOffsets[nSrc + 1]; i++ )
+        {
+            const CDirectedEdgeData edge = GetEdge ( i, static_cast<NODE_ID_T>(nSrc), false );
+
+            hash.Add ( (static_cast<QWORD>(edge.GetDestNodeID ( )) << 32) | static_cast<DWORD>(edge.GetWeight ( )) );
+        }
+    }
+
+    return hash.GetHash ( );
+}
+
+bool CCsrDependencyGraph::TopologicalSort ( std::vector<NODE_ID_T>& vOrder ) const
+{
+    vOrder.clear ( );
+
+    // a cyclic graph has already been found to have no topological order
+    if ( HasReverseIndex ( ) == false || IsAcyclic ( ) == false )
+        return false;
+
+    const size_t nCapacity = m_vNodeFlags.size ( );
+
+    vOrder.reserve ( m_nNumNodes );
+
+    // count the unordered dependencies of each node, those nodes having
+    // none may be ordered immediately
+    std::vector<DWORD> vRemaining ( nCapacity, 0 );
+
+    for ( size_t nSrc = 0; nSrc < nCapacity; nSrc++ )
+    {
+        if ( (m_vNodeFlags[nSrc] & NF_VALID) == 0 )
+            continue;
+
+        for ( size_t i = static_cast<size_t>(m_vOffsets[nSrc]); i < m_vOffsets[nSrc + 1]; i++ )
+        {
+            const NODE_ID_T idDest = GetDestNodeID ( i, static_cast<NODE_ID_T>(nSrc) );
+
+            if ( idDest != nSrc && HasNode ( idDest ) )
+                vRemaining[nSrc]++;
+        }
+
+        if ( vRemaining[nSrc] == 0 )
+            vOrder.push_back ( static_cast<NODE_ID_T>(nSrc) );
+    }
+
+    // the ordered nodes double as the work queue, ordering a node releases
+    // each of the nodes depending upon it
+    for ( size_t nPos = 0; nPos < vOrder.size ( ); nPos++ )
+    {
+        const size_t nNode = static_cast<size_t>(vOrder[nPos]);
+
+        for ( size_t i = static_cast<size_t>(m_vInOffsets[nNode]); i < m_vInOffsets[nNode + 1]; i++ )
+        {
+            const NODE_ID_T idSrc = GetEdge ( i, static_cast<NODE_ID_T>(nNode), true ).GetDestNodeID ( );
+
+            if ( idSrc != nNode && --vRemaining[idSrc] == 0 )
+                vOrder.push_back ( idSrc );
+        }
+    }
+
+    // a dependency cycle leaves some nodes impossible to order
+    return vOrder.size ( ) == m_nNumNodes;
+}
+
+size_t CCsrDependencyGraph::FindCycleEdges ( void )
+{
+    /// depth first search state of a node
+    enum DFS_STATE : BYTE { DFS_UNVISITED = 0, DFS_ON_STACK, DFS_FINISHED };
+
+    /// explicit stack frame, replacing the recursion of a conventional search
+    struct DFS_FRAME
+    {
+        NODE_ID_T       idNode;  ///< node being searched
+        EDGE_OFFSET_T   nNext;   ///< offset of its next 'out' edge to follow
+    };
+
+    std::vector<GRAPH_EDGE>().swap ( m_vCycleEdges );
+
+    const size_t nCapacity = m_vNodeFlags.size ( );
+
+    std::vector<BYTE>      vState ( nCapacity, DFS_UNVISITED );
+    std::vector<DFS_FRAME> vStack;
+
+    for ( size_t nRoot = 0; nRoot < nCapacity; nRoot++ )
+    {
+        if ( (m_vNodeFlags[nRoot] & NF_VALID) == 0 || vState[nRoot] != DFS_UNVISITED )
+            continue;
+
+        vState[nRoot] = DFS_ON_STACK;
+        vStack.push_back ( DFS_FRAME { static_cast<NODE_ID_T>(nRoot), m_vOffsets[nRoot] } );
+
+        while ( vStack.empty ( ) == false )
+        {
+            DFS_FRAME& frame = vStack.back ( );
+
+            if ( frame.nNext == m_vOffsets[frame.idNode + 1] )
+            {
+                // every dependency of this node has been searched
+                vState[frame.idNode] = DFS_FINISHED;
+                vStack.pop_back ( );
+                continue;
+            }
+
+            const NODE_ID_T idFrom = frame.idNode;
+            const NODE_ID_T idTo   = GetDestNodeID ( static_cast<size_t>(frame.nNext++), idFrom );
+
+            if ( HasNode ( idTo ) == false )
+                continue;
+
+            if ( vState[idTo] == DFS_ON_STACK )
+            {
+                // an edge back to a node still being searched closes a cycle
+                m_vCycleEdges.push_back ( GRAPH_EDGE { idFrom, idTo } );
+            }
+            else if ( vState[idTo] == DFS_UNVISITED )
+            {
+                vState[idTo] = DFS_ON_STACK;
+                vStack.push_back ( DFS_FRAME { idTo, m_vOffsets[idTo] } );
+            }
+        }
+    }
+
+    return m_vCycleEdges.size ( );
+}
+
+void CCsrDependencyGraph::Clear ( void ) noexcept
+{
+    m_nNumNodes = 0;
+
+    // swap with empty containers to actually release the memory
+    std::vector<BYTE>().swap ( m_vNodeFlags );
+    std::vector<EDGE_OFFSET_T>(1, 0).swap ( m_vOffsets );
+    std::vector<PACKED_EDGE_T>().swap ( m_vEdges );
+    std::vector<ESCAPED_EDGE>().swap ( m_vEscapedEdges );
+    std::vector<EDGE_OFFSET_T>().swap ( m_vInOffsets );
+    std::vector<PACKED_EDGE_T>().swap ( m_vInEdges );
+    std::vector<ESCAPED_EDGE>().swap ( m_vInEscapedEdges );
+    std::vector<GRAPH_EDGE>().swap ( m_vCycleEdges );
+}
+
+bool CCsrDependencyGraph::Save ( const TCHAR* szFileName ) const noexcept
+{
+    // the file format is defined as little-endian, and is written as a
+    // direct image of memory
+    if ( IsLittleEndian ( ) == false )
+        return false;
+
+    bool bReturn = false;
+
+    FILE* pFile = _tfopen ( szFileName, _T("wb") );
+
+    if ( pFile != nullptr )
+    {
+        GRAPH_FILE_HEADER hdr = { };
+
+        hdr.dwMagic        = GRAPH_FILE_MAGIC;
+        hdr.dwByteOrder    = GRAPH_FILE_BYTE_ORDER;
+        hdr.dwVersion      = GRAPH_FILE_VERSION;
+        hdr.qwNodeCapacity = m_vNodeFlags.size ( );
+        hdr.qwNumNodes     = m_nNumNodes;
+        hdr.qwNumEdges     = m_vEdges.size ( );
+
+        const BYTE   Padding[GRAPH_FILE_ALIGNMENT] = { 0 };
+        const size_t nPadding     = GetSectionPadding ( m_vNodeFlags.size ( ) );
+        const size_t nEdgePadding = GetSectionPadding ( m_vEdges.size ( ) * sizeof(PACKED_EDGE_T) );
+        const QWORD  qwNumEscaped = m_vEscapedEdges.size ( );
+
+        bReturn = (fwrite ( &hdr, sizeof(hdr), 1, pFile ) == 1) &&
+                  (fwrite ( m_vNodeFlags.data ( ), 1, m_vNodeFlags.size ( ), pFile ) == m_vNodeFlags.size ( )) &&
+                  (fwrite ( Padding, 1, nPadding, pFile ) == nPadding) &&
+                  (fwrite ( m_vOffsets.data ( ), sizeof(EDGE_OFFSET_T), m_vOffsets.size ( ), pFile ) == m_vOffsets.size ( )) &&
+                  (fwrite ( m_vEdges.data ( ), sizeof(PACKED_EDGE_T), m_vEdges.size ( ), pFile ) == m_vEdges.size ( )) &&
+                  (fwrite ( Padding, 1, nEdgePadding, pFile ) == nEdgePadding) &&
+                  (fwrite ( &qwNumEscaped, sizeof(qwNumEscaped), 1, pFile ) == 1) &&
+                  (fwrite ( m_vEscapedEdges.data ( ), sizeof(ESCAPED_EDGE), m_vEscapedEdges.size ( ), pFile ) == m_vEscapedEdges.size ( ));
+
+        if ( fclose ( pFile ) != 0 )
+            bReturn = false;
+    }
+
+    return bReturn;
+}
+
+bool CCsrDependencyGraph::Load ( const TCHAR* szFileName, bool bReverseIndex ) noexcept
+{
+    Clear ( );
+
+    if ( IsLittleEndian ( ) == false )
+        return false;
+
+    bool bReturn = false;
+
+    FILE* pFile = _tfopen ( szFileName, _T("rb") );
+
+    if ( pFile != nullptr )
+    {
+        GRAPH_FILE_HEADER hdr = { };
+
+        if ( (fread ( &hdr, sizeof(hdr), 1, pFile ) == 1) &&
+             IsValidFileHeader ( hdr, GetFileSize ( pFile ) ) )
+        {
+            const size_t nCapacity = static_cast<size_t>(hdr.qwNodeCapacity);
+            const size_t nNumEdges = static_cast<size_t>(hdr.qwNumEdges);
+            const size_t nPadding  = GetSectionPadding ( nCapacity );
+
+            BYTE Padding[GRAPH_FILE_ALIGNMENT] = { 0 };
+
+            m_vNodeFlags.resize ( nCapacity );
+            m_vOffsets.resize ( nCapacity + 1 );
+
+            bReturn = (fread ( m_vNodeFlags.data ( ), 1, nCapacity, pFile ) == nCapacity) &&
+                      (fread ( Padding, 1, nPadding, pFile ) == nPadding) &&
+                      (fread ( m_vOffsets.data ( ), sizeof(EDGE_OFFSET_T), nCapacity + 1, pFile ) == nCapacity + 1);
+
+            // verify the offsets are consistent with the edge data, so that
+            // malformed input can not lead to out-of-bounds access later on.
+            if ( bReturn )
+            {
+                bReturn = (m_vOffsets[0] == 0) && (m_vOffsets[nCapacity] == nNumEdges);
+
+                for ( size_t i = 0; bReturn && i < nCapacity; i++ )
+                {
+                    bReturn = (m_vOffsets[i] <= m_vOffsets[i + 1]);
+                }
+            }
+
+            if ( bReturn )
+            {
+                if ( hdr.dwVersion == GRAPH_FILE_VERSION )
+                    bReturn = ReadPackedEdges ( pFile, nNumEdges );
+                else
+                    bReturn = ReadUnpackedEdges ( pFile, nNumEdges );
+            }
+
+            m_nNumNodes = static_cast<size_t>(hdr.qwNumNodes);
+        }
+
+        fclose ( pFile );
+    }
+
+    if ( bReturn )
+    {
+        if ( bReverseIndex )
+            BuildReverseIndex ( );
+
+        FindCycleEdges ( );
+    }
+    else
+    {
+        Clear ( );
+    }
+
+    return bReturn;
+}
+
+bool CCsrDependencyGraph::ReadPackedEdges ( FILE* pFile, size_t nNumEdges ) noexcept
+{
+    const size_t nPadding     = GetSectionPadding ( nNumEdges * sizeof(PACKED_EDGE_T) );
+    QWORD        qwNumEscaped = 0;
+
+    BYTE Padding[GRAPH_FILE_ALIGNMENT] = { 0 };
+
+    m_vEdges.resize ( nNumEdges );
+
+    bool bReturn = (fread ( m_vEdges.data ( ), sizeof(PACKED_EDGE_T), nNumEdges, pFile ) == nNumEdges) &&
+                   (fread ( Padding, 1, nPadding, pFile ) == nPadding) &&
+                   (fread ( &qwNumEscaped, sizeof(qwNumEscaped), 1, pFile ) == 1) &&
+                   (qwNumEscaped <= nNumEdges);
+
+    // the escaped edge records must likewise lie within the file
+    if ( bReturn )
+    {
+        const long long nPos = _ftelli64 ( pFile );
+
+        bReturn = (nPos >= 0) &&
+                  (qwNumEscaped <= (GetFileSize ( pFile ) - static_cast<QWORD>(nPos)) / sizeof(ESCAPED_EDGE));
+    }
+
+    if ( bReturn )
+    {
+        const size_t nNumEscaped = static_cast<size_t>(qwNumEscaped);
+
+        m_vEscapedEdges.resize ( nNumEscaped );
+
+        bReturn = (fread ( m_vEscapedEdges.data ( ), sizeof(ESCAPED_EDGE), nNumEscaped, pFile ) == nNumEscaped);
+
+        // every escaped edge must be marked as such, in ascending order, so
+        // that each mark is certain to be found by its lookup
+        for ( size_t i = 0; bReturn && i < nNumEscaped; i++ )
+        {
+            const EDGE_OFFSET_T qwIndex = m_vEscapedEdges[i].qwIndex;
+
+            bReturn = (qwIndex < nNumEdges) &&
+                      ((i == 0) || (m_vEscapedEdges[i - 1].qwIndex < qwIndex)) &&
+                      (IsEscaped ( m_vEdges[static_cast<size_t>(qwIndex)] ));
+        }
+
+        size_t nNumMarked = 0;
+
+        for ( size_t i = 0; bReturn && i < nNumEdges; i++ )
+        {
+            if ( IsEscaped ( m_vEdges[i] ) )
+                nNumMarked++;
+        }
+
+        bReturn = bReturn && (nNumMarked == nNumEscaped);
+    }
+
+    return bReturn;
+}
+
+bool CCsrDependencyGraph::ReadUnpackedEdges ( FILE* pFile, size_t nNumEdges ) noexcept
+{
+    std::vector<CDirectedEdgeData> vChunk ( std::min ( nNumEdges, READ_CHUNK_EDGES ) );
+
+    m_vEdges.reserve ( nNumEdges );
+
+    bool   bReturn = true;
+    size_t nNode   = 0;
+
+    while ( bReturn && m_vEdges.size ( ) < nNumEdges )
+    {
+        const size_t nNumRead = std::min ( nNumEdges - m_vEdges.size ( ), vChunk.size ( ) );
+
+        bReturn = (fread ( vChunk.data ( ), sizeof(CDirectedEdgeData), nNumRead, pFile ) == nNumRead);
+
+        for ( size_t i = 0; bReturn && i < nNumRead; i++ )
+        {
+            // the offsets have been validated, locating the source of each edge
+            while ( m_vOffsets[nNode + 1] <= m_vEdges.size ( ) )
+                nNode++;
+
+            AppendEdge ( static_cast<NODE_ID_T>(nNode), vChunk[i], false, m_vEdges, m_vEscapedEdges );
+        }
+    }
+
+    return bReturn;
+}
+
+bool CCsrDependencyGraph::IsBinaryGraphFile ( const TCHAR* szFileName ) noexcept
+{
+    bool bReturn = false;
+
+    FILE* pFile = _tfopen ( szFileName, _T("rb") );
+
+    if ( pFile != nullptr )
+    {
+        DWORD dwMagic = 0;
+
+        bReturn = (fread ( &dwMagic, sizeof(dwMagic), 1, pFile ) == 1) &&
+                  (dwMagic == GRAPH_FILE_MAGIC);
+
+        fclose ( pFile );
+    }
+
+    return bReturn;
+}
+
+bool CCsrDependencyGraph::IsValidFileHeader ( const GRAPH_FILE_HEADER& hdr, QWORD qwFileSize ) noexcept
+{
+    if ( (hdr.dwMagic     != GRAPH_FILE_MAGIC)                                                     ||
+         (hdr.dwByteOrder != GRAPH_FILE_BYTE_ORDER)                                                ||
+         ((hdr.dwVersion  != GRAPH_FILE_VERSION) && (hdr.dwVersion != GRAPH_FILE_VERSION_UNPACKED)) ||
+         (hdr.qwNodeCapacity >= INVALID_NODE_ID)                                                   ||
+         (hdr.qwNumNodes  >  hdr.qwNodeCapacity) )
+        return false;
+
+    const bool  bPacked    = (hdr.dwVersion == GRAPH_FILE_VERSION);
+    const QWORD qwEdgeSize = bPacked ? sizeof(PACKED_EDGE_T) : sizeof(CDirectedEdgeData);
+
+    // the node capacity is bounded, so the node sections can not overflow
+    QWORD qwSize = sizeof(GRAPH_FILE_HEADER) + hdr.qwNodeCapacity +
+                   GetSectionPadding ( static_cast<size_t>(hdr.qwNodeCapacity) ) +
+                   (hdr.qwNodeCapacity + 1) * sizeof(EDGE_OFFSET_T);
+
+    // the edge count is unbounded, so it is tested before it is multiplied
+    if ( (qwSize > qwFileSize) || (hdr.qwNumEdges > (qwFileSize - qwSize) / qwEdgeSize) )
+        return false;
+
+    const QWORD qwEdgeBytes = hdr.qwNumEdges * qwEdgeSize;
+
+    qwSize += qwEdgeBytes;
+
+    // a packed file is followed by its padding and escaped edge count
+    if ( bPacked )
+        qwSize += GetSectionPadding ( static_cast<size_t>(qwEdgeBytes) ) + sizeof(QWORD);
+
+    return (qwSize <= qwFileSize);
+}
+
+QWORD CCsrDependencyGraph::GetFileSize ( FILE* pFile ) noexcept
+{
+    QWORD qwReturn = 0;
+
+    const long long nPos = _ftelli64 ( pFile );
+
+    if ( (nPos >= 0) && (_fseeki64 ( pFile, 0, SEEK_END ) == 0) )
+    {
+        const long long nSize = _ftelli64 ( pFile );
+
+        if ( nSize >= 0 )
+            qwReturn = static_cast<QWORD>(nSize);
+
+        if ( _fseeki64 ( pFile, nPos, SEEK_SET ) != 0 )
+            qwReturn = 0;
+    }
+
+    return qwReturn;
+}
@@ -0,0 +1,856 @@
+/**
+* @file       CsrDependencyGraph.h
+* @brief      CCsrDependencyGraph class interface
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  Once a dependency graph has been completely loaded it is no longer modified,
+*  so it may be "frozen" into a Compressed Sparse Row (CSR) representation:
+*  - an offset array, containing for each node the index of its first 'out'
+*    edge, with one additional trailing entry denoting the total edge count
+*  - a contiguous array of edge data, grouped by source node, and ordered by
+*    destination node ID within each group
+*
+*  This eliminates the per-edge heap allocation of the red-black tree based
+*  adjacency sets, and affords cache-friendly sequential traversals.
+*
+*  As the dependencies of a trace are local, each edge is packed into a
+*  single 32-bit word relative to the node it belongs to, rather than held
+*  as a CDirectedEdgeData:
+*  - the low 24 bits hold the signed distance from the node to the other
+*    end of the edge, measured back from the source node for an 'out' edge,
+*    and forward from the destination node for an 'in' edge
+*  - the high 8 bits hold the signed difference between the edge weight and
+*    that distance, 0 for every edge of a trace, whose weights are the
+*    dependency distances themselves
+*  An edge whose distance or weight does not fit is escaped, its packed word
+*  marking it as one of the few edges held in full in a separate table,
+*  ordered by edge offset.  The edges are decoded on the fly by the edge
+*  iterators, halving the memory they occupy.
+*
+*  Optionally, a reverse (or 'in' edge) index of the same form is built at
+*  freeze time, such that the set of instructions depending upon a given
+*  instruction may be found in O(degree) rather than by scanning every node.
+*
+*  As CDependencyGraph accepts any pair of nodes as an edge, the frozen graph
+*  is validated to be acyclic at freeze (or load) time, by way of an iterative
+*  depth first search whose explicit stack is bounded by the node count.  The
+*  edges closing a dependency cycle are retained for reporting, such that the
+*  analyses of a graph found to be acyclic need no defensive checks of their own.
+*  @sa http://en.wikipedia.org/wiki/Sparse_matrix#Compressed_sparse_row_.28CSR.2C_CRS_or_Yale_format.29
+*/
+#pragma once
+
+#if !defined(_CSR_DEPENDENCY_GRAPH_H__)
+#define _CSR_DEPENDENCY_GRAPH_H__
+
+#ifndef _DEPENDENCY_GRAPH_H__
+    #include "DependencyGraph.h"
+#endif
+
+#ifndef _VECTOR_
+    #include <vector>
+#endif
+
+#ifndef _ALGORITHM_
+    #include <algorithm>
+#endif
+
+/// node flag used to denote the node has been added to the graph
+constexpr BYTE NF_VALID       = 0x01;
+/// node flag bits containing the node's IC_INSTRUCTION_CLASS
+constexpr BYTE NF_CLASS_MASK  = 0xF0;
+/// bit position of the instruction class within the node flags
+constexpr BYTE NF_CLASS_SHIFT = 4;
+
+/// offset type used to index into the contiguous edge arrays
+typedef QWORD EDGE_OFFSET_T;
+
+/// binary graph file signature, reads as "IPDG" in a hex dump
+constexpr DWORD GRAPH_FILE_MAGIC      = 0x47445049;
+/// used to detect a byte order mismatch
+constexpr DWORD GRAPH_FILE_BYTE_ORDER = 0x01020304;
+/// current binary graph file format version, holding packed edges
+constexpr DWORD GRAPH_FILE_VERSION    = 2;
+/// binary graph file format version holding a CDirectedEdgeData per edge
+constexpr DWORD GRAPH_FILE_VERSION_UNPACKED = 1;
+/// alignment of each section within the binary graph file
+constexpr size_t GRAPH_FILE_ALIGNMENT = 8;
+
+/**
+    @brief Calculates the padding needed to align a binary graph file section
+
+    @param [in] nSize   size of the section in bytes
+
+    @retval size_t      number of pad bytes to follow the section
+*/
+constexpr size_t GetSectionPadding(size_t nSize) noexcept
+{
+    return (GRAPH_FILE_ALIGNMENT - (nSize % GRAPH_FILE_ALIGNMENT)) % GRAPH_FILE_ALIGNMENT;
+}
+
+/**
+    @retval true    if this platform stores values in little-endian order,
+                    that of the binary graph file
+*/
+inline bool IsLittleEndian(void) noexcept
+{
+    const DWORD dwProbe = 1;
+    return *reinterpret_cast<const BYTE*>(&dwProbe) == 1;
+}
+
+/// an edge packed relative to the node it belongs to
+typedef DWORD PACKED_EDGE_T;
+
+/// packed edge bits holding the signed distance to the other end of the edge
+constexpr DWORD PE_DISTANCE_BITS = 24;
+/// mask of the distance bits of a packed edge
+constexpr DWORD PE_DISTANCE_MASK = (1u << PE_DISTANCE_BITS) - 1;
+/// distance bits of an escaped edge, being the one distance never packed
+constexpr DWORD PE_ESCAPE        = 1u << (PE_DISTANCE_BITS - 1);
+/// greatest distance a packed edge holds, and the negation of the least
+constexpr int   PE_MAX_DISTANCE  = static_cast<int>(PE_ESCAPE) - 1;
+/// greatest difference between weight and distance a packed edge holds
+constexpr int   PE_MAX_RESIDUAL  = 127;
+/// least difference between weight and distance a packed edge holds
+constexpr int   PE_MIN_RESIDUAL  = -128;
+
+/**
+    @brief An edge too wide to be packed, held in full
+*/
+struct ESCAPED_EDGE
+{
+    EDGE_OFFSET_T       qwIndex;    ///< offset of the edge within its edge array
+    CDirectedEdgeData   edge;       ///< the edge itself
+
+    /// orders escaped edges by offset
+    constexpr bool operator<(const ESCAPED_EDGE& rhs) const noexcept
+    { return qwIndex < rhs.qwIndex; };
+};
+
+/**
+    @brief Binary graph file header
+*/
+struct GRAPH_FILE_HEADER
+{
+    DWORD   dwMagic;         ///< must be GRAPH_FILE_MAGIC
+    DWORD   dwByteOrder;     ///< must be GRAPH_FILE_BYTE_ORDER
+    DWORD   dwVersion;       ///< file format version
+    DWORD   dwReserved;      ///< reserved, must be 0
+    QWORD   qwNodeCapacity;  ///< number of node ID slots
+    QWORD   qwNumNodes;      ///< number of valid nodes
+    QWORD   qwNumEdges;      ///< number of edges
+};
+
+/**
+    @brief A directed edge, identified by both of its end-points
+*/
+struct GRAPH_EDGE
+{
+    NODE_ID_T   idFrom;      ///< source node ID, i.e. the dependent node
+    NODE_ID_T   idTo;        ///< destination node ID
+};
+
+class CCsrDependencyGraph;
+class CEdgeListBuilder;
+
+/**
+    @brief Iterates over the packed edges of a frozen graph node, decoding
+           each one as it is dereferenced
+*/
+class CCsrEdgeIterator
+{
+    const CCsrDependencyGraph* m_pGraph;  ///< owning graph
+    size_t                     m_nIndex;  ///< offset of the current edge
+    NODE_ID_T                  m_idNode;  ///< node the edges are packed relative to
+    bool                       m_bIn;     ///< iterating over 'in' edges
+    mutable CDirectedEdgeData  m_Edge;    ///< the current edge, once decoded
+
+public:
+    /// Default Constructor
+    constexpr CCsrEdgeIterator() noexcept
+        : m_pGraph(nullptr),
+          m_nIndex(0),
+          m_idNode(INVALID_NODE_ID),
+          m_bIn   (false),
+          m_Edge  ()
+    { };
+
+    /// Initialization Constructor
+    constexpr CCsrEdgeIterator(const CCsrDependencyGraph* pGraph, size_t nIndex, NODE_ID_T idNode, bool bIn) noexcept
+        : m_pGraph(pGraph),
+          m_nIndex(nIndex),
+          m_idNode(idNode),
+          m_bIn   (bIn),
+          m_Edge  ()
+    { };
+
+    inline const CDirectedEdgeData& operator*(void) const noexcept;
+
+    const CDirectedEdgeData* operator->(void) const noexcept
+    { return &**this; };
+
+    CCsrEdgeIterator& operator++(void) noexcept
+    {
+        ++m_nIndex;
+        return *this;
+    };
+
+    bool operator==(const CCsrEdgeIterator& rhs) const noexcept
+    { return m_nIndex == rhs.m_nIndex; };
+
+    bool operator!=(const CCsrEdgeIterator& rhs) const noexcept
+    { return m_nIndex != rhs.m_nIndex; };
+};
+
+/**
+    @brief A read-only view of a frozen graph node.
+
+    CCsrGraphNode affords the same query interface as CGraphNode, with
+    its 'out' edges residing in a contiguous range of the owning
+    CCsrDependencyGraph edge array.
+*/
+class CCsrGraphNode
+{
+    const CCsrDependencyGraph* m_pGraph;  ///< owning graph
+    size_t                     m_nIndex;  ///< this node's index within the graph
+
+public:
+    typedef CCsrEdgeIterator            const_iterator;
+
+    /// Default Constructor
+    constexpr CCsrGraphNode() noexcept
+        : m_pGraph(nullptr),
+          m_nIndex(0)
+    { };
+
+    /// Initialization Constructor
+    constexpr CCsrGraphNode(const CCsrDependencyGraph* pGraph, size_t nIndex) noexcept
+        : m_pGraph(pGraph),
+          m_nIndex(nIndex)
+    { };
+
+/**
+    @brief Retrieves this object's node ID
+
+    @retval NODE_ID_T       the current node ID
+    @retval INVALID_NODE_ID if node is vacant
+*/
+    inline NODE_ID_T GetNodeID(void) const noexcept;
+
+/**
+    @brief Used to check to see if node is active.
+
+    @retval true    if node has been added to the graph
+    @retval false   if node is vacant
+*/
+    inline bool IsValid(void) const noexcept;
+
+/**
+    @brief Retrieves the class of the associated instruction
+
+    @retval IC_INSTRUCTION_CLASS    the instruction class
+*/
+    inline IC_INSTRUCTION_CLASS GetClass(void) const noexcept;
+
+/**
+    @brief Retrieves number of 'out' edges originating from this node
+
+    @retval size_t  current number of edges
+*/
+    inline size_t GetNumEdges(void) const noexcept;
+
+/**
+    @brief Affords iterator functionality
+
+    @retval const_iterator iterator for beginning of
+                           non-mutable edge sequence
+*/
+    inline const_iterator beginEdge(void) const noexcept;
+
+/**
+    @brief Affords iterator functionality
+
+    @retval const_iterator iterator for end of non-mutable
+                           edge sequence
+*/
+    inline const_iterator endEdge(void) const noexcept;
+
+/**
+    @brief Test if given edge exists.
+
+    Performs a binary search over this node's ordered edge range.
+
+    @param [in] idToNode    target node
+
+    @retval true        if there exists an edge from this node
+                        to target node
+    @retval false       if target node or edge is not found
+*/
+    bool HasEdge(const NODE_ID_T& idToNode) const noexcept;
+
+/**
+    @brief Retrieves number of 'in' edges terminating at this node
+
+    This is the number of nodes which depend upon this node.
+
+    @retval size_t  current number of 'in' edges
+    @retval 0       if the reverse index was not built
+*/
+    inline size_t GetNumInEdges(void) const noexcept;
+
+/**
+    @brief Affords reverse iterator functionality
+
+    Each 'in' edge's GetDestNodeID() denotes the source node of
+    the edge, i.e. the dependent node, ordered by node ID.
+
+    @retval const_iterator iterator for beginning of
+                           non-mutable 'in' edge sequence, equal to
+                           endInEdge() if the reverse index was not built
+*/
+    inline const_iterator beginInEdge(void) const noexcept;
+
+/**
+    @brief Affords reverse iterator functionality
+
+    @retval const_iterator iterator for end of non-mutable
+                           'in' edge sequence
+*/
+    inline const_iterator endInEdge(void) const noexcept;
+};
+
+/**
+    @brief A frozen, read-only directed acyclic graph implementation
+
+    The CCsrDependencyGraph class is built from a fully loaded CDependencyGraph,
+    or CEdgeListBuilder, and stores its adjacency data in CSR form.  Edge data
+    for node 'n' is located in the range [m_vOffsets[n], m_vOffsets[n + 1])
+    of m_vEdges, packed relative to 'n'.
+*/
+class CCsrDependencyGraph
+{
+    size_t                          m_nNumNodes;   ///< current number of nodes
+    std::vector<BYTE>               m_vNodeFlags;  ///< per-node flags, indexed by node ID
+    std::vector<EDGE_OFFSET_T>      m_vOffsets;    ///< per-node offset of first edge
+    std::vector<PACKED_EDGE_T>      m_vEdges;      ///< contiguous packed 'out' edges
+    std::vector<ESCAPED_EDGE>       m_vEscapedEdges; ///< 'out' edges too wide to be packed
+    std::vector<EDGE_OFFSET_T>      m_vInOffsets;  ///< per-node offset of first 'in' edge
+    std::vector<PACKED_EDGE_T>      m_vInEdges;    ///< contiguous packed 'in' edges
+    std::vector<ESCAPED_EDGE>       m_vInEscapedEdges; ///< 'in' edges too wide to be packed
+    std::vector<GRAPH_EDGE>         m_vCycleEdges; ///< edges closing a dependency cycle
+
+    friend class CCsrGraphNode;
+    friend class CCsrEdgeIterator;
+
+public:
+
+    /**
+        @brief Affords read-only iteration over the graph nodes
+
+        The iterator yields CCsrGraphNode views, and as such supports
+        the same usage as CDependencyGraph::const_iterator.
+    */
+    class const_iterator
+    {
+        const CCsrDependencyGraph* m_pGraph;  ///< graph being iterated
+        size_t                     m_nIndex;  ///< index of the current node
+        CCsrGraphNode              m_Node;    ///< view of the current node
+
+    public:
+        /// Initialization Constructor
+        constexpr const_iterator(const CCsrDependencyGraph* pGraph, size_t nIndex) noexcept
+            : m_pGraph(pGraph),
+              m_nIndex(nIndex),
+              m_Node  (pGraph, nIndex)
+        { };
+
+        const CCsrGraphNode& operator*(void) const noexcept
+        { return m_Node; };
+
+        const CCsrGraphNode* operator->(void) const noexcept
+        { return &m_Node; };
+
+        const_iterator& operator++(void) noexcept
+        {
+            m_Node = CCsrGraphNode(m_pGraph, ++m_nIndex);
+            return *this;
+        };
+
+        bool operator==(const const_iterator& rhs) const noexcept
+        { return m_nIndex == rhs.m_nIndex; };
+
+        bool operator!=(const const_iterator& rhs) const noexcept
+        { return m_nIndex != rhs.m_nIndex; };
+    };
+
+    /// Default Constructor
+    CCsrDependencyGraph() noexcept;
+
+    /**
+        @brief Initialization Constructor
+
+        @param [in] dag             fully loaded graph to be frozen
+        @param [in] bReverseIndex   if true, the 'in' edge index is also built
+    */
+    explicit CCsrDependencyGraph(const CDependencyGraph& dag, bool bReverseIndex = true) noexcept;
+
+    /// Default Destructor
+    ~CCsrDependencyGraph() = default;
+
+    /**
+        @brief Builds the CSR representation from a mutable graph
+
+        Any previously frozen content is discarded.
+
+        @param [in] dag             fully loaded graph to be frozen
+        @param [in] bReverseIndex   if true, the 'in' edge index is also built
+
+        @retval size_t      the number of edges frozen
+    */
+    size_t Freeze(const CDependencyGraph& dag, bool bReverseIndex = true) noexcept;
+
+    /**
+        @brief Builds the CSR representation from a bulk edge list
+
+        The builder's edges are sorted in place, and the adjacency arrays
+        emitted in a single pass over them.  Any previously frozen content
+        is discarded.  Should the adjacency arrays not fit in memory,
+        std::bad_alloc is thrown and the graph must be cleared for reuse.
+
+        @param [in,out] builder     fully loaded edge list to be frozen
+        @param [in] bReverseIndex   if true, the 'in' edge index is also built
+
+        @retval size_t      the number of edges frozen
+    */
+    size_t Freeze(CEdgeListBuilder& builder, bool bReverseIndex = true);
+
+    /**
+        @brief Builds the 'in' edge index from the frozen 'out' edges
+
+        The index is built in a single counting pass, in O(V + E).
+    */
+    void   BuildReverseIndex(void);
+
+    /**
+        @retval true    if the 'in' edge index has been built
+    */
+    bool   HasReverseIndex(void) const noexcept
+    {
+        return m_vInOffsets.size() == m_vOffsets.size();
+    };
+
+    /**
+        @retval true    if the graph contains no dependency cycles
+    */
+    bool   IsAcyclic(void) const noexcept
+    {
+        return m_vCycleEdges.empty();
+    };
+
+    /**
+        @brief Retrieves the edges found to close a dependency cycle
+
+        These are the back edges of a depth first search, such that every
+        cycle contains at least one of them, and removing all of them would
+        leave the graph acyclic.  A dependency of a node upon itself is
+        reported as well.
+
+        @retval std::vector<GRAPH_EDGE>&    the offending edges, empty if acyclic
+    */
+    const std::vector<GRAPH_EDGE>& GetCycleEdges(void) const noexcept
+    {
+        return m_vCycleEdges;
+    };
+
+    /**
+        @brief Orders the nodes topologically, by way of Kahn's algorithm
+
+        Every node is preceded by the nodes it depends upon, i.e. the
+        destinations of its 'out' edges.  Dependencies of a node upon
+        itself, or upon nodes not in the graph, are disregarded.  The
+        sort is performed in O(V + E), and requires the reverse index.
+
+        @param [out] vOrder     node IDs in topological order
+
+        @retval true            if every node has been ordered
+        @retval false           if the graph contains a dependency cycle,
+                                or lacks its reverse index
+    */
+    bool   TopologicalSort(std::vector<NODE_ID_T>& vOrder) const;
+
+    /**
+        @brief Computes a hash of the graph content
+
+        The hash covers the node ID range, the class of each node, and the
+        destination and weight of each edge, such that graphs frozen from
+        the same trace, or loaded from its binary graph file, hash alike.
+        It is computed in O(V + E).
+
+        @retval QWORD       64-bit content hash
+    */
+    QWORD  GetContentHash(void) const noexcept;
+
+private:
+    /**
+        @brief Searches the graph for the edges closing a dependency cycle
+
+        The search is performed in O(V + E), and updates m_vCycleEdges.
+
+        @retval size_t      the number of offending edges found
+    */
+    size_t FindCycleEdges(void);
+
+public:
+
+    /**
+        @brief Saves the frozen graph to a binary graph file
+
+        @param [in] szFileName  name of the file to be written
+
+        @retval true            on success
+        @retval false           on error
+    */
+    bool   Save(const TCHAR* szFileName) const noexcept;
+
+    /**
+        @brief Loads a binary graph file
+
+        Each array is read in a single block, no parsing or per-edge
+        allocation is involved.  A file of the earlier unpacked format
+        is packed as it is read.  Any previously frozen content is
+        discarded.
+
+        @param [in] szFileName      name of the file to be read
+        @param [in] bReverseIndex   if true, the 'in' edge index is also built
+
+        @retval true            on success
+        @retval false           if the file could not be read or was
+                                found to be malformed
+    */
+    bool   Load(const TCHAR* szFileName, bool bReverseIndex = true) noexcept;
+
+    /**
+        @brief Tests if a file carries the binary graph file signature
+
+        @param [in] szFileName  name of the file to be probed
+
+        @retval true            if the file is a binary graph file
+    */
+    static bool IsBinaryGraphFile(const TCHAR* szFileName) noexcept;
+
+    /**
+        @brief Validates a binary graph file header, and the size of the
+               file against the sections it describes
+
+        The sections are sized by the node capacity and edge count of the
+        header alone, so these are checked against the file before any
+        section is allocated for, lest a malformed header exhaust memory.
+
+        @param [in] hdr         header read from the file
+        @param [in] qwFileSize  size of the whole file, in bytes
+
+        @retval true            if the header is valid, and the file is
+                                large enough to hold every section
+    */
+    static bool IsValidFileHeader(const GRAPH_FILE_HEADER& hdr, QWORD qwFileSize) noexcept;
+
+    /**
+        @brief Determines the size of an open file, preserving its position
+
+        @param [in] pFile       file to be measured
+
+        @retval QWORD           size of the file in bytes, 0 on error
+    */
+    static QWORD GetFileSize(FILE* pFile) noexcept;
+
+    /**
+        @brief Releases all graph content
+    */
+    void   Clear(void) noexcept;
+
+    /**
+        @brief Retrieves the current number of nodes in the graph
+
+        @retval size_t      the number of nodes (or vertices) in the graph
+    */
+    constexpr size_t GetNumNodes(void) const noexcept
+    {
+        return m_nNumNodes;
+    };
+
+    /**
+        @brief Retrieves the current number of edges in the graph
+
+        @retval size_t      the number of edges (or arcs) in the graph
+    */
+    size_t GetNumEdges(void) const noexcept
+    {
+        return m_vEdges.size();
+    };
+
+    /**
+        @brief Retrieves the number of 'out' edges too wide to be packed
+
+        @retval size_t      the number of escaped edges
+    */
+    size_t GetNumEscapedEdges(void) const noexcept
+    {
+        return m_vEscapedEdges.size();
+    };
+
+    /**
+        @brief Retrieves the memory occupied by the nodes and edges
+
+        @retval size_t      bytes held by the node, offset and edge arrays
+    */
+    size_t GetMemoryUsage(void) const noexcept;
+
+    /**
+        @brief Tests whether a packed edge is held in full in the escaped
+               edge table instead
+
+        @param [in] peEdge      packed edge
+
+        @retval true            if the edge is escaped
+    */
+    static constexpr bool IsEscaped(PACKED_EDGE_T peEdge) noexcept
+    { return (peEdge & PE_DISTANCE_MASK) == PE_ESCAPE; };
+
+    /**
+        @brief Decodes a packed edge which is not escaped
+
+        @param [in] idNode      node the edge belongs to
+        @param [in] peEdge      packed edge
+        @param [in] bIn         true for an 'in' edge
+
+        @retval CDirectedEdgeData   the edge
+    */
+    static inline CDirectedEdgeData UnpackEdge(NODE_ID_T idNode, PACKED_EDGE_T peEdge, bool bIn) noexcept;
+
+    /**
+        @brief  Affords the ability to query for the
+                existence of a particular graph node
+
+        @param [in] idNode  target node ID
+        @retval true        if idNode is found in the graph
+    */
+    bool   HasNode(const NODE_ID_T& idNode) const noexcept
+    {
+        return (idNode < m_vNodeFlags.size()) && (m_vNodeFlags[idNode] & NF_VALID);
+    };
+
+    /**
+        @brief Retrieves a view of the requested node
+
+        @param [in] idNode  target node ID, presumed to be less
+                            than GetNodeCapacity()
+
+        @retval CCsrGraphNode   read-only view of the node
+    */
+    CCsrGraphNode GetNode(const NODE_ID_T& idNode) const noexcept
+    {
+        return CCsrGraphNode(this, static_cast<size_t>(idNode));
+    };
+
+    /**
+        @brief Retrieves the extent of the node ID range
+
+        @retval size_t      one past the highest node ID slot
+    */
+    size_t GetNodeCapacity(void) const noexcept
+    {
+        return m_vNodeFlags.size();
+    };
+
+    /**
+        @brief Affords iteration functionality
+
+        @retval const_iterator iterator for beginning of nonmutable
+                               sequence
+    */
+    const_iterator begin(void) const noexcept
+    {
+        return const_iterator(this, 0);
+    };
+
+    /**
+        @brief Affords iteration functionality
+
+        @retval const_iterator iterator for end of nonmutable
+                               sequence
+    */
+    const_iterator end(void) const noexcept
+    {
+        return const_iterator(this, m_vNodeFlags.size());
+    };
+
+private:
+    /**
+        @brief Packs an edge relative to the node it belongs to
+
+        @param [in] idNode      node the edge belongs to
+        @param [in] edge        the edge, whose destination is the other end
+        @param [in] bIn         true for an 'in' edge, whose other end is
+                                the dependent node
+        @param [out] peEdge     receives the packed edge
+
+        @retval true            if the edge could be packed
+        @retval false           if the edge must be escaped
+    */
+    static bool PackEdge(NODE_ID_T idNode, const CDirectedEdgeData& edge, bool bIn, PACKED_EDGE_T& peEdge) noexcept;
+
+    /**
+        @brief Appends an edge to an edge array, escaping it if need be
+
+        @param [in] idNode          node the edge belongs to
+        @param [in] edge            the edge
+        @param [in] bIn             true for an 'in' edge
+        @param [in,out] vEdges      packed edge array
+        @param [in,out] vEscaped    escaped edges of vEdges
+    */
+    static void AppendEdge(NODE_ID_T idNode, const CDirectedEdgeData& edge, bool bIn,
+                           std::vector<PACKED_EDGE_T>& vEdges, std::vector<ESCAPED_EDGE>& vEscaped);
+
+    /**
+        @brief Decodes an edge
+
+        @param [in] nIndex      offset of the edge within its edge array
+        @param [in] idNode      node the edge belongs to
+        @param [in] bIn         true for an 'in' edge
+
+        @retval CDirectedEdgeData   the edge
+    */
+    inline CDirectedEdgeData GetEdge(size_t nIndex, NODE_ID_T idNode, bool bIn) const noexcept;
+
+    /**
+        @brief Decodes the destination of an 'out' edge
+
+        @param [in] nIndex      offset of the edge
+        @param [in] idNode      source node of the edge
+
+        @retval NODE_ID_T       the destination node ID
+    */
+    NODE_ID_T GetDestNodeID(size_t nIndex, NODE_ID_T idNode) const noexcept
+    {
+        return GetEdge(nIndex, idNode, false).GetDestNodeID();
+    };
+
+    /**
+        @brief Reads the packed and escaped edges of a binary graph file
+
+        @param [in] pFile       file positioned past the offset array
+        @param [in] nNumEdges   number of edges held by the file
+
+        @retval true            on success
+        @retval false           if the edges could not be read or were
+                                found to be malformed
+    */
+    bool ReadPackedEdges(FILE* pFile, size_t nNumEdges) noexcept;
+
+    /**
+        @brief Reads the CDirectedEdgeData of an unpacked binary graph
+               file, packing each against the validated offset array
+
+        @param [in] pFile       file positioned past the offset array
+        @param [in] nNumEdges   number of edges held by the file
+
+        @retval true            on success
+        @retval false           if the edges could not be read
+    */
+    bool ReadUnpackedEdges(FILE* pFile, size_t nNumEdges) noexcept;
+
+    /// copy constructor
+    CCsrDependencyGraph(const CCsrDependencyGraph& o) = delete;
+
+    /// assignment operator
+    CCsrDependencyGraph& operator=(const CCsrDependencyGraph& rhs) = delete;
+};
+
+inline NODE_ID_T CCsrGraphNode::GetNodeID(void) const noexcept
+{
+    return IsValid() ? static_cast<NODE_ID_T>(m_nIndex) : INVALID_NODE_ID;
+}
+
+inline bool CCsrGraphNode::IsValid(void) const noexcept
+{
+    return (m_pGraph->m_vNodeFlags[m_nIndex] & NF_VALID) != 0;
+}
+
+inline IC_INSTRUCTION_CLASS CCsrGraphNode::GetClass(void) const noexcept
+{
+    return static_cast<IC_INSTRUCTION_CLASS>((m_pGraph->m_vNodeFlags[m_nIndex] & NF_CLASS_MASK) >> NF_CLASS_SHIFT);
+}
+
+inline size_t CCsrGraphNode::GetNumEdges(void) const noexcept
+{
+    return static_cast<size_t>(m_pGraph->m_vOffsets[m_nIndex + 1] - m_pGraph->m_vOffsets[m_nIndex]);
+}
+
+inline CCsrGraphNode::const_iterator CCsrGraphNode::beginEdge(void) const noexcept
+{
+    return const_iterator(m_pGraph, static_cast<size_t>(m_pGraph->m_vOffsets[m_nIndex]), static_cast<NODE_ID_T>(m_nIndex), false);
+}
+
+inline CCsrGraphNode::const_iterator CCsrGraphNode::endEdge(void) const noexcept
+{
+    return const_iterator(m_pGraph, static_cast<size_t>(m_pGraph->m_vOffsets[m_nIndex + 1]), static_cast<NODE_ID_T>(m_nIndex), false);
+}
+
+inline size_t CCsrGraphNode::GetNumInEdges(void) const noexcept
+{
+    return m_pGraph->HasReverseIndex() ? 
+           static_cast<size_t>(m_pGraph->m_vInOffsets[m_nIndex + 1] - m_pGraph->m_vInOffsets[m_nIndex]) : 0;
+}
+
+inline CCsrGraphNode::const_iterator CCsrGraphNode::beginInEdge(void) const noexcept
+{
+    return m_pGraph->HasReverseIndex() ? 
+           const_iterator(m_pGraph, static_cast<size_t>(m_pGraph->m_vInOffsets[m_nIndex]), static_cast<NODE_ID_T>(m_nIndex), true) :
+           const_iterator();
+}
+
+inline CCsrGraphNode::const_iterator CCsrGraphNode::endInEdge(void) const noexcept
+{
+    return m_pGraph->HasReverseIndex() ? 
+           const_iterator(m_pGraph, static_cast<size_t>(m_pGraph->m_vInOffsets[m_nIndex + 1]), static_cast<NODE_ID_T>(m_nIndex), true) :
+           const_iterator();
+}
+
+inline CDirectedEdgeData CCsrDependencyGraph::GetEdge(size_t nIndex, NODE_ID_T idNode, bool bIn) const noexcept
+{
+    const PACKED_EDGE_T peEdge = bIn ? m_vInEdges[nIndex] : m_vEdges[nIndex];
+
+    if ( IsEscaped(peEdge) )
+    {
+        const std::vector<ESCAPED_EDGE>& vEscaped = bIn ? m_vInEscapedEdges : m_vEscapedEdges;
+
+        // every escaped edge has an entry, so the search never fails
+        const ESCAPED_EDGE escKey = { static_cast<EDGE_OFFSET_T>(nIndex), CDirectedEdgeData() };
+
+        return std::lower_bound(vEscaped.begin(), vEscaped.end(), escKey)->edge;
+    }
+
+    return UnpackEdge(idNode, peEdge, bIn);
+}
+
+inline CDirectedEdgeData CCsrDependencyGraph::UnpackEdge(NODE_ID_T idNode, PACKED_EDGE_T peEdge, bool bIn) noexcept
+{
+    // sign extend each field
+    const int iDistance = static_cast<int>((peEdge & PE_DISTANCE_MASK) ^ PE_ESCAPE) - static_cast<int>(PE_ESCAPE);
+    const int iResidual = (static_cast<int>(peEdge >> PE_DISTANCE_BITS) ^ 0x80) - 0x80;
+
+    const NODE_ID_T idOther = bIn ? idNode + static_cast<NODE_ID_T>(iDistance) : idNode - static_cast<NODE_ID_T>(iDistance);
+
+    return CDirectedEdgeData(idOther, iDistance + iResidual);
+}
+
+inline const CDirectedEdgeData& CCsrEdgeIterator::operator*(void) const noexcept
+{
+    m_Edge = m_pGraph->GetEdge(m_nIndex, m_idNode, m_bIn);
+    return m_Edge;
+}
+
+#endif
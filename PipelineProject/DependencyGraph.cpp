@@ -9,7 +9,7 @@
 
 #include "stdafx.h"
 #include "DependencyGraph.h"
-#include <locale>
+#include <new>
 
 
 bool CGraphNode::AddEdge ( const NODE_ID_T& idToNode, int iWeight )
@@ -37,28 +37,76 @@ bool CGraphNode::AddEdge ( const CDirectedEdgeData& edge )
 constexpr size_t DEFAULT_MAX_NODES = 10;
 
 CDependencyGraph::CDependencyGraph ( ) noexcept
-    : m_nMaxNodes(DEFAULT_MAX_NODES), 
-      m_nNumNodes(0),
-      m_vNodes(DEFAULT_MAX_NODES)
+    : m_nNumNodes(0),
+      m_pArena(),
+      m_vNodes(),
+      m_vChangeLog(),
+      m_qwLogBase(0),
+      m_bLogChanges(false)
 {
+    m_vNodes.reserve(DEFAULT_MAX_NODES);
 }
 
 CDependencyGraph::CDependencyGraph ( size_t nMaxNodes ) noexcept
-    : m_nMaxNodes(nMaxNodes), 
-      m_nNumNodes(0),
-      m_vNodes(nMaxNodes)
+    : m_nNumNodes(0),
+      m_pArena(),
+      m_vNodes(),
+      m_vChangeLog(),
+      m_qwLogBase(0),
+      m_bLogChanges(false)
 {
+    m_vNodes.reserve(nMaxNodes);
 }
 
-bool CDependencyGraph::AddNode ( const NODE_ID_T& idNode ) noexcept
+CDependencyGraph::CDependencyGraph ( GA_GRAPH_ALLOCATION gaAllocation ) noexcept
+    : m_nNumNodes(0),
+      m_pArena( (gaAllocation == GA_ARENA) ? std::make_unique<std::pmr::monotonic_buffer_resource>(DEFAULT_ARENA_BLOCK_SIZE)
+                                           : nullptr ),
+      m_vNodes( (gaAllocation == GA_ARENA) ? m_pArena.get() : std::pmr::get_default_resource() ),
+      m_vChangeLog(),
+      m_qwLogBase(0),
+      m_bLogChanges(false)
+{
+    m_vNodes.reserve(DEFAULT_MAX_NODES);
+}
+
+void CDependencyGraph::Clear ( void ) noexcept
+{
+    // the nodes are destroyed while their memory resource remains intact,
+    // the vector keeping the resource it was constructed with
+    m_vNodes = NODE_VECTOR_T(m_vNodes.get_allocator());
+    m_nNumNodes = 0;
+
+    ClearChangeLog();
+
+    // then the arena is emptied in a single release
+    if ( m_pArena != nullptr )
+        m_pArena->release();
+}
+
+bool CDependencyGraph::AddNode ( const NODE_ID_T& idNode )
 {
     bool bReturn = false;
 
     size_t nNodeIndex = GetNodeIndex(idNode);
 
-    // check to make sure index is not out of bounds of our vector
-    if ( IsValidNodeIndex(nNodeIndex) )
+    if ( nNodeIndex != INVALID_NODE_INDEX )
     {
+        // grow the vector to accommodate the new node, any intervening
+        // slots remain vacant until their node is added.  A node ID too
+        // large to be accommodated fails the add, rather than the process.
+        if ( IsValidNodeIndex(nNodeIndex) == false )
+        {
+            try
+            {
+                m_vNodes.resize(nNodeIndex + 1);
+            }
+            catch ( const std::bad_alloc& )
+            {
+                return false;
+            }
+        }
+
         // check to make sure we have not already added this node
         if ( m_vNodes[nNodeIndex].IsValid() == false )
         {
@@ -68,13 +116,15 @@ bool CDependencyGraph::AddNode ( const NODE_ID_T& idNode ) noexcept
             m_vNodes[nNodeIndex].SetNodeID(idNode);
             m_nNumNodes++;
             bReturn = true;
+
+            LogChange(GC_ADD_NODE, idNode, INVALID_NODE_ID, 0);
         }
     }
 
     return bReturn;
 }
 
-bool CDependencyGraph::AddEdge ( const NODE_ID_T& idFromNode, const NODE_ID_T& idToNode, int iWeight ) noexcept
+bool CDependencyGraph::AddEdge ( const NODE_ID_T& idFromNode, const NODE_ID_T& idToNode, int iWeight )
 {
     bool bReturn = false;
 
@@ -85,53 +135,93 @@ bool CDependencyGraph::AddEdge ( const NODE_ID_T& idFromNode, const NODE_ID_T& i
 
         if ( IsValidNodeIndex(nIndex) )
             bReturn = m_vNodes[nIndex].AddEdge (idToNode, iWeight);
-    }
 
+        if ( bReturn )
+            LogChange(GC_ADD_EDGE, idFromNode, idToNode, iWeight);
+    }
 
     return bReturn;
 }
 
 
-size_t CDependencyGraph::GetNumEdges ( void ) const noexcept
+bool CDependencyGraph::SetNodeClass ( const NODE_ID_T& idNode, IC_INSTRUCTION_CLASS icClass )
 {
-    size_t nNumEdges = 0;
+    bool bReturn = false;
 
-    // following static cast added to address compiler warning
-    for (size_t i = 0; i < m_nMaxNodes; i++)
+    if ( HasNode(idNode) )
     {
-        nNumEdges += m_vNodes[i].GetNumEdges();
+        m_vNodes[GetNodeIndex(idNode)].SetClass(icClass);
+        bReturn = true;
+
+        LogChange(GC_SET_CLASS, idNode, INVALID_NODE_ID, icClass);
     }
 
-    return nNumEdges;
+    return bReturn;
 }
 
-bool    CDependencyGraph::IsValidNodeID ( const NODE_ID_T& idNode ) const noexcept
+bool CDependencyGraph::RemoveNode ( const NODE_ID_T& idNode )
 {
     bool bReturn = false;
-// we are only allowing up to 25 instructions, each represented by a char in
-// in the range of [a..y].  lets allow some flexibility by being case-insensitive.
-    if ( (idNode >= 'a' && idNode <= 'y') || (idNode >= 'A' && idNode <= 'Y') )
+
+    if ( HasNode(idNode) )
+    {
+        CGraphNode& node = m_vNodes[GetNodeIndex(idNode)];
+
+        // the edges are recorded as removed one at a time ahead of the node,
+        // so a reader of the log need never consult the graph
+        for ( CGraphNode::const_iterator it = node.beginEdge(); it != node.endEdge(); ++it )
+            LogChange(GC_REMOVE_EDGE, idNode, it->GetDestNodeID(), it->GetWeight());
+
+        node.Vacate();
+        m_nNumNodes--;
         bReturn = true;
 
+        LogChange(GC_REMOVE_NODE, idNode, INVALID_NODE_ID, 0);
+    }
+
     return bReturn;
 }
 
-/**
-    Following method performs a pseudo-hashing of the node ID to
-    determine the proper location of the Node in the vector
-*/
-size_t  CDependencyGraph::GetNodeIndex ( const NODE_ID_T& idNode ) const noexcept
+bool CDependencyGraph::RemoveEdge ( const NODE_ID_T& idFromNode, const NODE_ID_T& idToNode )
+{
+    bool bReturn = false;
+
+    if ( HasNode(idFromNode) )
+    {
+        CGraphNode& node = m_vNodes[GetNodeIndex(idFromNode)];
+
+        CGraphNode::const_iterator it = node.FindEdge(idToNode);
+
+        if ( it != node.endEdge() )
+        {
+            const int iWeight = it->GetWeight();
+
+            bReturn = node.RemoveEdge(idToNode);
+
+            LogChange(GC_REMOVE_EDGE, idFromNode, idToNode, iWeight);
+        }
+    }
+
+    return bReturn;
+}
+
+void CDependencyGraph::ClearChangeLog ( void ) noexcept
 {
-    size_t nReturn = INVALID_NODE_INDEX;
+    m_qwLogBase += m_vChangeLog.size();
+
+    std::vector<GRAPH_CHANGE>().swap(m_vChangeLog);
+}
 
-    if ( IsValidNodeID(idNode) )
+size_t CDependencyGraph::GetNumEdges ( void ) const noexcept
+{
+    size_t nNumEdges = 0;
+
+    for (size_t i = 0; i < m_vNodes.size(); i++)
     {
-        const std::locale& loc = std::locale();  // construct from the default locale
-        TCHAR cId = static_cast<TCHAR>(idNode);
-        nReturn   = std::tolower(cId, loc) - _T('a');
+        nNumEdges += m_vNodes[i].GetNumEdges();
     }
 
-    return nReturn;
+    return nNumEdges;
 }
 
 bool CDependencyGraph::HasNode(const NODE_ID_T& idNode) const noexcept
@@ -23,6 +23,12 @@
 *  - For each dependency between two instructions, create a corresponding edge in the 
 *    graph
 *  - This edge is directed : it goes from the earlier instruction to the later one
+*
+*  A graph may be edited after it has been built, by removing nodes and
+*  edges as well as adding them.  Every edit may be recorded in a change
+*  log, from which an analysis of the graph, such as CIncrementalAnalysis,
+*  brings itself up to date with work proportional to the edits, rather
+*  than to the size of the graph.
 */
 #pragma once
 
@@ -33,6 +39,14 @@
     #include "CommonDef.h"
 #endif
 
+#ifndef _MEMORY_
+    #include <memory>
+#endif
+
+#ifndef _MEMORY_RESOURCE_
+    #include <memory_resource>
+#endif
+
 #ifndef _SET_
     #include <set>
 #endif
@@ -42,9 +56,15 @@
 #endif
 
 
-typedef TCHAR        NODE_ID_T;
-/// Used to identify an active node
-constexpr NODE_ID_T  INVALID_NODE_ID = 0;
+/**
+    Node IDs are numeric and double as the node's offset within the
+    graph's node vector, affording direct indexing without any hashing.
+    Symbolic instruction names (i.e. 'A'..'Z') are mapped onto this
+    range by the input layer.
+*/
+typedef DWORD        NODE_ID_T;
+/// Used to identify an inactive node
+constexpr NODE_ID_T  INVALID_NODE_ID = static_cast<NODE_ID_T>(-1);
 
 /**
   @brief Maintains directed edge data properties.
@@ -138,6 +158,29 @@ public:
     { return m_idDestNode > rhs.m_idDestNode; };
 };
 
+/**
+    @brief Graph change types, as recorded in a change log
+*/
+typedef enum GC_CHANGE_TYPE : BYTE
+{
+    GC_ADD_NODE    = 0,  ///< a node was added
+    GC_REMOVE_NODE = 1,  ///< a node was removed, its edges having been removed first
+    GC_ADD_EDGE    = 2,  ///< an edge was added
+    GC_REMOVE_EDGE = 3,  ///< an edge was removed
+    GC_SET_CLASS   = 4   ///< the instruction class of a node was set
+} GC_CHANGE_TYPE_T;
+
+/**
+    @brief An entry of a graph change log
+*/
+struct GRAPH_CHANGE
+{
+    GC_CHANGE_TYPE  gcType;  ///< type of change
+    NODE_ID_T       idFrom;  ///< node changed, or the source node of an edge
+    NODE_ID_T       idTo;    ///< destination node of an edge, otherwise INVALID_NODE_ID
+    int             iValue;  ///< weight of an edge, or the instruction class set
+};
+
 /**
     @brief a directed graph node implementation.
     
@@ -145,33 +188,76 @@ public:
     as a set of CDirectedEdgeData elements representing the
     set of 'out' edges from this graph node, as a form of
     an adjacency list.
+
+    The edge set takes its memory from the allocator the node is
+    constructed with, which a CDependencyGraph node vector supplies
+    to each of its nodes.
  */
 class CGraphNode
 {
-    typedef std::set<CDirectedEdgeData>   EDGE_SET_T;
-    typedef EDGE_SET_T::_Pairib           _Pairib;
+    typedef std::pmr::set<CDirectedEdgeData>   EDGE_SET_T;
+    typedef std::pair<EDGE_SET_T::iterator, bool> _Pairib;
     
     NODE_ID_T            m_ID;        ///< this is the node value or ID
+    IC_INSTRUCTION_CLASS m_icClass;   ///< class of the associated instruction
     EDGE_SET_T           m_setEdges;  ///< this is a set of directed 'out' edges 
 
 public:
     typedef EDGE_SET_T::const_iterator    const_iterator;
+
+    /// allocator the edge set is constructed with
+    typedef std::pmr::polymorphic_allocator<CGraphNode> allocator_type;
     
     /// Default Constructor
     CGraphNode() noexcept
         : m_ID(INVALID_NODE_ID), 
+          m_icClass(IC_ALU),
           m_setEdges()
     { };
 
+    /// Allocator Constructor
+    explicit CGraphNode(const allocator_type& alloc) noexcept
+        : m_ID(INVALID_NODE_ID), 
+          m_icClass(IC_ALU),
+          m_setEdges(alloc)
+    { };
+
     /// Initialization Constructor
     CGraphNode(const NODE_ID_T& idNode) noexcept
         : m_ID(idNode), 
+          m_icClass(IC_ALU),
           m_setEdges()
     { };
 
     /// Default Destructor
     ~CGraphNode() = default;
 
+    /// copy constructor
+    CGraphNode(const CGraphNode& o) = default;
+
+    /// move constructor, keeps node vector growth from copying edge sets
+    CGraphNode(CGraphNode&& o) noexcept = default;
+
+    /// allocator-extended copy constructor
+    CGraphNode(const CGraphNode& o, const allocator_type& alloc)
+        : m_ID(o.m_ID), 
+          m_icClass(o.m_icClass),
+          m_setEdges(o.m_setEdges, alloc)
+    { };
+
+    /// allocator-extended move constructor
+    CGraphNode(CGraphNode&& o, const allocator_type& alloc) noexcept
+        : m_ID(o.m_ID), 
+          m_icClass(o.m_icClass),
+          m_setEdges(std::move(o.m_setEdges), alloc)
+    { };
+
+    /// assignment operator
+    CGraphNode& operator=(const CGraphNode& rhs) = default;
+
+    /// move assignment operator
+    CGraphNode& operator=(CGraphNode&& rhs) noexcept = default;
+
 /**
     @brief Sets this object's node ID
 
@@ -189,6 +275,22 @@ public:
     constexpr NODE_ID_T GetNodeID(void) const noexcept
     { return m_ID; };
 
+/**
+    @brief Sets the class of the associated instruction
+
+    @param [in] icSet      new instruction class to be set
+*/
+    void SetClass(IC_INSTRUCTION_CLASS icSet) noexcept
+    { m_icClass = icSet; };
+
+/**
+    @brief Retrieves the class of the associated instruction
+
+    @retval IC_INSTRUCTION_CLASS    the instruction class, IC_ALU by default
+*/
+    constexpr IC_INSTRUCTION_CLASS GetClass(void) const noexcept
+    { return m_icClass; };
+
 /**
     @brief Used to check to see if node is active.
 
@@ -233,6 +335,27 @@ public:
 */
     bool AddEdge(const CDirectedEdgeData& edge);
 
+/**
+    @brief Removes an edge from the graph
+
+    @param [in] idToNode    ID of the destination node
+
+    @retval true            if the edge was removed
+    @retval false           if no such edge exists
+*/
+    bool RemoveEdge(const NODE_ID_T& idToNode) noexcept
+    { return m_setEdges.erase( CDirectedEdgeData(idToNode) ) > 0; };
+
+/**
+    @brief Vacates the node, removing every edge from it
+*/
+    void Vacate(void) noexcept
+    {
+        m_setEdges.clear();
+        m_ID      = INVALID_NODE_ID;
+        m_icClass = IC_ALU;
+    };
+
 /**
     @brief Retrieves number of edges
 
@@ -271,6 +394,16 @@ public:
     const_iterator endEdge(void) const noexcept
     { return m_setEdges.end(); };
 
+/**
+    @brief Looks up the edge to a given node
+
+    @param [in] idToNode    target node
+
+    @retval const_iterator  the edge, endEdge() if not found
+*/
+    const_iterator FindEdge ( const NODE_ID_T& idToNode ) const
+    { return m_setEdges.find( CDirectedEdgeData(idToNode) ); };
+
 /**
     @brief Test if given edge exists.
 
@@ -290,6 +423,18 @@ public:
 /// used to provide a consistent index out-of-range result 
 constexpr size_t INVALID_NODE_INDEX = static_cast<size_t>(-1);
 
+/// size of the first block of an arena, later blocks growing geometrically
+constexpr size_t DEFAULT_ARENA_BLOCK_SIZE = 64 * 1024;
+
+/**
+    @brief Graph memory allocation modes
+*/
+typedef enum GA_GRAPH_ALLOCATION
+{
+    GA_HEAP  = 0,    ///< nodes and edges are individually allocated from the heap
+    GA_ARENA = 1     ///< nodes and edges are carved out of an arena owned by the graph
+} GA_GRAPH_ALLOCATION_T;
+
 /**
     @brief A directed acyclic graph implementation
 
@@ -299,16 +444,31 @@ constexpr size_t INVALID_NODE_INDEX = static_cast<size_t>(-1);
       implemented as a vector of sets.  A vector provides random access to the 
       node data and a set is implemented as a balanced red-black tree and 
       provides access to the edge end-point in O(log n) time complexity.
+    - a node ID is used directly as the index into the node vector, which
+      grows on demand as higher numbered nodes are added.
+
+    A graph constructed with GA_ARENA allocates its node vector and every
+    edge set node from a monotonic buffer it owns.  Adding an edge is then
+    a pointer bump rather than a heap allocation, and the memory of the
+    whole graph is released at once, by Clear or upon destruction, rather
+    than one edge at a time.  The arena never reuses memory before then,
+    which suits a graph that is built once, frozen and discarded.
 */
 class CDependencyGraph
 {
-    size_t                  m_nMaxNodes; ///< upper limit on nodes allowed
+    typedef std::pmr::vector<CGraphNode>                    NODE_VECTOR_T;
+
     size_t                  m_nNumNodes; ///< current number of nodes
-    std::vector<CGraphNode> m_vNodes;    ///< container of nodes contained in graph
+    std::unique_ptr<std::pmr::monotonic_buffer_resource>
+                            m_pArena;    ///< arena the graph is allocated from, if any
+    NODE_VECTOR_T           m_vNodes;    ///< container of nodes contained in graph
+    std::vector<GRAPH_CHANGE> m_vChangeLog; ///< changes recorded since the log was last cleared
+    QWORD                   m_qwLogBase; ///< sequence number of the first change in the log
+    bool                    m_bLogChanges; ///< changes are being recorded
 
 public:
 
-    typedef std::vector<CGraphNode>::const_iterator    const_iterator;
+    typedef NODE_VECTOR_T::const_iterator    const_iterator;
 
     /// Default Constructor
     CDependencyGraph() noexcept;
@@ -319,13 +479,21 @@ public:
         Optimized constructor to allow the pre-allocation
         of the underlying graph node vector.
 
-        @param [in] nMaxNodes   The potential number of nodes to be
+        @param [in] nMaxNodes   The expected number of nodes to be
                                 stored in the graph. This value is
-                                used to preallocate enough space
-                                in the vector.
+                                only used to reserve space in the 
+                                vector, it is not an upper limit.
     */
     CDependencyGraph(size_t nMaxNodes) noexcept;
 
+    /**
+        @brief Initialization Constructor
+
+        @param [in] gaAllocation    GA_ARENA to allocate the nodes and
+                                    edges from an arena owned by the graph
+    */
+    explicit CDependencyGraph(GA_GRAPH_ALLOCATION gaAllocation) noexcept;
+
     /// Default Destructor
     ~CDependencyGraph() = default;
     /**
@@ -334,13 +502,17 @@ public:
         @param [in] idNode      ID of the new node to be added
 
         @retval true            if successfully added
-        @retval false           if already exists or error
+        @retval false           if already exists, or the node table could
+                                not be grown to the node ID
     */
-    bool AddNode(const NODE_ID_T& idNode) noexcept;
+    bool AddNode(const NODE_ID_T& idNode);
 
     /**
         @brief Adds a directed edge between 2 existing nodes.
 
+        The edge set of the node, and any change log, throw std::bad_alloc
+        should they be unable to grow.
+
         @param [in] idFromNode  value of the source node ID
         @param [in] idToNode    value of the destination node ID
         @param [in] iWeight     value of Edge weight
@@ -348,7 +520,123 @@ public:
         @retval true            if successfully added
         @retval false           if already exists or error
     */
-    bool AddEdge(const NODE_ID_T& idFromNode, const NODE_ID_T& idToNode, int iWeight) noexcept;
+    bool AddEdge(const NODE_ID_T& idFromNode, const NODE_ID_T& idToNode, int iWeight);
+
+    /**
+        @brief Sets the instruction class of an existing node
+
+        @param [in] idNode      ID of the node
+        @param [in] icClass     instruction class to be set
+
+        @retval true            on success
+        @retval false           if the node does not exist
+    */
+    bool SetNodeClass(const NODE_ID_T& idNode, IC_INSTRUCTION_CLASS icClass);
+
+    /**
+        @brief Removes a node, along with every edge from it
+
+        Any edges to the node are retained, such that they refer to a
+        node not in the graph, just as an edge to a node yet to be added
+        does.  Should the node be added again, they will once again be
+        dependencies upon it.
+
+        @param [in] idNode      ID of the node to be removed
+
+        @retval true            if successfully removed
+        @retval false           if the node does not exist
+    */
+    bool RemoveNode(const NODE_ID_T& idNode);
+
+    /**
+        @brief Removes a directed edge
+
+        @param [in] idFromNode  value of the source node ID
+        @param [in] idToNode    value of the destination node ID
+
+        @retval true            if successfully removed
+        @retval false           if no such edge exists
+    */
+    bool RemoveEdge(const NODE_ID_T& idFromNode, const NODE_ID_T& idToNode);
+
+    /**
+        @brief Starts, or stops, recording changes in the change log
+
+        @param [in] bEnable     true to record every subsequent change
+    */
+    void EnableChangeLog(bool bEnable = true) noexcept
+    {
+        m_bLogChanges = bEnable;
+    };
+
+    /**
+        @brief Retrieves the changes recorded since the log was last cleared
+
+        The n-th entry has the sequence number GetChangeLogBase() + n.
+
+        @retval std::vector<GRAPH_CHANGE>&  changes, in the order made
+    */
+    const std::vector<GRAPH_CHANGE>& GetChangeLog(void) const noexcept
+    {
+        return m_vChangeLog;
+    };
+
+    /**
+        @brief Retrieves the sequence number of the first change in the log
+
+        Sequence numbers keep increasing across ClearChangeLog calls, so one
+        past that of the last change seen identifies the changes which have
+        been recorded since.
+
+        @retval QWORD       sequence number
+    */
+    constexpr QWORD GetChangeLogBase(void) const noexcept
+    {
+        return m_qwLogBase;
+    };
+
+    /**
+        @brief Retrieves the sequence number of the next change to be recorded
+
+        @retval QWORD       sequence number
+    */
+    QWORD GetChangeLogEnd(void) const noexcept
+    {
+        return m_qwLogBase + m_vChangeLog.size();
+    };
+
+    /**
+        @brief Discards every change recorded, releasing the associated memory
+    */
+    void ClearChangeLog(void) noexcept;
+
+    /**
+        @brief Reserves space for the expected number of nodes
+
+        @param [in] nNumNodes   number of nodes to reserve space for
+    */
+    void Reserve(size_t nNumNodes)
+    {
+        m_vNodes.reserve(nNumNodes);
+    };
+
+    /**
+        @brief Removes all nodes and edges, releasing the associated memory
+
+        The change log is cleared as well, the removals not being recorded.
+    */
+    void Clear(void) noexcept;
+
+    /**
+        @brief Determines whether the graph is allocated from an arena
+
+        @retval true        if constructed with GA_ARENA
+        @retval false       otherwise
+    */
+    bool UsesArena(void) const noexcept
+    {
+        return m_pArena != nullptr;
+    };
 
     /**
         @brief Retrieves the current number of nodes in the graph
@@ -375,6 +663,29 @@ public:
     */
     bool   HasNode(const NODE_ID_T& idNode) const noexcept;
 
+    /**
+        @brief Retrieves the requested node
+
+        @param [in] idNode  target node ID, presumed to be less
+                            than GetNodeCapacity()
+
+        @retval CGraphNode& the node, vacant if not in the graph
+    */
+    const CGraphNode& GetNode(const NODE_ID_T& idNode) const noexcept
+    {
+        return m_vNodes[static_cast<size_t>(idNode)];
+    };
+
+    /**
+        @brief Retrieves the extent of the node ID range
+
+        @retval size_t      one past the highest node ID slot
+    */
+    size_t GetNodeCapacity(void) const noexcept
+    {
+        return m_vNodes.size();
+    };
+
     /**
         @brief Affords iteration functionality
 
@@ -414,7 +725,10 @@ private:
         @retval true            if idNode is a valid ID
         @retval false           on invalid node ID
     */
-    bool    IsValidNodeID(const NODE_ID_T& idNode) const noexcept;
+    constexpr bool IsValidNodeID(const NODE_ID_T& idNode) const noexcept
+    {
+        return (idNode != INVALID_NODE_ID);
+    };
 
     /**
         @brief Performs basic validation of a node index.
@@ -428,24 +742,38 @@ private:
                                 vector range
         @retval false           if Index is found out-of-bounds
     */
-    constexpr bool    IsValidNodeIndex(size_t nIndex) const noexcept
+    bool    IsValidNodeIndex(size_t nIndex) const noexcept
     {
-        return (nIndex < m_nMaxNodes);
+        return (nIndex < m_vNodes.size());
     };
 
 /**
     @brief returns corresponding node index
 
-    Performs a basic hash-translation of the index of
-    the node from its associated ID. The returned index
-    corresponds to the nodes offset within the vector.
+    A node ID directly corresponds to the node's offset
+    within the vector, so no translation is required.
 
     @param [in] idNode          subject node ID
 
     @retval size_t              Index for idNode
     @retval INVALID_NODE_INDEX  if no valid Index exists
 */
-    size_t  GetNodeIndex    (const NODE_ID_T& idNode) const noexcept;
+    constexpr size_t GetNodeIndex(const NODE_ID_T& idNode) const noexcept
+    {
+        return IsValidNodeID(idNode) ? static_cast<size_t>(idNode) : INVALID_NODE_INDEX;
+    };
+
+    /**
+        @brief Records a change, if the change log is enabled
+
+        A change log unable to grow throws std::bad_alloc, the change
+        itself having already been made.
+    */
+    void LogChange(GC_CHANGE_TYPE gcType, const NODE_ID_T& idFrom, const NODE_ID_T& idTo, int iValue)
+    {
+        if ( m_bLogChanges )
+            m_vChangeLog.push_back( GRAPH_CHANGE { gcType, idFrom, idTo, iValue } );
+    };
 
     /// copy constructor
     CDependencyGraph(const CDependencyGraph& o) = delete;
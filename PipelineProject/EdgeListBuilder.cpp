@@ -0,0 +1,215 @@
+/**
+* @file       EdgeListBuilder.cpp
+* @brief      CEdgeListBuilder class implementation
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*/
+
+#include "stdafx.h"
+#include "EdgeListBuilder.h"
+#include <algorithm>
+
+/// bits of a node ID sorted by each radix sort pass
+constexpr DWORD  RADIX_BITS = 11;
+/// number of buckets of each radix sort pass
+constexpr size_t RADIX_SIZE = static_cast<size_t>(1) << RADIX_BITS;
+/// longest run of edges of a source sorted by insertion
+constexpr size_t MAX_INSERTION_SORT = 32;
+
+/**
+    @brief Determines the number of radix digits spanned by a node ID
+*/
+static DWORD GetNumDigits ( NODE_ID_T idMax ) noexcept
+{
+    DWORD dwReturn = 0;
+
+    for ( QWORD qwValue = idMax; qwValue > 0; qwValue >>= RADIX_BITS )
+        dwReturn++;
+
+    return dwReturn;
+}
+
+
+CEdgeListBuilder::CEdgeListBuilder ( ) noexcept
+    : m_nNumNodes  ( 0 ),
+      m_vNodeFlags ( ),
+      m_vTriples   ( ),
+      m_vScratch   ( )
+{
+}
+
+bool CEdgeListBuilder::AddNode ( const NODE_ID_T& idNode )
+{
+    if ( idNode == INVALID_NODE_ID )
+        return false;
+
+    if ( idNode >= m_vNodeFlags.size ( ) )
+        m_vNodeFlags.resize ( static_cast<size_t>(idNode) + 1, 0 );
+
+    if ( m_vNodeFlags[idNode] & NF_VALID )
+        return false;
+
+    m_vNodeFlags[idNode] = NF_VALID;
+    m_nNumNodes++;
+
+    return true;
+}
+
+bool CEdgeListBuilder::SetNodeClass ( const NODE_ID_T& idNode, IC_INSTRUCTION_CLASS icClass ) noexcept
+{
+    if ( HasNode ( idNode ) == false )
+        return false;
+
+    m_vNodeFlags[idNode] = static_cast<BYTE>(NF_VALID | (icClass << NF_CLASS_SHIFT));
+
+    return true;
+}
+
+size_t CEdgeListBuilder::AddEdges ( const EDGE_TRIPLE* pTriples, size_t nNumTriples )
+{
+    const size_t nFirst = m_vTriples.size ( );
+
+    m_vTriples.reserve ( nFirst + nNumTriples );
+
+    for ( size_t i = 0; i < nNumTriples; i++ )
+    {
+        if ( HasNode ( pTriples[i].idFrom ) && pTriples[i].idTo != INVALID_NODE_ID )
+            m_vTriples.push_back ( pTriples[i] );
+    }
+
+    return m_vTriples.size ( ) - nFirst;
+}
+
+void CEdgeListBuilder::Reserve ( size_t nNumNodes, size_t nNumEdges )
+{
+    m_vNodeFlags.reserve ( nNumNodes );
+    m_vTriples.reserve ( nNumEdges );
+}
+
+void CEdgeListBuilder::Clear ( void ) noexcept
+{
+    m_nNumNodes = 0;
+
+    std::vector<BYTE>().swap ( m_vNodeFlags );
+    std::vector<EDGE_TRIPLE>().swap ( m_vTriples );
+    std::vector<EDGE_TRIPLE>().swap ( m_vScratch );
+}
+
+void CEdgeListBuilder::SortEdges ( void )
+{
+    const size_t nNumTriples = m_vTriples.size ( );
+
+    NODE_ID_T idMaxFrom   = 0;
+    NODE_ID_T idMaxTo     = 0;
+    bool      bSorted     = true;
+    bool      bFromSorted = true;
+
+    // a trace lists its dependencies largely in order, in which case
+    // there is nothing left to be done
+    for ( size_t i = 0; i < nNumTriples; i++ )
+    {
+        const EDGE_TRIPLE& edge = m_vTriples[i];
+
+        idMaxFrom = (edge.idFrom > idMaxFrom) ? edge.idFrom : idMaxFrom;
+        idMaxTo   = (edge.idTo   > idMaxTo)   ? edge.idTo   : idMaxTo;
+
+        if ( i > 0 && bFromSorted )
+        {
+            const EDGE_TRIPLE& prev = m_vTriples[i - 1];
+
+            bFromSorted = (prev.idFrom <= edge.idFrom);
+            bSorted     = bSorted && bFromSorted && (prev.idFrom < edge.idFrom || prev.idTo <= edge.idTo);
+        }
+    }
+
+    if ( bSorted )
+        return;
+
+    // more often, each instruction's dependencies are listed together,
+    // leaving only the short run of edges of each source to be sorted
+    if ( bFromSorted )
+    {
+        auto IsLess = [] ( const EDGE_TRIPLE& lhs, const EDGE_TRIPLE& rhs ) noexcept
+        { return lhs.idTo < rhs.idTo; };
+
+        for ( size_t nFirst = 0, nLast = 0; nFirst < nNumTriples; nFirst = nLast )
+        {
+            for ( nLast = nFirst + 1; nLast < nNumTriples && m_vTriples[nLast].idFrom == m_vTriples[nFirst].idFrom; nLast++ )
+                ;
+
+            EDGE_TRIPLE* pFirst = m_vTriples.data ( ) + nFirst;
+            EDGE_TRIPLE* pLast  = m_vTriples.data ( ) + nLast;
+
+            if ( nLast - nFirst > MAX_INSERTION_SORT )
+            {
+                std::stable_sort ( pFirst, pLast, IsLess );
+                continue;
+            }
+
+            for ( EDGE_TRIPLE* pEdge = pFirst + 1; pEdge < pLast; pEdge++ )
+            {
+                const EDGE_TRIPLE edge = *pEdge;
+                EDGE_TRIPLE*      pHole = pEdge;
+
+                for ( ; pHole > pFirst && IsLess ( edge, pHole[-1] ); pHole-- )
+                    *pHole = pHole[-1];
+
+                *pHole = edge;
+            }
+        }
+
+        return;
+    }
+
+    m_vScratch.resize ( nNumTriples );
+
+    EDGE_TRIPLE* pSource = m_vTriples.data ( );
+    EDGE_TRIPLE* pTarget = m_vScratch.data ( );
+
+    size_t rgnCounts[RADIX_SIZE];
+
+    // the destination is the less significant key, so its digits come first
+    auto SortByKey = [&] ( NODE_ID_T EDGE_TRIPLE::* pKey, NODE_ID_T idMax )
+    {
+        const DWORD dwNumDigits = GetNumDigits ( idMax );
+
+        for ( DWORD dwDigit = 0; dwDigit < dwNumDigits; dwDigit++ )
+        {
+            const DWORD dwShift = dwDigit * RADIX_BITS;
+
+            std::fill ( rgnCounts, rgnCounts + RADIX_SIZE, 0 );
+
+            for ( size_t i = 0; i < nNumTriples; i++ )
+                rgnCounts[(pSource[i].*pKey >> dwShift) & (RADIX_SIZE - 1)]++;
+
+            // a digit shared by every edge leaves the order unchanged
+            if ( rgnCounts[(pSource[0].*pKey >> dwShift) & (RADIX_SIZE - 1)] == nNumTriples )
+                continue;
+
+            size_t nOffset = 0;
+
+            for ( size_t j = 0; j < RADIX_SIZE; j++ )
+            {
+                const size_t nCount = rgnCounts[j];
+
+                rgnCounts[j] = nOffset;
+                nOffset     += nCount;
+            }
+
+            for ( size_t i = 0; i < nNumTriples; i++ )
+                pTarget[rgnCounts[(pSource[i].*pKey >> dwShift) & (RADIX_SIZE - 1)]++] = pSource[i];
+
+            std::swap ( pSource, pTarget );
+        }
+    };
+
+    SortByKey ( &EDGE_TRIPLE::idTo, idMaxTo );
+    SortByKey ( &EDGE_TRIPLE::idFrom, idMaxFrom );
+
+    if ( pSource != m_vTriples.data ( ) )
+        m_vTriples.swap ( m_vScratch );
+
+    std::vector<EDGE_TRIPLE>().swap ( m_vScratch );
+}
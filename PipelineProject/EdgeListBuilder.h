@@ -0,0 +1,182 @@
+/**
+* @file       EdgeListBuilder.h
+* @brief      CEdgeListBuilder class interface
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  Bulk construction of a frozen graph, bypassing CDependencyGraph.  Edges
+*  are appended to a contiguous array of (source, destination, weight)
+*  triples, without any per-edge lookup or allocation beyond that of the
+*  array itself.  Once every edge has been added, CCsrDependencyGraph::Freeze:
+*  - radix sorts the triples by source, and by destination within a source
+*  - drops the duplicates in a single pass which emits the CSR adjacency
+*    arrays directly
+*
+*  The sort is stable, so of duplicate edges the first added is retained,
+*  and the frozen graph is identical to that of a CDependencyGraph built
+*  by adding the same nodes and edges one at a time.
+*/
+#pragma once
+
+#if !defined(_EDGE_LIST_BUILDER_H__)
+#define _EDGE_LIST_BUILDER_H__
+
+#ifndef _CSR_DEPENDENCY_GRAPH_H__
+    #include "CsrDependencyGraph.h"
+#endif
+
+#ifndef _VECTOR_
+    #include <vector>
+#endif
+
+/**
+    @brief A directed, weighted edge as added to a CEdgeListBuilder
+*/
+struct EDGE_TRIPLE
+{
+    NODE_ID_T   idFrom;      ///< source node ID, i.e. the dependent node
+    NODE_ID_T   idTo;        ///< destination node ID
+    int         iWeight;     ///< edge weight
+};
+
+/**
+    @brief Bulk frozen graph builder
+
+    The members accumulating nodes and edges throw std::bad_alloc should
+    their storage be exhausted, leaving the builder as it was before.
+*/
+class CEdgeListBuilder
+{
+    size_t                   m_nNumNodes;   ///< count of nodes added
+    std::vector<BYTE>        m_vNodeFlags;  ///< NF_xxx node flags, indexed by node ID
+    std::vector<EDGE_TRIPLE> m_vTriples;    ///< edges, in the order added until sorted
+    std::vector<EDGE_TRIPLE> m_vScratch;    ///< radix sort buffer
+
+public:
+    /// Default Constructor
+    CEdgeListBuilder() noexcept;
+
+    /// Default Destructor
+    ~CEdgeListBuilder() = default;
+
+/**
+    @brief Adds a new node
+
+    @param [in] idNode      ID of the new node to be added
+
+    @retval true            if successfully added
+    @retval false           if already exists or error
+*/
+    bool AddNode(const NODE_ID_T& idNode);
+
+/**
+    @brief Sets the instruction class of an existing node
+
+    @param [in] idNode      ID of the node
+    @param [in] icClass     instruction class to be set
+
+    @retval true            on success
+    @retval false           if the node does not exist
+*/
+    bool SetNodeClass(const NODE_ID_T& idNode, IC_INSTRUCTION_CLASS icClass) noexcept;
+
+/**
+    @brief Appends a directed edge
+
+    As with CDependencyGraph, the source node must already have been
+    added, whereas the destination node need not be.  Duplicates are only
+    detected, and dropped, once frozen.
+
+    @param [in] idFromNode  value of the source node ID
+    @param [in] idToNode    value of the destination node ID
+    @param [in] iWeight     value of Edge weight
+
+    @retval true            if appended
+    @retval false           if the source node does not exist, or the
+                            destination node ID is invalid
+*/
+    bool AddEdge(const NODE_ID_T& idFromNode, const NODE_ID_T& idToNode, int iWeight)
+    {
+        if ( HasNode ( idFromNode ) == false || idToNode == INVALID_NODE_ID )
+            return false;
+
+        m_vTriples.push_back ( EDGE_TRIPLE { idFromNode, idToNode, iWeight } );
+
+        return true;
+    };
+
+/**
+    @brief Appends a contiguous array of edges
+
+    @param [in] pTriples    the edges
+    @param [in] nNumTriples number of edges
+
+    @retval size_t          number of edges appended, those rejected by
+                            AddEdge being skipped
+*/
+    size_t AddEdges(const EDGE_TRIPLE* pTriples, size_t nNumTriples);
+
+/**
+    @brief Reserves space for the expected number of nodes and edges
+
+    @param [in] nNumNodes   number of nodes to reserve space for
+    @param [in] nNumEdges   number of edges to reserve space for
+*/
+    void Reserve(size_t nNumNodes, size_t nNumEdges);
+
+/**
+    @brief Removes all nodes and edges, releasing the associated memory
+*/
+    void Clear(void) noexcept;
+
+/**
+    @brief Determines whether a node has been added
+
+    @param [in] idNode      ID of the node
+
+    @retval true            if the node exists
+    @retval false           otherwise
+*/
+    bool HasNode(const NODE_ID_T& idNode) const noexcept
+    { return (idNode < m_vNodeFlags.size ( )) && (m_vNodeFlags[idNode] & NF_VALID); };
+
+/**
+    @brief Retrieves the number of nodes added
+
+    @retval size_t      count of nodes
+*/
+    constexpr size_t GetNumNodes(void) const noexcept
+    { return m_nNumNodes; };
+
+/**
+    @brief Retrieves the number of edges appended, duplicates included
+
+    @retval size_t      count of edges
+*/
+    size_t GetNumTriples(void) const noexcept
+    { return m_vTriples.size ( ); };
+
+private:
+    friend class CCsrDependencyGraph;
+
+/**
+    @brief Radix sorts the edges by source, then destination node ID
+
+    The sort is stable, either way.  If the edges were added grouped by
+    source, as a trace lists them, only each source's edges are sorted,
+    by insertion; otherwise an LSD radix sort is performed, skipping the
+    digits beyond the largest node ID.  It is bypassed altogether if the
+    edges were added in order.
+*/
+    void SortEdges(void);
+
+    /// copy constructor
+    CEdgeListBuilder(const CEdgeListBuilder& o) = delete;
+
+    /// assignment operator
+    CEdgeListBuilder& operator=(const CEdgeListBuilder& rhs) = delete;
+};
+
+#endif
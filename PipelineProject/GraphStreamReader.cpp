@@ -0,0 +1,205 @@
+/**
+* @file       GraphStreamReader.cpp
+* @brief      CGraphStreamReader class implementation
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*/
+
+#include "stdafx.h"
+#include "GraphStreamReader.h"
+#include <algorithm>
+
+
+CGraphStreamReader::CGraphStreamReader ( ) noexcept
+    : m_pFile         ( nullptr ),
+      m_hdr           ( ),
+      m_nFlagsPos     ( 0 ),
+      m_nOffsetsPos   ( 0 ),
+      m_nEdgesPos     ( 0 ),
+      m_nEscapedPos   ( 0 ),
+      m_qwNumEscaped  ( 0 ),
+      m_qwNextEscaped ( 0 ),
+      m_nNextNode     ( 0 ),
+      m_qwNextEdge    ( 0 ),
+      m_bFailed       ( false ),
+      m_vOffsets      ( ),
+      m_vPacked       ( )
+{
+}
+
+CGraphStreamReader::~CGraphStreamReader ( )
+{
+    Close ( );
+}
+
+bool CGraphStreamReader::Open ( const TCHAR* szFileName ) noexcept
+{
+    Close ( );
+
+    // the file format is defined as little-endian
+    if ( IsLittleEndian ( ) == false )
+        return false;
+
+    m_pFile = _tfopen ( szFileName, _T("rb") );
+
+    const QWORD qwFileSize = (m_pFile != nullptr) ? CCsrDependencyGraph::GetFileSize ( m_pFile ) : 0;
+
+    // the sections are checked against the file size, as each block is
+    // allocated for from its offsets
+    bool bReturn = (m_pFile != nullptr)                               &&
+                   (fread ( &m_hdr, sizeof(m_hdr), 1, m_pFile ) == 1) &&
+                   CCsrDependencyGraph::IsValidFileHeader ( m_hdr, qwFileSize );
+
+    if ( bReturn )
+    {
+        const size_t nCapacity = static_cast<size_t>(m_hdr.qwNodeCapacity);
+
+        m_nFlagsPos   = sizeof(m_hdr);
+        m_nOffsetsPos = m_nFlagsPos + static_cast<long long>(nCapacity + GetSectionPadding ( nCapacity ));
+        m_nEdgesPos   = m_nOffsetsPos + static_cast<long long>((nCapacity + 1) * sizeof(EDGE_OFFSET_T));
+
+        if ( m_hdr.dwVersion == GRAPH_FILE_VERSION )
+        {
+            const size_t nEdgeBytes = static_cast<size_t>(m_hdr.qwNumEdges) * sizeof(PACKED_EDGE_T);
+            const long long nCountPos = m_nEdgesPos + static_cast<long long>(nEdgeBytes + GetSectionPadding ( nEdgeBytes ));
+
+            m_nEscapedPos = nCountPos + static_cast<long long>(sizeof(m_qwNumEscaped));
+
+            bReturn = ReadAt ( nCountPos, &m_qwNumEscaped, sizeof(m_qwNumEscaped), 1 ) &&
+                      (m_qwNumEscaped <= m_hdr.qwNumEdges) &&
+                      (m_qwNumEscaped <= (qwFileSize - static_cast<QWORD>(m_nEscapedPos)) / sizeof(ESCAPED_EDGE));
+        }
+    }
+
+    if ( bReturn == false )
+        Close ( );
+
+    return bReturn;
+}
+
+void CGraphStreamReader::Close ( void ) noexcept
+{
+    if ( m_pFile != nullptr )
+        fclose ( m_pFile );
+
+    m_pFile         = nullptr;
+    m_hdr           = GRAPH_FILE_HEADER ( );
+    m_qwNumEscaped  = 0;
+    m_qwNextEscaped = 0;
+    m_nNextNode     = 0;
+    m_qwNextEdge    = 0;
+    m_bFailed       = false;
+
+    std::vector<EDGE_OFFSET_T>().swap ( m_vOffsets );
+    std::vector<PACKED_EDGE_T>().swap ( m_vPacked );
+}
+
+size_t CGraphStreamReader::ReadBlock ( GRAPH_STREAM_BLOCK& block, size_t nMaxNodes ) noexcept
+{
+    const size_t nCapacity = static_cast<size_t>(m_hdr.qwNodeCapacity);
+
+    if ( m_pFile == nullptr || m_bFailed || m_nNextNode >= nCapacity )
+        return 0;
+
+    const size_t nNumNodes = std::min ( std::max ( nMaxNodes, static_cast<size_t>(1) ), nCapacity - m_nNextNode );
+    const bool   bLast     = (m_nNextNode + nNumNodes == nCapacity);
+
+    block.idFirst = static_cast<NODE_ID_T>(m_nNextNode);
+    block.vFlags.resize ( nNumNodes );
+    block.vOffsets.resize ( nNumNodes + 1 );
+    m_vOffsets.resize ( nNumNodes + 1 );
+
+    bool bReturn = ReadAt ( m_nFlagsPos + static_cast<long long>(m_nNextNode), block.vFlags.data ( ), 1, nNumNodes ) &&
+                   ReadAt ( m_nOffsetsPos + static_cast<long long>(m_nNextNode * sizeof(EDGE_OFFSET_T)),
+                            m_vOffsets.data ( ), sizeof(EDGE_OFFSET_T), nNumNodes + 1 );
+
+    // verify the offsets continue on from the previous block, and are
+    // consistent with the edge count, before any edge is read
+    bReturn = bReturn && (m_vOffsets[0] == m_qwNextEdge) &&
+              (m_vOffsets[nNumNodes] <= m_hdr.qwNumEdges) &&
+              ((bLast == false) || (m_vOffsets[nNumNodes] == m_hdr.qwNumEdges));
+
+    for ( size_t i = 0; bReturn && i < nNumNodes; i++ )
+    {
+        bReturn = (m_vOffsets[i] <= m_vOffsets[i + 1]);
+    }
+
+    if ( bReturn )
+    {
+        const size_t nNumEdges = static_cast<size_t>(m_vOffsets[nNumNodes] - m_vOffsets[0]);
+
+        for ( size_t i = 0; i <= nNumNodes; i++ )
+            block.vOffsets[i] = m_vOffsets[i] - m_vOffsets[0];
+
+        block.vEdges.resize ( nNumEdges );
+
+        if ( m_hdr.dwVersion == GRAPH_FILE_VERSION )
+        {
+            m_vPacked.resize ( nNumEdges );
+
+            bReturn = ReadAt ( m_nEdgesPos + static_cast<long long>(m_vOffsets[0] * sizeof(PACKED_EDGE_T)),
+                               m_vPacked.data ( ), sizeof(PACKED_EDGE_T), nNumEdges ) &&
+                      DecodeEdges ( block );
+
+            // every escaped edge record must have been found in its place
+            bReturn = bReturn && ((bLast == false) || (m_qwNextEscaped == m_qwNumEscaped));
+        }
+        else
+        {
+            bReturn = ReadAt ( m_nEdgesPos + static_cast<long long>(m_vOffsets[0] * sizeof(CDirectedEdgeData)),
+                               block.vEdges.data ( ), sizeof(CDirectedEdgeData), nNumEdges );
+        }
+    }
+
+    if ( bReturn == false )
+    {
+        m_bFailed = true;
+        return 0;
+    }
+
+    m_nNextNode  += nNumNodes;
+    m_qwNextEdge  = m_vOffsets[nNumNodes];
+
+    return nNumNodes;
+}
+
+bool CGraphStreamReader::ReadAt ( long long nPos, void* pData, size_t nSize, size_t nCount ) noexcept
+{
+    return (_fseeki64 ( m_pFile, nPos, SEEK_SET ) == 0) &&
+           (fread ( pData, nSize, nCount, m_pFile ) == nCount);
+}
+
+bool CGraphStreamReader::DecodeEdges ( GRAPH_STREAM_BLOCK& block ) noexcept
+{
+    bool bReturn = true;
+
+    for ( size_t nNode = 0; bReturn && nNode + 1 < block.vOffsets.size ( ); nNode++ )
+    {
+        const NODE_ID_T idNode = block.idFirst + static_cast<NODE_ID_T>(nNode);
+
+        for ( size_t i = static_cast<size_t>(block.vOffsets[nNode]); bReturn && i < block.vOffsets[nNode + 1]; i++ )
+        {
+            if ( CCsrDependencyGraph::IsEscaped ( m_vPacked[i] ) )
+            {
+                // escaped edges are few, each record is read as it is reached
+                ESCAPED_EDGE escEdge = { };
+
+                bReturn = (m_qwNextEscaped < m_qwNumEscaped) &&
+                          ReadAt ( m_nEscapedPos + static_cast<long long>(m_qwNextEscaped * sizeof(ESCAPED_EDGE)),
+                                   &escEdge, sizeof(escEdge), 1 ) &&
+                          (escEdge.qwIndex == m_vOffsets[0] + i);
+
+                block.vEdges[i] = escEdge.edge;
+                m_qwNextEscaped++;
+            }
+            else
+            {
+                block.vEdges[i] = CCsrDependencyGraph::UnpackEdge ( idNode, m_vPacked[i], false );
+            }
+        }
+    }
+
+    return bReturn;
+}
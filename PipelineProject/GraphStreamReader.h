@@ -0,0 +1,165 @@
+/**
+* @file       GraphStreamReader.h
+* @brief      CGraphStreamReader class interface
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  Reads a binary graph file a block of nodes at a time, rather than into a
+*  CCsrDependencyGraph in its entirety, such that a trace of any length may
+*  be simulated in memory proportional to the block size alone.  As the
+*  edges of the file are grouped by source node, in node ID order, each
+*  block of nodes is accompanied by a contiguous range of edges: its node
+*  flags, offsets and edges are each read from their own section of the
+*  file, and any escaped edges from the trailing escaped edge table, which
+*  is likewise ordered.
+*
+*  The edges of each block are decoded into CDirectedEdgeData as they are
+*  read, and the offsets validated as each block is read, so a malformed
+*  file is detected no later than the block in which it is malformed.
+*  Unlike CCsrDependencyGraph::Load, the graph is not checked for cycles,
+*  which would require the whole of it.
+*/
+#pragma once
+
+#if !defined(_GRAPH_STREAM_READER_H__)
+#define _GRAPH_STREAM_READER_H__
+
+#ifndef _CSR_DEPENDENCY_GRAPH_H__
+    #include "CsrDependencyGraph.h"
+#endif
+
+#ifndef _VECTOR_
+    #include <vector>
+#endif
+
+/**
+    @brief A block of consecutive nodes of a binary graph file, with their
+           'out' edges
+*/
+struct GRAPH_STREAM_BLOCK
+{
+    NODE_ID_T                       idFirst;   ///< ID of the first node of the block
+    std::vector<BYTE>               vFlags;    ///< flags of each node of the block
+    std::vector<EDGE_OFFSET_T>      vOffsets;  ///< index of each node's first edge within vEdges,
+                                               ///< with one additional trailing entry
+    std::vector<CDirectedEdgeData>  vEdges;    ///< decoded edges, grouped by source node
+};
+
+/**
+    @brief Block-wise reader of a binary graph file
+*/
+class CGraphStreamReader
+{
+    FILE*                       m_pFile;         ///< file being read, nullptr if not open
+    GRAPH_FILE_HEADER           m_hdr;           ///< header of the file
+    long long                   m_nFlagsPos;     ///< file position of the node flags
+    long long                   m_nOffsetsPos;   ///< file position of the offsets
+    long long                   m_nEdgesPos;     ///< file position of the edges
+    long long                   m_nEscapedPos;   ///< file position of the escaped edge records
+    QWORD                       m_qwNumEscaped;  ///< number of escaped edge records
+    QWORD                       m_qwNextEscaped; ///< number of escaped edge records read
+    size_t                      m_nNextNode;     ///< ID of the first node of the next block
+    EDGE_OFFSET_T               m_qwNextEdge;    ///< offset of that node's first edge
+    bool                        m_bFailed;       ///< the file was found to be malformed, or unreadable
+    std::vector<EDGE_OFFSET_T>  m_vOffsets;      ///< offsets of the block being read, as held by the file
+    std::vector<PACKED_EDGE_T>  m_vPacked;       ///< packed edges of the block being read
+
+public:
+    /// Default Constructor
+    CGraphStreamReader() noexcept;
+
+    /// Default Destructor, closes the file if open
+    ~CGraphStreamReader();
+
+    /**
+        @brief Opens a binary graph file, reading and validating its header
+
+        @param [in] szFileName  name of the file to be read
+
+        @retval true            on success
+        @retval false           if the file could not be opened, or is not
+                                a binary graph file of a known version
+    */
+    bool   Open(const TCHAR* szFileName) noexcept;
+
+    /**
+        @brief Closes the file
+    */
+    void   Close(void) noexcept;
+
+    /**
+        @brief Reads the next block of nodes
+
+        @param [out] block      receives the nodes, its storage being reused
+        @param [in]  nMaxNodes  maximum number of nodes to be read, at least 1
+
+        @retval size_t          number of nodes read, 0 once every node has
+                                been read, or on error
+    */
+    size_t ReadBlock(GRAPH_STREAM_BLOCK& block, size_t nMaxNodes) noexcept;
+
+    /**
+        @retval true            if every node has been read, and the file was
+                                found to be well formed throughout
+    */
+    bool   IsComplete(void) const noexcept
+    { return (m_pFile != nullptr) && !m_bFailed && (m_nNextNode == m_hdr.qwNodeCapacity); };
+
+    /**
+        @retval true            if the file was found to be malformed, or
+                                could not be read
+    */
+    constexpr bool HasFailed(void) const noexcept
+    { return m_bFailed; };
+
+    /**
+        @retval size_t          number of node ID slots of the file
+    */
+    constexpr size_t GetNodeCapacity(void) const noexcept
+    { return static_cast<size_t>(m_hdr.qwNodeCapacity); };
+
+    /**
+        @retval size_t          number of valid nodes of the file
+    */
+    constexpr size_t GetNumNodes(void) const noexcept
+    { return static_cast<size_t>(m_hdr.qwNumNodes); };
+
+    /**
+        @retval size_t          number of edges of the file
+    */
+    constexpr size_t GetNumEdges(void) const noexcept
+    { return static_cast<size_t>(m_hdr.qwNumEdges); };
+
+private:
+    /**
+        @brief Reads a span of a section of the file
+
+        @param [in]  nPos       file position of the span
+        @param [out] pData      receives the span
+        @param [in]  nSize      size of each element
+        @param [in]  nCount     number of elements
+
+        @retval true            on success
+    */
+    bool   ReadAt(long long nPos, void* pData, size_t nSize, size_t nCount) noexcept;
+
+    /**
+        @brief Decodes the edges of a block, as read from the file
+
+        @param [in,out] block   block whose flags and edge count are set
+
+        @retval true            on success
+        @retval false           if an escaped edge is not found in order
+    */
+    bool   DecodeEdges(GRAPH_STREAM_BLOCK& block) noexcept;
+
+    /// copy constructor
+    CGraphStreamReader(const CGraphStreamReader& o) = delete;
+
+    /// assignment operator
+    CGraphStreamReader& operator=(const CGraphStreamReader& rhs) = delete;
+};
+
+#endif
@@ -0,0 +1,256 @@
+/**
+* @file       HazardAnalysis.cpp
+* @brief      CHazardAnalysis class implementation
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*/
+
+#include "stdafx.h"
+#include "HazardAnalysis.h"
+#include <algorithm>
+
+
+
+CHazardAnalysis::CHazardAnalysis ( ) noexcept
+    : m_vStallCycles  ( ),
+      m_qwTotalStalls ( 0 ),
+      m_dwPenalty     { },
+      m_dwMaxPenalty  ( 0 ),
+      m_dwInterval    { },
+      m_qwUnitRelease { },
+      m_qwStructuralStalls ( 0 ),
+      m_vWindow       ( ),
+      m_qwNumIssued   ( 0 ),
+      m_qwPrevRelease ( 0 ),
+      m_bStreamDistance ( false )
+{
+}
+
+QWORD CHazardAnalysis::Analyze ( const CCsrDependencyGraph& dag, const CPipelineConfig& config )
+{
+    Prepare ( config );
+
+    m_vStallCycles.assign ( dag.GetNodeCapacity ( ), 0 );
+
+    // the 1-based cycle in which each instruction leaves the hazard
+    // detection stage, relative to the first; 0 if not yet issued
+    std::vector<QWORD> vRelease ( dag.GetNodeCapacity ( ), 0 );
+
+    QWORD qwPrevRelease = 0;
+
+    // an edge weight is the distance between node IDs, which is only the
+    // distance in issue slots if no node ID is left vacant
+    const bool bDistance = (dag.GetNumNodes ( ) == dag.GetNodeCapacity ( ));
+
+    for ( CCsrDependencyGraph::const_iterator it = dag.begin ( ); it != dag.end ( ); ++it )
+    {
+        if ( it->IsValid ( ) )
+            qwPrevRelease = Issue ( dag, *it, qwPrevRelease, bDistance, vRelease );
+    }
+
+    return m_qwTotalStalls;
+}
+
+QWORD CHazardAnalysis::Analyze ( const CCsrDependencyGraph& dag, const CPipelineConfig& config,
+                                 const std::vector<NODE_ID_T>& vIssueOrder )
+{
+    Prepare ( config );
+
+    m_vStallCycles.assign ( dag.GetNodeCapacity ( ), 0 );
+
+    std::vector<QWORD> vRelease ( dag.GetNodeCapacity ( ), 0 );
+
+    QWORD qwPrevRelease = 0;
+
+    for ( std::vector<NODE_ID_T>::const_iterator it = vIssueOrder.begin ( ); it != vIssueOrder.end ( ); ++it )
+    {
+        // each instruction is issued at most once
+        if ( dag.HasNode ( *it ) && vRelease[*it] == 0 )
+            qwPrevRelease = Issue ( dag, dag.GetNode ( *it ), qwPrevRelease, false, vRelease );
+    }
+
+    return m_qwTotalStalls;
+}
+
+void CHazardAnalysis::BeginStream ( const CPipelineConfig& config, bool bDistance ) noexcept
+{
+    Prepare ( config );
+
+    std::vector<BYTE>().swap ( m_vStallCycles );
+
+    // an instruction issued as many instructions before another as the
+    // largest penalty, or further, has been released at least that many
+    // cycles before the other's predecessor, so can no longer stall it
+    size_t nWindow = 1;
+
+    while ( nWindow < m_dwMaxPenalty )
+        nWindow <<= 1;
+
+    m_vWindow.assign ( nWindow, HAZARD_WINDOW_ENTRY ( ) );
+    m_qwNumIssued     = 0;
+    m_qwPrevRelease   = 0;
+    m_bStreamDistance = bDistance;
+}
+
+DWORD CHazardAnalysis::IssueStreamed ( NODE_ID_T idNode, IC_INSTRUCTION_CLASS icClass,
+                                       const CDirectedEdgeData* pBegin, const CDirectedEdgeData* pEnd ) noexcept
+{
+    const QWORD qwEarliest = m_qwPrevRelease + 1;
+    QWORD       qwRequired = qwEarliest;
+
+    // the window holds the latest instructions issued, in node ID order
+    const size_t nMask   = m_vWindow.size ( ) - 1;
+    const size_t nHeld   = static_cast<size_t>(std::min ( m_qwNumIssued, static_cast<QWORD>(m_vWindow.size ( )) ));
+    const QWORD  qwFirst = m_qwNumIssued - nHeld;
+
+    for ( const CDirectedEdgeData* pEdge = pBegin; pEdge != pEnd; ++pEdge )
+    {
+        // as with Analyze, a dependency further away than the largest
+        // penalty cannot stall
+        if ( m_bStreamDistance && pEdge->GetWeight ( ) > static_cast<int>(m_dwMaxPenalty) )
+            continue;
+
+        const NODE_ID_T idProducer = pEdge->GetDestNodeID ( );
+
+        size_t nFirst = 0;
+        size_t nLast  = nHeld;
+
+        while ( nFirst < nLast )
+        {
+            const size_t nMiddle = nFirst + (nLast - nFirst) / 2;
+
+            if ( m_vWindow[static_cast<size_t>(qwFirst + nMiddle) & nMask].idNode < idProducer )
+                nFirst = nMiddle + 1;
+            else
+                nLast  = nMiddle;
+        }
+
+        // a producer no longer held, or not yet issued, cannot stall
+        if ( nFirst < nHeld )
+        {
+            const HAZARD_WINDOW_ENTRY& entry = m_vWindow[static_cast<size_t>(qwFirst + nFirst) & nMask];
+
+            if ( entry.idNode == idProducer )
+            {
+                const QWORD qwReady = entry.qwRelease + m_dwPenalty[entry.byClass] + 1;
+
+                if ( qwReady > qwRequired )
+                    qwRequired = qwReady;
+            }
+        }
+    }
+
+    const BYTE  byClass   = static_cast<BYTE>(icClass) & (NF_CLASS_MASK >> NF_CLASS_SHIFT);
+    const QWORD qwRelease = Release ( byClass, qwEarliest, qwRequired );
+
+    HAZARD_WINDOW_ENTRY& entry = m_vWindow[static_cast<size_t>(m_qwNumIssued) & nMask];
+
+    entry.idNode    = idNode;
+    entry.byClass   = byClass;
+    entry.qwRelease = qwRelease;
+
+    m_qwNumIssued++;
+    m_qwPrevRelease = qwRelease;
+
+    return static_cast<DWORD>(qwRelease - qwEarliest);
+}
+
+void CHazardAnalysis::Clear ( void ) noexcept
+{
+    std::vector<BYTE> vEmpty;
+
+    m_vStallCycles.swap ( vEmpty );
+    std::vector<HAZARD_WINDOW_ENTRY>().swap ( m_vWindow );
+    m_qwTotalStalls      = 0;
+    m_qwStructuralStalls = 0;
+    m_qwNumIssued        = 0;
+    m_qwPrevRelease      = 0;
+    m_bStreamDistance    = false;
+}
+
+void CHazardAnalysis::Prepare ( const CPipelineConfig& config ) noexcept
+{
+    // the stall cycle array is sized by the graph alone, so its storage is
+    // retained from one analysis to the next
+    m_qwTotalStalls      = 0;
+    m_qwStructuralStalls = 0;
+
+    // resolve the adjacent stall penalty and issue interval of each class
+    // up front, covering every value the node flags are able to represent
+    m_dwMaxPenalty = 0;
+
+    for ( DWORD i = 0; i < _countof(m_dwPenalty); i++ )
+    {
+        m_dwPenalty[i]     = config.GetHazardPenalty ( static_cast<IC_INSTRUCTION_CLASS>(i) );
+        m_dwInterval[i]    = config.GetIssueInterval ( static_cast<IC_INSTRUCTION_CLASS>(i) );
+        m_qwUnitRelease[i] = 0;
+
+        if ( m_dwPenalty[i] > m_dwMaxPenalty )
+            m_dwMaxPenalty = m_dwPenalty[i];
+    }
+}
+
+QWORD CHazardAnalysis::Issue ( const CCsrDependencyGraph& dag, const CCsrGraphNode& node, QWORD qwPrevRelease,
+                               bool bDistance, std::vector<QWORD>& vRelease ) noexcept
+{
+    // absent any hazard, an instruction follows its predecessor by one cycle
+    const QWORD qwEarliest = qwPrevRelease + 1;
+    QWORD       qwRequired = qwEarliest;
+
+    for ( CCsrGraphNode::const_iterator pEdge = node.beginEdge ( ); pEdge != node.endEdge ( ); ++pEdge )
+    {
+        // when the edge weight is the dependency distance, as intervening
+        // stalls only ever lengthen it, a dependency further away than the
+        // largest penalty cannot stall
+        if ( bDistance && pEdge->GetWeight ( ) > static_cast<int>(m_dwMaxPenalty) )
+            continue;
+
+        const NODE_ID_T idProducer = pEdge->GetDestNodeID ( );
+
+        // only dependencies upon previously issued instructions are hazards
+        if ( idProducer < vRelease.size ( ) && vRelease[idProducer] != 0 )
+        {
+            const QWORD qwReady = vRelease[idProducer] +
+                                  m_dwPenalty[dag.GetNode ( idProducer ).GetClass ( )] + 1;
+
+            if ( qwReady > qwRequired )
+                qwRequired = qwReady;
+        }
+    }
+
+    const size_t nIndex = static_cast<size_t>(node.GetNodeID ( ));
+
+    vRelease[nIndex]       = Release ( static_cast<BYTE>(node.GetClass ( )), qwEarliest, qwRequired );
+    m_vStallCycles[nIndex] = static_cast<BYTE>(vRelease[nIndex] - qwEarliest);
+
+    return vRelease[nIndex];
+}
+
+QWORD CHazardAnalysis::Release ( BYTE byClass, QWORD qwEarliest, QWORD qwRequired ) noexcept
+{
+    // the unit of the instruction's class may still be busy, regardless
+    // of whether its operands are ready
+    const QWORD qwDataOnly = qwRequired;
+
+    if ( m_dwInterval[byClass] > 0 && m_qwUnitRelease[byClass] != 0 &&
+         m_qwUnitRelease[byClass] + m_dwInterval[byClass] > qwRequired )
+    {
+        qwRequired = m_qwUnitRelease[byClass] + m_dwInterval[byClass];
+    }
+
+    QWORD qwStalls = qwRequired - qwEarliest;
+
+    if ( qwStalls > MAX_STALL_CYCLES )
+        qwStalls = MAX_STALL_CYCLES;
+
+    m_qwTotalStalls += qwStalls;
+
+    if ( qwEarliest + qwStalls > qwDataOnly )
+        m_qwStructuralStalls += qwEarliest + qwStalls - qwDataOnly;
+
+    m_qwUnitRelease[byClass] = qwEarliest + qwStalls;
+
+    return m_qwUnitRelease[byClass];
+}
@@ -0,0 +1,220 @@
+/**
+* @file       HazardAnalysis.h
+* @brief      CHazardAnalysis class interface
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  Data hazards are determined from the pipeline depth and the dependency
+*  distance of each edge, rather than only between adjacent instructions.
+*
+*  A consumer depending upon a producer P with an adjacent stall penalty of
+*  p cycles may leave the hazard detection stage no earlier than p + 1 cycles
+*  after P did.  The effective dependency distance between the two is the
+*  edge's dependency distance, plus any stall cycles introduced by the
+*  instructions issued between them.  Such a consumer requires:
+*
+*        stalls = max(0, p + 1 - effective distance)
+*
+*  Tracking the cycle in which each instruction leaves the hazard detection
+*  stage accounts for the intervening stalls, so all hazards are resolved
+*  in a single linear pass over the per-node edge lists, O(V + E).
+*
+*  The same pass resolves the structural hazards of functional units which
+*  do not accept an instruction every cycle.  An instruction of a class
+*  whose unit has an issue interval of i cycles may leave the hazard
+*  detection stage no earlier than i cycles after the previous instruction
+*  of that class did, so only the release cycle of the latest instruction
+*  of each class need be tracked in addition.
+*
+*  When the graph is streamed rather than frozen in its entirety, the
+*  instructions are issued one at a time, in node ID order, along with
+*  their edges.  As an instruction is released at least one cycle after its
+*  predecessor, a producer issued as many instructions before a consumer as
+*  the largest stall penalty, or further, cannot stall it.  Only the release
+*  cycles of that many of the latest instructions are held, in a window
+*  ordered by node ID, so the memory required is independent of the length
+*  of the trace.
+*/
+#pragma once
+
+#if !defined(_HAZARD_ANALYSIS_H__)
+#define _HAZARD_ANALYSIS_H__
+
+#ifndef _CSR_DEPENDENCY_GRAPH_H__
+    #include "CsrDependencyGraph.h"
+#endif
+
+#ifndef _PIPELINE_CONFIG_H__
+    #include "PipelineConfig.h"
+#endif
+
+#ifndef _VECTOR_
+    #include <vector>
+#endif
+
+/**
+    @brief An instruction held in the window of a streamed analysis
+*/
+struct HAZARD_WINDOW_ENTRY
+{
+    NODE_ID_T   idNode;      ///< node ID of the instruction
+    BYTE        byClass;     ///< class of the instruction
+    QWORD       qwRelease;   ///< cycle it left the hazard detection stage
+};
+
+/**
+    @brief Dependency-distance-aware data hazard analysis
+
+    The stall cycles required by each instruction in a frozen dependency
+    graph, issued either in node ID order or in a scheduled issue order,
+    are computed once up front and then retrieved by node ID.
+*/
+class CHazardAnalysis
+{
+    std::vector<BYTE>   m_vStallCycles;  ///< stall cycles required, indexed by node ID
+    QWORD               m_qwTotalStalls; ///< sum of all stall cycles required
+    DWORD               m_dwPenalty[(NF_CLASS_MASK >> NF_CLASS_SHIFT) + 1]; ///< stall penalty per producer class
+    DWORD               m_dwMaxPenalty;  ///< largest of m_dwPenalty
+    DWORD               m_dwInterval[(NF_CLASS_MASK >> NF_CLASS_SHIFT) + 1]; ///< unit issue interval per class
+    QWORD               m_qwUnitRelease[(NF_CLASS_MASK >> NF_CLASS_SHIFT) + 1]; ///< release cycle of the latest instruction per class
+    QWORD               m_qwStructuralStalls; ///< portion of m_qwTotalStalls due to busy units
+    std::vector<HAZARD_WINDOW_ENTRY> m_vWindow; ///< latest instructions of a streamed analysis, a power of 2
+    QWORD               m_qwNumIssued;   ///< instructions issued by a streamed analysis
+    QWORD               m_qwPrevRelease; ///< release cycle of the latest of them
+    bool                m_bStreamDistance; ///< each edge weight of a streamed graph is an issue distance
+
+public:
+    /// Default Constructor
+    CHazardAnalysis() noexcept;
+
+    /// Default Destructor
+    ~CHazardAnalysis() = default;
+
+/**
+    @brief Computes the stall cycles required by every instruction
+
+    Only dependencies upon instructions issued earlier are considered,
+    the stall penalty of each being determined by the forwarding paths
+    of the pipeline and the class of the producing instruction.  The stall
+    cycle array is sized by the graph, std::bad_alloc being thrown should
+    it not fit.
+
+    @param [in] dag         frozen graph of instruction dependencies
+    @param [in] config      descriptor of the pipeline
+
+    @retval QWORD           total number of stall cycles required
+*/
+    QWORD Analyze(const CCsrDependencyGraph& dag, const CPipelineConfig& config);
+
+/**
+    @brief Computes the stall cycles required when issuing in a given order
+
+    @param [in] dag         frozen graph of instruction dependencies
+    @param [in] config      descriptor of the pipeline
+    @param [in] vIssueOrder node IDs in the order they are to be issued
+
+    @retval QWORD           total number of stall cycles required
+*/
+    QWORD Analyze(const CCsrDependencyGraph& dag, const CPipelineConfig& config,
+                  const std::vector<NODE_ID_T>& vIssueOrder);
+
+/**
+    @brief Begins the analysis of a streamed graph
+
+    The stall cycles of each instruction are returned as it is issued by
+    IssueStreamed, rather than being retrieved by GetStallCycles.
+
+    @param [in] config      descriptor of the pipeline
+    @param [in] bDistance   true if each edge weight is the distance in
+                            issue slots, i.e. no node ID is left vacant
+*/
+    void BeginStream(const CPipelineConfig& config, bool bDistance) noexcept;
+
+/**
+    @brief Issues the next instruction of a streamed graph
+
+    The instructions must be issued in ascending node ID order.  As with
+    Analyze, only dependencies upon instructions issued earlier are
+    considered.
+
+    @param [in] idNode      node ID of the instruction
+    @param [in] icClass     class of the instruction
+    @param [in] pBegin      first of the instruction's 'out' edges
+    @param [in] pEnd        one past the last of them
+
+    @retval DWORD           count of stall cycles required, saturated at 0xFF
+*/
+    DWORD IssueStreamed(NODE_ID_T idNode, IC_INSTRUCTION_CLASS icClass,
+                        const CDirectedEdgeData* pBegin, const CDirectedEdgeData* pEnd) noexcept;
+
+/**
+    @brief Retrieves the stall cycles required by an instruction
+
+    @param [in] idNode      target node ID
+
+    @retval DWORD           count of stall cycles, saturated at 0xFF
+*/
+    DWORD GetStallCycles(const NODE_ID_T& idNode) const noexcept
+    { return (idNode < m_vStallCycles.size()) ? m_vStallCycles[idNode] : 0; };
+
+/**
+    @brief Retrieves the total stall cycles required by the last analysis
+
+    @retval QWORD           count of stall cycles
+*/
+    constexpr QWORD GetTotalStalls(void) const noexcept
+    { return m_qwTotalStalls; };
+
+/**
+    @brief Retrieves the stall cycles of the last analysis required solely
+           by functional units not yet ready to accept an instruction
+
+    @retval QWORD           count of stall cycles
+*/
+    constexpr QWORD GetStructuralStalls(void) const noexcept
+    { return m_qwStructuralStalls; };
+
+/**
+    @brief Releases the results of the last analysis
+*/
+    void Clear(void) noexcept;
+
+private:
+/**
+    @brief Resets the results and resolves the stall penalty and issue
+           interval of each class
+*/
+    void Prepare(const CPipelineConfig& config) noexcept;
+
+/**
+    @brief Issues the next instruction, recording the stall cycles it requires
+
+    @param [in] dag             frozen graph of instruction dependencies
+    @param [in] node            instruction being issued
+    @param [in] qwPrevRelease   release cycle of the previously issued instruction
+    @param [in] bDistance       true if each edge weight is the distance in
+                                issue slots, i.e. instructions are issued in
+                                node ID order, no node ID being vacant
+    @param [in,out] vRelease    release cycle of each instruction, 0 if not yet issued
+
+    @retval QWORD               release cycle of the instruction
+*/
+    QWORD Issue(const CCsrDependencyGraph& dag, const CCsrGraphNode& node, QWORD qwPrevRelease,
+                bool bDistance, std::vector<QWORD>& vRelease) noexcept;
+
+/**
+    @brief Releases an instruction from the hazard detection stage once its
+           unit is ready, recording the stall cycles it requires
+
+    @param [in] byClass     class of the instruction
+    @param [in] qwEarliest  release cycle absent any hazard
+    @param [in] qwRequired  earliest release cycle its operands allow
+
+    @retval QWORD           release cycle of the instruction
+*/
+    QWORD Release(BYTE byClass, QWORD qwEarliest, QWORD qwRequired) noexcept;
+};
+
+#endif
@@ -0,0 +1,635 @@
+/**
+* @file       IncrementalAnalysis.cpp
+* @brief      CIncrementalAnalysis class implementation
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*/
+
+#include "stdafx.h"
+#include "IncrementalAnalysis.h"
+
+#ifndef _ALGORITHM_
+    #include <algorithm>
+#endif
+
+#ifndef _DEQUE_
+    #include <deque>
+#endif
+
+#ifndef _QUEUE_
+    #include <queue>
+#endif
+
+/**
+    @brief Propagation queue entry, ordered by the value the node held
+           before the edit, such that a node is ordinarily visited after
+           every node it depends upon
+*/
+struct PROPAGATION_ENTRY
+{
+    QWORD       qwKey;   ///< previous earliest start or priority
+    NODE_ID_T   idNode;  ///< node ID
+
+    bool operator>(const PROPAGATION_ENTRY& rhs) const noexcept
+    { return (qwKey != rhs.qwKey) ? (qwKey > rhs.qwKey) : (idNode > rhs.idNode); };
+};
+
+typedef std::priority_queue<PROPAGATION_ENTRY, std::vector<PROPAGATION_ENTRY>,
+                            std::greater<PROPAGATION_ENTRY>> PROPAGATION_QUEUE_T;
+
+/**
+    @brief Sorts a list of node IDs, dropping the duplicates
+*/
+static void SortUnique ( std::vector<NODE_ID_T>& vNodes ) noexcept
+{
+    std::sort ( vNodes.begin ( ), vNodes.end ( ) );
+    vNodes.erase ( std::unique ( vNodes.begin ( ), vNodes.end ( ) ), vNodes.end ( ) );
+}
+
+
+CIncrementalAnalysis::CIncrementalAnalysis ( ) noexcept
+    : m_Config         ( ),
+      m_qwLatency      { },
+      m_dwMaxPenalty   ( 0 ),
+      m_dwInterval     { },
+      m_dwWindow       ( 0 ),
+      m_bValid         ( false ),
+      m_qwLogPosition  ( 0 ),
+      m_nNumNodes      ( 0 ),
+      m_nNumRecomputed ( 0 ),
+      m_vConsumers     ( ),
+      m_vStallCycles   ( ),
+      m_qwTotalStalls  ( 0 ),
+      m_vEarliest      ( ),
+      m_vPriority      ( ),
+      m_mapEarliest    ( ),
+      m_vQueued        ( )
+{
+}
+
+bool CIncrementalAnalysis::Analyze ( const CDependencyGraph& dag, const CPipelineConfig& config ) noexcept
+{
+    Clear ( );
+
+    m_Config        = config;
+    m_qwLogPosition = dag.GetChangeLogEnd ( );
+    m_nNumNodes     = dag.GetNumNodes ( );
+
+    // resolve the latency of a dependency upon each producer class, and the
+    // issue interval of its unit, up front, covering every value the frozen
+    // node flags are able to represent
+    for ( DWORD i = 0; i < _countof(m_qwLatency); i++ )
+    {
+        const DWORD dwPenalty = config.GetHazardPenalty ( static_cast<IC_INSTRUCTION_CLASS>(i) );
+
+        m_qwLatency[i]  = static_cast<QWORD>(dwPenalty) + 1;
+        m_dwInterval[i] = config.GetIssueInterval ( static_cast<IC_INSTRUCTION_CLASS>(i) );
+
+        if ( dwPenalty > m_dwMaxPenalty )
+            m_dwMaxPenalty = dwPenalty;
+
+        if ( m_dwInterval[i] > m_dwWindow + 1 )
+            m_dwWindow = m_dwInterval[i] - 1;
+    }
+
+    if ( m_dwMaxPenalty > m_dwWindow )
+        m_dwWindow = m_dwMaxPenalty;
+
+    const size_t nCapacity = dag.GetNodeCapacity ( );
+
+    Resize ( nCapacity );
+
+    // the reverse index, which includes the edges to nodes not in the graph,
+    // should they be added later
+    for ( CDependencyGraph::const_iterator it = dag.begin ( ); it != dag.end ( ); ++it )
+    {
+        if ( it->IsValid ( ) == false )
+            continue;
+
+        for ( CGraphNode::const_iterator itEdge = it->beginEdge ( ); itEdge != it->endEdge ( ); ++itEdge )
+        {
+            const NODE_ID_T idProducer = itEdge->GetDestNodeID ( );
+
+            if ( idProducer >= m_vConsumers.size ( ) )
+                m_vConsumers.resize ( static_cast<size_t>(idProducer) + 1 );
+
+            m_vConsumers[idProducer].push_back ( it->GetNodeID ( ) );
+        }
+    }
+
+    UpdateStalls ( dag, std::vector<NODE_ID_T> ( 1, 0 ), false );
+
+    // order the instructions topologically, producers preceding consumers,
+    // disregarding dependencies upon itself or upon nodes not in the graph
+    std::vector<DWORD>     vNumProducers ( nCapacity, 0 );
+    std::vector<NODE_ID_T> vTopological;
+
+    vTopological.reserve ( m_nNumNodes );
+
+    for ( CDependencyGraph::const_iterator it = dag.begin ( ); it != dag.end ( ); ++it )
+    {
+        if ( it->IsValid ( ) == false )
+            continue;
+
+        for ( CGraphNode::const_iterator itEdge = it->beginEdge ( ); itEdge != it->endEdge ( ); ++itEdge )
+        {
+            if ( itEdge->GetDestNodeID ( ) != it->GetNodeID ( ) && dag.HasNode ( itEdge->GetDestNodeID ( ) ) )
+                vNumProducers[it->GetNodeID ( )]++;
+        }
+
+        if ( vNumProducers[it->GetNodeID ( )] == 0 )
+            vTopological.push_back ( it->GetNodeID ( ) );
+    }
+
+    for ( size_t nPos = 0; nPos < vTopological.size ( ); nPos++ )
+    {
+        const NODE_ID_T idNode = vTopological[nPos];
+
+        const std::vector<NODE_ID_T>& vConsumers = m_vConsumers[idNode];
+
+        for ( std::vector<NODE_ID_T>::const_iterator it = vConsumers.begin ( ); it != vConsumers.end ( ); ++it )
+        {
+            if ( *it != idNode && dag.HasNode ( *it ) && --vNumProducers[*it] == 0 )
+                vTopological.push_back ( *it );
+        }
+    }
+
+    if ( vTopological.size ( ) != m_nNumNodes )
+        return false;
+
+    // forward pass, every producer precedes its consumers
+    for ( std::vector<NODE_ID_T>::const_iterator it = vTopological.begin ( ); it != vTopological.end ( ); ++it )
+    {
+        const CGraphNode& node = dag.GetNode ( *it );
+
+        QWORD qwEarliest = 1;
+
+        for ( CGraphNode::const_iterator itEdge = node.beginEdge ( ); itEdge != node.endEdge ( ); ++itEdge )
+        {
+            const NODE_ID_T idProducer = itEdge->GetDestNodeID ( );
+
+            if ( idProducer != *it && dag.HasNode ( idProducer ) )
+                qwEarliest = std::max ( qwEarliest, m_vEarliest[idProducer] + GetLatency ( dag, idProducer ) );
+        }
+
+        SetEarliest ( *it, qwEarliest );
+    }
+
+    // backward pass, every consumer being visited before its producers
+    for ( std::vector<NODE_ID_T>::const_reverse_iterator it = vTopological.rbegin ( ); it != vTopological.rend ( ); ++it )
+    {
+        const QWORD qwLatency = GetLatency ( dag, *it );
+
+        QWORD qwPriority = 0;
+
+        const std::vector<NODE_ID_T>& vConsumers = m_vConsumers[*it];
+
+        for ( std::vector<NODE_ID_T>::const_iterator itConsumer = vConsumers.begin ( ); itConsumer != vConsumers.end ( ); ++itConsumer )
+        {
+            if ( *itConsumer != *it && dag.HasNode ( *itConsumer ) )
+                qwPriority = std::max ( qwPriority, qwLatency + m_vPriority[*itConsumer] );
+        }
+
+        m_vPriority[*it] = qwPriority;
+    }
+
+    m_nNumRecomputed += 2 * vTopological.size ( );
+    m_bValid          = true;
+
+    return true;
+}
+
+bool CIncrementalAnalysis::Update ( const CDependencyGraph& dag ) noexcept
+{
+    if ( m_bValid == false || m_qwLogPosition < dag.GetChangeLogBase ( ) )
+        return Analyze ( dag, m_Config );
+
+    m_nNumRecomputed = 0;
+
+    Resize ( dag.GetNodeCapacity ( ) );
+
+    std::vector<NODE_ID_T> vStallDirty;     // nodes whose stall cycles may have changed
+    std::vector<NODE_ID_T> vEarliestDirty;  // nodes whose producers have changed
+    std::vector<NODE_ID_T> vPriorityDirty;  // nodes whose consumers, or latency, have changed
+    std::vector<NODE_ID_T> vLatencyDirty;   // nodes whose consumers see a changed latency
+
+    const std::vector<GRAPH_CHANGE>& vChangeLog = dag.GetChangeLog ( );
+
+    for ( size_t nPos = static_cast<size_t>(m_qwLogPosition - dag.GetChangeLogBase ( )); nPos < vChangeLog.size ( ); nPos++ )
+    {
+        const GRAPH_CHANGE& change = vChangeLog[nPos];
+
+        switch ( change.gcType )
+        {
+            case GC_ADD_NODE:
+            case GC_REMOVE_NODE:
+                m_nNumNodes += (change.gcType == GC_ADD_NODE) ? 1 : -1;
+
+                vEarliestDirty.push_back ( change.idFrom );
+                vPriorityDirty.push_back ( change.idFrom );
+                vLatencyDirty.push_back ( change.idFrom );
+                vStallDirty.push_back ( change.idFrom );
+                break;
+
+            case GC_ADD_EDGE:
+                if ( change.idTo >= m_vConsumers.size ( ) )
+                    m_vConsumers.resize ( static_cast<size_t>(change.idTo) + 1 );
+
+                m_vConsumers[change.idTo].push_back ( change.idFrom );
+
+                vEarliestDirty.push_back ( change.idFrom );
+                vPriorityDirty.push_back ( change.idTo );
+                vStallDirty.push_back ( change.idFrom );
+                break;
+
+            case GC_REMOVE_EDGE:
+                if ( change.idTo < m_vConsumers.size ( ) )
+                {
+                    std::vector<NODE_ID_T>& vConsumers = m_vConsumers[change.idTo];
+
+                    std::vector<NODE_ID_T>::iterator it = std::find ( vConsumers.begin ( ), vConsumers.end ( ), change.idFrom );
+
+                    if ( it != vConsumers.end ( ) )
+                    {
+                        *it = vConsumers.back ( );
+                        vConsumers.pop_back ( );
+                    }
+                }
+
+                vEarliestDirty.push_back ( change.idFrom );
+                vPriorityDirty.push_back ( change.idTo );
+                vStallDirty.push_back ( change.idFrom );
+                break;
+
+            case GC_SET_CLASS:
+                vPriorityDirty.push_back ( change.idFrom );
+                vLatencyDirty.push_back ( change.idFrom );
+                vStallDirty.push_back ( change.idFrom );
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    m_qwLogPosition = dag.GetChangeLogEnd ( );
+
+    // the consumers of a node added, removed or of another class depend upon
+    // it anew, as the edges to a node remain in place while it is absent
+    SortUnique ( vLatencyDirty );
+
+    for ( std::vector<NODE_ID_T>::const_iterator it = vLatencyDirty.begin ( ); it != vLatencyDirty.end ( ); ++it )
+    {
+        if ( *it < m_vConsumers.size ( ) )
+            vEarliestDirty.insert ( vEarliestDirty.end ( ), m_vConsumers[*it].begin ( ), m_vConsumers[*it].end ( ) );
+    }
+
+    SortUnique ( vStallDirty );
+    SortUnique ( vEarliestDirty );
+    SortUnique ( vPriorityDirty );
+
+    UpdateStalls ( dag, vStallDirty, true );
+
+    m_bValid = UpdateEarliest ( dag, vEarliestDirty ) && UpdatePriority ( dag, vPriorityDirty );
+
+    return m_bValid;
+}
+
+QWORD CIncrementalAnalysis::GetCycleLowerBound ( void ) const noexcept
+{
+    QWORD qwReturn = 0;
+
+    // every instruction occupies an issue slot of its own, and the last
+    // one issued takes a further (stages - 1) cycles to complete
+    if ( m_nNumNodes > 0 )
+        qwReturn = std::max<QWORD> ( GetCriticalPathLength ( ), m_nNumNodes ) + m_Config.GetNumStages ( ) - 1;
+
+    return qwReturn;
+}
+
+void CIncrementalAnalysis::Clear ( void ) noexcept
+{
+    std::vector<std::vector<NODE_ID_T>>().swap ( m_vConsumers );
+    std::vector<BYTE>().swap ( m_vStallCycles );
+    std::vector<QWORD>().swap ( m_vEarliest );
+    std::vector<QWORD>().swap ( m_vPriority );
+    std::vector<BYTE>().swap ( m_vQueued );
+    m_mapEarliest.clear ( );
+
+    m_dwMaxPenalty   = 0;
+    m_dwWindow       = 0;
+    m_bValid         = false;
+    m_nNumNodes      = 0;
+    m_nNumRecomputed = 0;
+    m_qwTotalStalls  = 0;
+}
+
+void CIncrementalAnalysis::Resize ( size_t nCapacity ) noexcept
+{
+    if ( nCapacity > m_vStallCycles.size ( ) )
+    {
+        m_vStallCycles.resize ( nCapacity, 0 );
+        m_vEarliest.resize ( nCapacity, 0 );
+        m_vPriority.resize ( nCapacity, 0 );
+        m_vQueued.resize ( nCapacity, 0 );
+    }
+
+    if ( nCapacity > m_vConsumers.size ( ) )
+        m_vConsumers.resize ( nCapacity );
+}
+
+void CIncrementalAnalysis::UpdateStalls ( const CDependencyGraph& dag, const std::vector<NODE_ID_T>& vDirty,
+                                         bool bSettle ) noexcept
+{
+    const size_t nCapacity = dag.GetNodeCapacity ( );
+
+    // the instructions last issued, oldest first, along with their release
+    // cycles relative to one another; a producer issued before these is
+    // released at least as many cycles ahead of the previous instruction
+    // as the largest penalty, so is unable to stall its consumer, and its
+    // unit has long since become ready for another instruction
+    std::deque<std::pair<NODE_ID_T, QWORD>> deqWindow;
+
+    auto FindRelease = [&deqWindow] ( NODE_ID_T idNode ) noexcept -> const QWORD*
+    {
+        std::deque<std::pair<NODE_ID_T, QWORD>>::const_iterator it =
+            std::lower_bound ( deqWindow.begin ( ), deqWindow.end ( ), std::make_pair ( idNode, static_cast<QWORD>(0) ) );
+
+        return (it != deqWindow.end ( ) && it->first == idNode) ? &it->second : nullptr;
+    };
+
+    size_t nDirty = 0;
+
+    while ( nDirty < vDirty.size ( ) && vDirty[nDirty] < nCapacity )
+    {
+        // rebuild the window from the instructions preceding the edit, whose
+        // stall cycles, hence their relative release cycles, are unchanged
+        deqWindow.clear ( );
+
+        std::vector<NODE_ID_T> vPreceding;
+
+        for ( NODE_ID_T idNode = vDirty[nDirty]; idNode > 0 && vPreceding.size ( ) < m_dwWindow; )
+        {
+            if ( dag.HasNode ( --idNode ) )
+                vPreceding.push_back ( idNode );
+        }
+
+        QWORD qwPrevRelease = 0;
+
+        for ( std::vector<NODE_ID_T>::const_reverse_iterator it = vPreceding.rbegin ( ); it != vPreceding.rend ( ); ++it )
+        {
+            if ( deqWindow.empty ( ) == false )
+                qwPrevRelease += 1 + m_vStallCycles[*it];
+
+            deqWindow.push_back ( std::make_pair ( *it, qwPrevRelease ) );
+        }
+
+        NODE_ID_T idLastDirty = vDirty[nDirty];
+        DWORD     dwSettled   = 0;
+
+        for ( size_t nNode = vDirty[nDirty]; nNode < nCapacity; nNode++ )
+        {
+            const NODE_ID_T idNode = static_cast<NODE_ID_T>(nNode);
+
+            // any edit met on the way extends the region being recomputed
+            for ( ; nDirty < vDirty.size ( ) && vDirty[nDirty] <= idNode; nDirty++ )
+            {
+                idLastDirty = vDirty[nDirty];
+                dwSettled   = 0;
+            }
+
+            const BYTE byPrevious = m_vStallCycles[nNode];
+            BYTE       byStalls   = 0;
+
+            if ( dag.HasNode ( idNode ) )
+            {
+                // absent any hazard, an instruction follows its predecessor by one cycle
+                const QWORD qwEarliest = deqWindow.empty ( ) ? 0 : qwPrevRelease + 1;
+                QWORD       qwRequired = qwEarliest;
+
+                const CGraphNode& node = dag.GetNode ( idNode );
+
+                for ( CGraphNode::const_iterator it = node.beginEdge ( ); it != node.endEdge ( ); ++it )
+                {
+                    const QWORD* pRelease = (it->GetDestNodeID ( ) != idNode) ? FindRelease ( it->GetDestNodeID ( ) ) : nullptr;
+
+                    if ( pRelease != nullptr )
+                        qwRequired = std::max ( qwRequired, *pRelease + GetLatency ( dag, it->GetDestNodeID ( ) ) );
+                }
+
+                // the unit remains busy after the latest instruction of the
+                // same class, should it be within the window
+                const DWORD dwInterval = GetInterval ( dag, idNode );
+
+                if ( dwInterval > 0 )
+                {
+                    const BYTE byClass = GetClassIndex ( dag, idNode );
+
+                    for ( std::deque<std::pair<NODE_ID_T, QWORD>>::const_reverse_iterator it = deqWindow.rbegin ( );
+                          it != deqWindow.rend ( ); ++it )
+                    {
+                        if ( GetClassIndex ( dag, it->first ) == byClass )
+                        {
+                            qwRequired = std::max<QWORD> ( qwRequired, it->second + dwInterval );
+                            break;
+                        }
+                    }
+                }
+
+                byStalls      = static_cast<BYTE>(std::min<QWORD> ( qwRequired - qwEarliest, MAX_STALL_CYCLES ));
+                qwPrevRelease = qwEarliest + byStalls;
+
+                deqWindow.push_back ( std::make_pair ( idNode, qwPrevRelease ) );
+
+                if ( deqWindow.size ( ) > m_dwWindow )
+                    deqWindow.pop_front ( );
+
+                m_nNumRecomputed++;
+            }
+
+            m_vStallCycles[nNode] = byStalls;
+            m_qwTotalStalls       = m_qwTotalStalls + byStalls - byPrevious;
+
+            // once as many instructions as fill the window require the stall
+            // cycles they did before, the rest follow suit
+            if ( idNode > idLastDirty && dag.HasNode ( idNode ) )
+                dwSettled = (byStalls == byPrevious) ? dwSettled + 1 : 0;
+
+            if ( bSettle && idNode >= idLastDirty && dwSettled >= m_dwWindow )
+                break;
+        }
+    }
+}
+
+bool CIncrementalAnalysis::UpdateEarliest ( const CDependencyGraph& dag, const std::vector<NODE_ID_T>& vDirty ) noexcept
+{
+    // no earliest start exceeds that of a single chain through every node
+    const QWORD qwMaxEarliest = 1 + static_cast<QWORD>(m_nNumNodes) * (m_dwMaxPenalty + 1);
+
+    PROPAGATION_QUEUE_T queNodes;
+
+    for ( std::vector<NODE_ID_T>::const_iterator it = vDirty.begin ( ); it != vDirty.end ( ); ++it )
+    {
+        if ( *it < m_vEarliest.size ( ) && m_vQueued[*it] == 0 )
+        {
+            m_vQueued[*it] = 1;
+            queNodes.push ( PROPAGATION_ENTRY { m_vEarliest[*it], *it } );
+        }
+    }
+
+    bool bReturn = true;
+
+    while ( queNodes.empty ( ) == false )
+    {
+        const NODE_ID_T idNode = queNodes.top ( ).idNode;
+
+        queNodes.pop ( );
+        m_vQueued[idNode] = 0;
+
+        QWORD qwEarliest = 0;
+
+        if ( dag.HasNode ( idNode ) )
+        {
+            const CGraphNode& node = dag.GetNode ( idNode );
+
+            qwEarliest = 1;
+
+            for ( CGraphNode::const_iterator it = node.beginEdge ( ); it != node.endEdge ( ); ++it )
+            {
+                const NODE_ID_T idProducer = it->GetDestNodeID ( );
+
+                if ( idProducer != idNode && dag.HasNode ( idProducer ) )
+                    qwEarliest = std::max ( qwEarliest, m_vEarliest[idProducer] + GetLatency ( dag, idProducer ) );
+            }
+
+            m_nNumRecomputed++;
+        }
+
+        if ( qwEarliest == m_vEarliest[idNode] )
+            continue;
+
+        // the earliest starts only keep growing around a dependency cycle
+        if ( qwEarliest > qwMaxEarliest )
+            bReturn = false;
+
+        SetEarliest ( idNode, qwEarliest );
+
+        if ( bReturn == false )
+            break;
+
+        const std::vector<NODE_ID_T>& vConsumers = m_vConsumers[idNode];
+
+        for ( std::vector<NODE_ID_T>::const_iterator it = vConsumers.begin ( ); it != vConsumers.end ( ); ++it )
+        {
+            if ( *it != idNode && m_vQueued[*it] == 0 )
+            {
+                m_vQueued[*it] = 1;
+                queNodes.push ( PROPAGATION_ENTRY { m_vEarliest[*it], *it } );
+            }
+        }
+    }
+
+    for ( ; queNodes.empty ( ) == false; queNodes.pop ( ) )
+        m_vQueued[queNodes.top ( ).idNode] = 0;
+
+    return bReturn;
+}
+
+bool CIncrementalAnalysis::UpdatePriority ( const CDependencyGraph& dag, const std::vector<NODE_ID_T>& vDirty ) noexcept
+{
+    // no chain is longer than one through every node
+    const QWORD qwMaxPriority = static_cast<QWORD>(m_nNumNodes) * (m_dwMaxPenalty + 1);
+
+    PROPAGATION_QUEUE_T queNodes;
+
+    for ( std::vector<NODE_ID_T>::const_iterator it = vDirty.begin ( ); it != vDirty.end ( ); ++it )
+    {
+        if ( *it < m_vPriority.size ( ) && m_vQueued[*it] == 0 )
+        {
+            m_vQueued[*it] = 1;
+            queNodes.push ( PROPAGATION_ENTRY { m_vPriority[*it], *it } );
+        }
+    }
+
+    bool bReturn = true;
+
+    while ( queNodes.empty ( ) == false )
+    {
+        const NODE_ID_T idNode = queNodes.top ( ).idNode;
+
+        queNodes.pop ( );
+        m_vQueued[idNode] = 0;
+
+        QWORD qwPriority = 0;
+
+        if ( dag.HasNode ( idNode ) )
+        {
+            const QWORD qwLatency = GetLatency ( dag, idNode );
+
+            const std::vector<NODE_ID_T>& vConsumers = m_vConsumers[idNode];
+
+            for ( std::vector<NODE_ID_T>::const_iterator it = vConsumers.begin ( ); it != vConsumers.end ( ); ++it )
+            {
+                if ( *it != idNode && dag.HasNode ( *it ) )
+                    qwPriority = std::max ( qwPriority, qwLatency + m_vPriority[*it] );
+            }
+
+            m_nNumRecomputed++;
+        }
+
+        if ( qwPriority == m_vPriority[idNode] )
+            continue;
+
+        m_vPriority[idNode] = qwPriority;
+
+        // the priorities only keep growing around a dependency cycle
+        if ( qwPriority > qwMaxPriority )
+        {
+            bReturn = false;
+            break;
+        }
+
+        // the producers of a node being its edges, those of a removed node have
+        // had their own edges removed, and so are queued by the edit itself
+        if ( dag.HasNode ( idNode ) == false )
+            continue;
+
+        const CGraphNode& node = dag.GetNode ( idNode );
+
+        for ( CGraphNode::const_iterator it = node.beginEdge ( ); it != node.endEdge ( ); ++it )
+        {
+            const NODE_ID_T idProducer = it->GetDestNodeID ( );
+
+            if ( idProducer != idNode && idProducer < m_vPriority.size ( ) && m_vQueued[idProducer] == 0 )
+            {
+                m_vQueued[idProducer] = 1;
+                queNodes.push ( PROPAGATION_ENTRY { m_vPriority[idProducer], idProducer } );
+            }
+        }
+    }
+
+    for ( ; queNodes.empty ( ) == false; queNodes.pop ( ) )
+        m_vQueued[queNodes.top ( ).idNode] = 0;
+
+    return bReturn;
+}
+
+void CIncrementalAnalysis::SetEarliest ( const NODE_ID_T& idNode, QWORD qwEarliest ) noexcept
+{
+    const QWORD qwPrevious = m_vEarliest[idNode];
+
+    if ( qwPrevious != 0 )
+    {
+        std::map<QWORD, size_t>::iterator it = m_mapEarliest.find ( qwPrevious );
+
+        if ( it != m_mapEarliest.end ( ) && --it->second == 0 )
+            m_mapEarliest.erase ( it );
+    }
+
+    if ( qwEarliest != 0 )
+        m_mapEarliest[qwEarliest]++;
+
+    m_vEarliest[idNode] = qwEarliest;
+}
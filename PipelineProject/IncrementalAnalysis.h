@@ -0,0 +1,302 @@
+/**
+* @file       IncrementalAnalysis.h
+* @brief      CIncrementalAnalysis class interface
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  Analysis of a CDependencyGraph which is being edited, kept up to date by
+*  way of the graph's change log rather than by freezing and analyzing the
+*  whole graph again.  The following are maintained:
+*  - the stall cycles each instruction requires when issued in node ID
+*    order, as computed by CHazardAnalysis
+*  - the earliest start of each instruction, hence the critical path length
+*    and the lower bound on the cycles required, as computed by CCriticalPath
+*  - the length of the longest dependency chain originating from each
+*    instruction, i.e. its CListScheduler priority, and hence its latest
+*    start and slack
+*
+*  An edit disturbs the stall cycles of the instructions issued after it
+*  only until the last few instructions, as many as the largest stall
+*  penalty, or the longest issue interval less one, are seen to require
+*  their previous stall cycles, beyond which
+*  every instruction is simply released that much earlier or later.  An
+*  earliest start, or a priority, that is changed by an edit is propagated
+*  along the dependencies until the values found are those already held.
+*  Either way, the work done is proportional to the extent of the edit's
+*  effect, rather than to the size of the graph.
+*
+*  The graph's change log must be enabled, and not cleared past the changes
+*  yet to be applied, from the time of the initial analysis onwards.
+*/
+#pragma once
+
+#if !defined(_INCREMENTAL_ANALYSIS_H__)
+#define _INCREMENTAL_ANALYSIS_H__
+
+#ifndef _DEPENDENCY_GRAPH_H__
+    #include "DependencyGraph.h"
+#endif
+
+#ifndef _CSR_DEPENDENCY_GRAPH_H__
+    #include "CsrDependencyGraph.h"
+#endif
+
+#ifndef _PIPELINE_CONFIG_H__
+    #include "PipelineConfig.h"
+#endif
+
+#ifndef _MAP_
+    #include <map>
+#endif
+
+#ifndef _VECTOR_
+    #include <vector>
+#endif
+
+/**
+    @brief Incrementally updated analysis of an editable dependency graph
+*/
+class CIncrementalAnalysis
+{
+    CPipelineConfig                     m_Config;         ///< pipeline descriptor
+    QWORD                               m_qwLatency[(NF_CLASS_MASK >> NF_CLASS_SHIFT) + 1]; ///< latency of a dependency upon each class
+    DWORD                               m_dwMaxPenalty;   ///< largest stall penalty of any class
+    DWORD                               m_dwInterval[(NF_CLASS_MASK >> NF_CLASS_SHIFT) + 1]; ///< unit issue interval of each class
+    DWORD                               m_dwWindow;       ///< instructions able to delay the next, the greater of
+                                                          ///< m_dwMaxPenalty and the longest issue interval less one
+    bool                                m_bValid;         ///< the results reflect the graph
+    QWORD                               m_qwLogPosition;  ///< sequence number of the next change to be applied
+    size_t                              m_nNumNodes;      ///< number of instructions analyzed
+    size_t                              m_nNumRecomputed; ///< results recomputed by the last analysis
+    std::vector<std::vector<NODE_ID_T>> m_vConsumers;     ///< nodes having an edge to each node ID
+    std::vector<BYTE>                   m_vStallCycles;   ///< stall cycles required, indexed by node ID
+    QWORD                               m_qwTotalStalls;  ///< sum of all stall cycles required
+    std::vector<QWORD>                  m_vEarliest;      ///< earliest start, 0 if not in the graph
+    std::vector<QWORD>                  m_vPriority;      ///< longest dependency chain originating from each node
+    std::map<QWORD, size_t>             m_mapEarliest;    ///< number of instructions of each earliest start
+    std::vector<BYTE>                   m_vQueued;        ///< node is awaiting propagation
+
+public:
+    /// Default Constructor
+    CIncrementalAnalysis() noexcept;
+
+    /// Default Destructor
+    ~CIncrementalAnalysis() = default;
+
+/**
+    @brief Analyzes the whole graph
+
+    The changes recorded by the graph up to this point are deemed to have
+    been applied.
+
+    @param [in] dag         graph of instruction dependencies
+    @param [in] config      descriptor of the pipeline
+
+    @retval true            on success
+    @retval false           if the graph contains a dependency cycle
+*/
+    bool Analyze(const CDependencyGraph& dag, const CPipelineConfig& config) noexcept;
+
+/**
+    @brief Applies the changes recorded by the graph since the last analysis
+
+    Should the changes no longer be available, or the last analysis have
+    failed, the whole graph is analyzed instead.
+
+    @param [in] dag         graph of instruction dependencies, as
+                            previously analyzed, then edited
+
+    @retval true            on success
+    @retval false           if the graph contains a dependency cycle
+*/
+    bool Update(const CDependencyGraph& dag) noexcept;
+
+/**
+    @brief Retrieves the stall cycles required by an instruction
+
+    @param [in] idNode      target node ID
+
+    @retval DWORD           count of stall cycles, saturated at 0xFF
+*/
+    DWORD GetStallCycles(const NODE_ID_T& idNode) const noexcept
+    { return (idNode < m_vStallCycles.size()) ? m_vStallCycles[idNode] : 0; };
+
+/**
+    @brief Retrieves the total stall cycles required
+
+    @retval QWORD           count of stall cycles
+*/
+    constexpr QWORD GetTotalStalls(void) const noexcept
+    { return m_qwTotalStalls; };
+
+/**
+    @brief Retrieves the earliest start of an instruction
+
+    @param [in] idNode      target node ID
+
+    @retval QWORD           1-based issue slot, 0 if not in the graph
+*/
+    QWORD GetEarliestStart(const NODE_ID_T& idNode) const noexcept
+    { return (idNode < m_vEarliest.size()) ? m_vEarliest[idNode] : 0; };
+
+/**
+    @brief Retrieves the latest start of an instruction
+
+    @param [in] idNode      target node ID
+
+    @retval QWORD           1-based issue slot, 0 if not in the graph
+*/
+    QWORD GetLatestStart(const NODE_ID_T& idNode) const noexcept
+    { return (GetEarliestStart(idNode) != 0) ? GetCriticalPathLength() - m_vPriority[idNode] : 0; };
+
+/**
+    @brief Retrieves the slack of an instruction
+
+    @param [in] idNode      target node ID
+
+    @retval QWORD           issue slots the instruction may be delayed
+                            by without lengthening the critical path
+*/
+    QWORD GetSlack(const NODE_ID_T& idNode) const noexcept
+    { return GetLatestStart(idNode) - GetEarliestStart(idNode); };
+
+/**
+    @brief Retrieves the scheduling priority of an instruction
+
+    @param [in] idNode      target node ID
+
+    @retval QWORD           length in cycles of the longest dependency
+                            chain originating from the instruction
+*/
+    QWORD GetPriority(const NODE_ID_T& idNode) const noexcept
+    { return (idNode < m_vPriority.size()) ? m_vPriority[idNode] : 0; };
+
+/**
+    @brief Retrieves the critical path length
+
+    @retval QWORD           latest earliest start of any instruction
+*/
+    QWORD GetCriticalPathLength(void) const noexcept
+    { return m_mapEarliest.empty() ? 0 : m_mapEarliest.rbegin()->first; };
+
+/**
+    @brief Retrieves the lower bound on the cycles required to execute
+           every instruction, regardless of their issue order
+
+    @retval QWORD           count of cycles
+*/
+    QWORD GetCycleLowerBound(void) const noexcept;
+
+/**
+    @brief Retrieves the number of results recomputed by the last analysis
+
+    Each instruction's stall cycles, earliest start and priority count as
+    a result of their own, every time they are recomputed.
+
+    @retval size_t          count of results
+*/
+    constexpr size_t GetNumRecomputed(void) const noexcept
+    { return m_nNumRecomputed; };
+
+/**
+    @brief Releases the results of the last analysis
+*/
+    void Clear(void) noexcept;
+
+private:
+/**
+    @brief Retrieves the latency of a dependency upon a producer
+
+    @param [in] dag         graph of instruction dependencies
+    @param [in] idProducer  node ID of the producer
+
+    @retval QWORD           cycles, one more than the stall penalty
+*/
+    QWORD GetLatency(const CDependencyGraph& dag, const NODE_ID_T& idProducer) const noexcept
+    { return m_qwLatency[GetClassIndex(dag, idProducer)]; };
+
+/**
+    @brief Retrieves the issue interval of the unit executing an instruction
+
+    @param [in] dag         graph of instruction dependencies
+    @param [in] idNode      node ID of the instruction
+
+    @retval DWORD           cycles, 0 if the unit accepts an instruction
+                            every cycle
+*/
+    DWORD GetInterval(const CDependencyGraph& dag, const NODE_ID_T& idNode) const noexcept
+    { return m_dwInterval[GetClassIndex(dag, idNode)]; };
+
+/**
+    @brief Retrieves the class of an instruction as the frozen node flags
+           represent it
+
+    @param [in] dag         graph of instruction dependencies
+    @param [in] idNode      node ID of the instruction
+
+    @retval BYTE            class index, in [0..NF_CLASS_MASK >> NF_CLASS_SHIFT]
+*/
+    static BYTE GetClassIndex(const CDependencyGraph& dag, const NODE_ID_T& idNode) noexcept
+    { return (static_cast<BYTE>(dag.GetNode(idNode).GetClass() << NF_CLASS_SHIFT) & NF_CLASS_MASK) >> NF_CLASS_SHIFT; };
+
+/**
+    @brief Grows the per-node results to the graph's node ID range
+
+    @param [in] nCapacity   one past the highest node ID
+*/
+    void Resize(size_t nCapacity) noexcept;
+
+/**
+    @brief Recomputes the stall cycles of the instructions issued from the
+           first of a set of edited nodes onwards
+
+    @param [in] dag         graph of instruction dependencies
+    @param [in] vDirty      IDs of the edited nodes, sorted in ascending
+                            order
+    @param [in] bSettle     stop once the previous stall cycles are seen
+                            to hold, false if they are not yet known
+*/
+    void UpdateStalls(const CDependencyGraph& dag, const std::vector<NODE_ID_T>& vDirty, bool bSettle) noexcept;
+
+/**
+    @brief Recomputes the earliest starts of a set of nodes, propagating
+           any change to their consumers
+
+    @param [in] dag         graph of instruction dependencies
+    @param [in] vDirty      IDs of the nodes to be recomputed
+
+    @retval true            on success
+    @retval false           if a dependency cycle is found
+*/
+    bool UpdateEarliest(const CDependencyGraph& dag, const std::vector<NODE_ID_T>& vDirty) noexcept;
+
+/**
+    @brief Recomputes the priorities of a set of nodes, propagating any
+           change to their producers
+
+    @param [in] dag         graph of instruction dependencies
+    @param [in] vDirty      IDs of the nodes to be recomputed
+
+    @retval true            on success
+    @retval false           if a dependency cycle is found
+*/
+    bool UpdatePriority(const CDependencyGraph& dag, const std::vector<NODE_ID_T>& vDirty) noexcept;
+
+/**
+    @brief Records a change in the earliest start of a node
+
+    @param [in] idNode      target node ID
+    @param [in] qwEarliest  new earliest start, 0 if not in the graph
+*/
+    void SetEarliest(const NODE_ID_T& idNode, QWORD qwEarliest) noexcept;
+
+    /// copy constructor
+    CIncrementalAnalysis(const CIncrementalAnalysis& o) = delete;
+
+    /// assignment operator
+    CIncrementalAnalysis& operator=(const CIncrementalAnalysis& rhs) = delete;
+};
+
+#endif
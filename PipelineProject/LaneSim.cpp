@@ -0,0 +1,379 @@
+/**
+* @file       LaneSim.cpp
+* @brief      CLaneSim class implementation
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*/
+
+#include "stdafx.h"
+#include "LaneSim.h"
+
+#ifndef _CLIMITS_
+    #include <climits>
+#endif
+
+#ifndef _CSTRING_
+    #include <cstring>
+#endif
+
+#if defined(__AVX2__)
+    #define LANE_SIM_AVX2
+    #include <immintrin.h>
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define LANE_SIM_SSE2
+    #include <emmintrin.h>
+#endif
+
+/// content of an empty stage, as INVALID_INSTRUCTION
+constexpr int SLOT_EMPTY  = -1;
+/// content of a stage occupied by a bubble, as NOOP_INSTRUCTION
+constexpr int SLOT_BUBBLE = -2;
+/// bytes read beyond the last stall cycle by a 32-bit gather
+constexpr size_t GATHER_PADDING = sizeof(int) - 1;
+
+/*
+    A lane vector holds a value of each of a block of adjacent lanes, a
+    mask being a lane vector of 0 or -1 (all bits set) values.  Each of the
+    following operations applies to every lane of the block.
+*/
+#if defined(LANE_SIM_AVX2)
+
+typedef __m256i LANE_VECTOR;
+
+/// number of lanes of a lane vector
+constexpr DWORD LANE_WIDTH = 8;
+
+static inline LANE_VECTOR LaneLoad ( const int* pValues ) noexcept
+{ return _mm256_loadu_si256 ( reinterpret_cast<const __m256i*>(pValues) ); }
+
+static inline void LaneStore ( int* pValues, LANE_VECTOR v ) noexcept
+{ _mm256_storeu_si256 ( reinterpret_cast<__m256i*>(pValues), v ); }
+
+static inline LANE_VECTOR LaneSet ( int iValue ) noexcept
+{ return _mm256_set1_epi32 ( iValue ); }
+
+static inline LANE_VECTOR LaneAdd ( LANE_VECTOR a, LANE_VECTOR b ) noexcept
+{ return _mm256_add_epi32 ( a, b ); }
+
+static inline LANE_VECTOR LaneSub ( LANE_VECTOR a, LANE_VECTOR b ) noexcept
+{ return _mm256_sub_epi32 ( a, b ); }
+
+static inline LANE_VECTOR LaneAnd ( LANE_VECTOR a, LANE_VECTOR b ) noexcept
+{ return _mm256_and_si256 ( a, b ); }
+
+/// (not a) and b
+static inline LANE_VECTOR LaneAndNot ( LANE_VECTOR a, LANE_VECTOR b ) noexcept
+{ return _mm256_andnot_si256 ( a, b ); }
+
+static inline LANE_VECTOR LaneOr ( LANE_VECTOR a, LANE_VECTOR b ) noexcept
+{ return _mm256_or_si256 ( a, b ); }
+
+/// mask of a > b
+static inline LANE_VECTOR LaneGreater ( LANE_VECTOR a, LANE_VECTOR b ) noexcept
+{ return _mm256_cmpgt_epi32 ( a, b ); }
+
+/// mask ? a : b
+static inline LANE_VECTOR LaneSelect ( LANE_VECTOR mask, LANE_VECTOR a, LANE_VECTOR b ) noexcept
+{ return _mm256_blendv_epi8 ( b, a, mask ); }
+
+/// true if any lane of the mask is set
+static inline bool LaneAny ( LANE_VECTOR mask ) noexcept
+{ return _mm256_movemask_epi8 ( mask ) != 0; }
+
+/// mask ? pBytes[index] : 0
+static inline LANE_VECTOR LaneGather ( const BYTE* pBytes, LANE_VECTOR index, LANE_VECTOR mask ) noexcept
+{
+    const LANE_VECTOR v = _mm256_mask_i32gather_epi32 ( _mm256_setzero_si256 ( ), reinterpret_cast<const int*>(pBytes), index, mask, 1 );
+
+    return _mm256_and_si256 ( v, _mm256_set1_epi32 ( 0xFF ) );
+}
+
+#elif defined(LANE_SIM_SSE2)
+
+typedef __m128i LANE_VECTOR;
+
+/// number of lanes of a lane vector
+constexpr DWORD LANE_WIDTH = 4;
+
+static inline LANE_VECTOR LaneLoad ( const int* pValues ) noexcept
+{ return _mm_loadu_si128 ( reinterpret_cast<const __m128i*>(pValues) ); }
+
+static inline void LaneStore ( int* pValues, LANE_VECTOR v ) noexcept
+{ _mm_storeu_si128 ( reinterpret_cast<__m128i*>(pValues), v ); }
+
+static inline LANE_VECTOR LaneSet ( int iValue ) noexcept
+{ return _mm_set1_epi32 ( iValue ); }
+
+static inline LANE_VECTOR LaneAdd ( LANE_VECTOR a, LANE_VECTOR b ) noexcept
+{ return _mm_add_epi32 ( a, b ); }
+
+static inline LANE_VECTOR LaneSub ( LANE_VECTOR a, LANE_VECTOR b ) noexcept
+{ return _mm_sub_epi32 ( a, b ); }
+
+static inline LANE_VECTOR LaneAnd ( LANE_VECTOR a, LANE_VECTOR b ) noexcept
+{ return _mm_and_si128 ( a, b ); }
+
+/// (not a) and b
+static inline LANE_VECTOR LaneAndNot ( LANE_VECTOR a, LANE_VECTOR b ) noexcept
+{ return _mm_andnot_si128 ( a, b ); }
+
+static inline LANE_VECTOR LaneOr ( LANE_VECTOR a, LANE_VECTOR b ) noexcept
+{ return _mm_or_si128 ( a, b ); }
+
+/// mask of a > b
+static inline LANE_VECTOR LaneGreater ( LANE_VECTOR a, LANE_VECTOR b ) noexcept
+{ return _mm_cmpgt_epi32 ( a, b ); }
+
+/// mask ? a : b, SSE2 having no blend instruction
+static inline LANE_VECTOR LaneSelect ( LANE_VECTOR mask, LANE_VECTOR a, LANE_VECTOR b ) noexcept
+{ return _mm_or_si128 ( _mm_and_si128 ( mask, a ), _mm_andnot_si128 ( mask, b ) ); }
+
+/// true if any lane of the mask is set
+static inline bool LaneAny ( LANE_VECTOR mask ) noexcept
+{ return _mm_movemask_epi8 ( mask ) != 0; }
+
+/// mask ? pBytes[index] : 0, SSE2 having no gather instruction
+static inline LANE_VECTOR LaneGather ( const BYTE* pBytes, LANE_VECTOR index, LANE_VECTOR mask ) noexcept
+{
+    alignas(16) int rgIndex[LANE_WIDTH];
+    alignas(16) int rgMask[LANE_WIDTH];
+
+    _mm_store_si128 ( reinterpret_cast<__m128i*>(rgIndex), index );
+    _mm_store_si128 ( reinterpret_cast<__m128i*>(rgMask), mask );
+
+    return _mm_set_epi32 ( rgMask[3] ? pBytes[rgIndex[3]] : 0, rgMask[2] ? pBytes[rgIndex[2]] : 0,
+                           rgMask[1] ? pBytes[rgIndex[1]] : 0, rgMask[0] ? pBytes[rgIndex[0]] : 0 );
+}
+
+#else
+
+typedef int LANE_VECTOR;
+
+/// number of lanes of a lane vector
+constexpr DWORD LANE_WIDTH = 1;
+
+static inline LANE_VECTOR LaneLoad ( const int* pValues ) noexcept
+{ return *pValues; }
+
+static inline void LaneStore ( int* pValues, LANE_VECTOR v ) noexcept
+{ *pValues = v; }
+
+static inline LANE_VECTOR LaneSet ( int iValue ) noexcept
+{ return iValue; }
+
+static inline LANE_VECTOR LaneAdd ( LANE_VECTOR a, LANE_VECTOR b ) noexcept
+{ return static_cast<int>(static_cast<unsigned int>(a) + static_cast<unsigned int>(b)); }
+
+static inline LANE_VECTOR LaneSub ( LANE_VECTOR a, LANE_VECTOR b ) noexcept
+{ return static_cast<int>(static_cast<unsigned int>(a) - static_cast<unsigned int>(b)); }
+
+static inline LANE_VECTOR LaneAnd ( LANE_VECTOR a, LANE_VECTOR b ) noexcept
+{ return a & b; }
+
+/// (not a) and b
+static inline LANE_VECTOR LaneAndNot ( LANE_VECTOR a, LANE_VECTOR b ) noexcept
+{ return ~a & b; }
+
+static inline LANE_VECTOR LaneOr ( LANE_VECTOR a, LANE_VECTOR b ) noexcept
+{ return a | b; }
+
+/// mask of a > b
+static inline LANE_VECTOR LaneGreater ( LANE_VECTOR a, LANE_VECTOR b ) noexcept
+{ return (a > b) ? -1 : 0; }
+
+/// mask ? a : b
+static inline LANE_VECTOR LaneSelect ( LANE_VECTOR mask, LANE_VECTOR a, LANE_VECTOR b ) noexcept
+{ return mask ? a : b; }
+
+/// true if any lane of the mask is set
+static inline bool LaneAny ( LANE_VECTOR mask ) noexcept
+{ return mask != 0; }
+
+/// mask ? pBytes[index] : 0
+static inline LANE_VECTOR LaneGather ( const BYTE* pBytes, LANE_VECTOR index, LANE_VECTOR mask ) noexcept
+{ return mask ? pBytes[index] : 0; }
+
+#endif
+
+static_assert ( (MAX_SIM_LANES % LANE_WIDTH) == 0, "the lanes must form whole lane vectors" );
+
+
+CLaneSim::CLaneSim ( const CPipelineConfig& config ) noexcept
+    : m_dwNumStages   ( config.GetNumStages ( ) ),
+      m_dwHazardStage ( config.GetHazardStage ( ) ),
+      m_dwNumLanes    ( 0 ),
+      m_vStallCycles  ( GATHER_PADDING, 0 )
+{
+    Reset ( );
+}
+
+bool CLaneSim::AddLane ( const BYTE* pStallCycles, size_t nNumInstructions ) noexcept
+{
+    const size_t nBase = m_vStallCycles.size ( ) - GATHER_PADDING;
+
+    // the lanes' sequence positions, and offsets within m_vStallCycles, are
+    // 32-bit lane vector values
+    if ( m_dwNumLanes == MAX_SIM_LANES || nNumInstructions > static_cast<size_t>(INT_MAX) - m_vStallCycles.size ( ) )
+        return false;
+
+    // as are the lane's cycle and stall counts
+    QWORD qwNumCycles = static_cast<QWORD>(nNumInstructions) + m_dwNumStages;
+
+    for ( size_t i = 0; i < nNumInstructions; i++ )
+        qwNumCycles += pStallCycles[i];
+
+    if ( qwNumCycles > static_cast<QWORD>(INT_MAX) )
+        return false;
+
+    // the padding, following the last sequence, is moved to follow this one
+    m_vStallCycles.resize ( nBase );
+    m_vStallCycles.insert ( m_vStallCycles.end ( ), pStallCycles, pStallCycles + nNumInstructions );
+    m_vStallCycles.resize ( m_vStallCycles.size ( ) + GATHER_PADDING, 0 );
+
+    m_rgBase[m_dwNumLanes]  = static_cast<int>(nBase);
+    m_rgCount[m_dwNumLanes] = static_cast<int>(nNumInstructions);
+
+    m_dwNumLanes++;
+
+    return true;
+}
+
+bool CLaneSim::ProcessNextCycle ( void ) noexcept
+{
+    const DWORD dwLast   = m_dwNumStages - 1;
+    const DWORD dwHazard = m_dwHazardStage;
+
+    const LANE_VECTOR vEmpty  = LaneSet ( SLOT_EMPTY );
+    const LANE_VECTOR vBubble = LaneSet ( SLOT_BUBBLE );
+    const LANE_VECTOR vZero   = LaneSet ( 0 );
+    const BYTE*       pStalls = m_vStallCycles.data ( );
+
+    bool bReturn = false;
+
+    // the lanes beyond the last one added are left empty, and so have no
+    // bearing upon those in the same lane vector
+    for ( DWORD dwLane = 0; dwLane < m_dwNumLanes; dwLane += LANE_WIDTH )
+    {
+        // an instruction in the hazard detection stage with stall cycles
+        // remaining holds it, and every stage before it, inserting a bubble
+        // into the stage following it
+        LANE_VECTOR vHazard  = LaneLoad ( &m_rgSlots[dwHazard][dwLane] );
+        LANE_VECTOR vStall   = LaneLoad ( &m_rgStall[dwLane] );
+        LANE_VECTOR vStalled = LaneAnd ( LaneGreater ( vHazard, vEmpty ), LaneGreater ( vStall, vZero ) );
+
+        vStall = LaneAdd ( vStall, vStalled );
+
+        LaneStore ( &m_rgStalls[dwLane],
+                    LaneSub ( LaneLoad ( &m_rgStalls[dwLane] ), vStalled ) );
+
+        // the instruction in the final stage completes in any case
+        const LANE_VECTOR vLastDone = LaneGreater ( LaneLoad ( &m_rgSlots[dwLast][dwLane] ), vEmpty );
+
+        LaneStore ( &m_rgCompleted[dwLane],
+                    LaneSub ( LaneLoad ( &m_rgCompleted[dwLane] ), vLastDone ) );
+
+        // the stages following the bubble advance unconditionally,
+        // from the oldest to the most recently fetched
+        LANE_VECTOR vBusy = vZero;
+
+        for ( DWORD dwStage = dwLast; dwStage > dwHazard + 1; dwStage-- )
+        {
+            const LANE_VECTOR vSlot = LaneLoad ( &m_rgSlots[dwStage - 1][dwLane] );
+
+            LaneStore ( &m_rgSlots[dwStage][dwLane], vSlot );
+
+            vBusy = LaneOr ( vBusy, LaneGreater ( vSlot, vEmpty ) );
+        }
+
+        const LANE_VECTOR vAfterHazard = LaneSelect ( vStalled, vBubble, vHazard );
+
+        LaneStore ( &m_rgSlots[dwHazard + 1][dwLane], vAfterHazard );
+
+        vBusy = LaneOr ( vBusy, LaneGreater ( vAfterHazard, vEmpty ) );
+
+        // the hazard detection stage, and those before it, are held
+        for ( DWORD dwStage = dwHazard; dwStage > 0; dwStage-- )
+        {
+            const LANE_VECTOR vSlot = LaneSelect ( vStalled, LaneLoad ( &m_rgSlots[dwStage][dwLane] ),
+                                                             LaneLoad ( &m_rgSlots[dwStage - 1][dwLane] ) );
+
+            LaneStore ( &m_rgSlots[dwStage][dwLane], vSlot );
+
+            vBusy = LaneOr ( vBusy, LaneGreater ( vSlot, vEmpty ) );
+        }
+
+        // fetch the next instruction, or a bubble once the sequence has
+        // been exhausted
+        const LANE_VECTOR vNext    = LaneLoad ( &m_rgNext[dwLane] );
+        const LANE_VECTOR vPending = LaneGreater ( LaneLoad ( &m_rgCount[dwLane] ), vNext );
+        const LANE_VECTOR vFetch   = LaneSelect ( vPending, vNext, vBubble );
+        const LANE_VECTOR vFirst   = LaneSelect ( vStalled, LaneLoad ( &m_rgSlots[0][dwLane] ), vFetch );
+
+        LaneStore ( &m_rgSlots[0][dwLane], vFirst );
+        LaneStore ( &m_rgNext[dwLane], LaneSub ( vNext, LaneAndNot ( vStalled, vPending ) ) );
+
+        vBusy = LaneOr ( vBusy, LaneGreater ( vFirst, vEmpty ) );
+
+        // an instruction entering the hazard detection stage brings the
+        // stall cycles it requires along with it
+        vHazard = LaneLoad ( &m_rgSlots[dwHazard][dwLane] );
+
+        const LANE_VECTOR vEntered = LaneAndNot ( vStalled, LaneGreater ( vHazard, vEmpty ) );
+        const LANE_VECTOR vGather  = LaneGather ( pStalls, LaneAdd ( LaneLoad ( &m_rgBase[dwLane] ), vHazard ), vEntered );
+
+        LaneStore ( &m_rgStall[dwLane], LaneSelect ( vStalled, vStall, vGather ) );
+
+        // a lane's cycle counts while instructions remain to be executed
+        LaneStore ( &m_rgCycles[dwLane],
+                    LaneSub ( LaneLoad ( &m_rgCycles[dwLane] ), vBusy ) );
+
+        if ( LaneAny ( vBusy ) )
+            bReturn = true;
+    }
+
+    return bReturn;
+}
+
+DWORD CLaneSim::Run ( void ) noexcept
+{
+    DWORD dwReturn = 0;
+
+    while ( ProcessNextCycle ( ) )
+        dwReturn++;
+
+    return dwReturn;
+}
+
+void CLaneSim::GetStageOccupancy ( DWORD dwLane, INSTRUCTION_T* pSlots ) const noexcept
+{
+    for ( DWORD dwStage = 0; dwStage < m_dwNumStages; dwStage++ )
+    {
+        // the negative slot values have the same representation as
+        // NOOP_INSTRUCTION and INVALID_INSTRUCTION
+        pSlots[dwStage] = (dwLane < m_dwNumLanes) ? static_cast<INSTRUCTION_T>(m_rgSlots[dwStage][dwLane])
+                                                  : INVALID_INSTRUCTION;
+    }
+}
+
+void CLaneSim::Reset ( void ) noexcept
+{
+    m_dwNumLanes = 0;
+
+    std::vector<BYTE>(GATHER_PADDING, 0).swap ( m_vStallCycles );
+
+    for ( DWORD dwStage = 0; dwStage < MAX_PIPELINE_STAGES; dwStage++ )
+    {
+        for ( DWORD dwLane = 0; dwLane < MAX_SIM_LANES; dwLane++ )
+            m_rgSlots[dwStage][dwLane] = SLOT_EMPTY;
+    }
+
+    memset ( m_rgStall, 0, sizeof(m_rgStall) );
+    memset ( m_rgNext, 0, sizeof(m_rgNext) );
+    memset ( m_rgCount, 0, sizeof(m_rgCount) );
+    memset ( m_rgBase, 0, sizeof(m_rgBase) );
+    memset ( m_rgCycles, 0, sizeof(m_rgCycles) );
+    memset ( m_rgStalls, 0, sizeof(m_rgStalls) );
+    memset ( m_rgCompleted, 0, sizeof(m_rgCompleted) );
+}
@@ -0,0 +1,179 @@
+/**
+* @file       LaneSim.h
+* @brief      CLaneSim class interface
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  Steps a batch of up to MAX_SIM_LANES independent pipeline simulations in
+*  lockstep, one lane per simulation, such as the configurations of a
+*  parameter sweep.  The lanes share the pipeline depth and hazard detection
+*  stage, whereas each has an instruction sequence, and stall cycles, of its
+*  own.
+*
+*  Rather than the per-instruction objects of CPipelineSim, the lane state
+*  is held as a structure of arrays, e.g. the content of stage n of every
+*  lane is an array of its own, so each cycle is processed by way of SSE2,
+*  or AVX2 where the compiler targets it, a block of 4 or 8 lanes at a time:
+*  - the lanes stalled by the instruction in their hazard detection stage
+*    are determined by a single compare
+*  - every stage is advanced, or held behind a stall, by a single blend
+*  - the stall cycles of the instructions entering the hazard detection
+*    stage are gathered from each lane's sequence
+*
+*  The cycle, stall and completion counts of each lane are exactly those of
+*  a CPipelineSim stepped through the same instructions, provided none is a
+*  branch, nor of a class whose completion CPipelineSim defers.
+*/
+#pragma once
+
+#if !defined(_LANE_SIM_H__)
+#define _LANE_SIM_H__
+
+#ifndef _PIPELINE_SIM_H__
+    #include "PipelineSim.h"
+#endif
+
+#ifndef _VECTOR_
+    #include <vector>
+#endif
+
+/// maximum number of simulations stepped in lockstep
+constexpr DWORD MAX_SIM_LANES = 32;
+
+/**
+    @brief Lockstep simulation of a batch of N-staged pipelines
+*/
+class CLaneSim
+{
+    /// content of a stage, the lane's sequence position of the instruction
+    /// occupying it, negative for a bubble or an empty stage
+    typedef int LANE_SLOT_T;
+
+    DWORD             m_dwNumStages;    ///< number of pipeline stages of every lane
+    DWORD             m_dwHazardStage;  ///< index of the hazard detection stage of every lane
+    DWORD             m_dwNumLanes;     ///< number of lanes added
+    std::vector<BYTE> m_vStallCycles;   ///< stall cycles of every lane's sequence, concatenated
+
+    alignas(32) LANE_SLOT_T m_rgSlots[MAX_PIPELINE_STAGES][MAX_SIM_LANES]; ///< content of each stage of each lane
+    alignas(32) int   m_rgStall[MAX_SIM_LANES];     ///< stall cycles still required in the hazard detection stage
+    alignas(32) int   m_rgNext[MAX_SIM_LANES];      ///< sequence position of the next instruction to be fetched
+    alignas(32) int   m_rgCount[MAX_SIM_LANES];     ///< number of instructions of each sequence
+    alignas(32) int   m_rgBase[MAX_SIM_LANES];      ///< offset of each sequence in m_vStallCycles
+    alignas(32) int   m_rgCycles[MAX_SIM_LANES];    ///< cycles in which instructions remained to be executed
+    alignas(32) int   m_rgStalls[MAX_SIM_LANES];    ///< count of the stalls introduced
+    alignas(32) int   m_rgCompleted[MAX_SIM_LANES]; ///< count of instructions that completed execution
+
+public:
+    /**
+        @brief Initialization Constructor
+
+        @param [in] config      descriptor of the pipeline simulated by every
+                                lane, of which only the depth and hazard
+                                detection stage are of consequence
+    */
+    explicit CLaneSim(const CPipelineConfig& config) noexcept;
+
+    /// Default Destructor
+    ~CLaneSim() = default;
+
+/**
+    @brief Adds a lane, simulating a sequence of instructions
+
+    The instructions are identified by their position in the sequence,
+    only the stall cycles each requires in the hazard detection stage
+    being of consequence.  The stall cycles are copied.
+
+    @param [in] pStallCycles        stall cycles of each instruction, in
+                                    the order fetched
+    @param [in] nNumInstructions    number of instructions
+
+    @retval true            if the lane was added
+    @retval false           if every lane is in use, the sequences of the
+                            lanes would exceed 2^31 instructions, or the
+                            lane would take 2^31 cycles or more
+*/
+    bool AddLane(const BYTE* pStallCycles, size_t nNumInstructions) noexcept;
+
+/**
+    @brief Retrieves the number of lanes added
+
+    @retval DWORD       count of lanes
+*/
+    constexpr DWORD GetNumLanes(void) const noexcept
+    { return m_dwNumLanes; };
+
+/**
+    @brief Processes the next cycle of every lane
+
+    @retval true    if any lane has subsequent instructions to be executed
+    @retval false   if there are no more instructions to be executed
+*/
+    bool ProcessNextCycle(void) noexcept;
+
+/**
+    @brief Processes every remaining cycle of every lane
+
+    @retval DWORD   number of cycles processed in which any lane had
+                    instructions remaining to be executed
+*/
+    DWORD Run(void) noexcept;
+
+/**
+    @brief Retrieves the number of cycles a lane had instructions remaining
+           to be executed, i.e. the count of CPipelineSim::ProcessNextCycle
+           calls which would have returned true
+
+    @param [in] dwLane  index of the lane
+
+    @retval DWORD       count of cycles
+*/
+    DWORD GetCycleCount(DWORD dwLane) const noexcept
+    { return (dwLane < m_dwNumLanes) ? static_cast<DWORD>(m_rgCycles[dwLane]) : 0; };
+
+/**
+    @brief Retrieves the count of stalls introduced into a lane
+
+    @param [in] dwLane  index of the lane
+
+    @retval DWORD       count of stalls
+*/
+    DWORD GetStallCount(DWORD dwLane) const noexcept
+    { return (dwLane < m_dwNumLanes) ? static_cast<DWORD>(m_rgStalls[dwLane]) : 0; };
+
+/**
+    @brief Retrieves the count of instructions a lane has completed
+
+    @param [in] dwLane  index of the lane
+
+    @retval DWORD       count of completed instructions
+*/
+    DWORD GetCompletionCount(DWORD dwLane) const noexcept
+    { return (dwLane < m_dwNumLanes) ? static_cast<DWORD>(m_rgCompleted[dwLane]) : 0; };
+
+/**
+    @brief Retrieves the instruction occupying each stage of a lane
+
+    @param [in]  dwLane     index of the lane
+    @param [out] pSlots     receives the number of stages entries, the
+                            sequence position of the instruction in each
+                            stage, NOOP_INSTRUCTION for a bubble, or
+                            INVALID_INSTRUCTION if empty
+*/
+    void GetStageOccupancy(DWORD dwLane, INSTRUCTION_T* pSlots) const noexcept;
+
+/**
+    @brief Removes every lane, returning the simulation to its initial state
+*/
+    void Reset(void) noexcept;
+
+private:
+    /// copy constructor
+    CLaneSim(const CLaneSim& o) = delete;
+
+    /// assignment operator
+    CLaneSim& operator=(const CLaneSim& rhs) = delete;
+};
+
+#endif
@@ -0,0 +1,178 @@
+/**
+* @file       ListScheduler.cpp
+* @brief      CListScheduler class implementation
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*/
+
+#include "stdafx.h"
+#include "ListScheduler.h"
+
+#ifndef _QUEUE_
+    #include <queue>
+#endif
+
+/**
+    @brief Ready queue entry
+*/
+struct SCHEDULE_ENTRY
+{
+    QWORD       qwAvailable; ///< cycle from which the instruction may issue without a stall
+    QWORD       qwPriority;  ///< critical path length
+    NODE_ID_T   idNode;      ///< instruction node ID
+};
+
+/**
+    @brief Orders the available queue by descending priority, ties being
+           broken in favor of the original instruction order
+*/
+struct CPriorityOrder
+{
+    bool operator()(const SCHEDULE_ENTRY& lhs, const SCHEDULE_ENTRY& rhs) const noexcept
+    {
+        return (lhs.qwPriority != rhs.qwPriority) ? (lhs.qwPriority < rhs.qwPriority)
+                                                  : (lhs.idNode > rhs.idNode);
+    };
+};
+
+/**
+    @brief Orders the pending queue by ascending availability
+*/
+struct CAvailabilityOrder
+{
+    bool operator()(const SCHEDULE_ENTRY& lhs, const SCHEDULE_ENTRY& rhs) const noexcept
+    {
+        return (lhs.qwAvailable != rhs.qwAvailable) ? (lhs.qwAvailable > rhs.qwAvailable)
+                                                    : CPriorityOrder()(lhs, rhs);
+    };
+};
+
+
+CListScheduler::CListScheduler ( ) noexcept
+    : m_vIssueOrder ( ),
+      m_vPriority   ( )
+{
+}
+
+size_t CListScheduler::Schedule ( const CCsrDependencyGraph& dag, const CPipelineConfig& config )
+{
+    Clear ( );
+
+    const size_t nCapacity = dag.GetNodeCapacity ( );
+
+    // the latency of a dependency, in cycles between the producer and the
+    // consumer leaving the hazard detection stage, for each producer class
+    QWORD qwClassLatency[(NF_CLASS_MASK >> NF_CLASS_SHIFT) + 1];
+
+    for ( DWORD i = 0; i < _countof(qwClassLatency); i++ )
+        qwClassLatency[i] = config.GetHazardPenalty ( static_cast<IC_INSTRUCTION_CLASS>(i) ) + 1;
+
+    // order the instructions topologically, producers preceding consumers,
+    // a dependency cycle leaves some instructions impossible to order
+    std::vector<NODE_ID_T> vTopological;
+
+    if ( dag.TopologicalSort ( vTopological ) == false )
+        return 0;
+
+    // count the unscheduled producers of each instruction, disregarding
+    // dependencies upon itself or upon instructions not in the graph
+    std::vector<DWORD> vNumProducers ( nCapacity, 0 );
+
+    for ( std::vector<NODE_ID_T>::const_iterator it = vTopological.begin ( ); it != vTopological.end ( ); ++it )
+    {
+        const CCsrGraphNode node = dag.GetNode ( *it );
+
+        for ( CCsrGraphNode::const_iterator pEdge = node.beginEdge ( ); pEdge != node.endEdge ( ); ++pEdge )
+        {
+            if ( pEdge->GetDestNodeID ( ) != *it && dag.HasNode ( pEdge->GetDestNodeID ( ) ) )
+                vNumProducers[*it]++;
+        }
+    }
+
+    // the priority of each instruction is the length of the longest
+    // dependency chain originating from it, found in reverse topological order
+    m_vPriority.assign ( nCapacity, 0 );
+
+    for ( std::vector<NODE_ID_T>::const_reverse_iterator it = vTopological.rbegin ( ); it != vTopological.rend ( ); ++it )
+    {
+        const CCsrGraphNode node      = dag.GetNode ( *it );
+        const QWORD         qwLatency = qwClassLatency[node.GetClass ( )];
+
+        QWORD qwPriority = 0;
+
+        for ( CCsrGraphNode::const_iterator pIn = node.beginInEdge ( ); pIn != node.endInEdge ( ); ++pIn )
+        {
+            const NODE_ID_T idConsumer = pIn->GetDestNodeID ( );
+
+            if ( idConsumer != *it && qwLatency + m_vPriority[idConsumer] > qwPriority )
+                qwPriority = qwLatency + m_vPriority[idConsumer];
+        }
+
+        m_vPriority[*it] = qwPriority;
+    }
+
+    // list schedule, one instruction being issued per cycle
+    std::priority_queue<SCHEDULE_ENTRY, std::vector<SCHEDULE_ENTRY>, CAvailabilityOrder> quePending;
+    std::priority_queue<SCHEDULE_ENTRY, std::vector<SCHEDULE_ENTRY>, CPriorityOrder>     queAvailable;
+
+    std::vector<QWORD> vAvailable ( nCapacity, 0 );
+
+    for ( CCsrDependencyGraph::const_iterator it = dag.begin ( ); it != dag.end ( ); ++it )
+    {
+        if ( it->IsValid ( ) && vNumProducers[it->GetNodeID ( )] == 0 )
+            queAvailable.push ( SCHEDULE_ENTRY { 0, m_vPriority[it->GetNodeID ( )], it->GetNodeID ( ) } );
+    }
+
+    m_vIssueOrder.reserve ( dag.GetNumNodes ( ) );
+
+    QWORD qwPrevCycle = 0;
+
+    while ( queAvailable.empty ( ) == false || quePending.empty ( ) == false )
+    {
+        QWORD qwCycle = qwPrevCycle + 1;
+
+        // absent any available instruction, stall until the earliest becomes so
+        if ( queAvailable.empty ( ) && quePending.top ( ).qwAvailable > qwCycle )
+            qwCycle = quePending.top ( ).qwAvailable;
+
+        while ( quePending.empty ( ) == false && quePending.top ( ).qwAvailable <= qwCycle )
+        {
+            queAvailable.push ( quePending.top ( ) );
+            quePending.pop ( );
+        }
+
+        const SCHEDULE_ENTRY entry = queAvailable.top ( );
+        queAvailable.pop ( );
+
+        m_vIssueOrder.push_back ( entry.idNode );
+        qwPrevCycle = qwCycle;
+
+        // the consumers of this instruction may issue once its result can be forwarded
+        const CCsrGraphNode node      = dag.GetNode ( entry.idNode );
+        const QWORD         qwReady   = qwCycle + qwClassLatency[node.GetClass ( )];
+
+        for ( CCsrGraphNode::const_iterator pIn = node.beginInEdge ( ); pIn != node.endInEdge ( ); ++pIn )
+        {
+            const NODE_ID_T idConsumer = pIn->GetDestNodeID ( );
+
+            if ( idConsumer == entry.idNode )
+                continue;
+
+            if ( qwReady > vAvailable[idConsumer] )
+                vAvailable[idConsumer] = qwReady;
+
+            if ( --vNumProducers[idConsumer] == 0 )
+                quePending.push ( SCHEDULE_ENTRY { vAvailable[idConsumer], m_vPriority[idConsumer], idConsumer } );
+        }
+    }
+
+    return m_vIssueOrder.size ( );
+}
+
+void CListScheduler::Clear ( void ) noexcept
+{
+    std::vector<NODE_ID_T>().swap ( m_vIssueOrder );
+    std::vector<QWORD>().swap ( m_vPriority );
+}
@@ -0,0 +1,100 @@
+/**
+* @file       ListScheduler.h
+* @brief      CListScheduler class interface
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  Critical-path list scheduling of the instructions contained in a frozen
+*  dependency graph.  Each instruction is assigned a priority equal to the
+*  length, in cycles, of the longest dependency chain originating from it.
+*  The scheduler then issues one instruction per cycle from a ready queue:
+*  - an instruction becomes ready once all of the instructions it depends
+*    upon have been issued
+*  - a ready instruction is available once its operands can be forwarded
+*    to it without a stall
+*  - of the available instructions, the one of highest priority is issued;
+*    if none are available the one becoming available soonest is issued,
+*    incurring the fewest stall cycles
+*
+*  The resulting issue order respects every dependency, and is intended to
+*  be fed to CPipelineSim::InsertInstruction in place of node ID order.
+*  @sa Modern Processor Design, John Paul Shen, Mikko H. Lipasti, 2005
+*/
+#pragma once
+
+#if !defined(_LIST_SCHEDULER_H__)
+#define _LIST_SCHEDULER_H__
+
+#ifndef _CSR_DEPENDENCY_GRAPH_H__
+    #include "CsrDependencyGraph.h"
+#endif
+
+#ifndef _PIPELINE_CONFIG_H__
+    #include "PipelineConfig.h"
+#endif
+
+#ifndef _VECTOR_
+    #include <vector>
+#endif
+
+/**
+    @brief Critical-path priority list scheduler
+*/
+class CListScheduler
+{
+    std::vector<NODE_ID_T> m_vIssueOrder; ///< scheduled order of node IDs
+    std::vector<QWORD>     m_vPriority;   ///< critical path length, indexed by node ID
+
+public:
+    /// Default Constructor
+    CListScheduler() noexcept;
+
+    /// Default Destructor
+    ~CListScheduler() = default;
+
+/**
+    @brief Schedules the instructions of a frozen dependency graph
+
+    The graph must have been frozen with its reverse index, which
+    affords the set of instructions depending upon a given instruction.
+    The working storage, proportional to the graph, throws std::bad_alloc
+    should it not be available.
+
+    @param [in] dag         frozen graph of instruction dependencies
+    @param [in] config      descriptor of the pipeline, whose forwarding
+                            paths determine the latency of each dependency
+
+    @retval size_t          number of instructions scheduled, less than
+                            dag.GetNumNodes() if the graph contains a
+                            dependency cycle or lacks its reverse index
+*/
+    size_t Schedule(const CCsrDependencyGraph& dag, const CPipelineConfig& config);
+
+/**
+    @brief Retrieves the scheduled issue order
+
+    @retval std::vector<NODE_ID_T>&     node IDs in issue order
+*/
+    const std::vector<NODE_ID_T>& GetIssueOrder(void) const noexcept
+    { return m_vIssueOrder; };
+
+/**
+    @brief Retrieves the scheduling priority of an instruction
+
+    @param [in] idNode      target node ID
+
+    @retval QWORD           length in cycles of the longest dependency
+                            chain originating from the instruction
+*/
+    QWORD GetPriority(const NODE_ID_T& idNode) const noexcept
+    { return (idNode < m_vPriority.size()) ? m_vPriority[idNode] : 0; };
+
+/**
+    @brief Releases the results of the last schedule
+*/
+    void Clear(void) noexcept;
+};
+
+#endif
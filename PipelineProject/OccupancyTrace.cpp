@@ -0,0 +1,351 @@
+/**
+* @file       OccupancyTrace.cpp
+* @brief      COccupancyTraceWriter and COccupancyTraceReader class implementations
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*/
+
+#include "stdafx.h"
+#include "OccupancyTrace.h"
+
+/**
+    @brief Determines whether the platform is little-endian
+*/
+static bool IsLittleEndian ( void ) noexcept
+{
+    const DWORD dwProbe = 1;
+    return *reinterpret_cast<const BYTE*>(&dwProbe) == 1;
+}
+
+
+COccupancyTraceWriter::COccupancyTraceWriter ( ) noexcept
+    : m_pFile            ( nullptr ),
+      m_dwNumStages      ( 0 ),
+      m_dwSlotsPerStage  ( 0 ),
+      m_qwLastStallCount ( 0 ),
+      m_qwNumCycles      ( 0 ),
+      m_nBufferSize      ( 0 ),
+      m_vFront           ( ),
+      m_vBack            ( ),
+      m_mtxLock          ( ),
+      m_cvHandOver       ( ),
+      m_bPending         ( false ),
+      m_bStop            ( false ),
+      m_bError           ( false ),
+      m_thrWriter        ( )
+{
+}
+
+COccupancyTraceWriter::~COccupancyTraceWriter ( )
+{
+    Close ( );
+}
+
+bool COccupancyTraceWriter::Open ( const TCHAR* szFileName, DWORD dwNumStages, DWORD dwSlotsPerStage,
+                                   size_t nBufferSize ) noexcept
+{
+    Close ( );
+
+    if ( IsLittleEndian ( ) == false || dwNumStages == 0 || dwSlotsPerStage == 0 || dwSlotsPerStage > MAX_ISSUE_WIDTH )
+        return false;
+
+    m_pFile = _tfopen ( szFileName, _T("wb") );
+
+    if ( m_pFile == nullptr )
+        return false;
+
+    m_dwNumStages      = dwNumStages;
+    m_dwSlotsPerStage  = dwSlotsPerStage;
+    m_qwLastStallCount = 0;
+    m_qwNumCycles      = 0;
+    m_bPending         = false;
+    m_bStop            = false;
+
+    // the header is completed once the number of cycles is known
+    OCCUPANCY_FILE_HEADER hdr = { };
+
+    hdr.dwMagic     = OCCUPANCY_FILE_MAGIC;
+    hdr.dwByteOrder = OCCUPANCY_FILE_BYTE_ORDER;
+    hdr.dwVersion   = OCCUPANCY_FILE_VERSION;
+    hdr.dwNumStages     = m_dwNumStages;
+    hdr.dwSlotsPerStage = m_dwSlotsPerStage;
+
+    m_bError = (fwrite ( &hdr, sizeof(hdr), 1, m_pFile ) != 1);
+
+    // each buffer holds a whole number of records, and at least one
+    const size_t nRecordSize = GetOccupancyRecordSize ( m_dwNumStages, m_dwSlotsPerStage );
+
+    m_nBufferSize = (nBufferSize / sizeof(DWORD)) / nRecordSize * nRecordSize;
+
+    if ( m_nBufferSize < nRecordSize )
+        m_nBufferSize = nRecordSize;
+
+    m_vFront.reserve ( m_nBufferSize );
+    m_vBack.reserve ( m_nBufferSize );
+
+    m_thrWriter = std::thread ( &COccupancyTraceWriter::WriterLoop, this );
+
+    return m_bError == false;
+}
+
+void COccupancyTraceWriter::AppendCycle ( const CPipelineSim& sim ) noexcept
+{
+    if ( m_pFile == nullptr )
+        return;
+
+    const QWORD qwStallCount = sim.GetStallCount ( );
+    const DWORD dwExecuting  = std::min ( sim.GetExecutingCount ( ), OCC_EXECUTING_MAX );
+
+    const size_t nRecord = m_vFront.size ( );
+
+    // the buffer never reallocates, its capacity having been reserved
+    m_vFront.resize ( nRecord + GetOccupancyRecordSize ( m_dwNumStages, m_dwSlotsPerStage ) );
+
+    m_vFront[nRecord] = ((qwStallCount != m_qwLastStallCount) ? OCC_STALLED : 0) | (dwExecuting << OCC_EXECUTING_SHIFT);
+
+    sim.GetStageOccupancy ( &m_vFront[nRecord + 1], m_dwSlotsPerStage );
+
+    m_qwLastStallCount = qwStallCount;
+    m_qwNumCycles++;
+
+    if ( m_vFront.size ( ) >= m_nBufferSize )
+        SubmitFront ( );
+}
+
+void COccupancyTraceWriter::SubmitFront ( void ) noexcept
+{
+    std::unique_lock<std::mutex> lock ( m_mtxLock );
+
+    // only waits if the previous buffer has yet to be written
+    m_cvHandOver.wait ( lock, [this] { return m_bPending == false; } );
+
+    m_vFront.swap ( m_vBack );
+    m_vFront.clear ( );
+
+    m_bPending = true;
+
+    m_cvHandOver.notify_all ( );
+}
+
+void COccupancyTraceWriter::WriterLoop ( void ) noexcept
+{
+    std::unique_lock<std::mutex> lock ( m_mtxLock );
+
+    for ( ; ; )
+    {
+        m_cvHandOver.wait ( lock, [this] { return m_bPending || m_bStop; } );
+
+        if ( m_bPending )
+        {
+            // the back buffer belongs to this thread until m_bPending is reset
+            lock.unlock ( );
+
+            const bool bWritten = fwrite ( m_vBack.data ( ), sizeof(DWORD), m_vBack.size ( ), m_pFile ) == m_vBack.size ( );
+
+            lock.lock ( );
+
+            if ( bWritten == false )
+                m_bError = true;
+
+            m_bPending = false;
+
+            m_cvHandOver.notify_all ( );
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+
+bool COccupancyTraceWriter::Close ( void ) noexcept
+{
+    if ( m_pFile == nullptr )
+        return false;
+
+    if ( m_vFront.empty ( ) == false )
+        SubmitFront ( );
+
+    {
+        std::lock_guard<std::mutex> lock ( m_mtxLock );
+
+        m_bStop = true;
+
+        m_cvHandOver.notify_all ( );
+    }
+
+    // the writer thread drains any pending buffer before exiting
+    m_thrWriter.join ( );
+
+    bool bReturn = (m_bError == false);
+
+    // complete the header with the number of cycle records
+    const long nNumCyclesOffset = static_cast<long>(offsetof(OCCUPANCY_FILE_HEADER, qwNumCycles));
+
+    bReturn = bReturn && (fseek ( m_pFile, nNumCyclesOffset, SEEK_SET ) == 0) &&
+              (fwrite ( &m_qwNumCycles, sizeof(m_qwNumCycles), 1, m_pFile ) == 1);
+
+    if ( fclose ( m_pFile ) != 0 )
+        bReturn = false;
+
+    m_pFile = nullptr;
+
+    std::vector<DWORD>().swap ( m_vFront );
+    std::vector<DWORD>().swap ( m_vBack );
+
+    return bReturn;
+}
+
+
+COccupancyTraceReader::COccupancyTraceReader ( ) noexcept
+    : m_pFile           ( nullptr ),
+      m_dwNumStages     ( 0 ),
+      m_dwSlotsPerStage ( 0 ),
+      m_qwNumCycles     ( 0 ),
+      m_nHeaderSize     ( 0 )
+{
+}
+
+COccupancyTraceReader::~COccupancyTraceReader ( )
+{
+    Close ( );
+}
+
+bool COccupancyTraceReader::Open ( const TCHAR* szFileName ) noexcept
+{
+    Close ( );
+
+    if ( IsLittleEndian ( ) == false )
+        return false;
+
+    m_pFile = _tfopen ( szFileName, _T("rb") );
+
+    if ( m_pFile == nullptr )
+        return false;
+
+    OCCUPANCY_FILE_HEADER hdr = { };
+
+    // a version 1 header ends with the number of cycle records
+    const size_t nScalarSize = offsetof(OCCUPANCY_FILE_HEADER, dwSlotsPerStage);
+
+    bool bReturn = (fread ( &hdr, nScalarSize, 1, m_pFile ) == 1) &&
+                   (hdr.dwMagic     == OCCUPANCY_FILE_MAGIC)      &&
+                   (hdr.dwByteOrder == OCCUPANCY_FILE_BYTE_ORDER);
+
+    if ( bReturn && hdr.dwVersion == OCCUPANCY_FILE_VERSION_SCALAR )
+    {
+        hdr.dwSlotsPerStage = 1;
+        m_nHeaderSize       = nScalarSize;
+    }
+    else
+    {
+        bReturn = bReturn && (hdr.dwVersion == OCCUPANCY_FILE_VERSION) &&
+                  (fread ( reinterpret_cast<BYTE*>(&hdr) + nScalarSize, sizeof(hdr) - nScalarSize, 1, m_pFile ) == 1);
+
+        m_nHeaderSize = sizeof(hdr);
+    }
+
+    if ( bReturn                                          &&
+         (hdr.dwNumStages     >= MIN_PIPELINE_STAGES)     &&
+         (hdr.dwNumStages     <= MAX_PIPELINE_STAGES)     &&
+         (hdr.dwSlotsPerStage >= 1)                       &&
+         (hdr.dwSlotsPerStage <= MAX_ISSUE_WIDTH) )
+    {
+        m_dwNumStages     = hdr.dwNumStages;
+        m_dwSlotsPerStage = hdr.dwSlotsPerStage;
+        m_qwNumCycles     = hdr.qwNumCycles;
+
+        return true;
+    }
+
+    Close ( );
+
+    return false;
+}
+
+void COccupancyTraceReader::Close ( void ) noexcept
+{
+    if ( m_pFile != nullptr )
+        fclose ( m_pFile );
+
+    m_pFile           = nullptr;
+    m_dwNumStages     = 0;
+    m_dwSlotsPerStage = 0;
+    m_qwNumCycles     = 0;
+    m_nHeaderSize     = 0;
+}
+
+size_t COccupancyTraceReader::ReadCycles ( QWORD qwFirstCycle, size_t nNumCycles, std::vector<DWORD>& vRecords ) noexcept
+{
+    vRecords.clear ( );
+
+    if ( m_pFile == nullptr || qwFirstCycle == 0 || qwFirstCycle > m_qwNumCycles )
+        return 0;
+
+    if ( nNumCycles > m_qwNumCycles - qwFirstCycle + 1 )
+        nNumCycles = static_cast<size_t>(m_qwNumCycles - qwFirstCycle + 1);
+
+    const size_t nRecordSize = GetOccupancyRecordSize ( m_dwNumStages, m_dwSlotsPerStage );
+
+    // the records are of a fixed size, so any cycle is a single seek away
+    const QWORD qwOffset = m_nHeaderSize + (qwFirstCycle - 1) * nRecordSize * sizeof(DWORD);
+
+    if ( _fseeki64 ( m_pFile, static_cast<long long>(qwOffset), SEEK_SET ) != 0 )
+        return 0;
+
+    vRecords.resize ( nNumCycles * nRecordSize );
+
+    const size_t nNumRead = fread ( vRecords.data ( ), sizeof(DWORD) * nRecordSize, nNumCycles, m_pFile );
+
+    vRecords.resize ( nNumRead * nRecordSize );
+
+    return nNumRead;
+}
+
+tostream& COccupancyTraceReader::OutputRecord ( tostream& os, QWORD qwCycle, const DWORD* pRecord ) const noexcept
+{
+    os << std::setw(10) << qwCycle << _T(": ");
+
+    // in the order of the human-readable trace, the fetch stage first
+    if ( m_dwSlotsPerStage == 1 )
+    {
+        for ( DWORD i = 0; i < m_dwNumStages; i++ )
+        {
+            const INSTRUCTION_T instruction = pRecord[1 + i];
+
+            if ( instruction == NOOP_INSTRUCTION )
+                os << _T("- ");
+            else if ( instruction != INVALID_INSTRUCTION )
+                os << instruction << _T(" ");
+        }
+    }
+    else
+    {
+        // as for a superscalar pipeline, the instructions of each stage are
+        // separated by commas, an empty stage being output as a bubble
+        for ( DWORD i = 0; i < m_dwNumStages; i++ )
+        {
+            const INSTRUCTION_T* pSlots = &pRecord[1 + i * m_dwSlotsPerStage];
+
+            if ( pSlots[0] == INVALID_INSTRUCTION )
+                os << _T("-");
+
+            for ( DWORD j = 0; j < m_dwSlotsPerStage && pSlots[j] != INVALID_INSTRUCTION; j++ )
+                os << ((j > 0) ? _T(",") : _T("")) << pSlots[j];
+
+            os << _T(" ");
+        }
+    }
+
+    if ( pRecord[0] & OCC_STALLED )
+        os << _T("(stall)");
+
+    if ( (pRecord[0] >> OCC_EXECUTING_SHIFT) > 0 )
+        os << _T("(") << (pRecord[0] >> OCC_EXECUTING_SHIFT) << _T(" executing)");
+
+    os << _T("\n");
+
+    return os;
+}
@@ -0,0 +1,275 @@
+/**
+* @file       OccupancyTrace.h
+* @brief      COccupancyTraceWriter and COccupancyTraceReader class interfaces
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  A compact binary record of the pipeline's occupancy in every cycle, for
+*  post-hoc analysis of runs far too long for the human-readable trace.
+*
+*  The file consists of an OCCUPANCY_FILE_HEADER, followed by a fixed-size
+*  record per cycle, the first record being that of cycle 1:
+*  - a DWORD of OCC_xxx cycle flags, in the low byte, and of the count of
+*    instructions still executing beyond the final stage, saturated at
+*    OCC_EXECUTING_MAX, in the remaining bits
+*  - as many INSTRUCTION_T slots per stage as the pipeline issues
+*    instructions per cycle, as filled in by
+*    CPipelineSim::GetStageOccupancy
+*
+*  A version 1 file, of a scalar pipeline alone, has a header ending with
+*  qwNumCycles, and a single slot per stage.
+*
+*  The fixed record size affords random access to any cycle range by a
+*  single seek.  Like the binary graph file, the format is defined as
+*  little-endian, and is written as a direct image of memory.
+*
+*  The writer fills one buffer while a background thread writes the other
+*  to disk, such that the simulation thread only waits on the writer thread
+*  if the disk falls behind by an entire buffer.
+*/
+#pragma once
+
+#if !defined(_OCCUPANCY_TRACE_H__)
+#define _OCCUPANCY_TRACE_H__
+
+#ifndef _PIPELINE_SIM_H__
+    #include "PipelineSim.h"
+#endif
+
+#ifndef _CONDITION_VARIABLE_
+    #include <condition_variable>
+#endif
+
+#ifndef _MUTEX_
+    #include <mutex>
+#endif
+
+#ifndef _THREAD_
+    #include <thread>
+#endif
+
+#ifndef _VECTOR_
+    #include <vector>
+#endif
+
+/// occupancy trace file signature, reads as "IPOT" in a hex dump
+constexpr DWORD OCCUPANCY_FILE_MAGIC      = 0x544F5049;
+/// used to detect a byte order mismatch
+constexpr DWORD OCCUPANCY_FILE_BYTE_ORDER = 0x01020304;
+/// current occupancy trace file format version
+constexpr DWORD OCCUPANCY_FILE_VERSION    = 2;
+/// previous file format version, without the slots per stage
+constexpr DWORD OCCUPANCY_FILE_VERSION_SCALAR = 1;
+
+/// cycle flag used to denote a stall was introduced during the cycle
+constexpr DWORD OCC_STALLED = 0x01;
+/// position of the executing count within the cycle flags
+constexpr DWORD OCC_EXECUTING_SHIFT = 8;
+/// largest executing count recorded
+constexpr DWORD OCC_EXECUTING_MAX   = 0x00FFFFFF;
+
+/// default size in bytes of each of the writer's buffers
+constexpr size_t DEFAULT_OCCUPANCY_BUFFER_SIZE = 4 * 1024 * 1024;
+
+/**
+    @brief Occupancy trace file header
+*/
+struct OCCUPANCY_FILE_HEADER
+{
+    DWORD   dwMagic;         ///< must be OCCUPANCY_FILE_MAGIC
+    DWORD   dwByteOrder;     ///< must be OCCUPANCY_FILE_BYTE_ORDER
+    DWORD   dwVersion;       ///< file format version
+    DWORD   dwNumStages;     ///< number of pipeline stages
+    QWORD   qwNumCycles;     ///< number of cycle records
+    DWORD   dwSlotsPerStage; ///< number of slots of each stage, absent from version 1
+    DWORD   dwReserved;      ///< reserved, must be 0
+};
+
+/**
+    @brief Retrieves the size of each cycle record, in DWORDs
+
+    @param [in] dwNumStages     number of pipeline stages
+    @param [in] dwSlotsPerStage number of slots of each stage
+
+    @retval size_t              the flags plus the slots of every stage
+*/
+constexpr size_t GetOccupancyRecordSize(DWORD dwNumStages, DWORD dwSlotsPerStage) noexcept
+{
+    return 1 + static_cast<size_t>(dwNumStages) * dwSlotsPerStage;
+}
+
+/**
+    @brief Double-buffered background occupancy trace writer
+*/
+class COccupancyTraceWriter
+{
+    FILE*                   m_pFile;            ///< trace file
+    DWORD                   m_dwNumStages;      ///< number of pipeline stages
+    DWORD                   m_dwSlotsPerStage;  ///< number of slots of each stage
+    QWORD                   m_qwLastStallCount; ///< stall count of the previously appended cycle
+    QWORD                   m_qwNumCycles;      ///< number of cycles appended
+    size_t                  m_nBufferSize;      ///< capacity of each buffer, in DWORDs
+    std::vector<DWORD>      m_vFront;           ///< buffer being filled
+    std::vector<DWORD>      m_vBack;            ///< buffer being written
+    std::mutex              m_mtxLock;          ///< guards the hand over of m_vBack
+    std::condition_variable m_cvHandOver;       ///< signals m_bPending changes
+    bool                    m_bPending;         ///< m_vBack holds data awaiting the writer thread
+    bool                    m_bStop;            ///< requests the writer thread to exit
+    bool                    m_bError;           ///< a write has failed
+    std::thread             m_thrWriter;        ///< background writer thread
+
+public:
+    /// Default Constructor
+    COccupancyTraceWriter() noexcept;
+
+    /// Default Destructor, closes the file if open
+    ~COccupancyTraceWriter();
+
+/**
+    @brief Creates the trace file and starts the writer thread
+
+    @param [in] szFileName      name of the trace file
+    @param [in] dwNumStages     number of pipeline stages
+    @param [in] dwSlotsPerStage number of slots of each stage, the issue
+                                width of the pipeline
+    @param [in] nBufferSize     size in bytes of each buffer
+
+    @retval true                on success
+    @retval false               on error
+*/
+    bool Open(const TCHAR* szFileName, DWORD dwNumStages, DWORD dwSlotsPerStage,
+              size_t nBufferSize = DEFAULT_OCCUPANCY_BUFFER_SIZE) noexcept;
+
+/**
+    @brief Appends the occupancy of the cycle just processed
+
+    @param [in] sim     simulation object, of the depth and width the file
+                        was opened with
+*/
+    void AppendCycle(const CPipelineSim& sim) noexcept;
+
+/**
+    @brief Writes any remaining records, completes the header, and closes the file
+
+    @retval true        if every record has been written
+    @retval false       on error
+*/
+    bool Close(void) noexcept;
+
+/**
+    @brief Retrieves the number of cycles appended
+
+    @retval QWORD       count of cycle records
+*/
+    constexpr QWORD GetNumCycles(void) const noexcept
+    { return m_qwNumCycles; };
+
+private:
+/**
+    @brief Hands the front buffer over to the writer thread
+*/
+    void SubmitFront(void) noexcept;
+
+/**
+    @brief Writes each buffer handed over until asked to stop
+*/
+    void WriterLoop(void) noexcept;
+
+    /// copy constructor
+    COccupancyTraceWriter(const COccupancyTraceWriter& o) = delete;
+
+    /// assignment operator
+    COccupancyTraceWriter& operator=(const COccupancyTraceWriter& rhs) = delete;
+};
+
+/**
+    @brief Random access occupancy trace reader
+*/
+class COccupancyTraceReader
+{
+    FILE*   m_pFile;            ///< trace file
+    DWORD   m_dwNumStages;      ///< number of pipeline stages
+    DWORD   m_dwSlotsPerStage;  ///< number of slots of each stage
+    QWORD   m_qwNumCycles;      ///< number of cycle records
+    size_t  m_nHeaderSize;      ///< size in bytes of the file's header
+
+public:
+    /// Default Constructor
+    COccupancyTraceReader() noexcept;
+
+    /// Default Destructor, closes the file if open
+    ~COccupancyTraceReader();
+
+/**
+    @brief Opens a trace file and validates its header
+
+    @param [in] szFileName      name of the trace file
+
+    @retval true                on success
+    @retval false               on error
+*/
+    bool Open(const TCHAR* szFileName) noexcept;
+
+/**
+    @brief Closes the trace file
+*/
+    void Close(void) noexcept;
+
+/**
+    @brief Retrieves the number of pipeline stages
+
+    @retval DWORD       count of stages
+*/
+    constexpr DWORD GetNumStages(void) const noexcept
+    { return m_dwNumStages; };
+
+/**
+    @brief Retrieves the number of slots of each stage
+
+    @retval DWORD       count of slots
+*/
+    constexpr DWORD GetSlotsPerStage(void) const noexcept
+    { return m_dwSlotsPerStage; };
+
+/**
+    @brief Retrieves the number of cycle records
+
+    @retval QWORD       count of cycles
+*/
+    constexpr QWORD GetNumCycles(void) const noexcept
+    { return m_qwNumCycles; };
+
+/**
+    @brief Reads a range of cycle records
+
+    @param [in]  qwFirstCycle   1-based cycle of the first record
+    @param [in]  nNumCycles     number of records requested
+    @param [out] vRecords       receives GetOccupancyRecordSize DWORDs per record
+
+    @retval size_t              number of records read, fewer than requested
+                                at the end of the trace
+*/
+    size_t ReadCycles(QWORD qwFirstCycle, size_t nNumCycles, std::vector<DWORD>& vRecords) noexcept;
+
+/**
+    @brief Formats and outputs a record in the human-readable trace format
+
+    @param [in,out] os          destination output stream
+    @param [in] qwCycle         cycle of the record
+    @param [in] pRecord         the record
+
+    @retval tostream&           reference to updated stream
+*/
+    tostream& OutputRecord(tostream& os, QWORD qwCycle, const DWORD* pRecord) const noexcept;
+
+private:
+    /// copy constructor
+    COccupancyTraceReader(const COccupancyTraceReader& o) = delete;
+
+    /// assignment operator
+    COccupancyTraceReader& operator=(const COccupancyTraceReader& rhs) = delete;
+};
+
+#endif
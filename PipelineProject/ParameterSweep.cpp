@@ -0,0 +1,397 @@
+/**
+* @file       ParameterSweep.cpp
+* @brief      CParameterSweep class implementation
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*/
+
+#include "stdafx.h"
+#include "ParameterSweep.h"
+#include "HazardAnalysis.h"
+#include "LaneSim.h"
+#include "ResultCache.h"
+#include "WorkStealingPool.h"
+
+#ifndef _CHRONO_
+    #include <chrono>
+#endif
+
+/**
+    @brief Retrieves the command line name of a forwarding path mask
+*/
+static const TCHAR* GetForwardingName ( DWORD dwForwarding ) noexcept
+{
+    switch ( dwForwarding )
+    {
+        case FP_EX_EX:
+            return _T("ex");
+        case FP_MEM_EX:
+            return _T("mem");
+        case FP_FULL:
+            return _T("full");
+        default:
+            return _T("none");
+    }
+}
+
+
+CParameterSweep::CParameterSweep ( const CCsrDependencyGraph& dag, const CPipelineConfig& config ) noexcept
+    : m_dag          ( dag ),
+      m_Config       ( config ),
+      m_hzPenalty    ( HZ_LOAD_USE ),
+      m_vDepths      ( ),
+      m_vForwarding  ( ),
+      m_vPenalties   ( ),
+      m_vResults     ( ),
+      m_bStepped     ( false ),
+      m_qwGraphHash  ( 0 ),
+      m_dwNumWorkers ( 0 ),
+      m_dElapsed     ( 0.0 ),
+      m_pCache       ( nullptr )
+{
+}
+
+bool CParameterSweep::SetPenalties ( HZ_HAZARD_TYPE hzType, const std::vector<DWORD>& vPenalties ) noexcept
+{
+    m_hzPenalty = hzType;
+    m_vPenalties.clear ( );
+
+    // every configuration of the grid has the execute latencies of the base
+    CPipelineConfig config ( m_Config );
+
+    for ( std::vector<DWORD>::const_iterator it = vPenalties.begin ( ); it != vPenalties.end ( ); ++it )
+    {
+        if ( config.SetPenalty ( hzType, *it ) )
+            m_vPenalties.push_back ( *it );
+    }
+
+    return (m_vPenalties.size ( ) == vPenalties.size ( ));
+}
+
+bool CParameterSweep::IsPenaltyEffective ( void ) const noexcept
+{
+    // the classes of every instruction some other depends upon
+    bool bProducer[IC_NUM_CLASSES] = { };
+
+    for ( CCsrDependencyGraph::const_iterator it = m_dag.begin ( ); it != m_dag.end ( ); ++it )
+    {
+        if ( it->IsValid ( ) == false )
+            continue;
+
+        for ( CCsrGraphNode::const_iterator pEdge = it->beginEdge ( ); pEdge != it->endEdge ( ); ++pEdge )
+        {
+            const NODE_ID_T idProducer = pEdge->GetDestNodeID ( );
+
+            if ( m_dag.HasNode ( idProducer ) )
+                bProducer[m_dag.GetNode ( idProducer ).GetClass ( )] = true;
+        }
+    }
+
+    const size_t nForwarding = m_vForwarding.empty ( ) ? 1 : m_vForwarding.size ( );
+
+    CPipelineConfig config ( m_Config );
+
+    for ( size_t i = 0; i < nForwarding; i++ )
+    {
+        if ( m_vForwarding.empty ( ) == false )
+            config.SetForwarding ( m_vForwarding[i] );
+
+        for ( DWORD j = 0; j < IC_NUM_CLASSES; j++ )
+        {
+            if ( bProducer[j] && config.GetHazardType ( static_cast<IC_INSTRUCTION_CLASS>(j) ) == m_hzPenalty )
+                return true;
+        }
+    }
+
+    return false;
+}
+
+size_t CParameterSweep::GetNumConfigs ( void ) const noexcept
+{
+    // an empty axis contributes its single default value
+    const size_t nDepths     = m_vDepths.empty ( )     ? 1 : m_vDepths.size ( );
+    const size_t nForwarding = m_vForwarding.empty ( ) ? 1 : m_vForwarding.size ( );
+    const size_t nPenalties  = m_vPenalties.empty ( )  ? 1 : m_vPenalties.size ( );
+
+    return nDepths * nForwarding * nPenalties;
+}
+
+void CParameterSweep::GetConfig ( size_t nConfig, CPipelineConfig& config ) const noexcept
+{
+    const size_t nForwarding = m_vForwarding.empty ( ) ? 1 : m_vForwarding.size ( );
+    const size_t nPenalties  = m_vPenalties.empty ( )  ? 1 : m_vPenalties.size ( );
+
+    // the penalty axis varies fastest, the depth axis slowest
+    const size_t nPenalty = nConfig % nPenalties;
+    const size_t nForward = (nConfig / nPenalties) % nForwarding;
+    const size_t nDepth   = nConfig / (nPenalties * nForwarding);
+
+    // only the swept parameters differ from the base configuration
+    config = m_Config;
+
+    if ( m_vDepths.empty ( ) == false )
+        config.SetNumStages ( m_vDepths[nDepth] );
+
+    if ( m_vForwarding.empty ( ) == false )
+        config.SetForwarding ( m_vForwarding[nForward] );
+
+    if ( m_vPenalties.empty ( ) == false )
+        config.SetPenalty ( m_hzPenalty, m_vPenalties[nPenalty] );
+}
+
+size_t CParameterSweep::Run ( DWORD dwNumThreads ) noexcept
+{
+    std::vector<SWEEP_RESULT>().swap ( m_vResults );
+
+    m_dwNumWorkers = 0;
+    m_dElapsed     = 0.0;
+
+    if ( m_dag.IsAcyclic ( ) == false )
+        return 0;
+
+    const std::chrono::steady_clock::time_point tpStart = std::chrono::steady_clock::now ( );
+
+    m_vResults.assign ( GetNumConfigs ( ), SWEEP_RESULT { } );
+
+    // the graph is hashed once, for every configuration
+    m_qwGraphHash = (m_pCache != nullptr) ? m_dag.GetContentHash ( ) : 0;
+
+    CWorkStealingPool pool ( dwNumThreads );
+
+    // each worker has a hazard analysis of its own, reused for every
+    // configuration it runs
+    std::vector<CHazardAnalysis> vHazards ( pool.GetNumWorkers ( ) );
+
+    // the lanes model neither branches, deferred completions nor a
+    // superscalar pipeline, while a CPipelineSim steps every configuration
+    // of a graph, or base configuration, having any
+    CPipelineConfig config;
+
+    GetConfig ( 0, config );
+
+    bool bBranches = config.IsSuperscalar ( );
+
+    for ( CCsrDependencyGraph::const_iterator it = m_dag.begin ( ); it != m_dag.end ( ) && (bBranches == false); ++it )
+    {
+        bBranches = it->IsValid ( ) &&
+                    (IsBranchClass ( it->GetClass ( ) ) || config.GetExecuteLatency ( it->GetClass ( ) ) > 1);
+    }
+
+    if ( m_bStepped && (bBranches == false) )
+    {
+        // the penalty and forwarding axes vary fastest, so the configurations
+        // of each depth are contiguous, and split into groups of lanes
+        const size_t nPerDepth = m_vResults.size ( ) / (m_vDepths.empty ( ) ? 1 : m_vDepths.size ( ));
+
+        std::vector<size_t> vGroups;
+
+        for ( size_t nDepth = 0; nDepth < m_vResults.size ( ); nDepth += nPerDepth )
+        {
+            for ( size_t nConfig = nDepth; nConfig < nDepth + nPerDepth; nConfig += MAX_SIM_LANES )
+                vGroups.push_back ( nConfig );
+        }
+
+        pool.Run ( vGroups.size ( ), [this, &vHazards, &vGroups, nPerDepth] ( size_t nTask, DWORD dwWorker )
+        {
+            // a group ends with its depth, if not before
+            const size_t nFirst = vGroups[nTask];
+            const size_t nLimit = nFirst - (nFirst % nPerDepth) + nPerDepth;
+            const size_t nCount = ((nLimit - nFirst) < MAX_SIM_LANES) ? (nLimit - nFirst) : MAX_SIM_LANES;
+
+            SimulateLanes ( vHazards[dwWorker], nFirst, nCount );
+        } );
+    }
+    else
+    {
+        pool.Run ( m_vResults.size ( ), [this, &vHazards] ( size_t nTask, DWORD dwWorker )
+        {
+            CPipelineConfig config;
+
+            GetConfig ( nTask, config );
+
+            if ( LookupResult ( config, m_vResults[nTask] ) == false )
+            {
+                Simulate ( vHazards[dwWorker], config, m_vResults[nTask] );
+
+                InsertResult ( config, m_vResults[nTask] );
+            }
+        } );
+    }
+
+    m_dwNumWorkers = pool.GetNumWorkers ( );
+    m_dElapsed     = std::chrono::duration<double> ( std::chrono::steady_clock::now ( ) - tpStart ).count ( );
+
+    return m_vResults.size ( );
+}
+
+void CParameterSweep::Simulate ( CHazardAnalysis& hazards, const CPipelineConfig& config, SWEEP_RESULT& result ) const noexcept
+{
+    result.dwNumStages  = config.GetNumStages ( );
+    result.dwForwarding = config.GetForwarding ( );
+    result.dwPenalty    = config.GetPenalty ( m_hzPenalty );
+
+    CPipelineSim sim ( config );
+
+    sim.LoadInstructions ( m_dag, hazards );
+
+    // a grid may be large, each configuration is fast-forwarded
+    result.qwCycles    = sim.FastForward ( );
+
+    result.qwStalls    = sim.GetStallCount ( );
+    result.qwCompleted = sim.GetCompletionCount ( );
+}
+
+void CParameterSweep::SimulateLanes ( CHazardAnalysis& hazards, size_t nFirst, size_t nNumConfigs ) noexcept
+{
+    CPipelineConfig config;
+
+    GetConfig ( nFirst, config );
+
+    CLaneSim            lanes ( config );
+    std::vector<BYTE>   vStallCycles;
+    std::vector<size_t> vLaneConfigs;  // index of the configuration simulated by each lane
+
+    vStallCycles.reserve ( m_dag.GetNumNodes ( ) );
+
+    for ( size_t i = 0; i < nNumConfigs; i++ )
+    {
+        SWEEP_RESULT& result = m_vResults[nFirst + i];
+
+        GetConfig ( nFirst + i, config );
+
+        if ( LookupResult ( config, result ) )
+            continue;
+
+        result.dwNumStages  = config.GetNumStages ( );
+        result.dwForwarding = config.GetForwarding ( );
+        result.dwPenalty    = config.GetPenalty ( m_hzPenalty );
+
+        hazards.Analyze ( m_dag, config );
+
+        vStallCycles.clear ( );
+
+        for ( CCsrDependencyGraph::const_iterator it = m_dag.begin ( ); it != m_dag.end ( ); ++it )
+        {
+            if ( it->IsValid ( ) )
+                vStallCycles.push_back ( static_cast<BYTE>(hazards.GetStallCycles ( it->GetNodeID ( ) )) );
+        }
+
+        if ( lanes.AddLane ( vStallCycles.data ( ), vStallCycles.size ( ) ) )
+        {
+            vLaneConfigs.push_back ( nFirst + i );
+        }
+        else
+        {
+            // a sequence too long for a lane is fast-forwarded instead
+            Simulate ( hazards, config, result );
+
+            InsertResult ( config, result );
+        }
+    }
+
+    if ( vLaneConfigs.empty ( ) )
+        return;
+
+    lanes.Run ( );
+
+    for ( DWORD dwLane = 0; dwLane < lanes.GetNumLanes ( ); dwLane++ )
+    {
+        SWEEP_RESULT& result = m_vResults[vLaneConfigs[dwLane]];
+
+        result.qwCycles    = lanes.GetCycleCount ( dwLane );
+        result.qwStalls    = lanes.GetStallCount ( dwLane );
+        result.qwCompleted = lanes.GetCompletionCount ( dwLane );
+
+        GetConfig ( vLaneConfigs[dwLane], config );
+
+        InsertResult ( config, result );
+    }
+}
+
+bool CParameterSweep::LookupResult ( const CPipelineConfig& config, SWEEP_RESULT& result ) const noexcept
+{
+    CACHED_RESULT cached = { };
+
+    if ( m_pCache == nullptr || m_pCache->Lookup ( m_qwGraphHash, CResultCache::GetConfigKey ( config, false ), cached ) == false )
+        return false;
+
+    result.dwNumStages  = config.GetNumStages ( );
+    result.dwForwarding = config.GetForwarding ( );
+    result.dwPenalty    = config.GetPenalty ( m_hzPenalty );
+    result.qwCycles     = cached.qwCycles;
+    result.qwStalls     = cached.qwStalls;
+    result.qwCompleted  = cached.qwCompleted;
+    result.bCached      = true;
+
+    return true;
+}
+
+void CParameterSweep::InsertResult ( const CPipelineConfig& config, const SWEEP_RESULT& result ) const noexcept
+{
+    if ( m_pCache != nullptr )
+    {
+        const CACHED_RESULT cached = { result.qwCycles, result.qwStalls, result.qwCompleted };
+
+        m_pCache->Insert ( m_qwGraphHash, CResultCache::GetConfigKey ( config, false ), cached );
+    }
+}
+
+tostream& CParameterSweep::OutputResults ( tostream& os ) const noexcept
+{
+    const size_t nNumNodes = m_dag.GetNumNodes ( );
+
+    os << std::right << std::setw(8) << _T("Stages")
+       << std::setw(12) << _T("Forwarding")
+       << std::setw(10) << _T("Penalty")
+       << std::setw(12) << _T("Cycles")
+       << std::setw(10) << _T("CPI")
+       << std::setw(12) << _T("Stalls") << _T("\n");
+
+    std::vector<SWEEP_RESULT>::const_iterator itBest = m_vResults.end ( );
+
+    for ( std::vector<SWEEP_RESULT>::const_iterator it = m_vResults.begin ( ); it != m_vResults.end ( ); ++it )
+    {
+        os << std::setw(8)  << it->dwNumStages
+           << std::setw(12) << GetForwardingName ( it->dwForwarding )
+           << std::setw(10) << it->dwPenalty
+           << std::setw(12) << it->qwCycles
+           << std::setw(10) << std::fixed << std::setprecision(3)
+           << ((nNumNodes > 0) ? static_cast<double>(it->qwCycles) / nNumNodes : 0.0)
+           << std::setw(12) << it->qwStalls << _T("\n");
+
+        if ( itBest == m_vResults.end ( ) || it->qwCycles < itBest->qwCycles )
+            itBest = it;
+    }
+
+    os << _T("------------------------------------------------------------------") << _T("\n");
+
+    if ( itBest != m_vResults.end ( ) )
+    {
+        os << _T("Fewest cycles: ") << itBest->qwCycles << _T(" with ")
+           << itBest->dwNumStages << _T(" stages, forwarding ")
+           << GetForwardingName ( itBest->dwForwarding ) << _T(", penalty ")
+           << itBest->dwPenalty << _T("\n");
+    }
+
+    os << _T("Configurations simulated: ") << m_vResults.size ( );
+
+    if ( m_pCache != nullptr )
+    {
+        size_t nNumCached = 0;
+
+        for ( std::vector<SWEEP_RESULT>::const_iterator it = m_vResults.begin ( ); it != m_vResults.end ( ); ++it )
+        {
+            if ( it->bCached )
+                nNumCached++;
+        }
+
+        os << _T(", found in result cache: ") << nNumCached;
+    }
+
+    os << _T(", elapsed time: ") << std::fixed << std::setprecision(3) << m_dElapsed
+       << _T(" seconds, using ") << m_dwNumWorkers << _T(" worker thread(s)") << std::endl;
+
+    return os;
+}
@@ -0,0 +1,248 @@
+/**
+* @file       ParameterSweep.h
+* @brief      CParameterSweep class interface
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  Evaluates a grid of pipeline configurations against a single frozen
+*  graph, which is loaded once and shared read-only between the workers of
+*  a CWorkStealingPool.  Each configuration of the grid is a base
+*  configuration with some parameters varied, the grid being the cross
+*  product of:
+*  - the pipeline depths
+*  - the forwarding path masks
+*  - the stall penalties of one hazard type (by default HZ_LOAD_USE)
+*
+*  An empty axis contributes the single value of the base configuration,
+*  whose other parameters (issue and stage widths, branch prediction,
+*  execute latencies and issue intervals) are shared by the grid.  Each
+*  configuration is simulated to completion without per-cycle output, and
+*  its cycles, CPI and stall count are tabulated in grid order.
+*
+*  The cycles are ordinarily fast-forwarded.  They may instead be stepped,
+*  in which case the configurations sharing a depth are grouped into the
+*  lanes of a CLaneSim, up to MAX_SIM_LANES of them being simulated in
+*  lockstep by a single task.  As the lanes model neither branches,
+*  multi-cycle execution nor a superscalar pipeline, the configurations of
+*  a graph having either, or of a superscalar base configuration, are
+*  stepped by a CPipelineSim each.
+*
+*  Given a CResultCache, the configurations found in the cache for the
+*  graph are not simulated, and the result of each one simulated is
+*  inserted.
+*/
+#pragma once
+
+#if !defined(_PARAMETER_SWEEP_H__)
+#define _PARAMETER_SWEEP_H__
+
+#ifndef _CSR_DEPENDENCY_GRAPH_H__
+    #include "CsrDependencyGraph.h"
+#endif
+
+#ifndef _PIPELINE_SIM_H__
+    #include "PipelineSim.h"
+#endif
+
+#ifndef _VECTOR_
+    #include <vector>
+#endif
+
+/**
+    @brief Results of simulating a single configuration of the sweep
+*/
+struct SWEEP_RESULT
+{
+    DWORD   dwNumStages;   ///< pipeline depth
+    DWORD   dwForwarding;  ///< mask of FP_xxx forwarding paths
+    DWORD   dwPenalty;     ///< stall penalty of the swept hazard type
+    QWORD   qwCycles;      ///< cycles simulated
+    QWORD   qwStalls;      ///< stalls introduced
+    QWORD   qwCompleted;   ///< instructions completed
+    bool    bCached;       ///< results were found in the result cache
+};
+
+class CHazardAnalysis;
+class CResultCache;
+
+/**
+    @brief Parallel parameter sweep over a single graph
+*/
+class CParameterSweep
+{
+    const CCsrDependencyGraph& m_dag;          ///< graph shared by every configuration
+    CPipelineConfig            m_Config;       ///< base configuration of the grid
+    HZ_HAZARD_TYPE             m_hzPenalty;    ///< hazard type whose penalty is swept
+    std::vector<DWORD>         m_vDepths;      ///< pipeline depths
+    std::vector<DWORD>         m_vForwarding;  ///< forwarding path masks
+    std::vector<DWORD>         m_vPenalties;   ///< stall penalties
+    std::vector<SWEEP_RESULT>  m_vResults;     ///< per-configuration results, in grid order
+    bool                       m_bStepped;     ///< the cycles are stepped, rather than fast-forwarded
+    QWORD                      m_qwGraphHash;  ///< content hash of m_dag, if cached
+    DWORD                      m_dwNumWorkers; ///< worker threads used by the last run
+    double                     m_dElapsed;     ///< wall time of the last run, in seconds
+    CResultCache*              m_pCache;       ///< cache of results, if any
+
+public:
+    /**
+        @brief Initialization Constructor
+
+        @param [in] dag     frozen graph, which must outlive the sweep
+        @param [in] config  base configuration, whose parameters not swept
+                            are those of every configuration of the grid
+    */
+    CParameterSweep(const CCsrDependencyGraph& dag, const CPipelineConfig& config) noexcept;
+
+    /// Default Destructor
+    ~CParameterSweep() = default;
+
+/**
+    @brief Sets the pipeline depths of the grid
+
+    @param [in] vDepths     numbers of pipeline stages
+*/
+    void SetDepths(const std::vector<DWORD>& vDepths) noexcept
+    { m_vDepths = vDepths; };
+
+/**
+    @brief Sets the forwarding paths of the grid
+
+    @param [in] vForwarding masks of FP_xxx forwarding paths
+*/
+    void SetForwarding(const std::vector<DWORD>& vForwarding) noexcept
+    { m_vForwarding = vForwarding; };
+
+/**
+    @brief Sets the stall penalties of the grid
+
+    A penalty which CPipelineConfig::SetPenalty rejects, given the
+    execute latencies of the base configuration, is left out of the grid.
+
+    @param [in] hzType      hazard type whose penalty is swept
+    @param [in] vPenalties  stall cycles required by an adjacent dependency
+
+    @retval true            on success
+    @retval false           if any penalty was left out
+*/
+    bool SetPenalties(HZ_HAZARD_TYPE hzType, const std::vector<DWORD>& vPenalties) noexcept;
+
+/**
+    @brief Determines whether the swept penalty may affect any result
+
+    The penalty applies to a dependency upon a producer whose class, given
+    the forwarding paths, incurs the swept hazard type.  Should no edge of
+    the graph have such a producer under any forwarding path mask of the
+    grid, every penalty yields the same results.
+
+    @retval true            if some dependency incurs the swept hazard type
+*/
+    bool IsPenaltyEffective(void) const noexcept;
+
+/**
+    @brief Selects whether the cycles are stepped, rather than fast-forwarded
+
+    @param [in] bStepped    true to step every cycle of each configuration
+*/
+    void SetStepped(bool bStepped = true) noexcept
+    { m_bStepped = bStepped; };
+
+/**
+    @brief Sets the cache of results looked up ahead of each simulation
+
+    @param [in] pCache      result cache, which must outlive any run, or
+                            nullptr to simulate every configuration
+*/
+    void SetResultCache(CResultCache* pCache) noexcept
+    { m_pCache = pCache; };
+
+/**
+    @brief Retrieves the number of configurations in the grid
+
+    @retval size_t      count of configurations
+*/
+    size_t GetNumConfigs(void) const noexcept;
+
+/**
+    @brief Simulates every configuration of the grid
+
+    @param [in] dwNumThreads    number of worker threads, 0 to use the
+                                number of hardware threads available
+
+    @retval size_t              number of configurations simulated, 0
+                                if the graph is not acyclic
+*/
+    size_t Run(DWORD dwNumThreads = 0) noexcept;
+
+/**
+    @brief Retrieves the per-configuration results of the last run
+
+    @retval std::vector<SWEEP_RESULT>&  results, in grid order
+*/
+    const std::vector<SWEEP_RESULT>& GetResults(void) const noexcept
+    { return m_vResults; };
+
+/**
+    @brief Formats and outputs the results table
+
+    @param [in,out] os      destination output stream
+
+    @retval tostream&       reference to updated stream
+*/
+    tostream& OutputResults(tostream& os) const noexcept;
+
+private:
+/**
+    @brief Builds the descriptor of a configuration of the grid
+
+    @param [in]  nConfig    index of the configuration, in grid order
+    @param [out] config     receives the pipeline descriptor
+*/
+    void GetConfig(size_t nConfig, CPipelineConfig& config) const noexcept;
+
+/**
+    @brief Simulates a single configuration
+
+    @param [in,out] hazards     the executing worker's hazard analysis
+    @param [in]     config      descriptor of the pipeline
+    @param [out]    result      receives the configuration results
+*/
+    void Simulate(CHazardAnalysis& hazards, const CPipelineConfig& config, SWEEP_RESULT& result) const noexcept;
+
+/**
+    @brief Simulates a group of configurations of the same depth, stepping
+           every cycle of each in a lane of its own
+
+    @param [in,out] hazards     the executing worker's hazard analysis
+    @param [in]     nFirst      index of the first configuration, in grid order
+    @param [in]     nNumConfigs number of configurations, at most MAX_SIM_LANES
+*/
+    void SimulateLanes(CHazardAnalysis& hazards, size_t nFirst, size_t nNumConfigs) noexcept;
+
+/**
+    @brief Looks up the result of a configuration in the result cache
+
+    @param [in]  config     descriptor of the pipeline
+    @param [out] result     receives the configuration results, if found
+
+    @retval true            if the result was found
+*/
+    bool LookupResult(const CPipelineConfig& config, SWEEP_RESULT& result) const noexcept;
+
+/**
+    @brief Inserts the result of a configuration into the result cache
+
+    @param [in] config      descriptor of the pipeline
+    @param [in] result      configuration results
+*/
+    void InsertResult(const CPipelineConfig& config, const SWEEP_RESULT& result) const noexcept;
+
+    /// copy constructor
+    CParameterSweep(const CParameterSweep& o) = delete;
+
+    /// assignment operator
+    CParameterSweep& operator=(const CParameterSweep& rhs) = delete;
+};
+
+#endif
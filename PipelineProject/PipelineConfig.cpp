@@ -0,0 +1,354 @@
+/**
+* @file       PipelineConfig.cpp
+* @brief      CPipelineConfig class implementation
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*/
+
+#include "stdafx.h"
+#include "PipelineConfig.h"
+#include "ContentHash.h"
+
+/// stage names of the classic 4-stage pipeline
+static const TCHAR* const g_szFourStageNames[] = { _T("IF"), _T("ID"), _T("EX"), _T("WB") };
+/// stage names of the 5-stage MIPS pipeline
+static const TCHAR* const g_szFiveStageNames[] = { _T("IF"), _T("ID"), _T("EX"), _T("MEM"), _T("WB") };
+
+/// index of the decode stage, where hazards are conventionally detected
+constexpr DWORD DEFAULT_HAZARD_STAGE = 1;
+/// default stall penalty when an ALU result is forwarded from EX to EX
+constexpr DWORD DEFAULT_EX_EX_PENALTY    = 0;
+/// default stall penalty when a result is forwarded from MEM to EX
+constexpr DWORD DEFAULT_MEM_EX_PENALTY   = 1;
+/// default stall penalty when a load result is forwarded from MEM to EX
+constexpr DWORD DEFAULT_LOAD_USE_PENALTY = 1;
+
+/// default execute latency of each instruction class
+static const DWORD g_dwDefaultLatency[IC_NUM_CLASSES]  = { 1, 1, 1, 1, 3, 12 };
+/// default issue interval of each instruction class
+static const DWORD g_dwDefaultInterval[IC_NUM_CLASSES] = { 0, 0, 0, 0, 1, 12 };
+
+/**
+    @brief Calculates the penalty of a mispredicted branch
+
+    A branch is resolved in the stage following the hazard detection
+    stage, by which time as many instructions as there are stages up to
+    and including that one have been fetched down the wrong path.
+
+    @param [in] dwHazardStage   index of the hazard detection stage
+
+    @retval DWORD               fetch cycles lost
+*/
+constexpr DWORD GetMispredictPenalty ( DWORD dwHazardStage ) noexcept
+{
+    return dwHazardStage + 1;
+}
+
+/**
+    @brief Calculates the stall penalty of an unforwarded dependency
+
+    A consumer needs its operands upon entering the stage following the
+    hazard detection stage, while an unforwarded result is available
+    only after the final stage.
+
+    @param [in] dwNumStages     number of pipeline stages
+    @param [in] dwHazardStage   index of the hazard detection stage
+
+    @retval DWORD               stall cycles
+*/
+constexpr DWORD GetNoForwardPenalty ( DWORD dwNumStages, DWORD dwHazardStage ) noexcept
+{
+    return (dwNumStages > dwHazardStage + 2) ? dwNumStages - dwHazardStage - 2 : 0;
+}
+
+/**
+    @brief Determines whether a hazard type may arise from a class of
+           producer, given some set of forwarding paths
+
+    @param [in] hzType      hazard type
+    @param [in] icProducer  class of the producing instruction
+
+    @retval true            if the hazard type may arise
+*/
+constexpr bool IsHazardOf ( HZ_HAZARD_TYPE hzType, IC_INSTRUCTION_CLASS icProducer ) noexcept
+{
+    return (hzType == HZ_NO_FORWARD) || ((hzType == HZ_LOAD_USE) == (icProducer == IC_LOAD));
+}
+
+
+CPipelineConfig::CPipelineConfig ( )
+    : m_dwNumStages   ( DEFAULT_PIPELINE_STAGES ),
+      m_dwHazardStage ( DEFAULT_HAZARD_STAGE ),
+      m_dwForwarding  ( FP_NONE ),
+      m_dwPenalty     { GetNoForwardPenalty ( DEFAULT_PIPELINE_STAGES, DEFAULT_HAZARD_STAGE ),
+                        DEFAULT_EX_EX_PENALTY, DEFAULT_MEM_EX_PENALTY, DEFAULT_LOAD_USE_PENALTY },
+      m_dwIssueWidth  ( 1 ),
+      m_dwStageWidth  { },
+      m_bpPredictor   ( BP_NOT_TAKEN ),
+      m_dwPredictorBits ( DEFAULT_PREDICTOR_BITS ),
+      m_dwBranchPenalty ( GetMispredictPenalty ( DEFAULT_HAZARD_STAGE ) ),
+      m_dwLatency     { },
+      m_dwInterval    { },
+      m_vStageNames   ( g_szFourStageNames, g_szFourStageNames + _countof(g_szFourStageNames) )
+{
+    SetIssueWidth ( 1 );
+
+    for ( DWORD i = 0; i < IC_NUM_CLASSES; i++ )
+    {
+        m_dwLatency[i]  = g_dwDefaultLatency[i];
+        m_dwInterval[i] = g_dwDefaultInterval[i];
+    }
+}
+
+CPipelineConfig::CPipelineConfig ( DWORD dwNumStages )
+    : m_dwNumStages   ( DEFAULT_PIPELINE_STAGES ),
+      m_dwHazardStage ( DEFAULT_HAZARD_STAGE ),
+      m_dwForwarding  ( FP_NONE ),
+      m_dwPenalty     { 0, DEFAULT_EX_EX_PENALTY, DEFAULT_MEM_EX_PENALTY, DEFAULT_LOAD_USE_PENALTY },
+      m_dwIssueWidth  ( 1 ),
+      m_dwStageWidth  { },
+      m_bpPredictor   ( BP_NOT_TAKEN ),
+      m_dwPredictorBits ( DEFAULT_PREDICTOR_BITS ),
+      m_dwBranchPenalty ( GetMispredictPenalty ( DEFAULT_HAZARD_STAGE ) ),
+      m_dwLatency     { },
+      m_dwInterval    { },
+      m_vStageNames   ( )
+{
+    SetIssueWidth ( 1 );
+
+    for ( DWORD i = 0; i < IC_NUM_CLASSES; i++ )
+    {
+        m_dwLatency[i]  = g_dwDefaultLatency[i];
+        m_dwInterval[i] = g_dwDefaultInterval[i];
+    }
+
+    SetNumStages ( dwNumStages );
+}
+
+void CPipelineConfig::SetNumStages ( DWORD dwNumStages )
+{
+    if ( dwNumStages < MIN_PIPELINE_STAGES )
+        dwNumStages = MIN_PIPELINE_STAGES;
+    else if ( dwNumStages > MAX_PIPELINE_STAGES )
+        dwNumStages = MAX_PIPELINE_STAGES;
+
+    m_dwNumStages = dwNumStages;
+
+    // the last stage may not detect hazards
+    if ( m_dwHazardStage + 1 >= m_dwNumStages )
+    {
+        m_dwHazardStage   = DEFAULT_HAZARD_STAGE;
+        m_dwBranchPenalty = GetMispredictPenalty ( m_dwHazardStage );
+    }
+
+    m_dwPenalty[HZ_NO_FORWARD] = GetNoForwardPenalty ( m_dwNumStages, m_dwHazardStage );
+
+    m_vStageNames.clear ( );
+
+    if ( m_dwNumStages == _countof(g_szFourStageNames) )
+    {
+        m_vStageNames.assign ( g_szFourStageNames, g_szFourStageNames + _countof(g_szFourStageNames) );
+    }
+    else if ( m_dwNumStages == _countof(g_szFiveStageNames) )
+    {
+        m_vStageNames.assign ( g_szFiveStageNames, g_szFiveStageNames + _countof(g_szFiveStageNames) );
+    }
+    else
+    {
+        TCHAR szName[16] = { 0 };
+
+        for ( DWORD i = 0; i < m_dwNumStages; i++ )
+        {
+            _sntprintf ( szName, _countof(szName) - 1, _T("S%u"), i + 1 );
+            m_vStageNames.push_back ( szName );
+        }
+    }
+}
+
+bool CPipelineConfig::SetHazardStage ( DWORD dwStage ) noexcept
+{
+    bool bReturn = false;
+
+    if ( dwStage + 1 < m_dwNumStages )
+    {
+        m_dwHazardStage = dwStage;
+        m_dwPenalty[HZ_NO_FORWARD] = GetNoForwardPenalty ( m_dwNumStages, m_dwHazardStage );
+        m_dwBranchPenalty          = GetMispredictPenalty ( m_dwHazardStage );
+        bReturn = true;
+    }
+
+    return bReturn;
+}
+
+bool CPipelineConfig::SetIssueWidth ( DWORD dwWidth ) noexcept
+{
+    bool bReturn = false;
+
+    if ( dwWidth >= 1 && dwWidth <= MAX_ISSUE_WIDTH )
+    {
+        m_dwIssueWidth = dwWidth;
+
+        for ( DWORD i = 0; i < MAX_PIPELINE_STAGES; i++ )
+            m_dwStageWidth[i] = dwWidth;
+
+        bReturn = true;
+    }
+
+    return bReturn;
+}
+
+bool CPipelineConfig::SetStageWidth ( DWORD dwStage, DWORD dwWidth ) noexcept
+{
+    bool bReturn = false;
+
+    if ( dwStage < m_dwNumStages && dwWidth >= 1 && dwWidth <= m_dwIssueWidth )
+    {
+        m_dwStageWidth[dwStage] = dwWidth;
+        bReturn = true;
+    }
+
+    return bReturn;
+}
+
+bool CPipelineConfig::SetBranchPredictor ( BP_PREDICTOR_TYPE bpType ) noexcept
+{
+    bool bReturn = false;
+
+    if ( bpType < BP_NUM_TYPES )
+    {
+        m_bpPredictor = bpType;
+        bReturn = true;
+    }
+
+    return bReturn;
+}
+
+bool CPipelineConfig::SetPredictorBits ( DWORD dwBits ) noexcept
+{
+    bool bReturn = false;
+
+    if ( dwBits >= 1 && dwBits <= MAX_PREDICTOR_BITS )
+    {
+        m_dwPredictorBits = dwBits;
+        bReturn = true;
+    }
+
+    return bReturn;
+}
+
+bool CPipelineConfig::SetPenalty ( HZ_HAZARD_TYPE hzType, DWORD dwCycles ) noexcept
+{
+    bool bReturn = (hzType < HZ_NUM_TYPES);
+
+    // the stalls of every class of producer which may give rise to the
+    // hazard type, whatever the forwarding paths, must remain representable
+    for ( DWORD i = 0; bReturn && i < IC_NUM_CLASSES; i++ )
+    {
+        if ( IsHazardOf ( hzType, static_cast<IC_INSTRUCTION_CLASS>(i) ) )
+            bReturn = (dwCycles <= MAX_STALL_CYCLES + 1 - m_dwLatency[i]);
+    }
+
+    if ( bReturn )
+        m_dwPenalty[hzType] = dwCycles;
+
+    return bReturn;
+}
+
+bool CPipelineConfig::SetExecuteLatency ( IC_INSTRUCTION_CLASS icClass, DWORD dwCycles ) noexcept
+{
+    bool bReturn = (icClass < IC_NUM_CLASSES && dwCycles >= 1 && dwCycles <= MAX_EXECUTE_LATENCY);
+
+    for ( DWORD i = 0; bReturn && i < HZ_NUM_TYPES; i++ )
+    {
+        if ( IsHazardOf ( static_cast<HZ_HAZARD_TYPE>(i), icClass ) )
+            bReturn = (m_dwPenalty[i] <= MAX_STALL_CYCLES + 1 - dwCycles);
+    }
+
+    if ( bReturn )
+        m_dwLatency[icClass] = dwCycles;
+
+    return bReturn;
+}
+
+bool CPipelineConfig::SetIssueInterval ( IC_INSTRUCTION_CLASS icClass, DWORD dwCycles ) noexcept
+{
+    bool bReturn = false;
+
+    if ( icClass < IC_NUM_CLASSES && dwCycles <= MAX_EXECUTE_LATENCY )
+    {
+        m_dwInterval[icClass] = dwCycles;
+        bReturn = true;
+    }
+
+    return bReturn;
+}
+
+HZ_HAZARD_TYPE CPipelineConfig::GetHazardType ( IC_INSTRUCTION_CLASS icProducer ) const noexcept
+{
+    HZ_HAZARD_TYPE hzReturn = HZ_NO_FORWARD;
+
+    if ( icProducer == IC_LOAD )
+    {
+        // a loaded value only becomes available at the end of MEM
+        if ( m_dwForwarding & FP_MEM_EX )
+            hzReturn = HZ_LOAD_USE;
+    }
+    else
+    {
+        if ( m_dwForwarding & FP_EX_EX )
+            hzReturn = HZ_EX_EX;
+        else if ( m_dwForwarding & FP_MEM_EX )
+            hzReturn = HZ_MEM_EX;
+    }
+
+    return hzReturn;
+}
+
+QWORD CPipelineConfig::GetContentHash ( void ) const noexcept
+{
+    CContentHash hash;
+
+    hash.Add ( m_dwNumStages );
+    hash.Add ( m_dwHazardStage );
+    hash.Add ( m_dwForwarding );
+
+    for ( DWORD i = 0; i < HZ_NUM_TYPES; i++ )
+        hash.Add ( m_dwPenalty[i] );
+
+    hash.Add ( m_dwIssueWidth );
+
+    for ( DWORD i = 0; i < m_dwNumStages; i++ )
+        hash.Add ( m_dwStageWidth[i] );
+
+    hash.Add ( m_bpPredictor );
+    hash.Add ( m_dwPredictorBits );
+    hash.Add ( m_dwBranchPenalty );
+
+    for ( DWORD i = 0; i < IC_NUM_CLASSES; i++ )
+    {
+        hash.Add ( m_dwLatency[i] );
+        hash.Add ( m_dwInterval[i] );
+    }
+
+    return hash.GetHash ( );
+}
+
+const TCHAR* CPipelineConfig::GetStageName ( DWORD dwStage ) const noexcept
+{
+    return (dwStage < m_vStageNames.size ( )) ? m_vStageNames[dwStage].c_str ( ) : _T("");
+}
+
+bool CPipelineConfig::SetStageName ( DWORD dwStage, const TCHAR* szName )
+{
+    bool bReturn = false;
+
+    if ( dwStage < m_vStageNames.size ( ) && szName != nullptr )
+    {
+        m_vStageNames[dwStage] = szName;
+        bReturn = true;
+    }
+
+    return bReturn;
+}
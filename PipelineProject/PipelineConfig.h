@@ -0,0 +1,465 @@
+/**
+* @file       PipelineConfig.h
+* @brief      CPipelineConfig class interface
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  A pipeline descriptor, specifying the number of pipeline stages, their
+*  names, and which stage is responsible for detecting data hazards.
+*  Common configurations include:
+*  - the classic 4-stage pipeline: IF, ID, EX, WB
+*  - the 5-stage MIPS pipeline:    IF, ID, EX, MEM, WB
+*  - deeper N-stage pipelines, whose stages are named S1 .. SN
+*
+*  The descriptor also models the forwarding (or bypass) network.  A consumer
+*  instruction that immediately follows its producer stalls for a number of
+*  cycles determined by how the producer's result reaches it:
+*  - no forwarding, the result is available only after the final stage
+*  - EX to EX forwarding, an ALU result is passed straight back into EX
+*  - MEM to EX forwarding, a result is passed from the MEM stage into EX
+*  - a load-use hazard, a loaded value is only available after MEM
+*  Each of these carries its own configurable stall penalty.
+*
+*  Lastly, the descriptor specifies the issue width, the number of
+*  instructions that may be fetched, and leave each stage, in a single
+*  cycle.  Every stage is as wide as the pipeline issues, by default a
+*  single instruction, unless narrowed individually, e.g. a 4-wide machine
+*  having only a 2-wide execute stage.
+*
+*  Control hazards are described by the branch predictor consulted as each
+*  branch is fetched, and the number of fetch cycles lost flushing and
+*  refilling the pipeline once a branch is found to have been mispredicted,
+*  by default those of the stages up to and including the stage following
+*  the hazard detection stage, in which the branch is resolved.
+*
+*  Finally, each instruction class is described by its execute latency, the
+*  number of cycles its functional unit takes to produce a result, and the
+*  issue interval of that unit, the number of cycles which must separate the
+*  issue of two instructions of the class:
+*  - ALU, load and branch instructions execute in a single cycle, their
+*    units accepting an instruction every cycle
+*  - a multiply executes in 3 cycles, in a pipelined unit accepting an
+*    instruction every cycle
+*  - a divide executes in 12 cycles, in an unpipelined unit accepting an
+*    instruction only once the previous divide has completed
+*  The latency lengthens any dependency upon the class; the interval, when
+*  not 0, gives rise to structural hazards between instructions of the class.
+*/
+#pragma once
+
+#if !defined(_PIPELINE_CONFIG_H__)
+#define _PIPELINE_CONFIG_H__
+
+#ifndef _COMMON_DEF_H__
+    #include "CommonDef.h"
+#endif
+
+#ifndef _PLATFORM_DEF_H__
+    #include "PlatformDef.h"
+#endif
+
+#ifndef _STRING_
+    #include <string>
+#endif
+
+#ifndef _VECTOR_
+    #include <vector>
+#endif
+
+/// minimum number of stages in a pipeline
+constexpr DWORD MIN_PIPELINE_STAGES     = 3;
+/// maximum number of stages in a pipeline
+constexpr DWORD MAX_PIPELINE_STAGES     = 32;
+/// number of stages in the classic pipeline
+constexpr DWORD DEFAULT_PIPELINE_STAGES = 4;
+/// maximum number of instructions issued per cycle
+constexpr DWORD MAX_ISSUE_WIDTH         = 8;
+
+/// no forwarding paths, results are only available after the final stage
+constexpr DWORD FP_NONE   = 0x00;
+/// forwarding path from the output of EX to the input of EX
+constexpr DWORD FP_EX_EX  = 0x01;
+/// forwarding path from the output of MEM to the input of EX
+constexpr DWORD FP_MEM_EX = 0x02;
+/// all forwarding paths
+constexpr DWORD FP_FULL   = FP_EX_EX | FP_MEM_EX;
+
+/// log2 of the default number of branch predictor table entries
+constexpr DWORD DEFAULT_PREDICTOR_BITS  = 12;
+/// log2 of the maximum number of branch predictor table entries
+constexpr DWORD MAX_PREDICTOR_BITS      = 20;
+
+/// maximum number of cycles taken to execute an instruction
+constexpr DWORD MAX_EXECUTE_LATENCY     = 64;
+/// maximum number of stall cycles a single instruction may require, as
+/// each instruction holds its stall cycles in a BYTE
+constexpr DWORD MAX_STALL_CYCLES        = 0xFF;
+
+/**
+    @brief Branch prediction scheme
+*/
+typedef enum BP_PREDICTOR_TYPE : BYTE
+{
+    BP_NOT_TAKEN = 0,   ///< static, every branch is predicted not taken
+    BP_TAKEN,           ///< static, every branch is predicted taken
+    BP_BIMODAL,         ///< 2-bit saturating counters indexed by the branch address
+    BP_GSHARE,          ///< 2-bit saturating counters indexed by the branch
+                        ///< address XOR the global branch history
+    BP_NUM_TYPES        ///< number of prediction schemes
+} BP_PREDICTOR_TYPE_T;
+
+/**
+    @brief Data hazard type, identified by how the dependency is resolved
+*/
+typedef enum HZ_HAZARD_TYPE
+{
+    HZ_NO_FORWARD = 0,  ///< resolved through the register file
+    HZ_EX_EX,           ///< resolved by the EX to EX forwarding path
+    HZ_MEM_EX,          ///< resolved by the MEM to EX forwarding path
+    HZ_LOAD_USE,        ///< a load result resolved by the MEM to EX forwarding path
+    HZ_NUM_TYPES        ///< number of hazard types
+} HZ_HAZARD_TYPE_T;
+
+/**
+    @brief Pipeline descriptor
+
+    Stages are identified by their 0-based index, stage 0 being the
+    instruction fetch stage, and the last stage being the stage in which
+    an instruction completes.
+*/
+class CPipelineConfig
+{
+    DWORD                                m_dwNumStages;    ///< number of pipeline stages
+    DWORD                                m_dwHazardStage;  ///< index of the hazard detection stage
+    DWORD                                m_dwForwarding;   ///< mask of FP_xxx forwarding paths
+    DWORD                                m_dwPenalty[HZ_NUM_TYPES]; ///< stall cycles per hazard type
+    DWORD                                m_dwIssueWidth;   ///< instructions issued per cycle
+    DWORD                                m_dwStageWidth[MAX_PIPELINE_STAGES]; ///< instructions each stage holds
+    BP_PREDICTOR_TYPE                    m_bpPredictor;    ///< branch prediction scheme
+    DWORD                                m_dwPredictorBits; ///< log2 of the predictor table entries
+    DWORD                                m_dwBranchPenalty; ///< fetch cycles lost to a misprediction
+    DWORD                                m_dwLatency[IC_NUM_CLASSES];  ///< execute cycles per class
+    DWORD                                m_dwInterval[IC_NUM_CLASSES]; ///< issue interval per class, 0 if unlimited
+    std::vector<std::basic_string<TCHAR>> m_vStageNames;   ///< name of each stage
+
+public:
+    /// Default Constructor, describes the classic 4-stage pipeline
+    CPipelineConfig();
+
+    /**
+        @brief Initialization Constructor
+
+        Creates the conventional descriptor for the requested depth,
+        hazards being detected in the decode stage (index 1), and every
+        branch being predicted not taken.  Allocating the stage names may
+        throw std::bad_alloc.
+
+        @param [in] dwNumStages     number of pipeline stages, clamped to
+                                    [MIN_PIPELINE_STAGES..MAX_PIPELINE_STAGES]
+    */
+    explicit CPipelineConfig(DWORD dwNumStages);
+
+    /// Default Destructor
+    ~CPipelineConfig() = default;
+
+/**
+    @brief Retrieves the number of pipeline stages
+
+    @retval DWORD   number of stages
+*/
+    constexpr DWORD GetNumStages(void) const noexcept
+    { return m_dwNumStages; };
+
+/**
+    @brief Changes the number of pipeline stages
+
+    Only what follows from the depth is reset: the stage names become the
+    conventional ones, and the HZ_NO_FORWARD penalty that of the hazard
+    detection stage, which returns to the decode stage should it no longer
+    precede the last.  Every other parameter is retained.
+
+    @param [in] dwNumStages     number of pipeline stages, clamped to
+                                [MIN_PIPELINE_STAGES..MAX_PIPELINE_STAGES]
+*/
+    void SetNumStages(DWORD dwNumStages);
+
+/**
+    @brief Retrieves the index of the hazard detection stage
+
+    @retval DWORD   stage index
+*/
+    constexpr DWORD GetHazardStage(void) const noexcept
+    { return m_dwHazardStage; };
+
+/**
+    @brief Sets the hazard detection stage
+
+    An instruction stalled in the hazard detection stage is followed by
+    a bubble in the next stage, so the last stage may not be used.  The
+    HZ_NO_FORWARD penalty is reset to the number of cycles separating the
+    stage following dwStage from the end of the pipeline, and the branch
+    penalty to the number of stages up to and including that stage.
+
+    @param [in] dwStage     index of the stage
+
+    @retval true            on success
+    @retval false           if dwStage is out of range
+*/
+    bool SetHazardStage(DWORD dwStage) noexcept;
+
+/**
+    @brief Retrieves the name of a stage
+
+    @param [in] dwStage     index of the stage
+
+    @retval const TCHAR*    the stage name
+    @retval _T("")          if dwStage is out of range
+*/
+    const TCHAR* GetStageName(DWORD dwStage) const noexcept;
+
+/**
+    @brief Sets the name of a stage
+
+    @param [in] dwStage     index of the stage
+    @param [in] szName      new stage name
+
+    @retval true            on success
+    @retval false           if dwStage is out of range
+*/
+    bool SetStageName(DWORD dwStage, const TCHAR* szName);
+
+/**
+    @brief Retrieves the enabled forwarding paths
+
+    @retval DWORD   mask of FP_xxx values
+*/
+    constexpr DWORD GetForwarding(void) const noexcept
+    { return m_dwForwarding; };
+
+/**
+    @brief Sets the enabled forwarding paths
+
+    @param [in] dwSet   mask of FP_xxx values
+*/
+    void SetForwarding(DWORD dwSet) noexcept
+    { m_dwForwarding = dwSet & FP_FULL; };
+
+/**
+    @brief Retrieves the stall penalty of a hazard type
+
+    @param [in] hzType  hazard type
+
+    @retval DWORD       stall cycles required by an adjacent dependency
+*/
+    DWORD GetPenalty(HZ_HAZARD_TYPE hzType) const noexcept
+    { return (hzType < HZ_NUM_TYPES) ? m_dwPenalty[hzType] : 0; };
+
+/**
+    @brief Sets the stall penalty of a hazard type
+
+    The penalty is lengthened by the execute latency of the producer, see
+    GetHazardPenalty, and the result may not exceed MAX_STALL_CYCLES for
+    any class of producer the hazard type may arise from.
+
+    @param [in] hzType      hazard type
+    @param [in] dwCycles    stall cycles required by an adjacent dependency
+
+    @retval true            on success
+    @retval false           if hzType is out of range, or dwCycles is too
+                            large
+*/
+    bool SetPenalty(HZ_HAZARD_TYPE hzType, DWORD dwCycles) noexcept;
+
+/**
+    @brief Determines how a dependency upon a producer is resolved
+
+    @param [in] icProducer  class of the producing instruction
+
+    @retval HZ_HAZARD_TYPE  the resulting hazard type
+*/
+    HZ_HAZARD_TYPE GetHazardType(IC_INSTRUCTION_CLASS icProducer) const noexcept;
+
+/**
+    @brief Retrieves the stall cycles required by a consumer immediately
+           following its producer
+
+    The penalty of the hazard type is lengthened by each cycle the
+    producer executes beyond the first.
+
+    @param [in] icProducer  class of the producing instruction
+
+    @retval DWORD           number of stall cycles
+*/
+    DWORD GetHazardPenalty(IC_INSTRUCTION_CLASS icProducer) const noexcept
+    { return m_dwPenalty[GetHazardType(icProducer)] + GetExecuteLatency(icProducer) - 1; };
+
+/**
+    @brief Retrieves the execute latency of an instruction class
+
+    @param [in] icClass     instruction class
+
+    @retval DWORD           cycles taken to produce a result, 1 if icClass
+                            is out of range
+*/
+    DWORD GetExecuteLatency(IC_INSTRUCTION_CLASS icClass) const noexcept
+    { return (icClass < IC_NUM_CLASSES) ? m_dwLatency[icClass] : 1; };
+
+/**
+    @brief Sets the execute latency of an instruction class
+
+    @param [in] icClass     instruction class
+    @param [in] dwCycles    cycles taken to produce a result
+
+    @retval true            on success
+    @retval false           if icClass is out of range, dwCycles is not
+                            in [1..MAX_EXECUTE_LATENCY], or the hazard
+                            penalty of the class would then exceed
+                            MAX_STALL_CYCLES
+*/
+    bool SetExecuteLatency(IC_INSTRUCTION_CLASS icClass, DWORD dwCycles) noexcept;
+
+/**
+    @brief Retrieves the issue interval of an instruction class
+
+    @param [in] icClass     instruction class
+
+    @retval DWORD           cycles which must separate the issue of two
+                            instructions of the class, 0 if unlimited, or
+                            if icClass is out of range
+*/
+    DWORD GetIssueInterval(IC_INSTRUCTION_CLASS icClass) const noexcept
+    { return (icClass < IC_NUM_CLASSES) ? m_dwInterval[icClass] : 0; };
+
+/**
+    @brief Sets the issue interval of an instruction class
+
+    An interval of 1 describes a single pipelined unit, and an interval
+    equal to the execute latency a single unpipelined unit.
+
+    @param [in] icClass     instruction class
+    @param [in] dwCycles    cycles which must separate the issue of two
+                            instructions of the class, 0 if unlimited
+
+    @retval true            on success
+    @retval false           if icClass is out of range, or dwCycles
+                            exceeds MAX_EXECUTE_LATENCY
+*/
+    bool SetIssueInterval(IC_INSTRUCTION_CLASS icClass, DWORD dwCycles) noexcept;
+
+/**
+    @brief Retrieves the issue width
+
+    @retval DWORD   instructions issued per cycle
+*/
+    constexpr DWORD GetIssueWidth(void) const noexcept
+    { return m_dwIssueWidth; };
+
+/**
+    @brief Determines whether more than one instruction is issued per cycle
+
+    @retval true    if the issue width exceeds 1
+    @retval false   for a scalar pipeline
+*/
+    constexpr bool IsSuperscalar(void) const noexcept
+    { return m_dwIssueWidth > 1; };
+
+/**
+    @brief Sets the issue width
+
+    Every stage is reset to the new width.
+
+    @param [in] dwWidth     instructions issued per cycle
+
+    @retval true            on success
+    @retval false           if dwWidth is not in [1..MAX_ISSUE_WIDTH]
+*/
+    bool SetIssueWidth(DWORD dwWidth) noexcept;
+
+/**
+    @brief Retrieves the width of a stage
+
+    @param [in] dwStage     index of the stage
+
+    @retval DWORD           instructions the stage holds, 0 if dwStage
+                            is out of range
+*/
+    DWORD GetStageWidth(DWORD dwStage) const noexcept
+    { return (dwStage < m_dwNumStages) ? m_dwStageWidth[dwStage] : 0; };
+
+/**
+    @brief Narrows a stage, limiting the instructions it holds at once
+
+    @param [in] dwStage     index of the stage
+    @param [in] dwWidth     instructions the stage holds
+
+    @retval true            on success
+    @retval false           if dwStage is out of range, or dwWidth is
+                            not in [1..GetIssueWidth()]
+*/
+    bool SetStageWidth(DWORD dwStage, DWORD dwWidth) noexcept;
+
+/**
+    @brief Retrieves the branch prediction scheme
+
+    @retval BP_PREDICTOR_TYPE   prediction scheme
+*/
+    constexpr BP_PREDICTOR_TYPE GetBranchPredictor(void) const noexcept
+    { return m_bpPredictor; };
+
+/**
+    @brief Sets the branch prediction scheme
+
+    @param [in] bpType      prediction scheme
+
+    @retval true            on success
+    @retval false           if bpType is out of range
+*/
+    bool SetBranchPredictor(BP_PREDICTOR_TYPE bpType) noexcept;
+
+/**
+    @brief Retrieves the size of the branch predictor tables
+
+    @retval DWORD   log2 of the number of table entries
+*/
+    constexpr DWORD GetPredictorBits(void) const noexcept
+    { return m_dwPredictorBits; };
+
+/**
+    @brief Sets the size of the branch predictor tables, which also
+           determines the length of the global branch history
+
+    @param [in] dwBits      log2 of the number of table entries
+
+    @retval true            on success
+    @retval false           if dwBits is not in [1..MAX_PREDICTOR_BITS]
+*/
+    bool SetPredictorBits(DWORD dwBits) noexcept;
+
+/**
+    @brief Retrieves the branch misprediction penalty
+
+    @retval DWORD   fetch cycles lost to a mispredicted branch
+*/
+    constexpr DWORD GetBranchPenalty(void) const noexcept
+    { return m_dwBranchPenalty; };
+
+/**
+    @brief Sets the branch misprediction penalty
+
+    @param [in] dwCycles    fetch cycles lost to a mispredicted branch
+*/
+    void SetBranchPenalty(DWORD dwCycles) noexcept
+    { m_dwBranchPenalty = dwCycles; };
+
+/**
+    @brief Computes a hash of the parameters determining the results of a
+           simulation, i.e. every parameter except the stage names
+
+    @retval QWORD           64-bit content hash
+*/
+    QWORD GetContentHash(void) const noexcept;
+};
+
+#endif
@@ -9,47 +9,142 @@
 
 #include "stdafx.h"
 #include "PipelineSim.h"
+#include "CsrDependencyGraph.h"
+#include "HazardAnalysis.h"
+#include <algorithm>
 
 /**
-  four-stage pipeline only allows concurrent processing
-  of four instructions at a time.
+  the pipeline may momentarily hold one instruction beyond its depth
+  when fetching, plus a stall bubble inserted during decode.
 */
-constexpr int CONCURRENT_INSTRUCTION_LIMIT = 4;
-
-typedef std::list<CInstructionData>::iterator         LstIterator;
-typedef std::list<CInstructionData>::reverse_iterator rLstIterator;
+constexpr DWORD PIPELINE_SLOT_OVERHEAD = 2;
+
+
+CPipelineSim::CPipelineSim ( )
+    : m_Config(),
+      m_qwCycle(0),
+      m_qwStallCtr(0),
+      m_qwCompletedCtr(0),
+      m_dwMaxPipelineDepth ( m_Config.GetNumStages ( ) ),
+      m_rngInstructionPipeline ( m_Config.GetNumStages ( ) + PIPELINE_SLOT_OVERHEAD ),
+      m_queInstructions(),
+      m_Stats ( m_Config.GetNumStages ( ) ),
+      m_tpRunStart ( ),
+      m_bRunning ( false ),
+      m_pDag ( nullptr ),
+      m_vStageSlots ( m_Config.IsSuperscalar ( ) ? m_Config.GetNumStages ( ) * MAX_ISSUE_WIDTH : 0 ),
+      m_dwStageCount { },
+      m_vRelease ( ),
+      m_Predictor ( m_Config ),
+      m_dwRefillCtr ( 0 ),
+      m_dwQueuedBranches ( 0 ),
+      m_qwUnitRelease { },
+      m_dwExecuting ( 0 ),
+      m_dwCompletionWheel { },
+      m_bOutputAliases ( false )
+{
+}
 
+CPipelineSim::CPipelineSim ( const CPipelineConfig& config )
+    : m_Config(config),
+      m_qwCycle(0),
+      m_qwStallCtr(0),
+      m_qwCompletedCtr(0),
+      m_dwMaxPipelineDepth ( m_Config.GetNumStages ( ) ),
+      m_rngInstructionPipeline ( m_Config.GetNumStages ( ) + PIPELINE_SLOT_OVERHEAD ),
+      m_queInstructions(),
+      m_Stats ( m_Config.GetNumStages ( ) ),
+      m_tpRunStart ( ),
+      m_bRunning ( false ),
+      m_pDag ( nullptr ),
+      m_vStageSlots ( m_Config.IsSuperscalar ( ) ? m_Config.GetNumStages ( ) * MAX_ISSUE_WIDTH : 0 ),
+      m_dwStageCount { },
+      m_vRelease ( ),
+      m_Predictor ( m_Config ),
+      m_dwRefillCtr ( 0 ),
+      m_dwQueuedBranches ( 0 ),
+      m_qwUnitRelease { },
+      m_dwExecuting ( 0 ),
+      m_dwCompletionWheel { },
+      m_bOutputAliases ( false )
+{
+}
 
-CPipelineSim::CPipelineSim ( ) noexcept
-    : m_dwCycle(0),
-      m_dwStallCtr(0),
-      m_dwCompletedCtr(0),
-      m_dwMaxPipelineDepth ( CONCURRENT_INSTRUCTION_LIMIT ),
-      m_lstInstructionPipeline(),
-      m_queInstructions()
+void CPipelineSim::SetDependencyGraph ( const CCsrDependencyGraph* pDag )
 {
+    m_pDag = pDag;
+
+    // only a superscalar pipeline tracks when each instruction is released
+    if ( pDag != nullptr && m_Config.IsSuperscalar ( ) )
+        m_vRelease.assign ( pDag->GetNodeCapacity ( ), 0 );
+    else
+        std::vector<QWORD>().swap ( m_vRelease );
 }
 
 bool CPipelineSim::ProcessNextCycle(void) noexcept
 {
+    if ( m_Config.IsSuperscalar ( ) )
+        return ProcessNextCycleWide ( );
+
+    return ProcessNextCycleScalar ( );
+};
+
+bool CPipelineSim::ProcessNextCycleScalar(void) noexcept
+{
+    const DWORD dwNumStages = m_Config.GetNumStages();
+
+    // the states of the hazard detection stage, and the stage following it
+    const PS_PIPELINE_STATE psHazard = GetStageState(m_Config.GetHazardStage());
+    const PS_PIPELINE_STATE psNext   = GetStageState(m_Config.GetHazardStage() + 1);
+    // the state of the final stage, in which an instruction completes
+    const PS_PIPELINE_STATE psLast   = GetStageState(dwNumStages - 1);
+
     bool bReturn = false;
     // increment the cycle counter
-    m_dwCycle++;
+    m_qwCycle++;
+
+    RetireExecuted ( );
+
+    if ( m_bRunning == false )
+    {
+        m_tpRunStart = std::chrono::steady_clock::now ( );
+        m_bRunning   = true;
+    }
 
     // Begin processing our instruction queue
-    // check our current instruction pipeline size and see if we have room
-    if ( m_lstInstructionPipeline.size ( ) <= m_dwMaxPipelineDepth )
+    // check our current instruction pipeline size and see if we have room,
+    // an instruction fetched during a stall has yet to enter the fetch stage
+    // and so blocks any further fetching.
+    if ( m_rngInstructionPipeline.size ( ) <= m_dwMaxPipelineDepth &&
+         ( m_rngInstructionPipeline.empty ( ) || 
+           m_rngInstructionPipeline[0].GetState ( ) != PS_INVALID ) )
     {
         // check our instruction queue and see if we have anything left to execute
 
-        if (m_queInstructions.size() != 0)
+        if ( m_queInstructions.size ( ) != 0 && m_dwRefillCtr > 0 )
+        {
+            // the instruction fetched down the wrong path behind a
+            // mispredicted branch is flushed, leaving a bubble
+            CNoopInstruction NOOP;
+
+            m_rngInstructionPipeline.push_front ( NOOP );
+
+            m_dwRefillCtr--;
+            m_Stats.RecordFlushBubble ( );
+
+            bReturn = true;
+        }
+        else if (m_queInstructions.size() != 0)
         {
             CInstructionData instruction = m_queInstructions.front();
 
             m_queInstructions.pop();
 
+            if ( instruction.IsBranch ( ) )
+                PredictBranch ( instruction );
+
         // insert the instruction at the beginning of our pipeline
-            m_lstInstructionPipeline.push_front ( instruction );
+            m_rngInstructionPipeline.push_front ( instruction );
 
             bReturn = true;
         }
@@ -60,111 +155,645 @@ bool CPipelineSim::ProcessNextCycle(void) noexcept
             // clears the pipeline
             CNoopInstruction NOOP;
 
-            m_lstInstructionPipeline.push_front ( NOOP );
+            m_rngInstructionPipeline.push_front ( NOOP );
+
+            m_dwRefillCtr = 0;
+            m_Stats.RecordDrainBubble ( );
         }
     }
 
     bool bStalled = false;
-    // reverse iterate over the instruction currently in the pipeline 
-    for (rLstIterator itr = m_lstInstructionPipeline.rbegin(); 
-         itr != m_lstInstructionPipeline.rend() && (bStalled == false); ++itr)
+    // reverse iterate over the instruction currently in the pipeline,
+    // from the oldest (back) to the most recently fetched (front)
+    for (size_t nPos = m_rngInstructionPipeline.size(); 
+         nPos > 0 && (bStalled == false); --nPos)
     {
-        PS_PIPELINE_STATE stInstruction = itr->GetState();
+        CInstructionData* pInstruction = &m_rngInstructionPipeline[nPos - 1];
+
+        PS_PIPELINE_STATE stInstruction = pInstruction->GetState();
 
-        switch (stInstruction) 
+        if (stInstruction == PS_COMPLETED)
         {
+            continue;
+        }
+        else if (stInstruction == psLast)
+        {
+            // final stage, i.e. Write Back
+            pInstruction->SetState (PS_COMPLETED); // mark this for removal later
 
-            case PS_INVALID:   // initial default state
-                itr->SetState(PS_IF);
-                if ( itr->IsNOOP ( ) == false )
-                    bReturn = true;
-                break;
+            if (pInstruction->IsNOOP() == false)
+                Complete ( pInstruction->GetClass ( ) );
 
-            case PS_IF:        // Instruction Fetch state
-                itr->SetState(PS_ID);
-                if ( itr->IsNOOP ( ) == false )
-                    bReturn = true;
-                break;
+            continue;
+        }
+        else if (stInstruction == psHazard && pInstruction->IsDataDependent())
+        {
+            // need to verify if a dependency exists between this instruction
+            // and the immediately previous instruction, in which case
+            // we have to introduce a stall here, once for each cycle
+            // the producer's result is not yet available
+            pInstruction->SetStallCycles(pInstruction->GetStallCycles() - 1);
 
-            case PS_ID:        // Instruction Decode state
-                // need to verify if a dependency exists between this instruction
-                // and the immediately previous instruction
+            CNoopInstruction NOOP(psNext);
 
-                if (itr->IsDataDependent())
-                {
-                    // we have to introduce a stall here
-                    itr->SetDataDependent(false);
-                    
-                    CNoopInstruction NOOP(PS_EX);
-                    
-                    m_lstInstructionPipeline.insert(itr.base(), NOOP);
+            // the bubble occupies the slot immediately behind
+            // the stalled instruction
+            m_rngInstructionPipeline.insert(nPos, NOOP);
+
+            bStalled = true;
+            m_qwStallCtr++;
+            m_Stats.RecordHazardBubble ( );
+        }
+        else
+        {
+            // advance to the next stage, an instruction in the initial
+            // default state enters the fetch stage.
+            pInstruction->SetState(static_cast<PS_PIPELINE_STATE>(stInstruction + 1));
+        }
+
+        if (pInstruction->IsNOOP() == false)
+            bReturn = true;
+    }
+
+// check to see if we have a completed instruction for removal from the pipeline
+    if (m_rngInstructionPipeline.back().GetState() == PS_COMPLETED)
+        m_rngInstructionPipeline.pop_back();
+
+    // instructions still executing keep the run going
+    bReturn = bReturn || (m_dwExecuting > 0);
+
+    if ( bReturn )
+    {
+        const PS_PIPELINE_STATE psFetch = GetStageState ( 0 );
+
+        // the occupancy of each stage once the cycle has been processed
+        for ( size_t nPos = 0; nPos < m_rngInstructionPipeline.size ( ); ++nPos )
+        {
+            const CInstructionData& instruction = m_rngInstructionPipeline[nPos];
+
+            const PS_PIPELINE_STATE stInstruction = instruction.GetState ( );
+
+            if ( stInstruction >= psFetch && stInstruction <= psLast )
+                m_Stats.RecordStage ( stInstruction - psFetch, instruction.IsNOOP ( ) );
+        }
+
+        m_Stats.RecordCycle ( bStalled );
+    }
+    else
+    {
+        // the run is over
+        m_Stats.EndStallRun ( );
+        m_Stats.RecordElapsed ( std::chrono::duration<double> ( std::chrono::steady_clock::now ( ) - m_tpRunStart ).count ( ) );
+
+        m_bRunning = false;
+    }
+
+    return bReturn;
+};
+
+bool CPipelineSim::ProcessNextCycleWide ( void ) noexcept
+{
+    const DWORD dwNumStages = m_Config.GetNumStages ( );
+    const DWORD dwHazard    = m_Config.GetHazardStage ( );
+    const DWORD dwLast      = dwNumStages - 1;
+
+    m_qwCycle++;
+
+    if ( m_bRunning == false )
+    {
+        m_tpRunStart = std::chrono::steady_clock::now ( );
+        m_bRunning   = true;
+    }
+
+    RetireExecuted ( );
+
+    // every instruction in the final stage completes
+    for ( DWORD i = 0; i < m_dwStageCount[dwLast]; i++ )
+        Complete ( GetClass ( m_vStageSlots[dwLast * MAX_ISSUE_WIDTH + i] ) );
 
+    m_dwStageCount[dwLast] = 0;
+
+    bool bStalled = false;
+
+    // from the oldest stage to the most recently fetched, each passes as many
+    // of its instructions into the following stage, oldest first, as the
+    // following stage has room for
+    for ( DWORD dwStage = dwLast; dwStage > 0; dwStage-- )
+    {
+        INSTRUCTION_T* pFrom   = &m_vStageSlots[(dwStage - 1) * MAX_ISSUE_WIDTH];
+        INSTRUCTION_T* pTo     = &m_vStageSlots[dwStage * MAX_ISSUE_WIDTH];
+        DWORD&         dwFrom  = m_dwStageCount[dwStage - 1];
+        DWORD&         dwTo    = m_dwStageCount[dwStage];
+        const DWORD    dwRoom  = m_Config.GetStageWidth ( dwStage ) - dwTo;
+        DWORD          dwMoved = 0;
+
+        for ( ; dwMoved < dwFrom && dwMoved < dwRoom; dwMoved++ )
+        {
+            const INSTRUCTION_T instruction = pFrom[dwMoved];
+
+            if ( dwStage - 1 == dwHazard )
+            {
+                // an instruction held back by a dependency holds back every
+                // instruction behind it, those issued along with it included
+                if ( IsReady ( instruction ) == false )
+                {
                     bStalled = true;
-                    m_dwStallCtr++;
+                    break;
                 }
-                else
+
+                // as is one whose functional unit is not yet ready for it
+                const IC_INSTRUCTION_CLASS icClass    = GetClass ( instruction );
+                const DWORD                dwInterval = m_Config.GetIssueInterval ( icClass );
+
+                if ( dwInterval > 0 )
                 {
-                    itr->SetState(PS_EX);
+                    if ( m_qwUnitRelease[icClass] != 0 && m_qwCycle < m_qwUnitRelease[icClass] + dwInterval )
+                    {
+                        bStalled = true;
+                        break;
+                    }
+
+                    m_qwUnitRelease[icClass] = m_qwCycle;
                 }
 
-                if (itr->IsNOOP() == false)
-                    bReturn = true;
-                break;
+                if ( instruction < m_vRelease.size ( ) )
+                    m_vRelease[instruction] = m_qwCycle;
+            }
 
-            case PS_EX:        // Instruction Execute state
-                itr->SetState(PS_WB);
-                if (itr->IsNOOP() == false)
-                    bReturn = true;
-                break;
+            pTo[dwTo++] = instruction;
+        }
 
-            case PS_WB:         // Instruction Write Back state
-                itr->SetState (PS_COMPLETED); // mark this for removal later
+        for ( DWORD i = dwMoved; i < dwFrom; i++ )
+            pFrom[i - dwMoved] = pFrom[i];
 
-                if (itr->IsNOOP() == false)
-                    m_dwCompletedCtr++;
+        dwFrom -= dwMoved;
+    }
 
-                break;
+    // fetch as many instructions as the fetch stage has room for, unless
+    // refilling the pipeline behind a mispredicted branch, which itself
+    // ends the instructions fetched with it
+    const DWORD dwFetchWidth = m_Config.GetStageWidth ( 0 );
 
-            case PS_COMPLETED:
-            default:
+    if ( m_queInstructions.empty ( ) )
+    {
+        m_dwRefillCtr = 0;
+    }
+    else if ( m_dwRefillCtr > 0 )
+    {
+        if ( m_dwStageCount[0] < dwFetchWidth )
+        {
+            m_dwRefillCtr--;
+            m_Stats.RecordFlushBubble ( );
+        }
+    }
+    else
+    {
+        while ( m_dwStageCount[0] < dwFetchWidth && m_queInstructions.empty ( ) == false )
+        {
+            const CInstructionData instruction = m_queInstructions.front ( );
+
+            m_queInstructions.pop ( );
+
+            m_vStageSlots[m_dwStageCount[0]++] = instruction.GetInstruction ( );
 
+            if ( instruction.IsBranch ( ) && PredictBranch ( instruction ) )
                 break;
         }
     }
 
-// check to see if we have a completed instruction for removal from the pipeline
-    if (m_lstInstructionPipeline.back().GetState() == PS_COMPLETED)
-        m_lstInstructionPipeline.pop_back();
+    if ( m_dwStageCount[0] < dwFetchWidth && m_queInstructions.empty ( ) )
+        m_Stats.RecordDrainBubble ( );
+
+    if ( bStalled )
+    {
+        m_qwStallCtr++;
+        m_Stats.RecordHazardBubble ( );
+    }
+
+    // instructions may remain queued behind a refill of an empty pipeline,
+    // or be executing beyond it
+    bool bReturn = (m_dwExecuting > 0) || (m_queInstructions.empty ( ) == false);
+
+    for ( DWORD dwStage = 0; dwStage < dwNumStages && (bReturn == false); dwStage++ )
+        bReturn = (m_dwStageCount[dwStage] > 0);
+
+    if ( bReturn )
+    {
+        for ( DWORD dwStage = 0; dwStage < dwNumStages; dwStage++ )
+            m_Stats.RecordStage ( dwStage, m_dwStageCount[dwStage] == 0 );
+
+        m_Stats.RecordCycle ( bStalled );
+    }
+    else
+    {
+        // the run is over
+        m_Stats.EndStallRun ( );
+        m_Stats.RecordElapsed ( std::chrono::duration<double> ( std::chrono::steady_clock::now ( ) - m_tpRunStart ).count ( ) );
+
+        m_bRunning = false;
+    }
 
     return bReturn;
-};
+}
+
+bool CPipelineSim::IsReady ( INSTRUCTION_T instruction ) const noexcept
+{
+    if ( m_pDag == nullptr || m_pDag->HasNode ( instruction ) == false )
+        return true;
+
+    const CCsrGraphNode node = m_pDag->GetNode ( instruction );
+
+    for ( CCsrGraphNode::const_iterator pEdge = node.beginEdge ( ); pEdge != node.endEdge ( ); ++pEdge )
+    {
+        const NODE_ID_T idProducer = pEdge->GetDestNodeID ( );
+
+        // only dependencies upon previously released instructions are hazards,
+        // a producer's result being available p + 1 cycles after its release
+        if ( idProducer < m_vRelease.size ( ) && m_vRelease[idProducer] != 0 )
+        {
+            const QWORD qwReady = m_vRelease[idProducer] +
+                                  m_Config.GetHazardPenalty ( m_pDag->GetNode ( idProducer ).GetClass ( ) ) + 1;
+
+            if ( m_qwCycle < qwReady )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+IC_INSTRUCTION_CLASS CPipelineSim::GetClass ( INSTRUCTION_T instruction ) const noexcept
+{
+    return (m_pDag != nullptr && m_pDag->HasNode ( instruction )) ? m_pDag->GetNode ( instruction ).GetClass ( ) : IC_ALU;
+}
+
+void CPipelineSim::Complete ( IC_INSTRUCTION_CLASS icClass ) noexcept
+{
+    const DWORD dwLatency = m_Config.GetExecuteLatency ( icClass );
+
+    if ( dwLatency > 1 )
+    {
+        m_dwCompletionWheel[(m_qwCycle + dwLatency - 1) & (COMPLETION_WHEEL_SLOTS - 1)]++;
+        m_dwExecuting++;
+    }
+    else
+    {
+        m_qwCompletedCtr++;
+        m_Stats.RecordCompletion ( );
+    }
+}
+
+void CPipelineSim::RetireExecuted ( void ) noexcept
+{
+    if ( m_dwExecuting == 0 )
+        return;
+
+    DWORD& dwDue = m_dwCompletionWheel[m_qwCycle & (COMPLETION_WHEEL_SLOTS - 1)];
 
-size_t CPipelineSim::InsertInstruction ( const CInstructionData& instruction ) noexcept
+    for ( ; dwDue > 0; dwDue-- )
+    {
+        m_dwExecuting--;
+        m_qwCompletedCtr++;
+        m_Stats.RecordCompletion ( );
+    }
+}
+
+bool CPipelineSim::PredictBranch ( const CInstructionData& instruction ) noexcept
+{
+    const bool bTaken        = (instruction.GetClass ( ) == IC_BRANCH_TAKEN);
+    const bool bMispredicted = (m_Predictor.Predict ( instruction.GetInstruction ( ) ) != bTaken);
+
+    m_Predictor.Update ( instruction.GetInstruction ( ), bTaken );
+    m_Stats.RecordBranch ( bMispredicted );
+
+    if ( bMispredicted )
+        m_dwRefillCtr = m_Config.GetBranchPenalty ( );
+
+    m_dwQueuedBranches--;
+
+    return bMispredicted;
+}
+
+QWORD CPipelineSim::FastForward ( void ) noexcept
+{
+    QWORD qwReturn = 0;
+
+    // neither a superscalar pipeline, nor the predictor's, have a closed
+    // form, so are always stepped
+    if ( m_Config.IsSuperscalar ( ) || m_dwQueuedBranches > 0 )
+    {
+        while ( ProcessNextCycle ( ) )
+            qwReturn++;
+
+        return qwReturn;
+    }
+
+    const DWORD dwNumStages = m_Config.GetNumStages ( );
+    const DWORD dwHazard    = m_Config.GetHazardStage ( );
+
+    // a drained pipeline is either empty, or holds the NOOP in every stage
+    // that was fetched while draining a previous run, anything else being
+    // in flight
+    INSTRUCTION_T Slots[MAX_PIPELINE_STAGES];
+
+    GetStageOccupancy ( Slots );
+
+    DWORD dwNumNoops = 0;
+    bool  bInFlight  = false;
+
+    for ( DWORD dwStage = 0; dwStage < dwNumStages; dwStage++ )
+    {
+        if ( Slots[dwStage] == NOOP_INSTRUCTION )
+            dwNumNoops++;
+        else if ( Slots[dwStage] != INVALID_INSTRUCTION )
+            bInFlight = true;
+    }
+
+    const bool bDrained = (bInFlight == false) && (m_dwExecuting == 0) &&
+                          ((dwNumNoops == dwNumStages) || m_rngInstructionPipeline.empty ( ));
+
+    if ( bDrained == false )
+    {
+        while ( ProcessNextCycle ( ) )
+            qwReturn++;
+
+        return qwReturn;
+    }
+
+    const std::chrono::steady_clock::time_point tpStart = std::chrono::steady_clock::now ( );
+
+    const bool  bFull       = (m_rngInstructionPipeline.empty ( ) == false);
+    const QWORD qwNumQueued = m_queInstructions.size ( );
+
+    QWORD qwNumInstructions = 0;
+    QWORD qwNumStalls       = 0;
+    // the cycle in which the last deferred completion takes place
+    QWORD qwLastExecuted    = 0;
+
+    // the stages preceding the hazard detection stage hold the instructions
+    // behind a stalled one, the last few of which have fewer behind them
+    QWORD qwStalledBehind[MAX_PIPELINE_STAGES] = { 0 };
+
+    // the stalls are the only events in an otherwise fully predictable run,
+    // each instruction's stalls forming a run of their own
+    for ( ; m_queInstructions.empty ( ) == false; m_queInstructions.pop ( ) )
+    {
+        const DWORD dwStalls = m_queInstructions.front ( ).GetStallCycles ( );
+
+        if ( dwStalls > 0 )
+        {
+            for ( DWORD dwStage = 0; dwStage < dwHazard; dwStage++ )
+            {
+                if ( qwNumInstructions + (dwHazard - dwStage) < qwNumQueued )
+                    qwStalledBehind[dwStage] += dwStalls;
+            }
+
+            m_Stats.RecordStallRun ( dwStalls );
+        }
+
+        qwNumStalls += dwStalls;
+        qwNumInstructions++;
+
+        // the instruction leaves the final stage (stages - 1) cycles after
+        // it is fetched, and completes once it has finished executing
+        const DWORD dwLatency = m_Config.GetExecuteLatency ( m_queInstructions.front ( ).GetClass ( ) );
+
+        if ( dwLatency > 1 )
+            qwLastExecuted = std::max ( qwLastExecuted, qwNumInstructions + (dwNumStages - 1) + qwNumStalls + dwLatency - 1 );
+    }
+
+    if ( qwNumInstructions > 0 )
+    {
+        qwReturn = std::max ( qwNumInstructions + (dwNumStages - 1) + qwNumStalls, qwLastExecuted );
+
+        // the cycles spent waiting upon the last instructions executing
+        const QWORD qwExecuting = qwReturn - (qwNumInstructions + (dwNumStages - 1) + qwNumStalls);
+
+        // stage n is first occupied in cycle n + 1, unless a NOOP left over
+        // from the previous run occupies it, and then remains occupied until
+        // the end of the run, by an instruction or a bubble
+        for ( DWORD dwStage = 0; dwStage < dwNumStages; dwStage++ )
+        {
+            QWORD qwBusy = qwNumInstructions;
+
+            if ( dwStage < dwHazard )
+                qwBusy += qwStalledBehind[dwStage];
+            else if ( dwStage == dwHazard )
+                qwBusy += qwNumStalls;
+
+            const QWORD qwOccupied = bFull ? qwReturn : qwReturn - dwStage;
+
+            m_Stats.RecordStageBulk ( dwStage, qwBusy, qwOccupied - qwBusy );
+        }
+
+        // a NOOP is fetched in each of the final (stages) cycles, and in
+        // each cycle spent waiting
+        m_Stats.RecordDrainBulk ( dwNumStages + qwExecuting );
+    }
+    else
+    {
+        // the final cycle alone, fetching a single NOOP
+        m_Stats.RecordDrainBulk ( 1 );
+    }
+
+    m_Stats.RecordBulk ( qwReturn, qwNumInstructions, qwNumStalls );
+    m_Stats.RecordElapsed ( std::chrono::duration<double> ( std::chrono::steady_clock::now ( ) - tpStart ).count ( ) );
+
+    // leave the pipeline just as having stepped through the run would
+    if ( qwNumInstructions > 0 || bFull )
+    {
+        m_rngInstructionPipeline.clear ( );
+
+        for ( DWORD dwStage = dwNumStages; dwStage > 0; dwStage-- )
+            m_rngInstructionPipeline.push_front ( CNoopInstruction ( GetStageState ( dwStage - 1 ) ) );
+    }
+    else
+    {
+        m_rngInstructionPipeline.push_front ( CNoopInstruction ( GetStageState ( 0 ) ) );
+    }
+
+    // the final cycle, in which nothing remains to be executed
+    m_qwCycle        += qwReturn + 1;
+    m_qwStallCtr     += qwNumStalls;
+    m_qwCompletedCtr += qwNumInstructions;
+
+    return qwReturn;
+}
+
+size_t CPipelineSim::InsertInstruction ( const CInstructionData& instruction )
 {
     m_queInstructions.push(instruction);
 
+    if ( instruction.IsBranch ( ) )
+        m_dwQueuedBranches++;
+
     return m_queInstructions.size();
 };
 
-tostream& CPipelineSim::OutputCurrentInstructionCycle ( tostream& os ) noexcept
+size_t CPipelineSim::LoadInstructions ( const CCsrDependencyGraph& dag, CHazardAnalysis& hazards,
+                                        const std::vector<INSTRUCTION_T>* pIssueOrder )
 {
-    for ( LstIterator it = m_lstInstructionPipeline.begin ( ); 
-          it != m_lstInstructionPipeline.end ( ); ++it )
+    // a superscalar pipeline checks the dependencies itself, as it issues
+    SetDependencyGraph ( &dag );
+
+    if ( pIssueOrder != nullptr )
     {
-        switch (it->GetState())
+        hazards.Analyze ( dag, m_Config, *pIssueOrder );
+
+        for ( std::vector<INSTRUCTION_T>::const_iterator it = pIssueOrder->begin ( ); it != pIssueOrder->end ( ); ++it )
         {
-            case PS_IF:
-            case PS_ID:
-            case PS_EX:
-            case PS_WB:
-                os << it->GetInstruction() << _T(" ");
-                break;
-            default:
-                break;
+            CInstructionData instruction ( *it );
+
+            instruction.SetStallCycles ( hazards.GetStallCycles ( *it ) );
+            instruction.SetClass ( dag.GetNode ( *it ).GetClass ( ) );
+
+            InsertInstruction ( instruction );
+        }
+    }
+    else
+    {
+        hazards.Analyze ( dag, m_Config );
+
+        for ( CCsrDependencyGraph::const_iterator it = dag.begin ( ); it != dag.end ( ); ++it )
+        {
+            if ( it->IsValid ( ) )
+            {
+                CInstructionData instruction ( it->GetNodeID ( ) );
+
+                instruction.SetStallCycles ( hazards.GetStallCycles ( it->GetNodeID ( ) ) );
+                instruction.SetClass ( it->GetClass ( ) );
+
+                InsertInstruction ( instruction );
+            }
+        }
+    }
+
+    return m_queInstructions.size ( );
+}
+
+void CPipelineSim::Reset ( void ) noexcept
+{
+    m_qwCycle        = 0;
+    m_qwStallCtr     = 0;
+    m_qwCompletedCtr = 0;
+
+    m_rngInstructionPipeline.clear ( );
+
+    std::queue<CInstructionData>().swap ( m_queInstructions );
+
+    for ( DWORD i = 0; i < MAX_PIPELINE_STAGES; i++ )
+        m_dwStageCount[i] = 0;
+
+    std::fill ( m_vRelease.begin ( ), m_vRelease.end ( ), 0 );
+
+    m_Predictor.Reset ( );
+    m_dwRefillCtr      = 0;
+    m_dwQueuedBranches = 0;
+    m_dwExecuting      = 0;
+
+    for ( DWORD i = 0; i < IC_NUM_CLASSES; i++ )
+        m_qwUnitRelease[i] = 0;
+
+    for ( DWORD i = 0; i < COMPLETION_WHEEL_SLOTS; i++ )
+        m_dwCompletionWheel[i] = 0;
+
+    m_Stats.Reset ( m_Config.GetNumStages ( ) );
+    m_bRunning = false;
+}
+
+void CPipelineSim::GetStageOccupancy ( INSTRUCTION_T* pSlots, DWORD dwSlotsPerStage ) const noexcept
+{
+    const DWORD dwNumStages = m_Config.GetNumStages ( );
+
+    for ( DWORD i = 0; i < dwNumStages * dwSlotsPerStage; i++ )
+        pSlots[i] = INVALID_INSTRUCTION;
+
+    if ( m_Config.IsSuperscalar ( ) )
+    {
+        for ( DWORD i = 0; i < dwNumStages; i++ )
+        {
+            for ( DWORD j = 0; j < m_dwStageCount[i] && j < dwSlotsPerStage; j++ )
+                pSlots[i * dwSlotsPerStage + j] = m_vStageSlots[i * MAX_ISSUE_WIDTH + j];
         }
+
+        return;
     }
 
-    os << std::endl;
+    // no two instructions share the same state, and an instruction yet to
+    // enter the fetch stage, or one completed, occupies no stage
+    for ( size_t nPos = 0; nPos < m_rngInstructionPipeline.size ( ); ++nPos )
+    {
+        const CInstructionData& instruction = m_rngInstructionPipeline[nPos];
+
+        const PS_PIPELINE_STATE stInstruction = instruction.GetState ( );
+
+        if ( stInstruction != PS_INVALID && stInstruction <= GetStageState ( dwNumStages - 1 ) )
+            pSlots[(stInstruction - 1) * dwSlotsPerStage] = instruction.GetInstruction ( );
+    }
+}
+
+tostream& CPipelineSim::OutputCurrentInstructionCycle ( tostream& os ) const noexcept
+{
+    if ( m_Config.IsSuperscalar ( ) )
+    {
+        // the instructions of each stage are separated by commas, from the
+        // fetch stage onwards, an empty stage being output as a bubble
+        for ( DWORD dwStage = 0; dwStage < m_Config.GetNumStages ( ); dwStage++ )
+        {
+            if ( m_dwStageCount[dwStage] == 0 )
+                os << _T("-");
+
+            for ( DWORD i = 0; i < m_dwStageCount[dwStage]; i++ )
+            {
+                if ( i > 0 )
+                    os << _T(",");
+
+                OutputInstruction ( os, m_vStageSlots[dwStage * MAX_ISSUE_WIDTH + i] );
+            }
+
+            os << _T(" ");
+        }
+
+        if ( m_dwExecuting > 0 )
+            os << _T("(") << m_dwExecuting << _T(" executing)");
+
+        os << _T("\n");
+
+        return os;
+    }
+
+    for ( size_t nPos = 0; nPos < m_rngInstructionPipeline.size ( ); ++nPos )
+    {
+        const CInstructionData* pInstruction = &m_rngInstructionPipeline[nPos];
+
+        PS_PIPELINE_STATE stInstruction = pInstruction->GetState();
+
+        // only instructions currently occupying a stage are output
+        if ( stInstruction != PS_INVALID && stInstruction != PS_COMPLETED )
+        {
+            if (pInstruction->IsNOOP())
+                os << _T("- ");
+            else
+                OutputInstruction ( os, pInstruction->GetInstruction() ) << _T(" ");
+        }
+    }
+
+    // the pipeline may carry on, or drain, ahead of a deferred completion
+    if ( m_dwExecuting > 0 )
+        os << _T("(") << m_dwExecuting << _T(" executing)");
+
+    os << _T("\n");
+
+    return os;
+}
+
+tostream& CPipelineSim::OutputInstruction ( tostream& os, INSTRUCTION_T instruction ) const noexcept
+{
+    // the letters alias only the first 26 instructions of a trace
+    if ( m_bOutputAliases && instruction < 26 )
+        os << static_cast<TCHAR>(_T('A') + instruction);
+    else
+        os << instruction;
 
     return os;
 }
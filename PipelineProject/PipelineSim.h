@@ -16,22 +16,45 @@
     #include "CommonDef.h"
 #endif
 
-#ifndef _INC_TCHAR
-    #include <tchar.h>
+#ifndef _PLATFORM_DEF_H__
+    #include "PlatformDef.h"
 #endif
 
 #ifndef _QUEUE_
     #include <queue>
 #endif
 
-#ifndef _LIST_
-    #include <list>
+#ifndef _RING_BUFFER_H__
+    #include "RingBuffer.h"
+#endif
+
+#ifndef _PIPELINE_STATS_H__
+    #include "PipelineStats.h"
+#endif
+
+#ifndef _CHRONO_
+    #include <chrono>
+#endif
+
+#ifndef _PIPELINE_CONFIG_H__
+    #include "PipelineConfig.h"
+#endif
+
+#ifndef _BRANCH_PREDICTOR_H__
+    #include "BranchPredictor.h"
 #endif
 
 #ifndef _OSTREAM_
     #include <ostream>
 #endif
 
+#ifndef _VECTOR_
+    #include <vector>
+#endif
+
+class CCsrDependencyGraph;
+class CHazardAnalysis;
+
 #if defined(UNICODE) || defined(_UNICODE)
     #define tostream   std::wostream
 #else
@@ -40,29 +63,53 @@
 
 /**
     @brief Pipeline Instruction State
+
+    The state of an instruction occupying a pipeline stage is that
+    stage's 1-based stage number, in an N-stage pipeline values
+    [1..N] are used.  The stage names below are those of the classic
+    4-stage pipeline.
 */
-typedef enum PS_PIPELINE_STATE
+typedef enum PS_PIPELINE_STATE : BYTE
 {
-    PS_INVALID,   ///< initial default state
-    PS_IF,        ///< Instruction Fetch
-    PS_ID,        ///< Instruction Decode
-    PS_EX,        ///< Execute
-    PS_WB,        ///< Write Back
-    PS_COMPLETED  ///< instruction processing completed
+    PS_INVALID   = 0,    ///< initial default state
+    PS_IF        = 1,    ///< Instruction Fetch
+    PS_ID        = 2,    ///< Instruction Decode
+    PS_EX        = 3,    ///< Execute
+    PS_WB        = 4,    ///< Write Back
+    PS_COMPLETED = 0xFF  ///< instruction processing completed
 } PS_PIPELINE_STATE_T;
 
+/**
+    @brief Translates a 0-based stage index into its pipeline state
+
+    @param [in] dwStage     stage index, less than MAX_PIPELINE_STAGES
+
+    @retval PS_PIPELINE_STATE   state of an instruction occupying the stage
+*/
+constexpr PS_PIPELINE_STATE GetStageState(DWORD dwStage) noexcept
+{
+    return static_cast<PS_PIPELINE_STATE>(dwStage + 1);
+}
+
 
 /**
     In a more sophisticated simulation, the following would contain the
     actual instruction to be processed (either as a string or binary opcode);
-    however, in this instance it is only a single letter ('a'..'y').
+    however, in this instance it is only the numeric ID of the associated
+    dependency graph node.
 */
-typedef TCHAR INSTRUCTION_T;
+typedef DWORD INSTRUCTION_T;
 
 /// used to denote an uninitialized instruction
-constexpr INSTRUCTION_T INVALID_INSTRUCTION = 0;
+constexpr INSTRUCTION_T INVALID_INSTRUCTION = static_cast<INSTRUCTION_T>(-1);
 /// used to denote a no-operation instruction
-constexpr INSTRUCTION_T NOOP_INSTRUCTION    = '-';
+constexpr INSTRUCTION_T NOOP_INSTRUCTION    = static_cast<INSTRUCTION_T>(-2);
+
+/// number of cycles the completion timing wheel spans, a power of 2
+constexpr DWORD COMPLETION_WHEEL_SLOTS = 64;
+
+static_assert((COMPLETION_WHEEL_SLOTS & (COMPLETION_WHEEL_SLOTS - 1)) == 0, "COMPLETION_WHEEL_SLOTS must be a power of 2");
+static_assert(COMPLETION_WHEEL_SLOTS >= MAX_EXECUTE_LATENCY, "COMPLETION_WHEEL_SLOTS must span the longest execute latency");
 
 /** 
     @brief Instruction data and state
@@ -71,13 +118,15 @@ class CInstructionData
 {
     INSTRUCTION_T     m_Instruction;
     PS_PIPELINE_STATE m_psState;
-    bool              m_bDataDependent;
+    BYTE              m_byStallCycles;  ///< stall cycles still required in the hazard stage
+    IC_INSTRUCTION_CLASS m_icClass;     ///< class of the instruction
 public:
     /// Default Constructor
     constexpr CInstructionData() noexcept
         : m_Instruction    ( INVALID_INSTRUCTION ),
           m_psState        ( PS_INVALID ),
-          m_bDataDependent ( false )
+          m_byStallCycles  ( 0 ),
+          m_icClass        ( IC_ALU )
     { };
 
     /// Initialization Constructor
@@ -85,7 +134,8 @@ public:
                                           bool bDataDependent = false ) noexcept
         : m_Instruction    ( instruction ),
           m_psState        ( PS_INVALID ),
-          m_bDataDependent ( bDataDependent )
+          m_byStallCycles  ( bDataDependent ? 1 : 0 ),
+          m_icClass        ( IC_ALU )
     { };
 
     /// Initialization Constructor
@@ -94,7 +144,8 @@ public:
                                           bool bDataDependent = false ) noexcept
         : m_Instruction   ( instruction ),
           m_psState       ( psState ),
-          m_bDataDependent( bDataDependent )
+          m_byStallCycles ( bDataDependent ? 1 : 0 ),
+          m_icClass       ( IC_ALU )
     { };
 
     /// Destructor
@@ -112,10 +163,7 @@ public:
     @brief Gets the instruction pipeline state
 
     @retval PS_INVALID      initial default state
-    @retval PS_IF           Instruction Fetch
-    @retval PS_ID           Instruction Decode
-    @retval PS_EX           Execute
-    @retval PS_WB           Write Back
+    @retval [1..N]          1-based number of the stage occupied
     @retval PS_COMPLETED    instruction processing completed
 */
     constexpr PS_PIPELINE_STATE GetState(void) const noexcept
@@ -134,15 +182,54 @@ public:
                     annotated
 */
     constexpr bool    IsDataDependent(void) const noexcept
-    { return m_bDataDependent; };
+    { return m_byStallCycles != 0; };
 
     void              SetDataDependent(bool bSet = true) noexcept
-    { m_bDataDependent = bSet; };
+    { m_byStallCycles = bSet ? 1 : 0; };
+
+/**
+    @brief Retrieves the number of stall cycles the instruction still
+           requires in the hazard detection stage
+
+    @retval BYTE    count of stall cycles
+*/
+    constexpr BYTE    GetStallCycles(void) const noexcept
+    { return m_byStallCycles; };
+
+/**
+    @brief Sets the number of stall cycles required in the hazard detection
+           stage, as determined by the forwarding paths available
+
+    @param [in] dwCycles    count of stall cycles, saturated at 0xFF
+*/
+    void              SetStallCycles(DWORD dwCycles) noexcept
+    { m_byStallCycles = static_cast<BYTE>((dwCycles < 0xFF) ? dwCycles : 0xFF); };
+
+/**
+    @brief Retrieves the class of the instruction
+
+    @retval IC_INSTRUCTION_CLASS    the instruction class, IC_ALU by default
+*/
+    constexpr IC_INSTRUCTION_CLASS GetClass(void) const noexcept
+    { return m_icClass; };
+
+/**
+    @brief Sets the class of the instruction, that of a branch including its
+           traced outcome
+*/
+    void              SetClass(IC_INSTRUCTION_CLASS icSet) noexcept
+    { m_icClass = icSet; };
+
+    constexpr bool    IsBranch(void) const noexcept
+    { return IsBranchClass(m_icClass); };
 
     constexpr bool    IsNOOP(void) const noexcept
     { return m_Instruction == NOOP_INSTRUCTION; };
 };
 
+// the state, stall count and class share the word following the instruction
+static_assert(sizeof(CInstructionData) == 8, "unexpected CInstructionData layout");
+
 /** 
     @brief simulates injecting a bubble into the pipeline
 */
@@ -161,56 +248,166 @@ public:
 };
 
 /**
-    @brief A 4-staged pipeline simulation class
+    @brief An N-staged pipeline simulation class
     
     The following class attempts to simulate the processing
-    of instructions in a four-staged pipeline.  In a four-stage
-    pipeline it is possible to execute 'sub-instructions' of 
-    four separate instructions at the same time, with each one
+    of instructions in an N-staged pipeline, as described by a
+    CPipelineConfig (by default the classic four-stage pipeline).
+    In a four-stage pipeline it is possible to execute 'sub-instructions' 
+    of four separate instructions at the same time, with each one
     having a pipeline 'state' denoting what stage of the execution
     process it is in.  Additionally, no two instructions may share 
     the same 'state' concurrently.
 
-    This class simulates a pipeline in the form of a linked-list
-    to model the concurrent instruction processing.
+    This class simulates a pipeline in the form of a fixed-capacity ring
+    buffer of stage slots to model the concurrent instruction processing,
+    such that no allocation takes place while processing a cycle.  The 
+    front of the ring holds the most recently fetched instruction.
+
+    A pipeline issuing more than one instruction per cycle is simulated as
+    an in-order superscalar pipeline instead, each stage holding as many
+    instructions as its configured width.  Every cycle, the instructions of
+    each stage pass into the next, oldest first, as far as the next stage
+    has room for them.  Rather than precomputed stall cycles, an instruction
+    leaves the hazard detection stage only once the results of each of its
+    producers are available, as determined from the edges of the dependency
+    graph, so a consumer issued in the same cycle as its producer is held
+    back, taking every instruction behind it with it.  One stall is counted
+    for each cycle in which the hazard detection stage so holds back an
+    instruction, and a stage holding no instruction is counted as a bubble.
+
+    Either way, the branch predictor is consulted as each branch is fetched.
+    A correctly predicted branch costs nothing, its target being presumed
+    known in time, whereas the instructions fetched behind a mispredicted
+    branch, until it is resolved, are down the wrong path.  As a trace holds
+    the instructions of the path taken alone, the wrong path instructions
+    are simulated as a flush: nothing is fetched for as many fetch cycles as
+    the configured branch penalty, each being a bubble refilling the
+    pipeline.
+
+    An instruction of a class taking more than a single cycle to execute,
+    e.g. a divide, is handed off to its functional unit, leaving the main
+    pipeline to carry on; the cycles its unit is busy are accounted for by
+    the stall cycles of its consumers, and of the next instruction of the
+    same class.  Its completion is then deferred by each cycle of its
+    execute latency beyond the first, by way of a timing wheel: a ring of
+    COMPLETION_WHEEL_SLOTS counters, one per cycle, of the instructions
+    completing in that cycle.  Deferring a completion, and retiring those
+    of the current cycle, each cost a single counter update, however many
+    instructions are executing and however long they take.
 */
 class CPipelineSim
 {
-    DWORD                        m_dwCycle;                ///< maintains current pipeline cycle
-    DWORD                        m_dwStallCtr;             ///< a count of the stalls introduced
-    DWORD                        m_dwCompletedCtr;         ///< count of instructions that completed execution
+    CPipelineConfig              m_Config;                 ///< pipeline descriptor
+    QWORD                        m_qwCycle;                ///< maintains current pipeline cycle
+    QWORD                        m_qwStallCtr;             ///< a count of the stalls introduced
+    QWORD                        m_qwCompletedCtr;         ///< count of instructions that completed execution
     DWORD                        m_dwMaxPipelineDepth;     ///< limit on instructions in the pipeline
-    std::list<CInstructionData>  m_lstInstructionPipeline; ///< our instruction pipeline
+    CRingBuffer<CInstructionData> m_rngInstructionPipeline; ///< our instruction pipeline
     std::queue<CInstructionData> m_queInstructions;        ///< our instruction queue
+    CPipelineStats               m_Stats;                  ///< statistics of the cycles processed
+    std::chrono::steady_clock::time_point m_tpRunStart;    ///< wall time the current run started
+    bool                         m_bRunning;               ///< a run is in progress
+    const CCsrDependencyGraph*   m_pDag;                   ///< graph checked by a superscalar pipeline
+    std::vector<INSTRUCTION_T>   m_vStageSlots;            ///< MAX_ISSUE_WIDTH slots per superscalar stage, oldest first
+    DWORD                        m_dwStageCount[MAX_PIPELINE_STAGES]; ///< instructions in each superscalar stage
+    std::vector<QWORD>           m_vRelease;               ///< cycle each instruction left the hazard detection stage
+    CBranchPredictor             m_Predictor;              ///< consulted as each branch is fetched
+    DWORD                        m_dwRefillCtr;            ///< fetch cycles still lost to a misprediction
+    DWORD                        m_dwQueuedBranches;       ///< branches in the instruction queue
+    QWORD                        m_qwUnitRelease[IC_NUM_CLASSES]; ///< cycle a superscalar pipeline last issued to each unit
+    DWORD                        m_dwExecuting;            ///< instructions whose completion is deferred
+    DWORD                        m_dwCompletionWheel[COMPLETION_WHEEL_SLOTS]; ///< instructions completing in each cycle, modulo the slots
+    bool                         m_bOutputAliases;         ///< instructions 0-25 are output as the letters 'A' to 'Z'
 
 public:
-    /// Default Constructor
-    CPipelineSim() noexcept;
+    /// Default Constructor, simulates the classic 4-stage pipeline
+    CPipelineSim();
+
+    /**
+        @brief Initialization Constructor
+
+        The pipeline slots, and any predictor table, are allocated here,
+        std::bad_alloc being thrown should they not fit.
+
+        @param [in] config      descriptor of the pipeline to be simulated
+    */
+    explicit CPipelineSim(const CPipelineConfig& config);
+
     /// Default Destructor
     ~CPipelineSim() = default;
+
+/**
+    @brief Retrieves the descriptor of the simulated pipeline
+
+    @retval CPipelineConfig&    pipeline descriptor
+*/
+    const CPipelineConfig& GetConfig(void) const noexcept
+    { return m_Config; };
 /**
     @brief Retrieves the current number of cycles executed
 
-    @retval DWORD       current cycle
+    @retval QWORD       current cycle
 */
-    constexpr DWORD GetCycle(void) const noexcept
-    { return m_dwCycle; };
+    constexpr QWORD GetCycle(void) const noexcept
+    { return m_qwCycle; };
 
 /**
     @brief Retrieves the count of stalls introduced into the pipeline
 
-    @retval DWORD   count of stalls
+    @retval QWORD   count of stalls
 */
-    constexpr DWORD GetStallCount(void) const noexcept
-    { return m_dwStallCtr; };
+    constexpr QWORD GetStallCount(void) const noexcept
+    { return m_qwStallCtr; };
 
 /**
     @brief Retrieves the current count of completed instructions
 
-    @retval DWORD   count of completed instructions
+    @retval QWORD   count of completed instructions
+*/
+    constexpr QWORD GetCompletionCount(void) const noexcept
+    { return m_qwCompletedCtr; };
+
+/**
+    @brief Retrieves the count of instructions still executing, having left
+           the final stage with their completion deferred
+
+    @retval DWORD   count of executing instructions
+*/
+    constexpr DWORD GetExecutingCount(void) const noexcept
+    { return m_dwExecuting; };
+
+/**
+    @brief Retrieves the statistics of the cycles processed so far
+
+    @retval CPipelineStats&     statistics
+*/
+    const CPipelineStats& GetStats(void) const noexcept
+    { return m_Stats; };
+
+/**
+    @brief Sets the graph whose edges are checked when issuing more than
+           one instruction per cycle
+
+    The instructions are presumed to be the IDs of the graph's nodes.  A
+    scalar pipeline relies upon the stall cycles of each instruction alone,
+    and does not consult the graph; a superscalar one without a graph
+    treats every instruction as independent.
+
+    @param [in] pDag        frozen graph, which must outlive the
+                            simulation, or nullptr
+*/
+    void SetDependencyGraph(const CCsrDependencyGraph* pDag);
+
+/**
+    @brief Sets whether the instructions output are the letters aliasing
+           them in the trace
+
+    @param [in] bOutputAliases  true for instructions 0 to 25 to be output
+                                as 'A' to 'Z', those beyond remaining numbers
 */
-    constexpr DWORD GetCompletionCount(void) const noexcept
-    { return m_dwCompletedCtr; };
+    void SetOutputAliases(bool bOutputAliases) noexcept
+    { m_bOutputAliases = bOutputAliases; };
 
 /**
     @brief Process next pipeline instruction cycle
@@ -226,6 +423,29 @@ public:
 */
     bool ProcessNextCycle(void) noexcept;
 
+/**
+    @brief Processes every remaining pipeline cycle without stepping
+
+    Starting from a drained pipeline, an instruction leaves the fetch
+    stage every cycle, save for the bubbles inserted by the stalls it
+    requires in the hazard detection stage, and the last instruction
+    completes (stages - 1) cycles after it has been fetched.  The cycle,
+    stall and completion counts, and the statistics, are therefore computed
+    in closed form over the queued instructions, jumping directly from one
+    stall to the next, with exactly the results of calling ProcessNextCycle
+    until it returns false.  A drained pipeline is either empty, or holds
+    nothing but the NOOPs of a previous run having drained.  Otherwise, if
+    the pipeline is superscalar, or if any branch is queued, the remaining
+    cycles are stepped instead.  An instruction whose completion is
+    deferred by its execute latency extends the run until it completes,
+    each additional cycle fetching a NOOP.
+
+    @retval QWORD   number of cycles in which instructions remained to be
+                    executed, i.e. the count of ProcessNextCycle calls
+                    which would have returned true
+*/
+    QWORD FastForward(void) noexcept;
+
 /**
     @brief Adds the instruction to the instruction queue.
         
@@ -239,17 +459,143 @@ public:
 
     @retval size_t              number of instructions in the queue
 */
-    size_t InsertInstruction( const CInstructionData& instruction ) noexcept;
+    size_t InsertInstruction( const CInstructionData& instruction );
+
+/**
+    @brief Queues every instruction of a graph, with the stall cycles and
+           class of each
+
+    The hazards of the graph are analyzed for the issue order given, or
+    else for node ID order, and the graph is set as that checked by a
+    superscalar pipeline, see SetDependencyGraph.  Failing to queue them
+    all throws std::bad_alloc, with only some of them queued.
+
+    @param [in]     dag         frozen, acyclic graph, which must outlive
+                                the simulation
+    @param [in,out] hazards     analysis of the graph's hazards
+    @param [in]     pIssueOrder IDs of every node of the graph, in the order
+                                to be issued, or nullptr for node ID order
+
+    @retval size_t              number of instructions in the queue
+*/
+    size_t LoadInstructions( const CCsrDependencyGraph& dag, CHazardAnalysis& hazards,
+                             const std::vector<INSTRUCTION_T>* pIssueOrder = nullptr );
+
+/**
+    @brief Retrieves the number of instructions yet to be fetched
+
+    @retval size_t              number of instructions in the queue
+*/
+    size_t GetQueuedCount( void ) const noexcept
+    { return m_queInstructions.size(); };
+
+/**
+    @brief Returns the simulation to its initial state
+
+    Any queued or in-flight instructions are discarded, all counters and
+    statistics are cleared, and the branch predictor forgets its history,
+    such that the simulator may be reused for another instruction sequence.
+*/
+    void Reset(void) noexcept;
+
+/**
+    @brief Retrieves the instructions occupying each stage of the pipeline
+
+    @param [out] pSlots             receives dwSlotsPerStage entries for each
+                                    of GetConfig().GetNumStages() stages, the
+                                    instructions in the stage, oldest first,
+                                    NOOP_INSTRUCTION for a bubble, and
+                                    INVALID_INSTRUCTION for each slot unused
+    @param [in]  dwSlotsPerStage    number of entries of each stage, at least
+                                    the issue width for every instruction of
+                                    a superscalar stage to be retrieved
+*/
+    void GetStageOccupancy( INSTRUCTION_T* pSlots, DWORD dwSlotsPerStage = 1 ) const noexcept;
 
 /**
     @brief formats and outputs current pipelined instructions to the provided stream
 
+    The line is terminated without flushing the stream, flushing being at
+    the discretion of the caller.
+
     @param [in,out] os          destination output stream
 
     @retval tostream&           reference to updated stream
 */
-    tostream&   OutputCurrentInstructionCycle( tostream& os ) noexcept;
+    tostream&   OutputCurrentInstructionCycle( tostream& os ) const noexcept;
+
+private:
+/**
+    @brief Outputs an instruction, as its alias if one is to be output
 
+    @param [in,out] os          destination output stream
+    @param [in] instruction     instruction to be output
+
+    @retval tostream&           reference to updated stream
+*/
+    tostream&   OutputInstruction( tostream& os, INSTRUCTION_T instruction ) const noexcept;
+
+/**
+    @brief Implements ProcessNextCycle for a scalar pipeline
+*/
+    bool ProcessNextCycleScalar(void) noexcept;
+
+/**
+    @brief Implements ProcessNextCycle for a superscalar pipeline
+*/
+    bool ProcessNextCycleWide(void) noexcept;
+
+/**
+    @brief Determines whether the results of every producer of an
+           instruction are available to it in the current cycle
+
+    @param [in] instruction     instruction in the hazard detection stage
+
+    @retval true    if the instruction may leave the hazard detection stage
+    @retval false   if it must be held back
+*/
+    bool IsReady(INSTRUCTION_T instruction) const noexcept;
+
+/**
+    @brief Retrieves the class of an instruction in a superscalar stage
+
+    @param [in] instruction     instruction, presumed a node of the
+                                dependency graph
+
+    @retval IC_INSTRUCTION_CLASS    class of its node, IC_ALU if there is
+                                    no such node
+*/
+    IC_INSTRUCTION_CLASS GetClass(INSTRUCTION_T instruction) const noexcept;
+
+/**
+    @brief Completes an instruction leaving the final stage, or defers its
+           completion until its execute latency has elapsed
+
+    @param [in] icClass     class of the instruction
+*/
+    void Complete(IC_INSTRUCTION_CLASS icClass) noexcept;
+
+/**
+    @brief Completes the instructions deferred until the current cycle
+
+    As with an instruction leaving the final stage, the cycle in which the
+    last instruction completes is not itself part of the run, which lasts
+    only while any instruction remains executing.
+*/
+    void RetireExecuted(void) noexcept;
+
+/**
+    @brief Predicts a branch being fetched, and trains the predictor with
+           its traced outcome
+
+    A misprediction starts the refill of the pipeline.
+
+    @param [in] instruction     branch instruction being fetched
+
+    @retval true    if the branch was mispredicted
+    @retval false   if it was correctly predicted
+*/
+    bool PredictBranch(const CInstructionData& instruction) noexcept;
 
 };
 
@@ -0,0 +1,133 @@
+/**
+* @file       PipelineStats.cpp
+* @brief      CPipelineStats class implementation
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*/
+
+#include "stdafx.h"
+#include "PipelineStats.h"
+
+/**
+    @brief Outputs a string as a JSON string literal
+*/
+static void OutputJsonString ( std::basic_ostream<TCHAR>& os, const TCHAR* szValue ) noexcept
+{
+    os << _T('"');
+
+    for ( const TCHAR* pch = szValue; *pch != _T('\0'); ++pch )
+    {
+        if ( *pch == _T('"') || *pch == _T('\\') )
+            os << _T('\\') << *pch;
+        else if ( static_cast<unsigned>(*pch) < 0x20 )
+            os << _T(' ');
+        else
+            os << *pch;
+    }
+
+    os << _T('"');
+}
+
+
+CPipelineStats::CPipelineStats ( ) noexcept
+{
+    Reset ( DEFAULT_PIPELINE_STAGES );
+}
+
+CPipelineStats::CPipelineStats ( DWORD dwNumStages ) noexcept
+{
+    Reset ( dwNumStages );
+}
+
+void CPipelineStats::Reset ( DWORD dwNumStages ) noexcept
+{
+    m_dwNumStages     = (dwNumStages < MAX_PIPELINE_STAGES) ? dwNumStages : MAX_PIPELINE_STAGES;
+    m_dwCurrentRun    = 0;
+    m_qwCycles        = 0;
+    m_qwCompleted     = 0;
+    m_qwHazardBubbles = 0;
+    m_qwDrainBubbles  = 0;
+    m_qwFlushBubbles  = 0;
+    m_qwBranches      = 0;
+    m_qwMispredicted  = 0;
+    m_dElapsed        = 0.0;
+
+    for ( DWORD i = 0; i < MAX_PIPELINE_STAGES; i++ )
+    {
+        m_qwStageBusy[i]    = 0;
+        m_qwStageBubbles[i] = 0;
+    }
+
+    for ( DWORD i = 0; i < STALL_RUN_BUCKETS; i++ )
+        m_qwStallRuns[i] = 0;
+}
+
+QWORD CPipelineStats::GetStallRuns ( DWORD dwLength ) const noexcept
+{
+    QWORD qwReturn = 0;
+
+    if ( dwLength > 0 )
+        qwReturn = m_qwStallRuns[((dwLength < STALL_RUN_BUCKETS) ? dwLength : STALL_RUN_BUCKETS) - 1];
+
+    // a run still in progress has yet to be bucketed
+    if ( m_dwCurrentRun > 0 && (m_dwCurrentRun == dwLength ||
+                                (dwLength >= STALL_RUN_BUCKETS && m_dwCurrentRun >= STALL_RUN_BUCKETS)) )
+        qwReturn++;
+
+    return qwReturn;
+}
+
+std::basic_ostream<TCHAR>& CPipelineStats::OutputJson ( std::basic_ostream<TCHAR>& os, const CPipelineConfig& config ) const noexcept
+{
+    const std::streamsize      nPrecision = os.precision ( );
+    const std::ios_base::fmtflags ffFlags = os.flags ( );
+
+    os << std::fixed << std::setprecision(6);
+
+    os << _T("{\n");
+    os << _T("  \"stages\": ")           << m_dwNumStages     << _T(",\n");
+    os << _T("  \"cycles\": ")           << m_qwCycles        << _T(",\n");
+    os << _T("  \"instructions\": ")     << m_qwCompleted     << _T(",\n");
+    os << _T("  \"cpi\": ")              << GetCPI ( )        << _T(",\n");
+    os << _T("  \"ipc\": ")              << GetIPC ( )        << _T(",\n");
+    os << _T("  \"bubbles\": { \"data_hazard\": ") << m_qwHazardBubbles
+       << _T(", \"drain\": ") << m_qwDrainBubbles
+       << _T(", \"branch_flush\": ") << m_qwFlushBubbles << _T(" },\n");
+    os << _T("  \"branches\": { \"count\": ") << m_qwBranches
+       << _T(", \"mispredicted\": ") << m_qwMispredicted
+       << _T(", \"accuracy\": ") << GetPredictionAccuracy ( ) << _T(" },\n");
+
+    os << _T("  \"stage_occupancy\": [\n");
+
+    for ( DWORD i = 0; i < m_dwNumStages; i++ )
+    {
+        os << _T("    { \"stage\": ");
+        OutputJsonString ( os, config.GetStageName ( i ) );
+        os << _T(", \"busy\": ") << m_qwStageBusy[i]
+           << _T(", \"bubbles\": ") << m_qwStageBubbles[i]
+           << _T(", \"occupancy\": ")
+           << ((m_qwCycles > 0) ? static_cast<double>(m_qwStageBusy[i]) / m_qwCycles : 0.0)
+           << _T(" }") << ((i + 1 < m_dwNumStages) ? _T(",\n") : _T("\n"));
+    }
+
+    os << _T("  ],\n");
+
+    // indexed by run length - 1, the last entry counting every longer run
+    os << _T("  \"stall_run_histogram\": [");
+
+    for ( DWORD i = 0; i < STALL_RUN_BUCKETS; i++ )
+        os << ((i > 0) ? _T(", ") : _T(" ")) << GetStallRuns ( i + 1 );
+
+    os << _T(" ],\n");
+
+    os << _T("  \"elapsed_seconds\": ")   << m_dElapsed              << _T(",\n");
+    os << _T("  \"cycles_per_second\": ") << GetCyclesPerSecond ( ) << _T("\n");
+    os << _T("}") << std::endl;
+
+    os.flags ( ffFlags );
+    os.precision ( nPrecision );
+
+    return os;
+}
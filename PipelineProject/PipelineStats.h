@@ -0,0 +1,313 @@
+/**
+* @file       PipelineStats.h
+* @brief      CPipelineStats class interface
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  Counters gathered by CPipelineSim while it runs, covering the cycles in
+*  which instructions remained to be executed, i.e. those for which
+*  ProcessNextCycle returns true:
+*  - cycles and completed instructions, hence CPI and IPC
+*  - the occupancy of each stage, by instructions and by bubbles
+*  - bubbles by cause, data hazard stalls, the NOOPs fetched to drain the
+*    pipeline once the instruction queue is empty, and the fetch cycles
+*    lost refilling it after a mispredicted branch
+*  - branches fetched, and how many of them were mispredicted
+*  - a histogram of the lengths of runs of consecutive stall cycles
+*  - the wall time spent simulating, hence simulated cycles per second
+*
+*  All of the counters are fixed-size, such that recording involves no
+*  allocation and, each simulator owning its own, no locking.
+*/
+#pragma once
+
+#if !defined(_PIPELINE_STATS_H__)
+#define _PIPELINE_STATS_H__
+
+#ifndef _PIPELINE_CONFIG_H__
+    #include "PipelineConfig.h"
+#endif
+
+#ifndef _OSTREAM_
+    #include <ostream>
+#endif
+
+/// number of stall run histogram buckets, the last counting every longer run
+constexpr DWORD STALL_RUN_BUCKETS = 32;
+
+/**
+    @brief Pipeline simulation statistics
+*/
+class CPipelineStats
+{
+    DWORD   m_dwNumStages;                          ///< number of pipeline stages
+    DWORD   m_dwCurrentRun;                         ///< length of the stall run in progress
+    QWORD   m_qwCycles;                             ///< cycles recorded
+    QWORD   m_qwCompleted;                          ///< instructions completed
+    QWORD   m_qwHazardBubbles;                      ///< bubbles inserted by data hazard stalls
+    QWORD   m_qwDrainBubbles;                       ///< NOOPs fetched to drain the pipeline
+    QWORD   m_qwFlushBubbles;                       ///< NOOPs fetched refilling after a misprediction
+    QWORD   m_qwBranches;                           ///< branches fetched
+    QWORD   m_qwMispredicted;                       ///< branches mispredicted
+    QWORD   m_qwStageBusy[MAX_PIPELINE_STAGES];     ///< cycles each stage held an instruction
+    QWORD   m_qwStageBubbles[MAX_PIPELINE_STAGES];  ///< cycles each stage held a bubble
+    QWORD   m_qwStallRuns[STALL_RUN_BUCKETS];       ///< count of stall runs by length - 1
+    double  m_dElapsed;                             ///< wall time simulated, in seconds
+
+public:
+    /// Default Constructor
+    CPipelineStats() noexcept;
+
+    /**
+        @brief Initialization Constructor
+
+        @param [in] dwNumStages     number of pipeline stages
+    */
+    explicit CPipelineStats(DWORD dwNumStages) noexcept;
+
+    /// Default Destructor
+    ~CPipelineStats() = default;
+
+/**
+    @brief Clears every counter
+
+    @param [in] dwNumStages     number of pipeline stages
+*/
+    void Reset(DWORD dwNumStages) noexcept;
+
+/**
+    @brief Retrieves the number of pipeline stages
+
+    @retval DWORD   count of stages
+*/
+    constexpr DWORD GetNumStages(void) const noexcept
+    { return m_dwNumStages; };
+
+/**
+    @brief Retrieves the number of cycles recorded
+
+    @retval QWORD   count of cycles
+*/
+    constexpr QWORD GetCycles(void) const noexcept
+    { return m_qwCycles; };
+
+/**
+    @brief Retrieves the number of instructions completed
+
+    @retval QWORD   count of instructions
+*/
+    constexpr QWORD GetCompleted(void) const noexcept
+    { return m_qwCompleted; };
+
+/**
+    @brief Retrieves the number of bubbles inserted by data hazard stalls
+
+    @retval QWORD   count of bubbles
+*/
+    constexpr QWORD GetHazardBubbles(void) const noexcept
+    { return m_qwHazardBubbles; };
+
+/**
+    @brief Retrieves the number of NOOPs fetched to drain the pipeline
+
+    @retval QWORD   count of bubbles
+*/
+    constexpr QWORD GetDrainBubbles(void) const noexcept
+    { return m_qwDrainBubbles; };
+
+/**
+    @brief Retrieves the number of NOOPs fetched refilling the pipeline
+           after a mispredicted branch
+
+    @retval QWORD   count of bubbles
+*/
+    constexpr QWORD GetFlushBubbles(void) const noexcept
+    { return m_qwFlushBubbles; };
+
+/**
+    @brief Retrieves the number of branches fetched
+
+    @retval QWORD   count of branches
+*/
+    constexpr QWORD GetBranches(void) const noexcept
+    { return m_qwBranches; };
+
+/**
+    @brief Retrieves the number of branches mispredicted
+
+    @retval QWORD   count of branches
+*/
+    constexpr QWORD GetMispredicted(void) const noexcept
+    { return m_qwMispredicted; };
+
+/**
+    @brief Retrieves the fraction of branches correctly predicted
+
+    @retval double  prediction accuracy, 0 if no branch has been fetched
+*/
+    double GetPredictionAccuracy(void) const noexcept
+    { return (m_qwBranches > 0) ? static_cast<double>(m_qwBranches - m_qwMispredicted) / m_qwBranches : 0.0; };
+
+/**
+    @brief Retrieves the cycles a stage held an instruction
+
+    @param [in] dwStage     index of the stage
+
+    @retval QWORD           count of cycles, 0 if dwStage is out of range
+*/
+    QWORD GetStageBusy(DWORD dwStage) const noexcept
+    { return (dwStage < m_dwNumStages) ? m_qwStageBusy[dwStage] : 0; };
+
+/**
+    @brief Retrieves the cycles a stage held a bubble
+
+    @param [in] dwStage     index of the stage
+
+    @retval QWORD           count of cycles, 0 if dwStage is out of range
+*/
+    QWORD GetStageBubbles(DWORD dwStage) const noexcept
+    { return (dwStage < m_dwNumStages) ? m_qwStageBubbles[dwStage] : 0; };
+
+/**
+    @brief Retrieves the number of stall runs of a given length
+
+    @param [in] dwLength    run length, the last bucket counting every
+                            run of STALL_RUN_BUCKETS cycles or more
+
+    @retval QWORD           count of runs
+*/
+    QWORD GetStallRuns(DWORD dwLength) const noexcept;
+
+/**
+    @brief Retrieves the wall time simulated
+
+    @retval double  elapsed seconds
+*/
+    constexpr double GetElapsed(void) const noexcept
+    { return m_dElapsed; };
+
+/**
+    @brief Retrieves the cycles per completed instruction
+
+    @retval double  CPI, 0 if nothing has completed
+*/
+    double GetCPI(void) const noexcept
+    { return (m_qwCompleted > 0) ? static_cast<double>(m_qwCycles) / m_qwCompleted : 0.0; };
+
+/**
+    @brief Retrieves the instructions completed per cycle
+
+    @retval double  IPC, 0 if no cycles have been recorded
+*/
+    double GetIPC(void) const noexcept
+    { return (m_qwCycles > 0) ? static_cast<double>(m_qwCompleted) / m_qwCycles : 0.0; };
+
+/**
+    @brief Retrieves the simulated cycles per second of wall time
+
+    @retval double  cycles per second, 0 if no time has been recorded
+*/
+    double GetCyclesPerSecond(void) const noexcept
+    { return (m_dElapsed > 0.0) ? m_qwCycles / m_dElapsed : 0.0; };
+
+/**
+    @brief Formats and outputs the statistics as a JSON object
+
+    @param [in,out] os      destination output stream
+    @param [in] config      descriptor of the pipeline, naming the stages
+
+    @retval std::basic_ostream<TCHAR>&  reference to updated stream
+*/
+    std::basic_ostream<TCHAR>& OutputJson(std::basic_ostream<TCHAR>& os, const CPipelineConfig& config) const noexcept;
+
+/**
+    @name Recording, on behalf of CPipelineSim
+    @{
+*/
+    /// records a cycle in which instructions remained, and whether it stalled
+    void RecordCycle(bool bStalled) noexcept
+    {
+        m_qwCycles++;
+
+        if ( bStalled )
+            m_dwCurrentRun++;
+        else
+            EndStallRun ( );
+    };
+
+    /// records the occupant of a stage during the cycle
+    void RecordStage(DWORD dwStage, bool bNoop) noexcept
+    {
+        if ( bNoop )
+            m_qwStageBubbles[dwStage]++;
+        else
+            m_qwStageBusy[dwStage]++;
+    };
+
+    /// records a completed instruction
+    void RecordCompletion(void) noexcept
+    { m_qwCompleted++; };
+
+    /// records a bubble inserted by a data hazard stall
+    void RecordHazardBubble(void) noexcept
+    { m_qwHazardBubbles++; };
+
+    /// records a NOOP fetched to drain the pipeline
+    void RecordDrainBubble(void) noexcept
+    { m_qwDrainBubbles++; };
+
+    /// records a NOOP fetched refilling the pipeline after a misprediction
+    void RecordFlushBubble(void) noexcept
+    { m_qwFlushBubbles++; };
+
+    /// records a branch fetched, and whether it was mispredicted
+    void RecordBranch(bool bMispredicted) noexcept
+    {
+        m_qwBranches++;
+
+        if ( bMispredicted )
+            m_qwMispredicted++;
+    };
+
+    /// records a run of stall cycles of a given length
+    void RecordStallRun(DWORD dwLength) noexcept
+    {
+        if ( dwLength > 0 )
+            m_qwStallRuns[((dwLength < STALL_RUN_BUCKETS) ? dwLength : STALL_RUN_BUCKETS) - 1]++;
+    };
+
+    /// ends any stall run in progress
+    void EndStallRun(void) noexcept
+    {
+        RecordStallRun ( m_dwCurrentRun );
+        m_dwCurrentRun = 0;
+    };
+
+    /// records the wall time taken to simulate
+    void RecordElapsed(double dElapsed) noexcept
+    { m_dElapsed += dElapsed; };
+
+    /// records cycles, completed instructions and hazard bubbles at once
+    void RecordBulk(QWORD qwCycles, QWORD qwCompleted, QWORD qwHazardBubbles) noexcept
+    {
+        m_qwCycles        += qwCycles;
+        m_qwCompleted     += qwCompleted;
+        m_qwHazardBubbles += qwHazardBubbles;
+    };
+
+    /// records cycles of stage occupancy at once
+    void RecordStageBulk(DWORD dwStage, QWORD qwBusy, QWORD qwBubbles) noexcept
+    {
+        m_qwStageBusy[dwStage]    += qwBusy;
+        m_qwStageBubbles[dwStage] += qwBubbles;
+    };
+
+    /// records NOOPs fetched to drain the pipeline at once
+    void RecordDrainBulk(QWORD qwBubbles) noexcept
+    { m_qwDrainBubbles += qwBubbles; };
+/** @} */
+};
+
+#endif
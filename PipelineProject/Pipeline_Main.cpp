@@ -47,33 +47,52 @@
  */
 
 #include "stdafx.h"
-#include <fstream>
-#include <sstream>
-#include <cctype>
-#include <locale>
-#include <codecvt>
 #include "DependencyGraph.h"
+#include "CsrDependencyGraph.h"
+#include "EdgeListBuilder.h"
+#include "TraceLoader.h"
+#include "HazardAnalysis.h"
+#include "ListScheduler.h"
+#include "CriticalPath.h"
+#include "IncrementalAnalysis.h"
 #include "PipelineSim.h"
+#include "StreamingSim.h"
+#include "BatchDriver.h"
+#include "ParameterSweep.h"
+#include "ResultCache.h"
+#include "TraceSink.h"
+#include "OccupancyTrace.h"
 
-#if defined(UNICODE) || defined(_UNICODE)
-    #define tifstream      std::wifstream
-    #define tstringstream  std::wstringstream
-#else
-    #define tifstream      std::ifstream
-    #define tstringstream  std::stringstream
+#ifndef _CHRONO_
+    #include <chrono>
+#endif
+
+#ifndef _NEW_
+    #include <new>
 #endif
 
-/// maximum instructions specified
-constexpr int MAX_INSTRUCTIONS           = 25;
-/// non-overlapped cycles required to execute 1 instruction in a 4 staged-pipeline
-constexpr int BASE_CYCLES_PER_INSTUCTION = 4;
 
 /// File used to read in test case data
 constexpr TCHAR  g_szFileName[] = _T("InstructionInputData.txt");
-/// Global directed acyclic graph object
-CDependencyGraph g_DAG(MAX_INSTRUCTIONS);
-/// Global pipeline simulation object
-CPipelineSim     g_PipelineSim;
+/// File written by a buffered trace, unless named otherwise
+constexpr TCHAR  g_szTraceFileName[] = _T("PipelineTrace.txt");
+/// options of the command line, output when an argument is not recognized
+constexpr TCHAR  g_szUsage[] =
+    _T("usage: PipelineProject [input file] [-save <binary graph file>] [-stages <n>]\n")
+    _T("                       [-forward none|ex|mem|full] [-schedule] [-critical]\n")
+    _T("                       [-patch <file of edits to the trace>]\n")
+    _T("                       [-issue <width>] [-stage-width <width of each stage>]\n")
+    _T("                       [-predictor nt|taken|bimodal|gshare] [-predictor-bits <n>]\n")
+    _T("                       [-branch-penalty <cycles>] [-mul-latency <cycles>] [-div-latency <cycles>]\n")
+    _T("                       [-batch <directory|manifest file>] [-threads <n>]\n")
+    _T("                       [-sweep <depths>] [-sweep-forward <list>] [-sweep-penalty <list>]\n")
+    _T("                       [-sweep-hazard none|ex|mem|load]\n")
+    _T("                       [-sweep-step] [-cache <result cache file>]\n")
+    _T("                       [-fast] [-trace console|off|buffered|sampled]\n")
+    _T("                       [-trace-file <file>] [-sample <n, 0 for stall cycles only>]\n")
+    _T("                       [-occupancy <file>] [-dump <occupancy file> <first cycle, from 1> <count>]\n")
+    _T("                       [-stats <JSON file, - for the console>]\n")
+    _T("                       [-stream] [-stream-block <nodes per block>]\n");
 
 
 /**
@@ -82,105 +101,79 @@ CPipelineSim     g_PipelineSim;
  *
  * The basic formula to calculate the execution cycles required to
  * run N instructions sequentially (non-overlapped) in this scenario
- * is: <b>N * 4 cycles</b>
+ * is: <b>N * 4 cycles</b>, or more generally <b>N * S cycles</b> for
+ * an S staged pipeline, plus the execute cycles beyond the first of
+ * each instruction of a multi-cycle class, which the next instruction
+ * has to wait upon.
  *
  * @param [in] dag          DAG object containing a list of instructions
+ * @param [in] config       descriptor of the pipeline
  *
- * @retval int              the number sequential cycles required to run 
+ * @retval QWORD            the number sequential cycles required to run 
  *                          the instructions contained in DAG
  */
-int  CalculateSequentialExecutionCycles(const CDependencyGraph& dag) noexcept;
+QWORD CalculateSequentialExecutionCycles(const CCsrDependencyGraph& dag, const CPipelineConfig& config) noexcept;
 
 /**
- * @brief CalculateCompleteOverlappedExecutionCycles calculates the best 
- * case execution scenario in terms of minimum number of cycles required
- * to execute the set of instructions.
+ * @brief ParseForwarding translates a forwarding option into its paths.
  *
- * The basic formula to calculate the execution cycles required to run
- * N instructions in a 4 staged pipeline is something like:
+ * @param [in] szOption     one of "none", "ex", "mem" or "full"
  *
- * 1. Calculate number of cycles to execute 1st instruction, in this case
- *    it is 4 cycles.
- * 2. Then, based on the fact that a subsequent instruction will complete
- *    every cycle from cycle 4 on, for N number of instructions, therefore
- *    it will take <b>N + 3 cycles</b> to run the entire set of N instructions.
+ * @retval DWORD            mask of FP_xxx forwarding paths
+ */
+DWORD ParseForwarding ( const TCHAR* szOption ) noexcept;
+
+/**
+ * @brief ParseHazardType translates a hazard option into its hazard type.
  *
- * @param [in] dag          DAG object containing a list of instructions
+ * @param [in] szOption     one of "none", "ex", "mem" or "load", the
+ *                          dependencies resolved through the register file,
+ *                          or by the forwarding path named, respectively
  *
- * @retval int              the number of overlapped cycles (with no delays) 
- *                          required to run the instructions contained in DAG
+ * @retval HZ_HAZARD_TYPE   the hazard type, HZ_LOAD_USE if unrecognized
  */
-int  CalculateCompleteOverlappedExecutionCycles ( const CDependencyGraph& dag ) noexcept;
-
-/** 
-* @brief CalculatePartialOverlappedExecutionCycles computes the number of
-* cycles required to execute a set of instruction using a 4-staged pipeline
-* and factoring in delays introduced to address instruction-level data
-* dependencies.
-*
-* The basic formula needed to calculate the execution cycles required to
-* run N instructions in a 4 staged pipeline is :
-*
-* 1. Use the calculation from the formula above to determine the minimum
-*    number of cycles required. In this case it is: 
-*    <b>N + 3 cycles</b>.
-* 2. Then add 1 cycle for each delay introduced.
-*
-* Considering the initial program data provided in this assignment :
-*
-* 1. 6 instructions to be executed. Minimum execution time is N + 3 cycles,
-*    or 9 cycles in this case.
-* 2. 2 bubbles or stalls were introduced due to data - dependencies.
-* 3. 9 cycles + 2 cycles ( for the stalls ) = 11 cycles. This is the same
-*    result as reported in the assignment example.
-* 4. So the resultant formula to calculate the number of cycles for a
-*    partial overlapped pipelined execution of N instructions given M stalls
-*    introduced is :
-*    <b>N + 3 + M cycles</b>
-*
-*   So, how do we find the number of stalls required to be introduced due
-*   to data dependencies ? In this scenario given only a 4 cycle "data
-*   hazard" window of opportunity, and considering data reads occur in the
-*   3rd stage ( EX ), while data writes are only accessible after WB ( to be
-*   interpreted as the 5th stage ), that further narrows the "data hazard
-*   window" down to 2 cycles.  The only way a data hazard could occur
-*   is if there is a data dependency between two immediately sequential
-*   instructions.
-*
-*   It is deduced that the very worst possible case of extreme data
-*   dependency requiring a stall for every instruction would only require
-*   at most :
-*
-*   <b>N + 3 cycles</b> for the instructions, plus another 
-*   <b>N - 1 cycles</b> for adding 1 bubble / stall cycle for
-*   every instruction after the 1st.
-*
-*   Therefore <b>( 2 * N ) + 2 cycles</b> would be the worst 
-*   possible number of cycles required to run any set of instructions 
-*   overlapped.
-*
-* @param [in] dag          DAG object containing a list of instructions
-*
-* @retval int              the number of overlapped cycles (with delays)
-*                          required to run the instructions contained in DAG
-*/
-int CalculatePartialOverlappedExecutionCycles ( const CDependencyGraph& dag ) noexcept;
+HZ_HAZARD_TYPE ParseHazardType ( const TCHAR* szOption ) noexcept;
 
 /**
- * @brief CalculateNumberOfStallsRequired calculates data-dependent 
- * pipeline stalls.
+ * @brief ParseTraceMode translates a trace option into its sink mode.
  *
- * This function identifies and calculates the number Pipeline stalls 
- * introduced into the pipeline to avoid data-dependency hazards in 
- * the pipelined execution of the set of instructions.
+ * @param [in] szOption     one of "console", "off", "buffered" or "sampled"
  *
- * @param [in] dag          DAG object containing a list of instructions
+ * @retval TS_SINK_MODE     the sink mode
+ */
+TS_SINK_MODE ParseTraceMode ( const TCHAR* szOption ) noexcept;
+
+/**
+ * @brief ParsePredictor translates a predictor option into its scheme.
  *
- * @retval int              the number pipeline stalls required to  
- *                          address instruction data dependencies 
- *                          identified in a the DAGi
+ * @param [in] szOption     one of "nt", "taken", "bimodal" or "gshare"
+ *
+ * @retval BP_PREDICTOR_TYPE    the branch prediction scheme
  */
-int  CalculateNumberOfStallsRequired ( const CDependencyGraph& dag ) noexcept;
+BP_PREDICTOR_TYPE ParsePredictor ( const TCHAR* szOption ) noexcept;
+
+/**
+ * @brief ParseValueList translates a list option into its values.
+ *
+ * The list is comma separated, each element being either a single value
+ * or an inclusive range of values, such as "4,6,8-12".
+ *
+ * @param [in]  szOption    list of values
+ * @param [out] vValues     receives the values, in list order
+ *
+ * @retval size_t           the number of values
+ */
+size_t ParseValueList ( const TCHAR* szOption, std::vector<DWORD>& vValues ) noexcept;
+
+/**
+ * @brief ParseForwardingList translates a list of forwarding options.
+ *
+ * @param [in]  szOption    comma separated list of "none", "ex", "mem" or "full"
+ * @param [out] vValues     receives the masks of FP_xxx forwarding paths
+ *
+ * @retval size_t           the number of values
+ */
+size_t ParseForwardingList ( const TCHAR* szOption, std::vector<DWORD>& vValues ) noexcept;
 
 /**
  * @brief Performs basic pipeline process simulation.
@@ -189,191 +182,1299 @@ int  CalculateNumberOfStallsRequired ( const CDependencyGraph& dag ) noexcept;
  * and feeds it to the simulation object for running of the instruction
  * pipeline simulation
  *
+ * When scheduling is requested, the instructions are reordered by a
+ * critical-path list scheduler before being fed to the simulation, and the
+ * resulting cycle count is reported against the unscheduled baseline.
+ *
+ * When fast-forwarding is requested, the cycles are computed in closed form
+ * rather than stepped, and no per-cycle output is produced.  Otherwise each
+ * cycle is handed to the trace sink, which determines whether, and where,
+ * it is written.
+ *
  * @param [in,out] sim      Simulation object
  * @param [in] dag          DAG object containing a list of instructions
+ * @param [in] bSchedule    true to issue the instructions in scheduled order,
+ *                          false to issue them in their initial order
+ * @param [in] bFastForward true to fast-forward the simulation
+ * @param [in,out] sink     destination of the per-cycle trace
+ * @param [in,out] pOccupancy   binary occupancy trace of each stepped cycle,
+ *                          nullptr if none
  *
  * @retval true             on success
  * @retval false            on error
  *
  */
-bool ExecutePipelineSimulation ( CPipelineSim& sim, const CDependencyGraph& dag ) noexcept;
+bool ExecutePipelineSimulation ( CPipelineSim& sim, const CCsrDependencyGraph& dag, bool bSchedule,
+                                 bool bFastForward, CTraceSink& sink,
+                                 COccupancyTraceWriter* pOccupancy ) noexcept;
+
+/**
+ * @brief Performs the pipeline simulation of a streamed binary graph file.
+ *
+ * ExecuteStreamingSimulation simulates the instructions of a binary graph
+ * file as they are read, a block at a time, on a background thread, rather
+ * than loading the whole graph first, such that the memory required is
+ * bounded by the window of blocks in flight, however long the trace.  The
+ * instructions are issued in node ID order, and the cycles are stepped,
+ * each being handed to the trace sink as for ExecutePipelineSimulation.
+ *
+ * @param [in,out] sim      Simulation object, of a scalar pipeline
+ * @param [in] szFileName   name of the binary graph file
+ * @param [in] nBlockNodes  number of nodes read into each block
+ * @param [in,out] sink     destination of the per-cycle trace
+ * @param [in,out] pOccupancy   binary occupancy trace of each stepped cycle,
+ *                          nullptr if none
+ *
+ * @retval true             on success
+ * @retval false            if the file could not be opened, or was found
+ *                          to be malformed part way through
+ */
+bool ExecuteStreamingSimulation ( CPipelineSim& sim, const TCHAR* szFileName, size_t nBlockNodes,
+                                  CTraceSink& sink, COccupancyTraceWriter* pOccupancy ) noexcept;
+
+/**
+ * @brief Outputs a range of cycles of a binary occupancy trace.
+ *
+ * @param [in] szFileName   name of the occupancy trace file
+ * @param [in] qwFirstCycle 1-based cycle of the first record output
+ * @param [in] qwNumCycles  number of cycles output, the range ending early
+ *                          at the last cycle of the trace
+ *
+ * @retval true             on success
+ * @retval false            if the file is not an occupancy trace, the first
+ *                          cycle lies outside of the trace, or a record
+ *                          could not be read
+ */
+bool DumpOccupancyTrace ( const TCHAR* szFileName, QWORD qwFirstCycle, QWORD qwNumCycles ) noexcept;
+
+/**
+ * @brief SaveStats writes the simulation statistics as JSON.
+ *
+ * @param [in] szFileName   name of the file to be written, or "-" for the console
+ * @param [in] sim          Simulation object, having completed its run
+ *
+ * @retval true             on success
+ * @retval false            on error
+ */
+bool SaveStats ( const TCHAR* szFileName, const CPipelineSim& sim ) noexcept;
+
+/**
+ * @brief Performs critical path analysis in place of the simulation.
+ *
+ * ExecuteCriticalPathAnalysis reports the critical chain of the instructions
+ * contained in the DAG, and the resulting lower bound on the cycles
+ * required to execute them, in O(V + E) time.
+ *
+ * @param [in] dag          DAG object containing a list of instructions
+ * @param [in] config       descriptor of the pipeline
+ *
+ * @retval true             on success
+ * @retval false            if the DAG contains a dependency cycle
+ */
+bool ExecuteCriticalPathAnalysis ( const CCsrDependencyGraph& dag, const CPipelineConfig& config ) noexcept;
+
+/**
+ * @brief Performs the hazard and critical path analysis of an edited trace.
+ *
+ * ExecuteIncrementalAnalysis analyzes the trace, applies the edits listed
+ * by a patch file, then brings the analysis up to date by recomputing only
+ * the results affected by the edits.  Each line of the patch file lists
+ * a single edit:
+ *   + N        adds instruction N
+ *   - N        removes instruction N
+ *   + B A      adds the dependency of instruction B upon instruction A
+ *   - B A      removes the dependency of instruction B upon instruction A
+ *   = N class  sets the class of instruction N, alu, load, mul, div, bt or bn
+ *
+ * @param [in] szInputFile  name of the text trace file
+ * @param [in] szPatchFile  name of the patch file
+ * @param [in] config       descriptor of the pipeline
+ *
+ * @retval true             on success
+ * @retval false            if either file could not be read, or the trace
+ *                          contains a dependency cycle, or the edited graph
+ *                          could not be accommodated
+ */
+bool ExecuteIncrementalAnalysis ( const TCHAR* szInputFile, const TCHAR* szPatchFile,
+                                  const CPipelineConfig& config ) noexcept;
 
+/**
+ * @brief Applies the edits listed by a patch file to a graph
+ *
+ * @param [in]     szFileName   name of the patch file
+ * @param [in,out] dag          graph to be edited
+ *
+ * A node added may not lie more than LOADER_MAX_ID_GAP beyond the node
+ * ID range of the graph, as the trace loader requires of a trace; such an
+ * edit, or one naming an out of range node ID, is skipped.  Should the
+ * graph be unable to grow, std::bad_alloc propagates once the file has
+ * been closed.
+ *
+ * @retval size_t               number of edits applied, or (size_t)-1 if
+ *                              the file could not be opened
+ */
+size_t ApplyPatchFile ( const TCHAR* szFileName, CDependencyGraph& dag );
+
+/**
+ * @brief Performs the pipeline simulation of a batch of traces.
+ *
+ * ExecuteBatchSimulation simulates every trace named by a directory or
+ * manifest file on a pool of worker threads, without per-cycle output, and
+ * reports the per-trace and aggregate results.
+ *
+ * @param [in] szSource     directory or manifest file naming the traces
+ * @param [in] config       descriptor of the pipeline
+ * @param [in] dwNumThreads number of worker threads, 0 to use the number
+ *                          of hardware threads available
+ * @param [in] bSchedule    true to issue the instructions in scheduled order
+ * @param [in,out] pCache   cache of results, flushed once the batch has been
+ *                          simulated, or nullptr to simulate every trace
+ *
+ * @retval true             if every trace has been simulated
+ * @retval false            otherwise
+ */
+bool ExecuteBatchSimulation ( const TCHAR* szSource, const CPipelineConfig& config,
+                              DWORD dwNumThreads, bool bSchedule, CResultCache* pCache ) noexcept;
+
+/**
+ * @brief Performs the pipeline simulation of a grid of configurations.
+ *
+ * ExecuteParameterSweep simulates the DAG once for each combination of
+ * pipeline depth, forwarding paths and stall penalty of the swept hazard
+ * type, on a pool of worker threads sharing the DAG, and reports the
+ * results table.
+ *
+ * @param [in,out] sweep    sweep whose grid has been set up
+ * @param [in] dwNumThreads number of worker threads, 0 to use the number
+ *                          of hardware threads available
+ * @param [in,out] pCache   cache of results, flushed once the grid has been
+ *                          simulated, or nullptr to simulate every configuration
+ *
+ * @retval true             on success
+ * @retval false            if the DAG contains a dependency cycle
+ */
+bool ExecuteParameterSweep ( CParameterSweep& sweep, DWORD dwNumThreads, CResultCache* pCache ) noexcept;
+
+/**
+ * @brief Writes the results inserted into a result cache to its file.
+ *
+ * @param [in,out] cache    result cache to be flushed
+ */
+void FlushResultCache ( CResultCache& cache ) noexcept;
+
+
+/**
+ * @brief ValidateGraph verifies that the loaded graph is acyclic.
+ *
+ * Any edges found to close a dependency cycle at freeze (or load) time are
+ * reported in the trace file's "B A" format.
+ *
+ * @param [in] dag          frozen DAG object
+ *
+ * @retval true             if the graph contains no dependency cycles
+ * @retval false            otherwise
+ */
+bool ValidateGraph ( const CCsrDependencyGraph& dag );
 
 /**
  * @brief LoadData performs basic file level data input.
  *
- * This method reads input data from text file and returns contents in a 
- * directed acyclic graph
+ * This method reads input data from text file and returns contents in an
+ * edge list, ready to be frozen.  The file is block-read and parsed by
+ * CTraceLoader.
+ *
+ * @param [in]  szFileName   name of the data file to be loaded
+ * @param [out] builder      reference to an edge list builder object
+ * @param [out] bAliased     set if the instructions were named by letter
+ *
+ * @retval size_t       the number of item nodes read into the edge list
+ */
+size_t LoadData ( const TCHAR* szFileName, CEdgeListBuilder& builder, bool& bAliased );
+
+/**
+ * @brief LoadBinaryData reads a previously saved binary graph file.
+ *
+ * The file content is read directly into the frozen graph arrays, which
+ * involves no parsing, and no per-edge allocation.
+ *
+ * @param [in]  szFileName   name of the binary graph file to be loaded
+ * @param [out] dag          reference to a frozen dag object
+ *
+ * @retval size_t       the number of item nodes read into the graph
+ */
+size_t LoadBinaryData ( const TCHAR* szFileName, CCsrDependencyGraph& dag );
+
+/**
+ * @brief SaveBinaryData writes a frozen graph to a binary graph file.
+ *
+ * This affords a one-time conversion of a text trace file, such that
+ * subsequent runs may be started by way of LoadBinaryData.
+ *
+ * @param [in] szFileName    name of the binary graph file to be written
+ * @param [in] dag           reference to a frozen dag object
+ *
+ * @retval true             on success
+ * @retval false            on error
+ */
+bool   SaveBinaryData ( const TCHAR* szFileName, const CCsrDependencyGraph& dag );
+
+/**
+ * @brief LoadGraph loads either a text trace or a binary graph file.
+ *
+ * The file format is determined by probing for the binary graph file
+ * signature.  A text trace is loaded into an edge list which is then
+ * frozen and released.
  *
  * @param [in]  szFileName   name of the data file to be loaded
- * @param [out] dag          reference to a dag object
+ * @param [out] dag          reference to a frozen dag object
+ * @param [out] bAliased     set if the instructions of a text trace were
+ *                           named by letter, cleared otherwise
  *
  * @retval size_t       the number of item nodes read into the graph
  */
-size_t LoadData ( const TCHAR* szFileName, CDependencyGraph& dag );
+size_t LoadGraph ( const TCHAR* szFileName, CCsrDependencyGraph& dag, bool& bAliased );
 
 
-int _tmain ( int /*argc*/, _TCHAR* /*argv[]*/ )
+int _tmain ( int argc, _TCHAR* argv[] )
 {
-    if (LoadData(g_szFileName, g_DAG) == 0)
+    const TCHAR* szInputFile = g_szFileName;
+    const TCHAR* szSaveFile  = nullptr;
+    const TCHAR* szBatch     = nullptr;
+    const TCHAR* szPatchFile = nullptr;
+    const TCHAR* szCacheFile = nullptr;
+    DWORD        dwNumStages = DEFAULT_PIPELINE_STAGES;
+    DWORD        dwForwarding = FP_NONE;
+    DWORD        dwNumThreads = 0;
+    DWORD        dwIssueWidth = 1;
+    BP_PREDICTOR_TYPE bpPredictor = BP_NOT_TAKEN;
+    DWORD        dwPredictorBits  = DEFAULT_PREDICTOR_BITS;
+    int          iBranchPenalty   = -1;
+    int          iMulLatency      = -1;
+    int          iDivLatency      = -1;
+    bool         bSchedule   = false;
+    bool         bCritical   = false;
+    bool         bSweep      = false;
+    bool         bSweepStep  = false;
+    bool         bFastForward = false;
+    bool         bStream      = false;
+    size_t       nStreamBlock = DEFAULT_STREAM_BLOCK_NODES;
+    TS_SINK_MODE tsTrace     = TS_CONSOLE;
+    const TCHAR* szTraceFile = nullptr;
+    DWORD        dwSampleInterval = SAMPLE_STALLS_ONLY;
+    const TCHAR* szOccupancyFile  = nullptr;
+    const TCHAR* szStatsFile      = nullptr;
+
+    std::vector<DWORD> vSweepDepths;
+    std::vector<DWORD> vSweepForwarding;
+    std::vector<DWORD> vSweepPenalties;
+    HZ_HAZARD_TYPE     hzSweep       = HZ_LOAD_USE;
+    const TCHAR*       szSweepHazard = _T("load");
+    std::vector<DWORD> vStageWidths;
+    int                iReturn = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ( (_tcscmp(argv[i], _T("-save")) == 0) && (i + 1 < argc) )
+            szSaveFile  = argv[++i];
+        else if ( (_tcscmp(argv[i], _T("-stages")) == 0) && (i + 1 < argc) )
+            dwNumStages = static_cast<DWORD>(_ttoi(argv[++i]));
+        else if ( (_tcscmp(argv[i], _T("-forward")) == 0) && (i + 1 < argc) )
+            dwForwarding = ParseForwarding(argv[++i]);
+        else if ( (_tcscmp(argv[i], _T("-issue")) == 0) && (i + 1 < argc) )
+            dwIssueWidth = static_cast<DWORD>(_ttoi(argv[++i]));
+        else if ( (_tcscmp(argv[i], _T("-stage-width")) == 0) && (i + 1 < argc) )
+            ParseValueList(argv[++i], vStageWidths);
+        else if ( (_tcscmp(argv[i], _T("-predictor")) == 0) && (i + 1 < argc) )
+            bpPredictor = ParsePredictor(argv[++i]);
+        else if ( (_tcscmp(argv[i], _T("-predictor-bits")) == 0) && (i + 1 < argc) )
+            dwPredictorBits = static_cast<DWORD>(_ttoi(argv[++i]));
+        else if ( (_tcscmp(argv[i], _T("-branch-penalty")) == 0) && (i + 1 < argc) )
+            iBranchPenalty = _ttoi(argv[++i]);
+        else if ( (_tcscmp(argv[i], _T("-mul-latency")) == 0) && (i + 1 < argc) )
+            iMulLatency = _ttoi(argv[++i]);
+        else if ( (_tcscmp(argv[i], _T("-div-latency")) == 0) && (i + 1 < argc) )
+            iDivLatency = _ttoi(argv[++i]);
+        else if ( (_tcscmp(argv[i], _T("-batch")) == 0) && (i + 1 < argc) )
+            szBatch     = argv[++i];
+        else if ( (_tcscmp(argv[i], _T("-threads")) == 0) && (i + 1 < argc) )
+            dwNumThreads = static_cast<DWORD>(_ttoi(argv[++i]));
+        else if ( (_tcscmp(argv[i], _T("-sweep")) == 0) && (i + 1 < argc) )
+            bSweep      = ParseValueList(argv[++i], vSweepDepths) > 0;
+        else if ( (_tcscmp(argv[i], _T("-sweep-forward")) == 0) && (i + 1 < argc) )
+            bSweep      = ParseForwardingList(argv[++i], vSweepForwarding) > 0 || bSweep;
+        else if ( (_tcscmp(argv[i], _T("-sweep-penalty")) == 0) && (i + 1 < argc) )
+            bSweep      = ParseValueList(argv[++i], vSweepPenalties) > 0 || bSweep;
+        else if ( (_tcscmp(argv[i], _T("-sweep-hazard")) == 0) && (i + 1 < argc) )
+        {
+            szSweepHazard = argv[++i];
+            hzSweep       = ParseHazardType(szSweepHazard);
+        }
+        else if ( _tcscmp(argv[i], _T("-sweep-step")) == 0 )
+            bSweepStep  = true;
+        else if ( (_tcscmp(argv[i], _T("-cache")) == 0) && (i + 1 < argc) )
+            szCacheFile = argv[++i];
+        else if ( _tcscmp(argv[i], _T("-schedule")) == 0 )
+            bSchedule   = true;
+        else if ( _tcscmp(argv[i], _T("-critical")) == 0 )
+            bCritical   = true;
+        else if ( (_tcscmp(argv[i], _T("-patch")) == 0) && (i + 1 < argc) )
+            szPatchFile = argv[++i];
+        else if ( (_tcscmp(argv[i], _T("-trace")) == 0) && (i + 1 < argc) )
+            tsTrace     = ParseTraceMode(argv[++i]);
+        else if ( (_tcscmp(argv[i], _T("-trace-file")) == 0) && (i + 1 < argc) )
+            szTraceFile = argv[++i];
+        else if ( (_tcscmp(argv[i], _T("-sample")) == 0) && (i + 1 < argc) )
+            dwSampleInterval = static_cast<DWORD>(_ttoi(argv[++i]));
+        else if ( (_tcscmp(argv[i], _T("-stats")) == 0) && (i + 1 < argc) )
+            szStatsFile = argv[++i];
+        else if ( (_tcscmp(argv[i], _T("-occupancy")) == 0) && (i + 1 < argc) )
+            szOccupancyFile = argv[++i];
+        else if ( (_tcscmp(argv[i], _T("-dump")) == 0) && (i + 3 < argc) )
+            return DumpOccupancyTrace(argv[i + 1], _tcstoul(argv[i + 2], nullptr, 10),
+                                      _tcstoul(argv[i + 3], nullptr, 10)) ? 0 : 1;
+        else if ( _tcscmp(argv[i], _T("-fast")) == 0 )
+            bFastForward = true;
+        else if ( _tcscmp(argv[i], _T("-stream")) == 0 )
+            bStream      = true;
+        else if ( (_tcscmp(argv[i], _T("-stream-block")) == 0) && (i + 1 < argc) )
+            nStreamBlock = static_cast<size_t>(_ttoi(argv[++i]));
+        else if ( (_tcscmp(argv[i], _T("-h")) == 0) || (_tcscmp(argv[i], _T("--help")) == 0) )
+        {
+            tcout << g_szUsage;
+            return 0;
+        }
+        else if ( (argv[i][0] != _T('-')) && (szInputFile == g_szFileName) )
+            szInputFile = argv[i];
+        else
+        {
+            // an option missing its value is as unrecognized as a misspelled one,
+            // rather than being taken for the input file
+            tcout << _T("Unrecognized argument, or option missing its value: ") << argv[i] << std::endl;
+            tcout << g_szUsage;
+            return 1;
+        }
+    }
+
+    CPipelineConfig config(dwNumStages);
+    config.SetForwarding(dwForwarding);
+
+    if ( config.SetIssueWidth(dwIssueWidth) == false )
+        tcout << _T("Invalid issue width: ") << dwIssueWidth << _T(", issuing a single instruction per cycle") << std::endl;
+
+    // a stage may only be narrowed from the issue width
+    for ( DWORD i = 0; i < vStageWidths.size(); i++ )
+    {
+        if ( config.SetStageWidth(i, vStageWidths[i]) == false )
+            tcout << _T("Invalid width of stage ") << i << _T(": ") << vStageWidths[i] << std::endl;
+    }
+
+    config.SetBranchPredictor(bpPredictor);
+
+    if ( config.SetPredictorBits(dwPredictorBits) == false )
+        tcout << _T("Invalid predictor table size: ") << dwPredictorBits << _T(", using ")
+              << config.GetPredictorBits() << _T(" bits") << std::endl;
+
+    // the penalty is otherwise that of the conventional resolution stage
+    if ( iBranchPenalty >= 0 )
+        config.SetBranchPenalty(static_cast<DWORD>(iBranchPenalty));
+
+    // the multiplier remains pipelined, while the divider remains unable to
+    // accept another divide until the last has completed
+    if ( iMulLatency >= 0 && config.SetExecuteLatency(IC_MUL, static_cast<DWORD>(iMulLatency)) == false )
+        tcout << _T("Invalid multiply latency: ") << iMulLatency << _T(", using ")
+              << config.GetExecuteLatency(IC_MUL) << _T(" cycles") << std::endl;
+
+    if ( iDivLatency >= 0 )
+    {
+        if ( config.SetExecuteLatency(IC_DIV, static_cast<DWORD>(iDivLatency)) )
+            config.SetIssueInterval(IC_DIV, static_cast<DWORD>(iDivLatency));
+        else
+            tcout << _T("Invalid divide latency: ") << iDivLatency << _T(", using ")
+                  << config.GetExecuteLatency(IC_DIV) << _T(" cycles") << std::endl;
+    }
+
+    // batch and sweep results are looked up in the cache, if any
+    CResultCache  cache;
+    CResultCache* pCache = nullptr;
+
+    if ( szCacheFile != nullptr )
+    {
+        if ( cache.Open(szCacheFile) )
+            pCache = &cache;
+        else
+            tcout << _T("Error reading result cache file:") << szCacheFile << std::endl;
+    }
+
+    if ( szBatch != nullptr )
+        return ExecuteBatchSimulation(szBatch, config, dwNumThreads, bSchedule, pCache) ? 0 : 1;
+
+    if ( szPatchFile != nullptr )
+        return ExecuteIncrementalAnalysis(szInputFile, szPatchFile, config) ? 0 : 1;
+
+    CPipelineSim        sim(config);
+    CCsrDependencyGraph dag;
+    bool                bAliased = false;
+
+    // only the simulation of a binary graph file by a scalar pipeline, in
+    // node ID order, is streamed; anything else requires the whole graph
+    if ( bStream && (config.IsSuperscalar() || bSchedule || bSweep || bCritical || (szSaveFile != nullptr) ||
+                     (CCsrDependencyGraph::IsBinaryGraphFile(szInputFile) == false)) )
+    {
+        tcout << _T("Streaming requires a binary graph file, simulated by a scalar pipeline alone, ")
+              << _T("loading the whole graph instead") << std::endl;
+        bStream = false;
+    }
+
+    if ( bStream )
+    {
+        // the cycles of a streamed simulation are always stepped
+        bFastForward = false;
+    }
+    else if ( (LoadGraph(szInputFile, dag, bAliased) == 0) && (szInputFile == g_szFileName) )
     {
         // try the Data directory next
-        tstring strDataDir(_T("..\\Data\\"));
+        tstring strDataDir(_T("..") PATH_SEPARATOR _T("Data") PATH_SEPARATOR);
         strDataDir += g_szFileName;
 
-        LoadData(strDataDir.c_str(), g_DAG);
+        if ( LoadGraph(strDataDir.c_str(), dag, bAliased) == 0 )
+            return 1;
+    }
+    else if ( dag.GetNumNodes() == 0 )
+    {
+        // the error was reported by the loader
+        return 1;
+    }
+
+    if ( szSaveFile != nullptr )
+    {
+        if ( SaveBinaryData(szSaveFile, dag) )
+            tcout << _T("Saved binary graph file: ") << szSaveFile << _T(", ")
+                  << dag.GetNumEdges() << _T(" edges (") << dag.GetNumEscapedEdges() << _T(" escaped), ")
+                  << dag.GetMemoryUsage() << _T(" bytes in memory") << std::endl;
+        else
+            tcout << _T("Error saving binary graph file:") << szSaveFile << std::endl;
+    }
+
+    // neither the hazard analysis nor the simulation are meaningful
+    // in the presence of a dependency cycle
+    if ( (bStream == false) && (ValidateGraph(dag) == false) )
+    {
+        tcout << _T("Simulation skipped") << std::endl;
+    }
+    else if ( bSweep )
+    {
+        // an axis left out of the sweep keeps the value of its single option,
+        // as does every parameter which is not swept
+        CParameterSweep sweep(dag, sim.GetConfig());
+
+        sweep.SetDepths(vSweepDepths);
+        sweep.SetForwarding(vSweepForwarding);
+        if ( sweep.SetPenalties(hzSweep, vSweepPenalties) == false )
+            tcout << _T("Invalid ") << szSweepHazard << _T(" penalties, exceeding ") << MAX_STALL_CYCLES
+                  << _T(" stall cycles, are not swept") << std::endl;
+
+        // penalties which cannot differ in their results collapse to one
+        if ( (vSweepPenalties.empty() == false) && (sweep.IsPenaltyEffective() == false) )
+        {
+            tcout << _T("No dependency incurs the ") << szSweepHazard << _T(" hazard with the forwarding ")
+                  << _T("paths swept, its penalty is not swept") << std::endl;
+            sweep.SetPenalties(hzSweep, std::vector<DWORD>());
+        }
+        sweep.SetStepped(bSweepStep);
+
+        ExecuteParameterSweep(sweep, dwNumThreads, pCache);
+    }
+    else if ( bCritical )
+        ExecuteCriticalPathAnalysis(dag, sim.GetConfig());
+    else
+    {
+        CTraceSink sink;
+
+        // a buffered trace always goes to a file
+        if ( (tsTrace == TS_BUFFERED) && (szTraceFile == nullptr) )
+            szTraceFile = g_szTraceFileName;
+
+        if ( sink.Open(tsTrace, szTraceFile, dwSampleInterval) == false )
+            tcout << _T("Error opening trace file:") << szTraceFile << std::endl;
+
+        COccupancyTraceWriter occupancy;
+
+        const bool bOccupancy = (szOccupancyFile != nullptr) &&
+                                occupancy.Open(szOccupancyFile, sim.GetConfig().GetNumStages(), sim.GetConfig().GetIssueWidth());
+
+        if ( (szOccupancyFile != nullptr) && (bOccupancy == false) )
+            tcout << _T("Error opening occupancy trace file:") << szOccupancyFile << std::endl;
+
+        if ( bStream )
+            iReturn = ExecuteStreamingSimulation(sim, szInputFile, nStreamBlock, sink, bOccupancy ? &occupancy : nullptr) ? 0 : 1;
+        else
+        {
+            // the trace output names the instructions as the trace did
+            sim.SetOutputAliases(bAliased);
+            ExecutePipelineSimulation(sim, dag, bSchedule, bFastForward, sink, bOccupancy ? &occupancy : nullptr);
+        }
+
+        if ( bOccupancy )
+        {
+            const QWORD qwNumCycles = occupancy.GetNumCycles();
+
+            if ( occupancy.Close() )
+                tcout << _T("Saved occupancy trace file: ") << szOccupancyFile << _T(", ")
+                      << qwNumCycles << _T(" cycles") << std::endl;
+            else
+                tcout << _T("Error writing occupancy trace file:") << szOccupancyFile << std::endl;
+        }
+
+        if ( (szStatsFile != nullptr) && (SaveStats(szStatsFile, sim) == false) )
+            tcout << _T("Error writing statistics file:") << szStatsFile << std::endl;
     }
 
-    ExecutePipelineSimulation(g_PipelineSim, g_DAG);
+    return iReturn;
+}
+
+bool ValidateGraph ( const CCsrDependencyGraph& dag )
+{
+    // limits the output of very malformed input
+    constexpr size_t MAX_EDGE_OUTPUT = 64;
 
-    TCHAR iAnyKey;
-    tcout << _T("press (q) to quit ");
-    tcin  >> iAnyKey;
-    tcout << std::endl << _T("close enough!");
+    const std::vector<GRAPH_EDGE>& vCycleEdges = dag.GetCycleEdges ( );
 
-    return 0;
+    if ( vCycleEdges.empty ( ) == false )
+    {
+        tcout << _T("Error: dependency cycles found, ") << vCycleEdges.size ( )
+              << _T(" offending edge(s):") << std::endl;
+
+        for ( size_t i = 0; i < vCycleEdges.size ( ) && i < MAX_EDGE_OUTPUT; i++ )
+            tcout << vCycleEdges[i].idFrom << _T(" ") << vCycleEdges[i].idTo << std::endl;
+
+        if ( vCycleEdges.size ( ) > MAX_EDGE_OUTPUT )
+            tcout << _T("...") << std::endl;
+    }
+
+    return dag.IsAcyclic ( );
 }
 
-size_t LoadData ( const TCHAR* szFileName, CDependencyGraph& dag )
+size_t LoadData ( const TCHAR* szFileName, CEdgeListBuilder& builder, bool& bAliased )
 {
     size_t nReturn = 0;
 
-    tifstream infile;
-
-#if defined(UNICODE) || defined(_UNICODE)
-    std::locale utf8_locale ( std::locale ( infile.getloc ( ) ), 
-                              new std::codecvt_utf8_utf16<wchar_t> );
-    infile.imbue ( utf8_locale );
-#endif
+    CTraceLoader loader ( builder );
 
-    infile.open ( szFileName );
+    bAliased = false;
 
-    if ( infile.bad ( ) )
+    if ( loader.LoadFile ( szFileName ) == false )
     {
-        tcout << _T ( "Error opening data file:" ) << szFileName << std::endl;
+        if ( loader.IsMalformed ( ) )
+            tcout << _T ( "Malformed data file, node ID out of range:" ) << szFileName << std::endl;
+        else
+            tcout << _T ( "Error opening data file:" ) << szFileName << std::endl;
+
+        // nothing partially loaded is simulated
+        builder.Clear ( );
     }
     else
     {
-        TCHAR szLineBuffer[128] = { 0 };
-
-        // read in the 1st line of input, this will contain the list of instructions
-        infile.getline ( szLineBuffer, _countof ( szLineBuffer ) - 1 );
+        nReturn  = loader.GetNumNodes ( );
+        bAliased = loader.IsAliased ( );
+    }
 
-        // parse the instruction list, removing trailing punctuation.
-        tstringstream strStream;
+    return nReturn;
+}
 
-        strStream << szLineBuffer;
+size_t LoadBinaryData ( const TCHAR* szFileName, CCsrDependencyGraph& dag )
+{
+    size_t nReturn = 0;
 
-        while ( strStream.getline ( szLineBuffer, 5, _T ( ' ' ) ) && 
-              ( nReturn < MAX_INSTRUCTIONS ) )
-        {
-            dag.AddNode ( szLineBuffer[0] );
+    if ( dag.Load ( szFileName ) == false )
+    {
+        tcout << _T ( "Error loading binary graph file:" ) << szFileName << std::endl;
+    }
+    else
+    {
+        nReturn = dag.GetNumNodes ( );
+    }
 
-            nReturn++;
-        }
+    return nReturn;
+}
 
-        // now parse the instruction dependencies
-        // this will be in the format of:
-        //      B<space>A<NL>
-        // where "B A" means that B depends on the result of A
+bool SaveBinaryData ( const TCHAR* szFileName, const CCsrDependencyGraph& dag )
+{
+    return dag.Save ( szFileName );
+}
 
-        TCHAR idSrcNode = 0;
-        TCHAR idDestNode = 0;
+size_t LoadGraph ( const TCHAR* szFileName, CCsrDependencyGraph& dag, bool& bAliased )
+{
+    size_t nReturn = 0;
 
-        while ( infile >> idSrcNode >> idDestNode )
-        {
-            // in estimating an edge weight, lets use the time delta or "dependency
-            // distance" between when the 2 instructions are scheduled to begin execution.
+    // a binary graph file retains no aliases
+    bAliased = false;
 
-            int iWeight = idSrcNode - idDestNode;
+    if ( CCsrDependencyGraph::IsBinaryGraphFile ( szFileName ) )
+    {
+        nReturn = LoadBinaryData ( szFileName, dag );
+    }
+    else
+    {
+        CEdgeListBuilder builder;
 
-            dag.AddEdge ( idSrcNode, idDestNode, iWeight );
-        }
+        nReturn = LoadData ( szFileName, builder, bAliased );
 
-        infile.close ( );
+        // loading is complete, so sort the edges straight into the
+        // read-only graph, the edge list is released upon return.
+        dag.Freeze ( builder );
     }
 
     return nReturn;
 }
 
-int CalculateSequentialExecutionCycles ( const CDependencyGraph& dag ) noexcept
+QWORD CalculateSequentialExecutionCycles ( const CCsrDependencyGraph& dag, const CPipelineConfig& config ) noexcept
+{
+    QWORD qwReturn = static_cast<QWORD>(dag.GetNumNodes ( )) * config.GetNumStages ( );
+
+    for ( CCsrDependencyGraph::const_iterator it = dag.begin ( ); it != dag.end ( ); ++it )
+    {
+        if ( it->IsValid ( ) )
+            qwReturn += config.GetExecuteLatency ( it->GetClass ( ) ) - 1;
+    }
+
+    return qwReturn;
+}
+
+DWORD ParseForwarding ( const TCHAR* szOption ) noexcept
 {
-    return dag.GetNumNodes ( ) * BASE_CYCLES_PER_INSTUCTION;
+    DWORD dwReturn = FP_NONE;
+
+    if ( _tcscmp(szOption, _T("ex")) == 0 )
+        dwReturn = FP_EX_EX;
+    else if ( _tcscmp(szOption, _T("mem")) == 0 )
+        dwReturn = FP_MEM_EX;
+    else if ( _tcscmp(szOption, _T("full")) == 0 )
+        dwReturn = FP_FULL;
+    else if ( _tcscmp(szOption, _T("none")) != 0 )
+        tcout << _T("Unrecognized forwarding option: ") << szOption << std::endl;
+
+    return dwReturn;
 }
 
-int CalculateCompleteOverlappedExecutionCycles ( const CDependencyGraph& dag ) noexcept
+HZ_HAZARD_TYPE ParseHazardType ( const TCHAR* szOption ) noexcept
 {
-    return dag.GetNumNodes ( ) + 3;
+    HZ_HAZARD_TYPE hzReturn = HZ_LOAD_USE;
+
+    if ( _tcscmp(szOption, _T("none")) == 0 )
+        hzReturn = HZ_NO_FORWARD;
+    else if ( _tcscmp(szOption, _T("ex")) == 0 )
+        hzReturn = HZ_EX_EX;
+    else if ( _tcscmp(szOption, _T("mem")) == 0 )
+        hzReturn = HZ_MEM_EX;
+    else if ( _tcscmp(szOption, _T("load")) != 0 )
+        tcout << _T("Unrecognized hazard option: ") << szOption << std::endl;
+
+    return hzReturn;
 }
 
-int CalculatePartialOverlappedExecutionCycles ( const CDependencyGraph& dag ) noexcept
+TS_SINK_MODE ParseTraceMode ( const TCHAR* szOption ) noexcept
 {
-    return dag.GetNumNodes() + CalculateNumberOfStallsRequired(dag) + 3;
+    TS_SINK_MODE tsReturn = TS_CONSOLE;
+
+    if ( _tcscmp(szOption, _T("off")) == 0 )
+        tsReturn = TS_OFF;
+    else if ( _tcscmp(szOption, _T("buffered")) == 0 )
+        tsReturn = TS_BUFFERED;
+    else if ( _tcscmp(szOption, _T("sampled")) == 0 )
+        tsReturn = TS_SAMPLED;
+    else if ( _tcscmp(szOption, _T("console")) != 0 )
+        tcout << _T("Unrecognized trace option: ") << szOption << std::endl;
+
+    return tsReturn;
 }
 
-int  CalculateNumberOfStallsRequired ( const CDependencyGraph& dag ) noexcept
+BP_PREDICTOR_TYPE ParsePredictor ( const TCHAR* szOption ) noexcept
 {
-    int iNumStalls = 0;
+    BP_PREDICTOR_TYPE bpReturn = BP_NOT_TAKEN;
+
+    if ( _tcscmp(szOption, _T("taken")) == 0 )
+        bpReturn = BP_TAKEN;
+    else if ( _tcscmp(szOption, _T("bimodal")) == 0 )
+        bpReturn = BP_BIMODAL;
+    else if ( _tcscmp(szOption, _T("gshare")) == 0 )
+        bpReturn = BP_GSHARE;
+    else if ( _tcscmp(szOption, _T("nt")) != 0 )
+        tcout << _T("Unrecognized predictor option: ") << szOption << std::endl;
 
-    CDependencyGraph::const_iterator it;
+    return bpReturn;
+}
 
-    for (it = dag.begin(); it != dag.end(); ++ it )
+size_t ParseValueList ( const TCHAR* szOption, std::vector<DWORD>& vValues ) noexcept
+{
+    std::vector<DWORD>().swap ( vValues );
+
+    const TCHAR* szPos = szOption;
+
+    while ( *szPos != _T('\0') )
     {
-        if (it->IsValid())
+        TCHAR* szEnd = nullptr;
+
+        const DWORD dwFirst = static_cast<DWORD>(_tcstoul ( szPos, &szEnd, 10 ));
+        DWORD       dwLast  = dwFirst;
+
+        if ( szEnd == szPos )
+            break;
+
+        if ( *szEnd == _T('-') )
         {
-            NODE_ID_T idNode = it->GetNodeID();
-            // following will determine if an instruction is dependent on
-            // an immediately previous one, (i.e B->A), which is the only
-            // case that any stall is required to be introduced.
-            if (it->HasEdge(idNode - 1))
-                iNumStalls++;
+            szPos  = szEnd + 1;
+            dwLast = static_cast<DWORD>(_tcstoul ( szPos, &szEnd, 10 ));
+
+            if ( szEnd == szPos )
+                break;
         }
+
+        for ( DWORD dwValue = dwFirst; dwValue <= dwLast; dwValue++ )
+            vValues.push_back ( dwValue );
+
+        if ( *szEnd != _T(',') )
+            break;
+
+        szPos = szEnd + 1;
     }
 
-    return iNumStalls;
+    if ( vValues.empty ( ) )
+        tcout << _T("Unrecognized list option: ") << szOption << std::endl;
+
+    return vValues.size ( );
 }
 
-bool ExecutePipelineSimulation ( CPipelineSim& sim, const CDependencyGraph& dag) noexcept
+size_t ParseForwardingList ( const TCHAR* szOption, std::vector<DWORD>& vValues ) noexcept
 {
-    bool bReturn = false;
+    std::vector<DWORD>().swap ( vValues );
 
-    // add the loaded instructions to the pipeline simulator
-    CDependencyGraph::const_iterator it;
+    tstring strOption ( szOption );
 
-    for ( it = dag.begin ( ); it != dag.end ( ); ++it )
+    for ( size_t nPos = 0; nPos <= strOption.size ( ); )
     {
-        if ( it->IsValid ( ) )
-        {
-            bool bDataDependent = false;
-            NODE_ID_T idNode = it->GetNodeID ( );
+        size_t nEnd = strOption.find ( _T(','), nPos );
 
-            if ( it->HasEdge ( idNode - 1 ) )
-                bDataDependent = true;
+        if ( nEnd == tstring::npos )
+            nEnd = strOption.size ( );
 
-            sim.InsertInstruction(CInstructionData(idNode, bDataDependent) );
-        }
+        if ( nEnd > nPos )
+            vValues.push_back ( ParseForwarding ( strOption.substr ( nPos, nEnd - nPos ).c_str ( ) ) );
+
+        nPos = nEnd + 1;
+    }
+
+    return vValues.size ( );
+}
+
+bool ExecutePipelineSimulation ( CPipelineSim& sim, const CCsrDependencyGraph& dag, bool bSchedule,
+                                 bool bFastForward, CTraceSink& sink,
+                                 COccupancyTraceWriter* pOccupancy ) noexcept
+{
+    bool bReturn = false;
+
+    CHazardAnalysis hazards;
+    CListScheduler  scheduler;
+
+    if ( bSchedule && (scheduler.Schedule ( dag, sim.GetConfig ( ) ) != dag.GetNumNodes ( )) )
+    {
+        tcout << _T("Unable to schedule instructions, issuing in initial order") << std::endl;
+        bSchedule = false;
     }
 
+    // add the loaded instructions to the pipeline simulator, scheduled or not
+    sim.LoadInstructions ( dag, hazards, bSchedule ? &scheduler.GetIssueOrder ( ) : nullptr );
 
     tcout << _T ( "Total time for sequential (non overlapped) execution: " )
-          << CalculateSequentialExecutionCycles ( dag ) << _T ( " cycles" ) << std::endl;
+          << CalculateSequentialExecutionCycles ( dag, sim.GetConfig ( ) ) << _T ( " cycles" ) << std::endl;
     tcout << _T ("------------------------------------------------------------------")
           << std::endl;
+    if ( bFastForward )
+    {
+        const QWORD qwCycles = sim.FastForward ( );
+
+        tcout << _T ( "Overlapped execution fast-forwarded: " ) << qwCycles << _T ( " cycles, " )
+              << sim.GetStallCount ( ) << _T ( " stalls, " )
+              << sim.GetCompletionCount ( ) << _T ( " instructions completed" ) << std::endl;
+    }
+    else
+    {
+        tcout << _T ( "Overlapped execution:" ) << std::endl;
+
+        bool bMoreInstructions = sim.ProcessNextCycle();
+
+        if ( sink.IsEnabled ( ) || pOccupancy != nullptr )
+        {
+            while (bMoreInstructions)
+            {
+                if ( sink.IsEnabled ( ) )
+                    sink.OutputCycle(sim);
+
+                if ( pOccupancy != nullptr )
+                    pOccupancy->AppendCycle(sim);
+
+                bMoreInstructions = sim.ProcessNextCycle();
+            }
+
+            sink.Flush ( );
+        }
+        else
+        {
+            // nothing to be written, the stats alone are of interest
+            while (bMoreInstructions)
+                bMoreInstructions = sim.ProcessNextCycle();
+        }
+    }
+
+    tcout << _T ( "------------------------------------------------------------------")
+          << std::endl;
+    if ( sim.GetStats ( ).GetBranches ( ) > 0 )
+    {
+        tcout << _T ( "Branches: " ) << sim.GetStats ( ).GetBranches ( ) << _T ( ", " )
+              << sim.GetStats ( ).GetMispredicted ( ) << _T ( " mispredicted, accuracy " )
+              << std::fixed << std::setprecision ( 3 ) << sim.GetStats ( ).GetPredictionAccuracy ( )
+              << _T ( ", " ) << sim.GetStats ( ).GetFlushBubbles ( ) << _T ( " flush bubbles" ) << std::endl;
+    }
+
+    if ( hazards.GetStructuralStalls ( ) > 0 )
+    {
+        tcout << _T ( "Structural hazards: " ) << hazards.GetStructuralStalls ( ) << _T ( " of " )
+              << hazards.GetTotalStalls ( ) << _T ( " stalls awaiting a busy functional unit" ) << std::endl;
+    }
+
+    if ( sim.GetConfig ( ).IsSuperscalar ( ) )
+    {
+        tcout << _T ( "Total time for " ) << sim.GetConfig ( ).GetIssueWidth ( ) << _T ( "-wide issue: " )
+              << sim.GetStats ( ).GetCycles ( ) << _T ( " cycles, " )
+              << sim.GetStallCount ( ) << _T ( " stalls, IPC " )
+              << std::fixed << std::setprecision ( 3 ) << sim.GetStats ( ).GetIPC ( ) << std::endl;
+    }
+
+    if ( bSchedule )
+    {
+        // the instructions are simulated in their initial order as well, for
+        // the totals to be compared, flushes and deferred completions included
+        CPipelineSim    baseline ( sim.GetConfig ( ) );
+        CHazardAnalysis baselineHazards;
+
+        baseline.LoadInstructions ( dag, baselineHazards );
+        baseline.FastForward ( );
+
+        const QWORD qwScheduled = sim.GetStats ( ).GetCycles ( );
+        const QWORD qwBaseline  = baseline.GetStats ( ).GetCycles ( );
+
+        tcout << _T ( "Total time for scheduled pipelined execution: " )
+              << qwScheduled << _T ( " cycles" ) << std::endl;
+        tcout << _T ( "Total time for unscheduled pipelined execution: " ) << qwBaseline << _T ( " cycles (" );
+
+        // the counts are unsigned, and a schedule may yet take longer
+        if ( qwBaseline >= qwScheduled )
+            tcout << (qwBaseline - qwScheduled) << _T ( " saved)" ) << std::endl;
+        else
+            tcout << (qwScheduled - qwBaseline) << _T ( " lost)" ) << std::endl;
+    }
+    else
+    {
+        tcout << _T ( "Total time for pipelined (overlapped) execution: " )
+              << sim.GetStats ( ).GetCycles ( ) << _T ( " cycles" ) << std::endl;
+    }
+
+    return bReturn;
+}
+
+bool ExecuteStreamingSimulation ( CPipelineSim& sim, const TCHAR* szFileName, size_t nBlockNodes,
+                                  CTraceSink& sink, COccupancyTraceWriter* pOccupancy ) noexcept
+{
+    CStreamingSim stream ( sim, nBlockNodes );
+
+    if ( stream.Open ( szFileName ) == false )
+    {
+        tcout << _T ( "Error streaming binary graph file:" ) << szFileName << std::endl;
+        return false;
+    }
+
     tcout << _T ( "Overlapped execution:" ) << std::endl;
 
-    bool bMoreInstructions = sim.ProcessNextCycle();
+    bool bMoreInstructions = stream.ProcessNextCycle();
 
     while (bMoreInstructions)
     {
-        sim.OutputCurrentInstructionCycle(tcout);
+        if ( sink.IsEnabled ( ) )
+            sink.OutputCycle(sim);
+
+        if ( pOccupancy != nullptr )
+            pOccupancy->AppendCycle(sim);
 
-        bMoreInstructions = sim.ProcessNextCycle();
+        bMoreInstructions = stream.ProcessNextCycle();
     }
 
+    sink.Flush ( );
+
+    const bool bReturn = stream.Close ( );
+
     tcout << _T ( "------------------------------------------------------------------")
           << std::endl;
+
+    if ( bReturn == false )
+        tcout << _T ( "Error reading binary graph file:" ) << szFileName << _T ( ", simulation incomplete" ) << std::endl;
+
+    tcout << _T ( "Streamed " ) << stream.GetNumStreamed ( ) << _T ( " instructions, in a window of at most " )
+          << stream.GetWindowNodes ( ) << _T ( " nodes" ) << std::endl;
+
+    if ( sim.GetStats ( ).GetBranches ( ) > 0 )
+    {
+        tcout << _T ( "Branches: " ) << sim.GetStats ( ).GetBranches ( ) << _T ( ", " )
+              << sim.GetStats ( ).GetMispredicted ( ) << _T ( " mispredicted, accuracy " )
+              << std::fixed << std::setprecision ( 3 ) << sim.GetStats ( ).GetPredictionAccuracy ( )
+              << _T ( ", " ) << sim.GetStats ( ).GetFlushBubbles ( ) << _T ( " flush bubbles" ) << std::endl;
+    }
+
+    const CHazardAnalysis& hazards = stream.GetHazards ( );
+
+    if ( hazards.GetStructuralStalls ( ) > 0 )
+    {
+        tcout << _T ( "Structural hazards: " ) << hazards.GetStructuralStalls ( ) << _T ( " of " )
+              << hazards.GetTotalStalls ( ) << _T ( " stalls awaiting a busy functional unit" ) << std::endl;
+    }
+
+    // the classes of the instructions are only known once streamed
+    tcout << _T ( "Total time for sequential (non overlapped) execution: " )
+          << stream.GetSequentialCycles ( ) << _T ( " cycles" ) << std::endl;
     tcout << _T ( "Total time for pipelined (overlapped) execution: " )
-          << CalculatePartialOverlappedExecutionCycles ( dag ) << _T ( " cycles" ) << std::endl;
+          << sim.GetStats ( ).GetCycles ( ) << _T ( " cycles" ) << std::endl;
 
     return bReturn;
-}
\ No newline at end of file
+}
+
+bool ExecuteCriticalPathAnalysis ( const CCsrDependencyGraph& dag, const CPipelineConfig& config ) noexcept
+{
+    // limits the output of very long chains
+    constexpr size_t MAX_CHAIN_OUTPUT = 64;
+
+    CCriticalPath critical;
+
+    bool bReturn = critical.Analyze ( dag, config );
+
+    if ( bReturn )
+    {
+        const std::vector<NODE_ID_T>& vChain = critical.GetCriticalChain ( );
+
+        tcout << _T ( "Critical path length: " ) << critical.GetCriticalPathLength ( )
+              << _T ( " issue slots, " ) << vChain.size ( ) << _T ( " instructions" ) << std::endl;
+        tcout << _T ( "Critical chain: " );
+
+        for ( size_t i = 0; i < vChain.size ( ) && i < MAX_CHAIN_OUTPUT; i++ )
+            tcout << vChain[i] << _T ( " " );
+
+        if ( vChain.size ( ) > MAX_CHAIN_OUTPUT )
+            tcout << _T ( "..." );
+
+        tcout << std::endl;
+        tcout << _T ( "Lower bound for pipelined (overlapped) execution: " )
+              << critical.GetCycleLowerBound ( ) << _T ( " cycles" ) << std::endl;
+    }
+    else
+    {
+        tcout << _T ( "Unable to analyze the critical path, the graph is not acyclic" ) << std::endl;
+    }
+
+    return bReturn;
+}
+
+bool ExecuteIncrementalAnalysis ( const TCHAR* szInputFile, const TCHAR* szPatchFile,
+                                  const CPipelineConfig& config ) noexcept
+{
+    CDependencyGraph dag;
+    CTraceLoader     loader ( dag );
+
+    if ( loader.LoadFile ( szInputFile ) == false )
+    {
+        tcout << _T ( "Error reading trace file:" ) << szInputFile << std::endl;
+        return false;
+    }
+
+    CIncrementalAnalysis analysis;
+
+    // the edits are recorded from the initial analysis onwards
+    dag.EnableChangeLog ( );
+
+    std::chrono::steady_clock::time_point tpStart = std::chrono::steady_clock::now ( );
+
+    if ( analysis.Analyze ( dag, config ) == false )
+    {
+        tcout << _T ( "Unable to analyze the trace, the graph is not acyclic" ) << std::endl;
+        return false;
+    }
+
+    const double dAnalyzed = std::chrono::duration<double> ( std::chrono::steady_clock::now ( ) - tpStart ).count ( );
+
+    tcout << _T ( "Initial analysis: " ) << dag.GetNumNodes ( ) << _T ( " instructions, " )
+          << analysis.GetTotalStalls ( ) << _T ( " stalls, critical path length " )
+          << analysis.GetCriticalPathLength ( ) << _T ( ", lower bound " ) << analysis.GetCycleLowerBound ( )
+          << _T ( " cycles, " ) << analysis.GetNumRecomputed ( ) << _T ( " results in " )
+          << dAnalyzed << _T ( " s" ) << std::endl;
+
+    size_t nNumEdits = 0;
+
+    try
+    {
+        nNumEdits = ApplyPatchFile ( szPatchFile, dag );
+    }
+    catch ( const std::bad_alloc& )
+    {
+        tcout << _T ( "Insufficient memory to apply patch file:" ) << szPatchFile << std::endl;
+        return false;
+    }
+
+    if ( nNumEdits == static_cast<size_t>(-1) )
+    {
+        tcout << _T ( "Error reading patch file:" ) << szPatchFile << std::endl;
+        return false;
+    }
+
+    tpStart = std::chrono::steady_clock::now ( );
+
+    const bool bReturn = analysis.Update ( dag );
+
+    const double dUpdated = std::chrono::duration<double> ( std::chrono::steady_clock::now ( ) - tpStart ).count ( );
+
+    dag.ClearChangeLog ( );
+
+    if ( bReturn )
+    {
+        tcout << _T ( "Updated analysis: " ) << nNumEdits << _T ( " edits, " ) << dag.GetNumNodes ( )
+              << _T ( " instructions, " ) << analysis.GetTotalStalls ( ) << _T ( " stalls, critical path length " )
+              << analysis.GetCriticalPathLength ( ) << _T ( ", lower bound " ) << analysis.GetCycleLowerBound ( )
+              << _T ( " cycles, " ) << analysis.GetNumRecomputed ( ) << _T ( " results in " )
+              << dUpdated << _T ( " s" ) << std::endl;
+    }
+    else
+    {
+        tcout << _T ( "Unable to update the analysis, the edited graph is not acyclic" ) << std::endl;
+    }
+
+    return bReturn;
+}
+
+size_t ApplyPatchFile ( const TCHAR* szFileName, CDependencyGraph& dag )
+{
+    FILE* pFile = _tfopen ( szFileName, _T("r") );
+
+    if ( pFile == nullptr )
+        return static_cast<size_t>(-1);
+
+    size_t nReturn = 0;
+    char   szLine[256];
+
+    // the file is closed whatever becomes of the edits
+    try
+    {
+        while ( fgets ( szLine, _countof(szLine), pFile ) != nullptr )
+        {
+            char* szPos = szLine;
+
+            while ( *szPos == ' ' || *szPos == '\t' )
+                szPos++;
+
+            const char chEdit = *szPos;
+
+            if ( chEdit != '+' && chEdit != '-' && chEdit != '=' )
+                continue;
+
+            char* szEnd = nullptr;
+
+            const unsigned long ulFirst = strtoul ( szPos + 1, &szEnd, 10 );
+
+            if ( (szEnd == szPos + 1) || (ulFirst >= INVALID_NODE_ID) )
+                continue;
+
+            const NODE_ID_T idFirst = static_cast<NODE_ID_T>(ulFirst);
+
+            bool bApplied = false;
+
+            if ( chEdit == '=' )
+            {
+                while ( *szEnd == ' ' || *szEnd == '\t' )
+                    szEnd++;
+
+                if ( strncmp ( szEnd, "ld", 2 ) == 0 || strncmp ( szEnd, "load", 4 ) == 0 )
+                    bApplied = dag.SetNodeClass ( idFirst, IC_LOAD );
+                else if ( strncmp ( szEnd, "alu", 3 ) == 0 )
+                    bApplied = dag.SetNodeClass ( idFirst, IC_ALU );
+                else if ( strncmp ( szEnd, "bt", 2 ) == 0 )
+                    bApplied = dag.SetNodeClass ( idFirst, IC_BRANCH_TAKEN );
+                else if ( strncmp ( szEnd, "bn", 2 ) == 0 )
+                    bApplied = dag.SetNodeClass ( idFirst, IC_BRANCH );
+                else if ( strncmp ( szEnd, "mul", 3 ) == 0 )
+                    bApplied = dag.SetNodeClass ( idFirst, IC_MUL );
+                else if ( strncmp ( szEnd, "div", 3 ) == 0 )
+                    bApplied = dag.SetNodeClass ( idFirst, IC_DIV );
+            }
+            else
+            {
+                char* szSecond = szEnd;
+
+                const unsigned long ulSecond = strtoul ( szSecond, &szEnd, 10 );
+
+                if ( szEnd == szSecond )
+                {
+                    // the graph is sized by its largest node ID
+                    if ( chEdit == '+' )
+                        bApplied = (idFirst < dag.GetNodeCapacity ( ) + LOADER_MAX_ID_GAP) && dag.AddNode ( idFirst );
+                    else
+                        bApplied = dag.RemoveNode ( idFirst );
+                }
+                else if ( ulSecond < INVALID_NODE_ID )
+                {
+                    const NODE_ID_T idSecond = static_cast<NODE_ID_T>(ulSecond);
+
+                    // the same weight estimate as that of the trace loader
+                    bApplied = (chEdit == '+') ? dag.AddEdge ( idFirst, idSecond, static_cast<int>(idFirst) - static_cast<int>(idSecond) )
+                                               : dag.RemoveEdge ( idFirst, idSecond );
+                }
+            }
+
+            if ( bApplied )
+                nReturn++;
+        }
+    }
+    catch ( const std::bad_alloc& )
+    {
+        fclose ( pFile );
+        throw;
+    }
+
+    fclose ( pFile );
+
+    return nReturn;
+}
+
+bool ExecuteBatchSimulation ( const TCHAR* szSource, const CPipelineConfig& config,
+                              DWORD dwNumThreads, bool bSchedule, CResultCache* pCache ) noexcept
+{
+    CBatchDriver batch ( config, bSchedule );
+
+    batch.SetResultCache ( pCache );
+
+    if ( batch.AddSource ( szSource ) == 0 )
+    {
+        tcout << _T ( "No traces found in batch: " ) << szSource << std::endl;
+        return false;
+    }
+
+    const size_t nNumSimulated = batch.Run ( dwNumThreads );
+
+    batch.OutputResults ( tcout );
+
+    if ( pCache != nullptr )
+        FlushResultCache ( *pCache );
+
+    return nNumSimulated == batch.GetNumTraces ( );
+}
+
+bool ExecuteParameterSweep ( CParameterSweep& sweep, DWORD dwNumThreads, CResultCache* pCache ) noexcept
+{
+    sweep.SetResultCache ( pCache );
+
+    const bool bReturn = sweep.Run ( dwNumThreads ) > 0;
+
+    if ( bReturn )
+        sweep.OutputResults ( tcout );
+    else
+        tcout << _T ( "Unable to run the parameter sweep, the graph is not acyclic" ) << std::endl;
+
+    if ( pCache != nullptr )
+        FlushResultCache ( *pCache );
+
+    return bReturn;
+}
+
+void FlushResultCache ( CResultCache& cache ) noexcept
+{
+    const bool bFlushed = cache.Flush ( );
+
+    tcout << _T ( "Result cache: " ) << cache.GetNumHits ( ) << _T ( " hits, " )
+          << cache.GetNumMisses ( ) << _T ( " misses, " ) << cache.GetNumResults ( ) << _T ( " results" );
+
+    if ( bFlushed == false )
+        tcout << _T ( ", error writing the result cache file" );
+
+    tcout << std::endl;
+}
+
+bool DumpOccupancyTrace ( const TCHAR* szFileName, QWORD qwFirstCycle, QWORD qwNumCycles ) noexcept
+{
+    // the range is read in chunks, bounding the memory used by long ranges
+    constexpr size_t CHUNK_CYCLES = 64 * 1024;
+
+    COccupancyTraceReader reader;
+
+    if ( reader.Open ( szFileName ) == false )
+    {
+        tcout << _T ( "Error opening occupancy trace file:" ) << szFileName << std::endl;
+        return false;
+    }
+
+    tcout << _T ( "Occupancy trace: " ) << reader.GetNumCycles ( ) << _T ( " cycles, " )
+          << reader.GetNumStages ( ) << _T ( " stages" );
+
+    if ( reader.GetSlotsPerStage ( ) > 1 )
+        tcout << _T ( " of " ) << reader.GetSlotsPerStage ( ) << _T ( " slots" );
+
+    tcout << std::endl;
+
+    // the cycles are numbered from 1, as in the human-readable trace
+    if ( (qwFirstCycle == 0) || (qwFirstCycle > reader.GetNumCycles ( )) )
+    {
+        tcout << _T ( "Invalid first cycle: " ) << qwFirstCycle << _T ( ", the trace holds cycles 1 to " )
+              << reader.GetNumCycles ( ) << std::endl;
+        return false;
+    }
+
+    const size_t       nRecordSize = GetOccupancyRecordSize ( reader.GetNumStages ( ), reader.GetSlotsPerStage ( ) );
+    std::vector<DWORD> vRecords;
+
+    for ( QWORD qwCycle = qwFirstCycle; qwNumCycles > 0; )
+    {
+        const size_t nRequested = (qwNumCycles < CHUNK_CYCLES) ? static_cast<size_t>(qwNumCycles) : CHUNK_CYCLES;
+        const size_t nNumRead   = reader.ReadCycles ( qwCycle, nRequested, vRecords );
+
+        for ( size_t i = 0; i < nNumRead; i++ )
+            reader.OutputRecord ( tcout, qwCycle + i, &vRecords[i * nRecordSize] );
+
+        // a range ending past the trace is cut short at its last cycle
+        if ( qwCycle + nNumRead > reader.GetNumCycles ( ) )
+            break;
+
+        if ( nNumRead < nRequested )
+        {
+            tcout << _T ( "Error reading occupancy trace file:" ) << szFileName << _T ( ", at cycle " )
+                  << qwCycle + nNumRead << std::endl;
+            return false;
+        }
+
+        qwCycle     += nNumRead;
+        qwNumCycles -= nNumRead;
+    }
+
+    tcout.flush ( );
+
+    return true;
+}
+
+bool SaveStats ( const TCHAR* szFileName, const CPipelineSim& sim ) noexcept
+{
+    if ( _tcscmp ( szFileName, _T ( "-" ) ) == 0 )
+    {
+        sim.GetStats ( ).OutputJson ( tcout, sim.GetConfig ( ) );
+        return true;
+    }
+
+    std::basic_ofstream<TCHAR> ofs ( szFileName );
+
+    if ( ofs.is_open ( ) == false )
+        return false;
+
+    sim.GetStats ( ).OutputJson ( ofs, sim.GetConfig ( ) );
+
+    return ofs.good ( );
+}
@@ -0,0 +1,68 @@
+/**
+* @file       PlatformDef.h
+* @brief      Platform portability definitions
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  The simulation is written against the generic-text mappings of the
+*  Microsoft C runtime, TCHAR and the _t prefixed functions, so that it
+*  may be built for either character set on Windows.  Other platforms lack
+*  both <tchar.h> and a number of the runtime's extensions, so they are
+*  mapped here onto their narrow character, POSIX equivalents.  Only the
+*  mappings used within the projects are defined.
+*/
+#pragma once
+
+#if !defined(_PLATFORM_DEF_H__)
+#define _PLATFORM_DEF_H__
+
+#if defined(_WIN32)
+
+    #ifndef _INC_TCHAR
+        #include <tchar.h>
+    #endif
+
+    #define PATH_SEPARATOR  _T("\\")    ///< separates the directories of a path
+
+#else
+
+    #ifndef _CSTDIO_
+        #include <cstdio>
+    #endif
+
+    #ifndef _CSTDLIB_
+        #include <cstdlib>
+    #endif
+
+    #ifndef _CSTRING_
+        #include <cstring>
+    #endif
+
+    typedef char TCHAR;     ///< generic-text character, narrow only
+    typedef char _TCHAR;    ///< generic-text character, as named by _tmain
+
+    #define _T(x)           x
+    #define _tmain          main
+
+    #define _tcscmp         strcmp
+    #define _tcsncpy        strncpy
+    #define _tcstod         strtod
+    #define _tcstoul        strtoul
+    #define _ttoi           atoi
+    #define _tfopen         fopen
+    #define _sntprintf      snprintf
+    #define _vsntprintf     vsnprintf
+
+    // file offsets beyond 2 GiB, given _FILE_OFFSET_BITS=64 on 32-bit targets
+    #define _fseeki64       fseeko
+    #define _ftelli64       ftello
+
+    #define _countof(a)     (sizeof(a) / sizeof((a)[0]))
+
+    #define PATH_SEPARATOR  _T("/")     ///< separates the directories of a path
+
+#endif
+
+#endif
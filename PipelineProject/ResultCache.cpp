@@ -0,0 +1,229 @@
+/**
+* @file       ResultCache.cpp
+* @brief      CResultCache class implementation
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*/
+
+#include "stdafx.h"
+#include "ResultCache.h"
+#include "ContentHash.h"
+
+static_assert(sizeof(RESULT_CACHE_FILE_HEADER) == 16, "unexpected RESULT_CACHE_FILE_HEADER layout");
+static_assert(sizeof(RESULT_CACHE_RECORD) == 48, "unexpected RESULT_CACHE_RECORD layout");
+
+/// number of records read from the cache file at a time
+constexpr size_t READ_CHUNK_RECORDS = 4096;
+
+
+CResultCache::CResultCache ( ) noexcept
+    : m_mtxLock     ( ),
+      m_strFileName ( ),
+      m_mapResults  ( ),
+      m_vPending    ( ),
+      m_qwNumHits   ( 0 ),
+      m_qwNumMisses ( 0 )
+{
+}
+
+bool CResultCache::Open ( const TCHAR* szFileName ) noexcept
+{
+    Clear ( );
+
+    std::lock_guard<std::mutex> lock ( m_mtxLock );
+
+    FILE* pFile = _tfopen ( szFileName, _T("rb") );
+
+    // the file is created once there is a result to be written
+    if ( pFile == nullptr )
+    {
+        m_strFileName = szFileName;
+        return true;
+    }
+
+    RESULT_CACHE_FILE_HEADER hdr = { };
+
+    const bool bReturn = (fread ( &hdr, sizeof(hdr), 1, pFile ) == 1)           &&
+                         (hdr.dwMagic     == RESULT_CACHE_FILE_MAGIC)           &&
+                         (hdr.dwByteOrder == RESULT_CACHE_FILE_BYTE_ORDER)      &&
+                         (hdr.dwVersion   == RESULT_CACHE_FILE_VERSION);
+
+    if ( bReturn )
+    {
+        std::vector<RESULT_CACHE_RECORD> vRecords ( READ_CHUNK_RECORDS );
+
+        size_t nNumRead = 0;
+
+        do
+        {
+            nNumRead = fread ( vRecords.data ( ), sizeof(RESULT_CACHE_RECORD), vRecords.size ( ), pFile );
+
+            for ( size_t i = 0; i < nNumRead; i++ )
+            {
+                const RESULT_CACHE_RECORD& record = vRecords[i];
+
+                // an incomplete record is disregarded, as are any duplicates
+                if ( record.dwChecksum == GetChecksum ( record ) )
+                {
+                    const CACHED_RESULT result = { record.qwCycles, record.qwStalls, record.qwCompleted };
+
+                    m_mapResults.emplace ( CACHE_KEY_T ( record.qwGraphHash, record.qwConfigKey ), result );
+                }
+            }
+        } while ( nNumRead == vRecords.size ( ) );
+
+        m_strFileName = szFileName;
+    }
+
+    fclose ( pFile );
+
+    return bReturn;
+}
+
+bool CResultCache::Flush ( void ) noexcept
+{
+    std::lock_guard<std::mutex> lock ( m_mtxLock );
+
+    if ( m_strFileName.empty ( ) )
+        return false;
+
+    if ( m_vPending.empty ( ) )
+        return true;
+
+    bool bReturn = false;
+
+    FILE* pFile = _tfopen ( m_strFileName.c_str ( ), _T("ab") );
+
+    if ( pFile != nullptr )
+    {
+        bReturn = (_fseeki64 ( pFile, 0, SEEK_END ) == 0);
+
+        const long long nSize = bReturn ? _ftelli64 ( pFile ) : -1;
+
+        if ( nSize == 0 )
+        {
+            const RESULT_CACHE_FILE_HEADER hdr = { RESULT_CACHE_FILE_MAGIC, RESULT_CACHE_FILE_BYTE_ORDER,
+                                                   RESULT_CACHE_FILE_VERSION, 0 };
+
+            bReturn = (fwrite ( &hdr, sizeof(hdr), 1, pFile ) == 1);
+        }
+        else if ( nSize >= static_cast<long long>(sizeof(RESULT_CACHE_FILE_HEADER)) )
+        {
+            // realign to a record boundary past any incomplete record, which
+            // then fails its checksum
+            const size_t nPartial = static_cast<size_t>((nSize - sizeof(RESULT_CACHE_FILE_HEADER)) % sizeof(RESULT_CACHE_RECORD));
+            const BYTE   Padding[sizeof(RESULT_CACHE_RECORD)] = { 0 };
+
+            if ( nPartial > 0 )
+                bReturn = (fwrite ( Padding, 1, sizeof(Padding) - nPartial, pFile ) == sizeof(Padding) - nPartial);
+        }
+        else
+        {
+            bReturn = false;
+        }
+
+        bReturn = bReturn && (fwrite ( m_vPending.data ( ), sizeof(RESULT_CACHE_RECORD), m_vPending.size ( ), pFile ) == m_vPending.size ( ));
+
+        if ( fclose ( pFile ) != 0 )
+            bReturn = false;
+    }
+
+    if ( bReturn )
+        std::vector<RESULT_CACHE_RECORD>().swap ( m_vPending );
+
+    return bReturn;
+}
+
+QWORD CResultCache::GetConfigKey ( const CPipelineConfig& config, bool bSchedule ) noexcept
+{
+    CContentHash hash ( RESULT_CACHE_FILE_MAGIC );
+
+    hash.Add ( config.GetContentHash ( ) );
+    hash.Add ( bSchedule ? 1 : 0 );
+
+    return hash.GetHash ( );
+}
+
+bool CResultCache::Lookup ( QWORD qwGraphHash, QWORD qwConfigKey, CACHED_RESULT& result ) noexcept
+{
+    std::lock_guard<std::mutex> lock ( m_mtxLock );
+
+    std::map<CACHE_KEY_T, CACHED_RESULT>::const_iterator it = m_mapResults.find ( CACHE_KEY_T ( qwGraphHash, qwConfigKey ) );
+
+    const bool bReturn = (it != m_mapResults.end ( ));
+
+    if ( bReturn )
+    {
+        result = it->second;
+        m_qwNumHits++;
+    }
+    else
+    {
+        m_qwNumMisses++;
+    }
+
+    return bReturn;
+}
+
+void CResultCache::Insert ( QWORD qwGraphHash, QWORD qwConfigKey, const CACHED_RESULT& result ) noexcept
+{
+    std::lock_guard<std::mutex> lock ( m_mtxLock );
+
+    // a result simulated concurrently by another worker is recorded once
+    if ( m_mapResults.emplace ( CACHE_KEY_T ( qwGraphHash, qwConfigKey ), result ).second )
+    {
+        RESULT_CACHE_RECORD record = { qwGraphHash, qwConfigKey, result.qwCycles, result.qwStalls, result.qwCompleted, 0, 0 };
+
+        record.dwChecksum = GetChecksum ( record );
+
+        m_vPending.push_back ( record );
+    }
+}
+
+size_t CResultCache::GetNumResults ( void ) noexcept
+{
+    std::lock_guard<std::mutex> lock ( m_mtxLock );
+
+    return m_mapResults.size ( );
+}
+
+QWORD CResultCache::GetNumHits ( void ) noexcept
+{
+    std::lock_guard<std::mutex> lock ( m_mtxLock );
+
+    return m_qwNumHits;
+}
+
+QWORD CResultCache::GetNumMisses ( void ) noexcept
+{
+    std::lock_guard<std::mutex> lock ( m_mtxLock );
+
+    return m_qwNumMisses;
+}
+
+void CResultCache::Clear ( void ) noexcept
+{
+    std::lock_guard<std::mutex> lock ( m_mtxLock );
+
+    m_strFileName.clear ( );
+    m_mapResults.clear ( );
+    std::vector<RESULT_CACHE_RECORD>().swap ( m_vPending );
+
+    m_qwNumHits   = 0;
+    m_qwNumMisses = 0;
+}
+
+DWORD CResultCache::GetChecksum ( const RESULT_CACHE_RECORD& record ) noexcept
+{
+    CContentHash hash ( RESULT_CACHE_FILE_MAGIC );
+
+    hash.Add ( record.qwGraphHash );
+    hash.Add ( record.qwConfigKey );
+    hash.Add ( record.qwCycles );
+    hash.Add ( record.qwStalls );
+    hash.Add ( record.qwCompleted );
+
+    return static_cast<DWORD>(hash.GetHash ( ));
+}
@@ -0,0 +1,207 @@
+/**
+* @file       ResultCache.h
+* @brief      CResultCache class interface
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  A persistent cache of simulation results, keyed by the content hash of
+*  the frozen graph simulated and the content hash of the pipeline
+*  configuration it was simulated with, such that a trace simulated again
+*  with the same parameters, by this or any later run, need not be.
+*
+*  The cache file consists of a RESULT_CACHE_FILE_HEADER, followed by fixed
+*  size RESULT_CACHE_RECORD entries, which are only ever appended:
+*  - the whole file is read when the cache is opened
+*  - the results inserted since are appended when the cache is flushed
+*
+*  As each record carries a checksum of its own, a record left incomplete,
+*  e.g. by a run terminated while flushing, is simply disregarded when the
+*  file is next read.  Lookups and insertions may be made concurrently by
+*  the workers of a CWorkStealingPool.
+*/
+#pragma once
+
+#if !defined(_RESULT_CACHE_H__)
+#define _RESULT_CACHE_H__
+
+#ifndef _PIPELINE_CONFIG_H__
+    #include "PipelineConfig.h"
+#endif
+
+#ifndef _MAP_
+    #include <map>
+#endif
+
+#ifndef _MUTEX_
+    #include <mutex>
+#endif
+
+#ifndef _STRING_
+    #include <string>
+#endif
+
+#ifndef _VECTOR_
+    #include <vector>
+#endif
+
+/// result cache file signature, reads as "IPRC" in a hex dump
+constexpr DWORD RESULT_CACHE_FILE_MAGIC      = 0x43525049;
+/// used to detect a byte order mismatch
+constexpr DWORD RESULT_CACHE_FILE_BYTE_ORDER = 0x01020304;
+/// current result cache file format version
+constexpr DWORD RESULT_CACHE_FILE_VERSION    = 2;
+
+/**
+    @brief Result cache file header
+*/
+struct RESULT_CACHE_FILE_HEADER
+{
+    DWORD   dwMagic;         ///< must be RESULT_CACHE_FILE_MAGIC
+    DWORD   dwByteOrder;     ///< must be RESULT_CACHE_FILE_BYTE_ORDER
+    DWORD   dwVersion;       ///< file format version
+    DWORD   dwReserved;      ///< reserved, must be 0
+};
+
+/**
+    @brief Final counts of a simulation
+*/
+struct CACHED_RESULT
+{
+    QWORD   qwCycles;        ///< cycles simulated
+    QWORD   qwStalls;        ///< stalls introduced
+    QWORD   qwCompleted;     ///< instructions completed
+};
+
+/**
+    @brief Result cache file record
+*/
+struct RESULT_CACHE_RECORD
+{
+    QWORD   qwGraphHash;     ///< content hash of the graph
+    QWORD   qwConfigKey;     ///< key of the simulation parameters
+    QWORD   qwCycles;        ///< cycles simulated
+    QWORD   qwStalls;        ///< stalls introduced
+    QWORD   qwCompleted;     ///< instructions completed
+    DWORD   dwChecksum;      ///< checksum of the preceding fields
+    DWORD   dwReserved;      ///< reserved, must be 0
+};
+
+/**
+    @brief Persistent cache of simulation results
+*/
+class CResultCache
+{
+    typedef std::pair<QWORD, QWORD>  CACHE_KEY_T;   ///< graph hash and configuration key
+
+    std::mutex                           m_mtxLock;      ///< guards every member below
+    std::basic_string<TCHAR>             m_strFileName;  ///< cache file name, empty if not open
+    std::map<CACHE_KEY_T, CACHED_RESULT> m_mapResults;   ///< cached results
+    std::vector<RESULT_CACHE_RECORD>     m_vPending;     ///< records yet to be appended to the file
+    QWORD                                m_qwNumHits;    ///< lookups which found a result
+    QWORD                                m_qwNumMisses;  ///< lookups which found none
+
+public:
+    /// Default Constructor
+    CResultCache() noexcept;
+
+    /// Default Destructor
+    ~CResultCache() = default;
+
+/**
+    @brief Opens a cache file, reading every result it holds
+
+    A file which does not yet exist is created when first flushed.
+
+    @param [in] szFileName  name of the cache file
+
+    @retval true            on success
+    @retval false           if the file exists, but is not a cache file
+                            of the current version
+*/
+    bool Open(const TCHAR* szFileName) noexcept;
+
+/**
+    @brief Appends the results inserted since the last flush to the file
+
+    @retval true            on success, or if there was nothing to append
+    @retval false           if no file is open, or on error
+*/
+    bool Flush(void) noexcept;
+
+/**
+    @brief Computes the key of the parameters of a simulation
+
+    @param [in] config      descriptor of the pipeline
+    @param [in] bSchedule   true if the instructions are issued in
+                            scheduled order, rather than node ID order
+
+    @retval QWORD           configuration key
+*/
+    static QWORD GetConfigKey(const CPipelineConfig& config, bool bSchedule) noexcept;
+
+/**
+    @brief Looks up the result of a simulation
+
+    @param [in]  qwGraphHash    content hash of the graph
+    @param [in]  qwConfigKey    key of the simulation parameters
+    @param [out] result         receives the result, if found
+
+    @retval true                if the result was found
+*/
+    bool Lookup(QWORD qwGraphHash, QWORD qwConfigKey, CACHED_RESULT& result) noexcept;
+
+/**
+    @brief Inserts the result of a simulation
+
+    @param [in] qwGraphHash     content hash of the graph
+    @param [in] qwConfigKey     key of the simulation parameters
+    @param [in] result          result of the simulation
+*/
+    void Insert(QWORD qwGraphHash, QWORD qwConfigKey, const CACHED_RESULT& result) noexcept;
+
+/**
+    @brief Retrieves the number of results held
+
+    @retval size_t          count of results
+*/
+    size_t GetNumResults(void) noexcept;
+
+/**
+    @brief Retrieves the number of lookups which found a result
+
+    @retval QWORD           count of lookups
+*/
+    QWORD GetNumHits(void) noexcept;
+
+/**
+    @brief Retrieves the number of lookups which found no result
+
+    @retval QWORD           count of lookups
+*/
+    QWORD GetNumMisses(void) noexcept;
+
+/**
+    @brief Releases every result, closing the cache file without flushing
+*/
+    void Clear(void) noexcept;
+
+private:
+/**
+    @brief Computes the checksum of a record
+
+    @param [in] record      record whose fields, bar the checksum, are set
+
+    @retval DWORD           checksum
+*/
+    static DWORD GetChecksum(const RESULT_CACHE_RECORD& record) noexcept;
+
+    /// copy constructor
+    CResultCache(const CResultCache& o) = delete;
+
+    /// assignment operator
+    CResultCache& operator=(const CResultCache& rhs) = delete;
+};
+
+#endif
@@ -0,0 +1,180 @@
+/**
+* @file       RingBuffer.h
+* @brief      CRingBuffer class template interface and implementation
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  A fixed-capacity circular array, affording the handful of double-ended
+*  list operations required by the pipeline simulation without any heap
+*  allocation once constructed.  The capacity is rounded up to a power
+*  of 2 so that wrapping an index is a simple mask operation.
+*/
+#pragma once
+
+#if !defined(_RING_BUFFER_H__)
+#define _RING_BUFFER_H__
+
+#ifndef _VECTOR_
+    #include <vector>
+#endif
+
+/**
+    @brief A fixed-capacity double-ended ring buffer
+
+    Elements are addressed by their logical position, with position 0
+    being the front (most recently pushed) element, and position
+    size() - 1 being the back (oldest) element.
+
+    @tparam T   element type, must be default constructible and copyable
+*/
+template <class T>
+class CRingBuffer
+{
+    std::vector<T>  m_vSlots;  ///< underlying storage
+    size_t          m_nMask;   ///< capacity - 1, used to wrap indices
+    size_t          m_nHead;   ///< physical index of the front element
+    size_t          m_nSize;   ///< current number of elements
+
+public:
+    /**
+        @brief Initialization Constructor
+
+        The capacity is allocated up front, and never grows thereafter.
+
+        @param [in] nMinCapacity    minimum number of elements to be held
+    */
+    explicit CRingBuffer(size_t nMinCapacity)
+        : m_vSlots(),
+          m_nMask (0),
+          m_nHead (0),
+          m_nSize (0)
+    {
+        size_t nCapacity = 1;
+
+        while ( nCapacity < nMinCapacity )
+            nCapacity <<= 1;
+
+        m_vSlots.resize(nCapacity);
+        m_nMask = nCapacity - 1;
+    };
+
+    /// Default Destructor
+    ~CRingBuffer() = default;
+
+/**
+    @retval size_t      the current number of elements
+*/
+    constexpr size_t size(void) const noexcept
+    { return m_nSize; };
+
+/**
+    @retval size_t      the maximum number of elements
+*/
+    size_t capacity(void) const noexcept
+    { return m_vSlots.size(); };
+
+/**
+    @retval true        if no elements are held
+*/
+    constexpr bool empty(void) const noexcept
+    { return m_nSize == 0; };
+
+/**
+    @retval true        if no further elements may be added
+*/
+    bool full(void) const noexcept
+    { return m_nSize == m_vSlots.size(); };
+
+/**
+    @brief  Affords access to the element at a logical position
+
+    @param [in] nPos    logical position, presumed to be less than size()
+
+    @retval T&          reference to the element
+*/
+    T& operator[](size_t nPos) noexcept
+    { return m_vSlots[(m_nHead + nPos) & m_nMask]; };
+
+    const T& operator[](size_t nPos) const noexcept
+    { return m_vSlots[(m_nHead + nPos) & m_nMask]; };
+
+/**
+    @retval T&          reference to the back (oldest) element
+*/
+    T& back(void) noexcept
+    { return (*this)[m_nSize - 1]; };
+
+/**
+    @brief Adds an element to the front
+
+    @param [in] val     element to be added
+
+    @retval true        on success
+    @retval false       if the buffer is full
+*/
+    bool push_front(const T& val) noexcept
+    {
+        bool bReturn = false;
+
+        if ( !full() )
+        {
+            m_nHead = (m_nHead - 1) & m_nMask;
+            m_vSlots[m_nHead] = val;
+            m_nSize++;
+            bReturn = true;
+        }
+
+        return bReturn;
+    };
+
+/**
+    @brief Removes the back (oldest) element
+*/
+    void pop_back(void) noexcept
+    {
+        if ( m_nSize > 0 )
+            m_nSize--;
+    };
+
+/**
+    @brief Inserts an element at a logical position
+
+    The elements from nPos onward are each moved one position
+    towards the back to make room.
+
+    @param [in] nPos    logical position of the new element
+    @param [in] val     element to be inserted
+
+    @retval true        on success
+    @retval false       if the buffer is full
+*/
+    bool insert(size_t nPos, const T& val) noexcept
+    {
+        bool bReturn = false;
+
+        if ( !full() && nPos <= m_nSize )
+        {
+            for ( size_t i = m_nSize; i > nPos; i-- )
+                (*this)[i] = (*this)[i - 1];
+
+            (*this)[nPos] = val;
+            m_nSize++;
+            bReturn = true;
+        }
+
+        return bReturn;
+    };
+
+/**
+    @brief Removes all elements
+*/
+    void clear(void) noexcept
+    {
+        m_nHead = 0;
+        m_nSize = 0;
+    };
+};
+
+#endif
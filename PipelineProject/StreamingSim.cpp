@@ -0,0 +1,131 @@
+/**
+* @file       StreamingSim.cpp
+* @brief      CStreamingSim class implementation
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*/
+
+#include "stdafx.h"
+#include "StreamingSim.h"
+
+
+CStreamingSim::CStreamingSim ( CPipelineSim& sim, size_t nBlockNodes, size_t nQueueBlocks ) noexcept
+    : m_Sim           ( sim ),
+      m_Reader        ( ),
+      m_Hazards       ( ),
+      m_queBlocks     ( nQueueBlocks ),
+      m_Block         ( ),
+      m_nBlockNodes   ( (nBlockNodes > 0) ? nBlockNodes : 1 ),
+      m_thrReader     ( ),
+      m_bEndOfStream  ( true ),
+      m_bComplete     ( false ),
+      m_qwNumStreamed ( 0 ),
+      m_qwSequential  ( 0 )
+{
+}
+
+CStreamingSim::~CStreamingSim ( )
+{
+    Close ( );
+}
+
+bool CStreamingSim::Open ( const TCHAR* szFileName ) noexcept
+{
+    Close ( );
+
+    // a superscalar pipeline checks the dependencies of the whole graph
+    if ( m_Sim.GetConfig ( ).IsSuperscalar ( ) || m_Reader.Open ( szFileName ) == false )
+        return false;
+
+    m_Sim.SetDependencyGraph ( nullptr );
+    // as with a frozen graph, an edge weight is only an issue distance if
+    // no node ID is left vacant
+    m_Hazards.BeginStream ( m_Sim.GetConfig ( ), m_Reader.GetNumNodes ( ) == m_Reader.GetNodeCapacity ( ) );
+    m_queBlocks.Reset ( );
+
+    m_bEndOfStream  = false;
+    m_bComplete     = false;
+    m_qwNumStreamed = 0;
+    m_qwSequential  = 0;
+
+    m_thrReader = std::thread ( &CStreamingSim::ReaderLoop, this );
+
+    return true;
+}
+
+bool CStreamingSim::ProcessNextCycle ( void ) noexcept
+{
+    // an empty instruction queue would otherwise start draining the pipeline
+    if ( m_Sim.GetQueuedCount ( ) == 0 && m_bEndOfStream == false )
+        Refill ( );
+
+    return m_Sim.ProcessNextCycle ( );
+}
+
+bool CStreamingSim::Close ( void ) noexcept
+{
+    if ( m_thrReader.joinable ( ) )
+    {
+        // a reader waiting for room in the queue gives up
+        m_queBlocks.Close ( );
+        m_thrReader.join ( );
+
+        m_bComplete = m_Reader.IsComplete ( );
+    }
+
+    m_Reader.Close ( );
+    m_bEndOfStream = true;
+
+    return m_bComplete;
+}
+
+void CStreamingSim::ReaderLoop ( void ) noexcept
+{
+    // the block pushed is exchanged for the storage of one already simulated
+    GRAPH_STREAM_BLOCK block = { };
+
+    while ( m_Reader.ReadBlock ( block, m_nBlockNodes ) > 0 )
+    {
+        if ( m_queBlocks.Push ( block ) == false )
+            break;
+    }
+
+    m_queBlocks.Close ( );
+}
+
+void CStreamingSim::Refill ( void ) noexcept
+{
+    while ( m_Sim.GetQueuedCount ( ) == 0 )
+    {
+        if ( m_queBlocks.Pop ( m_Block ) == false )
+        {
+            m_bEndOfStream = true;
+            break;
+        }
+
+        for ( size_t i = 0; i < m_Block.vFlags.size ( ); i++ )
+        {
+            const BYTE byFlags = m_Block.vFlags[i];
+
+            if ( (byFlags & NF_VALID) == 0 )
+                continue;
+
+            const NODE_ID_T            idNode  = m_Block.idFirst + static_cast<NODE_ID_T>(i);
+            const IC_INSTRUCTION_CLASS icClass = static_cast<IC_INSTRUCTION_CLASS>((byFlags & NF_CLASS_MASK) >> NF_CLASS_SHIFT);
+            const CDirectedEdgeData*   pEdges  = m_Block.vEdges.data ( );
+
+            CInstructionData instruction ( idNode );
+
+            instruction.SetStallCycles ( m_Hazards.IssueStreamed ( idNode, icClass,
+                                                                   pEdges + m_Block.vOffsets[i],
+                                                                   pEdges + m_Block.vOffsets[i + 1] ) );
+            instruction.SetClass ( icClass );
+
+            m_Sim.InsertInstruction ( instruction );
+            m_qwNumStreamed++;
+            m_qwSequential += m_Sim.GetConfig ( ).GetNumStages ( ) + m_Sim.GetConfig ( ).GetExecuteLatency ( icClass ) - 1;
+        }
+    }
+}
@@ -0,0 +1,179 @@
+/**
+* @file       StreamingSim.h
+* @brief      CStreamingSim class interface
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  Simulates a binary graph file without loading it, for traces too long to
+*  be held in memory as a CCsrDependencyGraph.  A reader thread reads the
+*  file a block of nodes at a time, by way of a CGraphStreamReader, into a
+*  CBoundedQueue of blocks, waiting whenever the simulation falls behind by
+*  the whole queue.  The simulation thread pops a block whenever the
+*  simulator's instruction queue runs dry, issues each of its instructions
+*  through a streamed CHazardAnalysis, and inserts them into the
+*  CPipelineSim, whose pipeline discards each instruction as it retires.
+*
+*  The memory used is therefore bounded by the block size and the queue
+*  depth, the sliding window of instructions read but not yet simulated,
+*  however long the trace; the results are those of loading the whole graph
+*  and simulating it in node ID order, stepped.  As a superscalar pipeline
+*  consults the graph as it issues, and the list scheduler requires the
+*  whole of it, only the scalar pipeline, issuing in node ID order, is
+*  streamed.
+*/
+#pragma once
+
+#if !defined(_STREAMING_SIM_H__)
+#define _STREAMING_SIM_H__
+
+#ifndef _PIPELINE_SIM_H__
+    #include "PipelineSim.h"
+#endif
+
+#ifndef _GRAPH_STREAM_READER_H__
+    #include "GraphStreamReader.h"
+#endif
+
+#ifndef _HAZARD_ANALYSIS_H__
+    #include "HazardAnalysis.h"
+#endif
+
+#ifndef _BOUNDED_QUEUE_H__
+    #include "BoundedQueue.h"
+#endif
+
+#ifndef _THREAD_
+    #include <thread>
+#endif
+
+/// default number of nodes read into each block
+constexpr size_t DEFAULT_STREAM_BLOCK_NODES  = 16384;
+/// default number of blocks the reader may be ahead of the simulation
+constexpr size_t DEFAULT_STREAM_QUEUE_BLOCKS = 4;
+
+/**
+    @brief Windowed simulation of a streamed binary graph file
+*/
+class CStreamingSim
+{
+    CPipelineSim&                     m_Sim;           ///< simulation fed by the stream
+    CGraphStreamReader                m_Reader;        ///< reader of the file, owned by the reader thread while running
+    CHazardAnalysis                   m_Hazards;       ///< streamed analysis of the instructions issued
+    CBoundedQueue<GRAPH_STREAM_BLOCK> m_queBlocks;     ///< blocks read but not yet simulated
+    GRAPH_STREAM_BLOCK                m_Block;         ///< block last popped by the simulation thread
+    size_t                            m_nBlockNodes;   ///< number of nodes read into each block
+    std::thread                       m_thrReader;     ///< background reader thread
+    bool                              m_bEndOfStream;  ///< every block has been popped
+    bool                              m_bComplete;     ///< the whole file was read, once closed
+    QWORD                             m_qwNumStreamed; ///< instructions inserted into the simulation
+    QWORD                             m_qwSequential;  ///< cycles the instructions inserted take to execute sequentially
+
+public:
+    /**
+        @brief Initialization Constructor
+
+        @param [in,out] sim         scalar simulation to be fed, presumed
+                                    to be in its initial state
+        @param [in] nBlockNodes     number of nodes read into each block
+        @param [in] nQueueBlocks    number of blocks the reader may be
+                                    ahead of the simulation
+    */
+    explicit CStreamingSim(CPipelineSim& sim, size_t nBlockNodes = DEFAULT_STREAM_BLOCK_NODES,
+                           size_t nQueueBlocks = DEFAULT_STREAM_QUEUE_BLOCKS) noexcept;
+
+    /// Default Destructor, stops the reader thread if running
+    ~CStreamingSim();
+
+/**
+    @brief Opens a binary graph file and starts the reader thread
+
+    @param [in] szFileName  name of the binary graph file
+
+    @retval true            on success
+    @retval false           if the file is not a binary graph file, or
+                            the simulated pipeline is superscalar
+*/
+    bool Open(const TCHAR* szFileName) noexcept;
+
+/**
+    @brief Process next pipeline instruction cycle, first refilling the
+           simulation's instruction queue from the stream if it is empty
+
+    @retval true    if there are subsequent instructions to be executed
+    @retval false   if there are no more instructions to be executed
+*/
+    bool ProcessNextCycle(void) noexcept;
+
+/**
+    @brief Stops the reader thread, and closes the file
+
+    @retval true    if the whole file was read, and found to be well formed
+*/
+    bool Close(void) noexcept;
+
+/**
+    @brief Retrieves the number of valid nodes of the file
+
+    @retval size_t          count of instructions
+*/
+    size_t GetNumNodes(void) const noexcept
+    { return m_Reader.GetNumNodes(); };
+
+/**
+    @brief Retrieves the number of instructions streamed into the simulation
+
+    @retval QWORD           count of instructions
+*/
+    constexpr QWORD GetNumStreamed(void) const noexcept
+    { return m_qwNumStreamed; };
+
+/**
+    @brief Retrieves the number of cycles the instructions streamed into the
+           simulation would take to execute sequentially, each passing every
+           stage and taking its execute latency
+
+    @retval QWORD           count of cycles
+*/
+    constexpr QWORD GetSequentialCycles(void) const noexcept
+    { return m_qwSequential; };
+
+/**
+    @brief Retrieves the maximum number of nodes held at once, those of
+           the blocks queued, being read, and being simulated
+
+    @retval size_t          count of nodes
+*/
+    size_t GetWindowNodes(void) const noexcept
+    { return m_nBlockNodes * (m_queBlocks.capacity() + 2); };
+
+/**
+    @brief Retrieves the analysis of the instructions issued
+
+    @retval CHazardAnalysis&    streamed analysis
+*/
+    const CHazardAnalysis& GetHazards(void) const noexcept
+    { return m_Hazards; };
+
+private:
+/**
+    @brief Reads every block of the file into the queue, closing it once
+           done, or once the queue is closed
+*/
+    void ReaderLoop(void) noexcept;
+
+/**
+    @brief Pops blocks until at least one instruction has been inserted
+           into the simulation, or the stream has ended
+*/
+    void Refill(void) noexcept;
+
+    /// copy constructor
+    CStreamingSim(const CStreamingSim& o) = delete;
+
+    /// assignment operator
+    CStreamingSim& operator=(const CStreamingSim& rhs) = delete;
+};
+
+#endif
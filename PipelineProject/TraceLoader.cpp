@@ -0,0 +1,259 @@
+/**
+* @file       TraceLoader.cpp
+* @brief      CTraceLoader class implementation
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*/
+
+#include "stdafx.h"
+#include "TraceLoader.h"
+#include <string.h>
+#include <new>
+
+
+CTraceLoader::CTraceLoader ( CDependencyGraph& dag ) noexcept
+    : m_pGraph          ( &dag ),
+      m_pBuilder        ( nullptr ),
+      m_nNumNodes       ( 0 ),
+      m_nNumEdges       ( 0 ),
+      m_nBytesParsed    ( 0 ),
+      m_bMalformed      ( false ),
+      m_bNodeList       ( true ),
+      m_bInToken        ( false ),
+      m_bAlias          ( false ),
+      m_bAliased        ( false ),
+      m_ullValue        ( 0 ),
+      m_idPendingSrc    ( INVALID_NODE_ID ),
+      m_bHavePendingSrc ( false ),
+      m_idLastNode      ( INVALID_NODE_ID ),
+      m_bClassPending   ( false ),
+      m_nClassLen       ( 0 ),
+      m_szClass         ( )
+{
+}
+
+CTraceLoader::CTraceLoader ( CEdgeListBuilder& builder ) noexcept
+    : m_pGraph          ( nullptr ),
+      m_pBuilder        ( &builder ),
+      m_nNumNodes       ( 0 ),
+      m_nNumEdges       ( 0 ),
+      m_nBytesParsed    ( 0 ),
+      m_bMalformed      ( false ),
+      m_bNodeList       ( true ),
+      m_bInToken        ( false ),
+      m_bAlias          ( false ),
+      m_bAliased        ( false ),
+      m_ullValue        ( 0 ),
+      m_idPendingSrc    ( INVALID_NODE_ID ),
+      m_bHavePendingSrc ( false ),
+      m_idLastNode      ( INVALID_NODE_ID ),
+      m_bClassPending   ( false ),
+      m_nClassLen       ( 0 ),
+      m_szClass         ( )
+{
+}
+
+bool CTraceLoader::LoadFile ( const TCHAR* szFileName ) noexcept
+{
+    bool bReturn = false;
+
+    FILE* pFile = _tfopen ( szFileName, _T("rb") );
+
+    if ( pFile != nullptr )
+    {
+        std::vector<char> vBuffer ( LOADER_BLOCK_SIZE );
+
+        size_t nRead = 0;
+
+        // a graph too large to be accommodated fails the load, rather
+        // than the process
+        try
+        {
+            while ( (nRead = fread ( vBuffer.data ( ), 1, vBuffer.size ( ), pFile )) > 0 )
+            {
+                ParseBlock ( vBuffer.data ( ), vBuffer.data ( ) + nRead );
+            }
+
+            Finish ( );
+
+            bReturn = (ferror ( pFile ) == 0) && (m_bMalformed == false);
+        }
+        catch ( const std::bad_alloc& )
+        {
+            bReturn = false;
+        }
+
+        fclose ( pFile );
+    }
+
+    return bReturn;
+}
+
+void CTraceLoader::ParseBlock ( const char* pBegin, const char* pEnd )
+{
+    // skip any UTF-8 byte order mark at the start of the data
+    if ( m_nBytesParsed == 0 && (pEnd - pBegin) >= 3 &&
+         static_cast<BYTE>(pBegin[0]) == 0xEF &&
+         static_cast<BYTE>(pBegin[1]) == 0xBB &&
+         static_cast<BYTE>(pBegin[2]) == 0xBF )
+    {
+        pBegin += 3;
+    }
+
+    m_nBytesParsed += (pEnd - pBegin);
+
+    for ( const char* p = pBegin; p != pEnd && m_bMalformed == false; ++p )
+    {
+        const char ch = *p;
+
+        const unsigned int uDigit = static_cast<unsigned int>(ch - '0');
+
+        if ( uDigit < 10 )
+        {
+            // digits are not significant within a class name
+            if ( m_bClassPending )
+                continue;
+
+            if ( m_bInToken == false )
+            {
+                m_bInToken = true;
+                m_bAlias   = false;
+                m_ullValue = 0;
+            }
+
+            // digits trailing an alias are ignored, and numeric values are
+            // clamped such that an overflow maps onto INVALID_NODE_ID
+            if ( m_bAlias == false && m_ullValue < INVALID_NODE_ID )
+                m_ullValue = (m_ullValue * 10) + uDigit;
+        }
+        else if ( (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') )
+        {
+            if ( m_bClassPending )
+            {
+                // accumulate the instruction class name, lower-cased
+                if ( m_nClassLen < MAX_CLASS_NAME )
+                    m_szClass[m_nClassLen++] = (ch >= 'a') ? ch : static_cast<char>(ch - 'A' + 'a');
+            }
+            // only the leading letter of a token is significant
+            else if ( m_bInToken == false )
+            {
+                m_bInToken = true;
+                m_bAlias   = true;
+                m_bAliased = true;
+                m_ullValue = (ch >= 'a') ? (ch - 'a') : (ch - 'A');
+            }
+        }
+        else
+        {
+            // anything else is a separator
+            if ( m_bInToken )
+                CompleteToken ( );
+            else if ( m_nClassLen > 0 )
+                CompleteClass ( );
+
+            if ( ch == ':' && m_bNodeList )
+            {
+                m_bClassPending = true;
+            }
+            else if ( ch == ',' || ch == '\n' )
+            {
+                m_bClassPending = false;
+
+                if ( ch == '\n' )
+                    m_bNodeList = false;
+            }
+        }
+    }
+}
+
+void CTraceLoader::Finish ( void )
+{
+    if ( m_bInToken )
+        CompleteToken ( );
+    else if ( m_nClassLen > 0 )
+        CompleteClass ( );
+
+    m_bNodeList       = false;
+    m_bClassPending   = false;
+    m_bHavePendingSrc = false;
+}
+
+void CTraceLoader::CompleteToken ( void )
+{
+    m_bInToken = false;
+
+    NODE_ID_T idNode = (m_ullValue < INVALID_NODE_ID) ? static_cast<NODE_ID_T>(m_ullValue)
+                                                      : INVALID_NODE_ID;
+
+    // an overflowed node ID, or one listed far beyond the count of nodes,
+    // would otherwise have the graph sized for it
+    if ( (idNode == INVALID_NODE_ID) ||
+         (m_bNodeList && idNode >= m_nNumNodes + LOADER_MAX_ID_GAP) )
+    {
+        m_bMalformed = true;
+        return;
+    }
+
+    if ( m_bNodeList )
+    {
+        const bool bAdded = (m_pBuilder != nullptr) ? m_pBuilder->AddNode ( idNode )
+                                                    : m_pGraph->AddNode ( idNode );
+
+        if ( bAdded )
+            m_nNumNodes++;
+
+        m_idLastNode = idNode;
+    }
+    else if ( m_bHavePendingSrc == false )
+    {
+        m_idPendingSrc    = idNode;
+        m_bHavePendingSrc = true;
+    }
+    else
+    {
+        m_bHavePendingSrc = false;
+
+        // in estimating an edge weight, lets use the time delta or "dependency
+        // distance" between when the 2 instructions are scheduled to begin execution.
+        int iWeight = static_cast<int>(m_idPendingSrc) - static_cast<int>(idNode);
+
+        const bool bAdded = (m_pBuilder != nullptr) ? m_pBuilder->AddEdge ( m_idPendingSrc, idNode, iWeight )
+                                                    : m_pGraph->AddEdge ( m_idPendingSrc, idNode, iWeight );
+
+        if ( bAdded )
+            m_nNumEdges++;
+    }
+}
+
+void CTraceLoader::CompleteClass ( void )
+{
+    m_szClass[m_nClassLen] = '\0';
+
+    IC_INSTRUCTION_CLASS icClass = IC_NUM_CLASSES;
+
+    if ( strcmp ( m_szClass, "ld" ) == 0 || strcmp ( m_szClass, "load" ) == 0 )
+        icClass = IC_LOAD;
+    else if ( strcmp ( m_szClass, "alu" ) == 0 )
+        icClass = IC_ALU;
+    else if ( strcmp ( m_szClass, "bt" ) == 0 )
+        icClass = IC_BRANCH_TAKEN;
+    else if ( strcmp ( m_szClass, "bn" ) == 0 )
+        icClass = IC_BRANCH;
+    else if ( strcmp ( m_szClass, "mul" ) == 0 )
+        icClass = IC_MUL;
+    else if ( strcmp ( m_szClass, "div" ) == 0 )
+        icClass = IC_DIV;
+
+    if ( icClass != IC_NUM_CLASSES )
+    {
+        if ( m_pBuilder != nullptr )
+            m_pBuilder->SetNodeClass ( m_idLastNode, icClass );
+        else
+            m_pGraph->SetNodeClass ( m_idLastNode, icClass );
+    }
+
+    m_bClassPending = false;
+    m_nClassLen     = 0;
+}
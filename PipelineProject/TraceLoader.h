@@ -0,0 +1,186 @@
+/**
+* @file       TraceLoader.h
+* @brief      CTraceLoader class interface
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  The instruction trace input format consists of:
+*  - a 1st line containing the list of instructions, separated by commas
+*    and/or white space
+*  - followed by any number of instruction dependencies, in the format of:
+*        B<space>A<NL>
+*    where "B A" means that B depends on the result of A
+*
+*  An instruction may either be a decimal node number, or a single letter
+*  used as a symbolic alias, in which case 'A' (or 'a') maps to node 0,
+*  'B' to node 1 and so on.
+*
+*  Within the instruction list, an instruction may optionally be followed
+*  by a colon and its instruction class, e.g. "A, B:ld, C"; recognized
+*  classes are "alu" (the default), "ld" or "load", "mul", "div", and for a
+*  conditional branch, the outcome it had when traced, "bt" if taken or "bn"
+*  if not.
+*
+*  Node IDs need not be contiguous, though a listed node ID may not lie more
+*  than LOADER_MAX_ID_GAP beyond the number of nodes listed before it, nor
+*  may any node ID overflow; either renders the trace malformed.
+*/
+#pragma once
+
+#if !defined(_TRACE_LOADER_H__)
+#define _TRACE_LOADER_H__
+
+#ifndef _DEPENDENCY_GRAPH_H__
+    #include "DependencyGraph.h"
+#endif
+
+#ifndef _EDGE_LIST_BUILDER_H__
+    #include "EdgeListBuilder.h"
+#endif
+
+#ifndef _VECTOR_
+    #include <vector>
+#endif
+
+/// size of the blocks read from the input file
+constexpr size_t LOADER_BLOCK_SIZE = 1024 * 1024;
+/// maximum significant length of an instruction class name
+constexpr size_t MAX_CLASS_NAME    = 8;
+/// greatest number of node ID slots a listed node may lie beyond the count
+/// of nodes listed before it, as the graph is sized by its largest node ID
+constexpr size_t LOADER_MAX_ID_GAP = 1024 * 1024;
+
+/**
+    @brief Streaming instruction trace loader
+
+    CTraceLoader reads the input file in large blocks, and parses the raw
+    bytes with a hand-rolled, locale-independent scanner.  The scanner
+    state persists between blocks, so tokens may straddle a block
+    boundary without any data being copied.  Parsed nodes and edges are
+    pushed directly into the target, either a CDependencyGraph or, when the
+    graph is to be frozen, a CEdgeListBuilder.
+*/
+class CTraceLoader
+{
+    CDependencyGraph*   m_pGraph;          ///< graph being loaded, if any
+    CEdgeListBuilder*   m_pBuilder;        ///< edge list being loaded, if any
+    size_t              m_nNumNodes;       ///< count of nodes added to the graph
+    size_t              m_nNumEdges;       ///< count of edges added to the graph
+    size_t              m_nBytesParsed;    ///< count of bytes scanned so far
+    bool                m_bMalformed;      ///< true once a node ID has been rejected
+    bool                m_bNodeList;       ///< true while parsing the 1st line
+    bool                m_bInToken;        ///< true while inside of a token
+    bool                m_bAlias;          ///< current token is a symbolic alias
+    bool                m_bAliased;        ///< true once any token has been an alias
+    unsigned long long  m_ullValue;        ///< current token value
+    NODE_ID_T           m_idPendingSrc;    ///< source node awaiting its destination
+    bool                m_bHavePendingSrc; ///< true if m_idPendingSrc is set
+    NODE_ID_T           m_idLastNode;      ///< most recently listed node
+    bool                m_bClassPending;   ///< a ':' has been found, class name follows
+    size_t              m_nClassLen;       ///< length of the class name scanned so far
+    char                m_szClass[MAX_CLASS_NAME + 1]; ///< class name being scanned
+
+public:
+    /**
+        @brief Initialization Constructor
+
+        @param [in,out] dag     destination graph for the loaded data
+    */
+    explicit CTraceLoader(CDependencyGraph& dag) noexcept;
+
+    /**
+        @brief Initialization Constructor
+
+        @param [in,out] builder destination edge list for the loaded data
+    */
+    explicit CTraceLoader(CEdgeListBuilder& builder) noexcept;
+
+    /// Default Destructor
+    ~CTraceLoader() = default;
+
+    /**
+        @brief Loads an instruction trace file in its entirety
+
+        @param [in] szFileName  name of the data file to be loaded
+
+        @retval true            on success
+        @retval false           if the file could not be opened or read,
+                                or was found to be malformed
+    */
+    bool LoadFile(const TCHAR* szFileName) noexcept;
+
+    /**
+        @brief Parses the next contiguous block of trace data
+
+        Blocks are expected to be presented in file order; the end
+        of the data must be signalled by calling Finish().  Once the
+        data is found to be malformed, any remaining data is ignored.
+        Exhausting memory in growing the graph throws std::bad_alloc.
+
+        @param [in] pBegin      start of the block
+        @param [in] pEnd        one past the end of the block
+    */
+    void ParseBlock(const char* pBegin, const char* pEnd);
+
+    /**
+        @brief Completes parsing of any token left pending at end of data
+    */
+    void Finish(void);
+
+    /**
+        @brief Retrieves the number of nodes added to the graph
+
+        @retval size_t      count of nodes
+    */
+    constexpr size_t GetNumNodes(void) const noexcept
+    { return m_nNumNodes; };
+
+    /**
+        @brief Retrieves the number of edges added to the graph
+
+        An edge list accepts every edge, its duplicates only being
+        dropped once frozen.
+
+        @retval size_t      count of edges
+    */
+    constexpr size_t GetNumEdges(void) const noexcept
+    { return m_nNumEdges; };
+
+    /**
+        @brief Determines whether the data has been found to be malformed
+
+        @retval true        if a node ID overflowed, or was listed too far
+                            beyond the nodes preceding it
+    */
+    constexpr bool IsMalformed(void) const noexcept
+    { return m_bMalformed; };
+
+    /**
+        @brief Determines whether the trace names its instructions by letter
+
+        @retval true        if any instruction was given as a symbolic alias
+    */
+    constexpr bool IsAliased(void) const noexcept
+    { return m_bAliased; };
+
+private:
+    /**
+        @brief Dispatches a completed token as either a node or edge end-point
+    */
+    void CompleteToken(void);
+
+    /**
+        @brief Applies a completed instruction class name to the last listed node
+    */
+    void CompleteClass(void);
+
+    /// copy constructor
+    CTraceLoader(const CTraceLoader& o) = delete;
+
+    /// assignment operator
+    CTraceLoader& operator=(const CTraceLoader& rhs) = delete;
+};
+
+#endif
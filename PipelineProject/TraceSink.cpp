@@ -0,0 +1,100 @@
+/**
+* @file       TraceSink.cpp
+* @brief      CTraceSink class implementation
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*/
+
+#include "stdafx.h"
+#include "TraceSink.h"
+
+
+CTraceSink::CTraceSink ( ) noexcept
+    : m_tsMode           ( TS_CONSOLE ),
+      m_dwSampleInterval ( SAMPLE_STALLS_ONLY ),
+      m_qwLastStallCount ( 0 ),
+      m_vBuffer          ( ),
+      m_ofs              ( ),
+      m_pStream          ( &tcout )
+{
+}
+
+CTraceSink::~CTraceSink ( )
+{
+    Flush ( );
+}
+
+bool CTraceSink::Open ( TS_SINK_MODE tsMode, const TCHAR* szFileName, DWORD dwSampleInterval ) noexcept
+{
+    Flush ( );
+
+    if ( m_ofs.is_open ( ) )
+        m_ofs.close ( );
+
+    m_tsMode           = tsMode;
+    m_dwSampleInterval = dwSampleInterval;
+    m_qwLastStallCount = 0;
+    m_pStream          = nullptr;
+
+    const bool bFile = (tsMode == TS_BUFFERED) || (tsMode == TS_SAMPLED && szFileName != nullptr);
+
+    if ( bFile )
+    {
+        if ( szFileName == nullptr )
+        {
+            m_tsMode = TS_OFF;
+            return false;
+        }
+
+        // the buffer must be in place before the file is opened
+        m_vBuffer.resize ( DEFAULT_TRACE_BUFFER_SIZE );
+        m_ofs.rdbuf ( )->pubsetbuf ( m_vBuffer.data ( ), static_cast<std::streamsize>(m_vBuffer.size ( )) );
+
+        m_ofs.open ( szFileName, std::ios::out | std::ios::trunc );
+
+        if ( m_ofs.is_open ( ) == false )
+        {
+            m_tsMode = TS_OFF;
+            return false;
+        }
+
+        m_pStream = &m_ofs;
+    }
+    else if ( tsMode != TS_OFF )
+    {
+        m_pStream = &tcout;
+    }
+
+    return true;
+}
+
+void CTraceSink::OutputCycle ( const CPipelineSim& sim ) noexcept
+{
+    if ( m_pStream == nullptr )
+        return;
+
+    if ( m_tsMode == TS_SAMPLED )
+    {
+        const QWORD qwStallCount = sim.GetStallCount ( );
+
+        const bool bSelected = (m_dwSampleInterval == SAMPLE_STALLS_ONLY) ? (qwStallCount != m_qwLastStallCount)
+                                                                          : (sim.GetCycle ( ) % m_dwSampleInterval == 0);
+
+        m_qwLastStallCount = qwStallCount;
+
+        if ( bSelected == false )
+            return;
+
+        *m_pStream << std::setw(10) << sim.GetCycle ( ) << _T(": ");
+    }
+
+    sim.OutputCurrentInstructionCycle ( *m_pStream );
+}
+
+void CTraceSink::Flush ( void ) noexcept
+{
+    if ( m_pStream != nullptr )
+        m_pStream->flush ( );
+}
@@ -0,0 +1,127 @@
+/**
+* @file       TraceSink.h
+* @brief      CTraceSink class interface
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  The destination of the per-cycle pipeline trace, decoupling what is
+*  written, and how, from the simulation loop.  The supported modes are:
+*  - console, every cycle is written to the console (the default)
+*  - off, nothing is written, only the summary statistics are reported
+*  - buffered, every cycle is written to a file through a large stream
+*    buffer, with no flush per line
+*  - sampled, only every Nth cycle, or only the cycles in which a stall was
+*    introduced, is written to a file or to the console, each line being
+*    prefixed by its cycle number
+*/
+#pragma once
+
+#if !defined(_TRACE_SINK_H__)
+#define _TRACE_SINK_H__
+
+#ifndef _PIPELINE_SIM_H__
+    #include "PipelineSim.h"
+#endif
+
+#ifndef _FSTREAM_
+    #include <fstream>
+#endif
+
+#ifndef _VECTOR_
+    #include <vector>
+#endif
+
+/// default number of TCHARs buffered ahead of a buffered trace file
+constexpr size_t DEFAULT_TRACE_BUFFER_SIZE = 1024 * 1024;
+
+/// sampling interval selecting only the cycles in which a stall was introduced
+constexpr DWORD  SAMPLE_STALLS_ONLY = 0;
+
+/**
+    @brief Trace sink mode
+*/
+typedef enum TS_SINK_MODE
+{
+    TS_CONSOLE = 0,     ///< every cycle is written to the console
+    TS_OFF,             ///< no trace is written
+    TS_BUFFERED,        ///< every cycle is written to a buffered file
+    TS_SAMPLED          ///< sampled cycles are written to a file or the console
+} TS_SINK_MODE_T;
+
+/**
+    @brief Per-cycle pipeline trace destination
+*/
+class CTraceSink
+{
+    TS_SINK_MODE               m_tsMode;           ///< sink mode
+    DWORD                      m_dwSampleInterval; ///< cycles between samples, or SAMPLE_STALLS_ONLY
+    QWORD                      m_qwLastStallCount; ///< stall count of the previously written cycle
+    std::vector<TCHAR>         m_vBuffer;          ///< file stream buffer
+    std::basic_ofstream<TCHAR> m_ofs;              ///< trace file, if any
+    tostream*                  m_pStream;          ///< destination stream, nullptr if off
+
+public:
+    /// Default Constructor, writes every cycle to the console
+    CTraceSink() noexcept;
+
+    /// Default Destructor, flushes any buffered output
+    ~CTraceSink();
+
+/**
+    @brief Selects the sink mode and destination
+
+    @param [in] tsMode              sink mode
+    @param [in] szFileName          trace file name, required by TS_BUFFERED,
+                                    optional for TS_SAMPLED (nullptr for the
+                                    console) and otherwise ignored
+    @param [in] dwSampleInterval    TS_SAMPLED cycles between samples, or
+                                    SAMPLE_STALLS_ONLY
+
+    @retval true                    on success
+    @retval false                   if the trace file could not be opened,
+                                    in which case the sink is off
+*/
+    bool Open(TS_SINK_MODE tsMode, const TCHAR* szFileName = nullptr,
+              DWORD dwSampleInterval = SAMPLE_STALLS_ONLY) noexcept;
+
+/**
+    @brief Retrieves the sink mode
+
+    @retval TS_SINK_MODE    sink mode
+*/
+    constexpr TS_SINK_MODE GetMode(void) const noexcept
+    { return m_tsMode; };
+
+/**
+    @brief Determines whether anything is written at all, such that the
+           simulation loop may skip calling OutputCycle
+
+    @retval true    if cycles are written
+    @retval false   if the sink is off
+*/
+    constexpr bool IsEnabled(void) const noexcept
+    { return m_pStream != nullptr; };
+
+/**
+    @brief Writes the cycle just processed, if selected by the sink mode
+
+    @param [in] sim     simulation object
+*/
+    void OutputCycle(const CPipelineSim& sim) noexcept;
+
+/**
+    @brief Flushes any buffered output
+*/
+    void Flush(void) noexcept;
+
+private:
+    /// copy constructor
+    CTraceSink(const CTraceSink& o) = delete;
+
+    /// assignment operator
+    CTraceSink& operator=(const CTraceSink& rhs) = delete;
+};
+
+#endif
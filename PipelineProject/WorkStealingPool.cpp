@@ -0,0 +1,99 @@
+/**
+* @file       WorkStealingPool.cpp
+* @brief      CWorkStealingPool class implementation
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*/
+
+#include "stdafx.h"
+#include "WorkStealingPool.h"
+
+#ifndef _THREAD_
+    #include <thread>
+#endif
+
+
+CWorkStealingPool::CWorkStealingPool ( DWORD dwNumWorkers ) noexcept
+    : m_dwNumWorkers ( dwNumWorkers ),
+      m_vQueues      ( )
+{
+    if ( m_dwNumWorkers == 0 )
+        m_dwNumWorkers = std::thread::hardware_concurrency ( );
+
+    // hardware_concurrency may not be able to tell
+    if ( m_dwNumWorkers == 0 )
+        m_dwNumWorkers = 1;
+
+    std::vector<WORK_QUEUE>(m_dwNumWorkers).swap ( m_vQueues );
+}
+
+void CWorkStealingPool::Run ( size_t nNumTasks, const TASK_FN& fnTask ) noexcept
+{
+    // deal the tasks out round-robin, in such a way that each worker
+    // takes the lowest of its own task indices first
+    for ( size_t nTask = 0; nTask < nNumTasks; nTask++ )
+        m_vQueues[nTask % m_dwNumWorkers].deqTasks.push_front ( nTask );
+
+    // there is no point in starting more threads than there are tasks
+    const DWORD dwNumThreads = (nNumTasks < m_dwNumWorkers) ? static_cast<DWORD>(nNumTasks)
+                                                            : m_dwNumWorkers;
+
+    std::vector<std::thread> vThreads;
+
+    for ( DWORD dwWorker = 1; dwWorker < dwNumThreads; dwWorker++ )
+        vThreads.emplace_back ( &CWorkStealingPool::WorkerLoop, this, dwWorker, std::cref ( fnTask ) );
+
+    WorkerLoop ( 0, fnTask );
+
+    for ( std::vector<std::thread>::iterator it = vThreads.begin ( ); it != vThreads.end ( ); ++it )
+        it->join ( );
+}
+
+void CWorkStealingPool::WorkerLoop ( DWORD dwWorker, const TASK_FN& fnTask ) noexcept
+{
+    size_t nTask = 0;
+
+    // no tasks are added while running, so once every queue has been
+    // found empty the worker is done
+    while ( PopTask ( dwWorker, nTask ) || StealTask ( dwWorker, nTask ) )
+        fnTask ( nTask, dwWorker );
+}
+
+bool CWorkStealingPool::PopTask ( DWORD dwWorker, size_t& nTask ) noexcept
+{
+    WORK_QUEUE& queue = m_vQueues[dwWorker];
+
+    std::lock_guard<std::mutex> lock ( queue.mtxLock );
+
+    if ( queue.deqTasks.empty ( ) )
+        return false;
+
+    nTask = queue.deqTasks.back ( );
+    queue.deqTasks.pop_back ( );
+
+    return true;
+}
+
+bool CWorkStealingPool::StealTask ( DWORD dwWorker, size_t& nTask ) noexcept
+{
+    // visit the other workers starting with the next one, so that
+    // thieves spread out over their victims
+    for ( DWORD i = 1; i < m_dwNumWorkers; i++ )
+    {
+        WORK_QUEUE& queue = m_vQueues[(dwWorker + i) % m_dwNumWorkers];
+
+        std::lock_guard<std::mutex> lock ( queue.mtxLock );
+
+        if ( queue.deqTasks.empty ( ) == false )
+        {
+            nTask = queue.deqTasks.front ( );
+            queue.deqTasks.pop_front ( );
+
+            return true;
+        }
+    }
+
+    return false;
+}
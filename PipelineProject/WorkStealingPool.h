@@ -0,0 +1,122 @@
+/**
+* @file       WorkStealingPool.h
+* @brief      CWorkStealingPool class interface
+*
+*
+* @author     Mark L. Short
+* @date       October 14, 2026
+*
+*  A pool of worker threads executing a fixed set of independent tasks,
+*  identified by their index.  The tasks are initially dealt out round-robin
+*  to a double-ended queue per worker:
+*  - a worker takes its own tasks from the back of its queue
+*  - a worker whose queue has been exhausted steals tasks from the front of
+*    the other workers' queues
+*
+*  Such that a skew in the size of the tasks does not leave workers idle
+*  while others still have work queued.
+*/
+#pragma once
+
+#if !defined(_WORK_STEALING_POOL_H__)
+#define _WORK_STEALING_POOL_H__
+
+#ifndef _COMMON_DEF_H__
+    #include "CommonDef.h"
+#endif
+
+#ifndef _DEQUE_
+    #include <deque>
+#endif
+
+#ifndef _FUNCTIONAL_
+    #include <functional>
+#endif
+
+#ifndef _MUTEX_
+    #include <mutex>
+#endif
+
+#ifndef _VECTOR_
+    #include <vector>
+#endif
+
+/**
+    @brief Work-stealing thread pool
+*/
+class CWorkStealingPool
+{
+    /**
+        @brief A worker's queue of task indices
+    */
+    struct WORK_QUEUE
+    {
+        std::mutex          mtxLock;  ///< guards deqTasks
+        std::deque<size_t>  deqTasks; ///< queued task indices
+    };
+
+    DWORD                   m_dwNumWorkers; ///< number of worker threads
+    std::vector<WORK_QUEUE> m_vQueues;      ///< per-worker task queues
+
+public:
+    /// task function, invoked with the task index and the executing worker index
+    typedef std::function<void(size_t nTask, DWORD dwWorker)> TASK_FN;
+
+    /**
+        @brief Initialization Constructor
+
+        @param [in] dwNumWorkers    number of worker threads, 0 to use the
+                                    number of hardware threads available
+    */
+    explicit CWorkStealingPool(DWORD dwNumWorkers = 0) noexcept;
+
+    /// Default Destructor
+    ~CWorkStealingPool() = default;
+
+/**
+    @brief Retrieves the number of worker threads
+
+    @retval DWORD   count of worker threads
+*/
+    constexpr DWORD GetNumWorkers(void) const noexcept
+    { return m_dwNumWorkers; };
+
+/**
+    @brief Executes a set of tasks to completion
+
+    Each of the tasks [0..nNumTasks) is executed exactly once, by one of
+    the workers.  The calling thread acts as worker 0, and the call
+    returns once every task has completed.
+
+    @param [in] nNumTasks   number of tasks
+    @param [in] fnTask      task function
+*/
+    void Run(size_t nNumTasks, const TASK_FN& fnTask) noexcept;
+
+private:
+/**
+    @brief Executes tasks until none remain in any queue
+
+    @param [in] dwWorker    index of the executing worker
+    @param [in] fnTask      task function
+*/
+    void WorkerLoop(DWORD dwWorker, const TASK_FN& fnTask) noexcept;
+
+/**
+    @brief Takes the next task from a worker's own queue
+*/
+    bool PopTask(DWORD dwWorker, size_t& nTask) noexcept;
+
+/**
+    @brief Steals a task from the queue of another worker
+*/
+    bool StealTask(DWORD dwWorker, size_t& nTask) noexcept;
+
+    /// copy constructor
+    CWorkStealingPool(const CWorkStealingPool& o) = delete;
+
+    /// assignment operator
+    CWorkStealingPool& operator=(const CWorkStealingPool& rhs) = delete;
+};
+
+#endif
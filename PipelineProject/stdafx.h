@@ -11,12 +11,14 @@
 
 #pragma once
 
-#include "targetver.h"
+#if defined(_WIN32)
+    #include "targetver.h"
+#endif
 
 #define _CRT_SECURE_NO_WARNINGS // turn off silly warnings from using string methods
 
 #include <stdio.h>
-#include <tchar.h>
+#include "PlatformDef.h"
 
 #ifndef _STRING_
     #include <string>